@@ -13,30 +13,37 @@
  *     Bit "1": ~0.8µs HIGH, ~0.45µs LOW   (total ~1.25µs)
  *     Bit "0": ~0.4µs HIGH, ~0.85µs LOW   (total ~1.25µs)
  *
- * We encode each LED data bit as 8 SPI bits at ~6.4 MHz:
- *     SPI bit period = 1 / 6.4MHz ≈ 156ns
- *     8 SPI bits = 8 × 156ns = 1.25µs  ← matches one LED bit period
+ * SpiEncoding::BITS_8 (default) — each LED bit is 8 SPI bits at 8 MHz:
+ *     SPI bit period = 1 / 8MHz = 125ns
  *
- *     LED bit "1" → SPI byte 0xF8 (11111000):
- *         5 × 156ns = 780ns HIGH  (spec: 580-1000ns ✓)
- *         3 × 156ns = 468ns LOW   (spec: 220-420ns, slightly over but works)
+ *     LED bit "1" → SPI byte 0xFC (11111100): 750ns HIGH, 250ns LOW
+ *     LED bit "0" → SPI byte 0xE0 (11100000): 375ns HIGH, 625ns LOW
  *
- *     LED bit "0" → SPI byte 0xC0 (11000000):
- *         2 × 156ns = 312ns HIGH  (spec: 220-380ns ✓)
- *         6 × 156ns = 937ns LOW   (spec: 580-1000ns ✓)
+ *     One LED byte → 8 SPI bytes.
  *
- * So for each byte of LED color data (8 LED bits), we produce 8 SPI bytes.
- * The SPI peripheral + DMA blasts them out with zero CPU involvement.
+ * SpiEncoding::BITS_3 — each LED bit is 3 SPI bits at 2.4 MHz:
+ *     SPI bit period = 1 / 2.4MHz ≈ 417ns
+ *
+ *     LED bit "1" → 110: 833ns HIGH, 417ns LOW
+ *     LED bit "0" → 100: 417ns HIGH, 833ns LOW
+ *
+ *     One LED byte → 3 SPI bytes (62% less DMA memory, less timing margin).
+ *     WS2812B only: SK6812 allows T1H 450-750ns, and 833ns is past it.
+ *     init() fails for SK6812 types with this encoding.
+ *
+ * Both encoders are table lookups with no per-bit branches: a nibble
+ * becomes one 32-bit word (BITS_8), a byte becomes 3 bytes (BITS_3).
  *
  * RESET PULSE:
- *     The strip needs >280µs of LOW to latch data.
- *     We append zeros to the SPI buffer: 280µs / 156ns ≈ 1795 bits ≈ 225 bytes.
- *     We use 256 bytes (rounded up) of 0x00 for a clean reset.
+ *     The strip needs >280µs of LOW to latch data. The tail of the SPI
+ *     buffer is zeros (written once at init): 256 bytes at 8 MHz, 96
+ *     bytes (~320µs) at 2.4 MHz.
  */
 
 #include "addressable_led.h"
 #include <freertos/FreeRTOS.h>
 #include <esp_log.h>
+#include <esp_timer.h>
 #include <cstring>
 #include <cmath>
 #include <esp_heap_caps.h>
@@ -60,11 +67,64 @@ static constexpr uint32_t WS2812_RESET_US = 280;
 // RMT resolution (10MHz = 100ns per tick)
 static constexpr uint32_t RMT_RESOLUTION_HZ = 10000000;
 
-// SPI encoding constants
+// SPI encoding constants (SpiEncoding::BITS_8)
 static constexpr uint8_t SPI_BIT_1 = 0xFC;         // 11111100 — 750ns HIGH, 250ns LOW
 static constexpr uint8_t SPI_BIT_0 = 0xE0;         // 11100000 — 375ns HIGH, 625ns LOW
-static constexpr uint32_t SPI_CLOCK_HZ = 8000000;    ///< 6.4 MHz → ~156ns per SPI bit
-static constexpr size_t SPI_RESET_BYTES = 256;      ///< ~320µs of LOW for reset
+static constexpr uint32_t SPI_CLOCK_HZ = 8000000;    ///< 8 MHz → 125ns per SPI bit
+static constexpr size_t SPI_RESET_BYTES = 256;      ///< 256µs of LOW for reset
+
+// SpiEncoding::BITS_3
+static constexpr uint8_t SPI3_BIT_1 = 0x6;          // 110 — 833ns HIGH, 417ns LOW
+static constexpr uint8_t SPI3_BIT_0 = 0x4;          // 100 — 417ns HIGH, 833ns LOW
+static constexpr uint32_t SPI3_CLOCK_HZ = 2400000;  ///< 2.4 MHz → ~417ns per SPI bit
+static constexpr size_t SPI3_RESET_BYTES = 96;      ///< ~320µs of LOW for reset
+
+
+/*
+ * =============================================================================
+ * SPI ENCODING TABLES
+ * =============================================================================
+ *
+ * BITS_8: nibble → 4 SPI bytes, stored as the little-endian word that puts
+ * them in memory in wire order (first bit = lowest address):
+ *
+ *     0b1010 → FC E0 FC E0 → 0xE0FCE0FC
+ *
+ * BITS_3: byte → 24 SPI bits, as 3 bytes in wire order.
+ */
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "SPI nibble table assumes a little-endian CPU");
+
+struct SpiNibbleTable {
+    uint32_t words[16];
+
+    constexpr SpiNibbleTable() : words{} {
+        for (int n = 0; n < 16; n++) {
+            for (int bit = 0; bit < 4; bit++) {
+                uint32_t spiByte = (n & (8 >> bit)) ? SPI_BIT_1 : SPI_BIT_0;
+                words[n] |= spiByte << (8 * bit);
+            }
+        }
+    }
+};
+
+struct Spi3ByteTable {
+    uint8_t bytes[256][3];
+
+    constexpr Spi3ByteTable() : bytes{} {
+        for (int v = 0; v < 256; v++) {
+            uint32_t bits = 0;
+            for (int bit = 7; bit >= 0; bit--) {
+                bits = (bits << 3) | ((v & (1 << bit)) ? SPI3_BIT_1 : SPI3_BIT_0);
+            }
+            bytes[v][0] = bits >> 16;
+            bytes[v][1] = bits >> 8;
+            bytes[v][2] = bits;
+        }
+    }
+};
+
+static constexpr SpiNibbleTable SPI_NIBBLE_TABLE;
+static constexpr Spi3ByteTable SPI3_BYTE_TABLE;
 
 
 /*
@@ -91,6 +151,37 @@ const uint8_t AddressableLED::GAMMA_TABLE[256] = {
     205, 207, 210, 212, 214, 216, 219, 221, 223, 226, 228, 231, 233, 235, 238, 255
 };
 
+/*
+ * 16-bit (8.8) version of GAMMA_TABLE for dithering. Below input 96 it
+ * is a smooth 2.6 power curve, where the 8-bit table can only say 0, 1
+ * or 2; above that it blends into GAMMA_TABLE × 256, so dithered and
+ * plain output look the same (within 1.25 levels).
+ */
+const uint16_t AddressableLED::GAMMA16_TABLE[256] = {
+        0,     0,     0,     1,     1,     2,     4,     5,     8,    10,    13,    17,
+       22,    27,    33,    39,    46,    54,    63,    72,    83,    94,   106,   120,
+      134,   149,   165,   182,   200,   219,   240,   261,   284,   308,   333,   359,
+      387,   415,   445,   477,   509,   543,   579,   616,   654,   694,   735,   777,
+      821,   867,   914,   963,  1013,  1065,  1118,  1173,  1230,  1288,  1348,  1410,
+     1474,  1539,  1606,  1675,  1745,  1818,  1892,  1968,  2046,  2125,  2207,  2291,
+     2376,  2463,  2553,  2644,  2738,  2833,  2930,  3030,  3131,  3235,  3341,  3448,
+     3558,  3670,  3785,  3901,  4020,  4140,  4263,  4389,  4516,  4646,  4778,  4912,
+     5049,  5188,  5329,  5473,  5619,  5768,  5919,  6072,  6229,  6385,  6547,  6713,
+     6875,  7046,  7220,  7387,  7566,  7749,  7921,  8109,  8300,  8494,  8672,  8871,
+     9074,  9280,  9462,  9672,  9886, 10103, 10287, 10508, 10732, 10959, 11189, 11422,
+    11608, 11844, 12083, 12324, 12568, 12814, 13063, 13314, 13568, 13823, 14081, 14262,
+    14521, 14782, 15044, 15308, 15573, 15840, 16108, 16378, 16753, 17027, 17303, 17579,
+    17856, 18134, 18412, 18690, 18969, 19248, 19662, 19944, 20226, 20508, 20789, 21219,
+    21503, 21786, 22069, 22511, 22795, 23077, 23359, 23812, 24094, 24374, 24834, 25115,
+    25581, 25861, 26139, 26610, 26888, 27363, 27640, 27914, 28394, 28667, 29149, 29421,
+    29906, 30175, 30663, 31152, 31419, 31911, 32176, 32669, 33164, 33426, 33922, 34420,
+    34679, 35178, 35677, 35935, 36435, 36936, 37438, 37693, 38196, 38699, 39204, 39709,
+    39962, 40468, 40975, 41482, 41991, 42500, 43010, 43520, 44032, 44544, 45056, 45568,
+    46080, 46592, 47104, 47616, 48128, 48640, 49152, 49664, 50176, 50944, 51456, 51968,
+    52480, 52992, 53760, 54272, 54784, 55296, 56064, 56576, 57088, 57856, 58368, 59136,
+    59648, 60160, 60928, 65280
+};
+
 
 /*
  * =============================================================================
@@ -195,16 +286,30 @@ AddressableLED::AddressableLED(gpio_num_t pin, uint16_t numLeds,
       rmtEncoder(nullptr),
       spiDevice(nullptr),
       spiBuffer(nullptr),
-      spiBufferSize(0)
+      spiBufferSize(0),
+      spiEncoding(SpiEncoding::BITS_8),
+      spiTxn{},
+      spiResultPending(false),
+      sending(false),
+      showEvents(nullptr),
+      showCallback(nullptr),
+      showCallbackArg(nullptr),
+      showStartUs(0),
+      stats{},
+      ditherEnabled(false),
+      preciseBuffer(nullptr),
+      ditherError(nullptr)
 {
     if (order == ColorOrder::GRB) {
         colorOrder = getDefaultOrder(type);
     }
 
+    rebuildCorrectionLut();
+
     bufferSize = numLeds * bytesPerLed;
 
-    ESP_LOGI(TAG, "Created AddressableLED: %d LEDs, %d bytes/LED, buffer=%d bytes, backend=%s",
-             numLeds, bytesPerLed, bufferSize,
+    ESP_LOGI(TAG, "Created AddressableLED: %d LEDs, %d bytes/LED, buffer=%u bytes, backend=%s",
+             numLeds, bytesPerLed, (unsigned)bufferSize,
              backend == TransportBackend::SPI ? "SPI" : "RMT");
 }
 
@@ -216,6 +321,9 @@ AddressableLED::AddressableLED(gpio_num_t pin, uint16_t numLeds,
  */
 AddressableLED::~AddressableLED()
 {
+    // The peripheral may still be reading frontBuffer / spiBuffer
+    if (initialized) waitShowDone(pdMS_TO_TICKS(ADDRESSABLE_SHOW_TIMEOUT_MS));
+
     // RMT cleanup
     if (rmtEncoder) {
         rmt_del_encoder(rmtEncoder);
@@ -249,6 +357,19 @@ AddressableLED::~AddressableLED()
         delete[] backBuffer;
         backBuffer = nullptr;
     }
+    if (preciseBuffer) {
+        delete[] preciseBuffer;
+        preciseBuffer = nullptr;
+    }
+    if (ditherError) {
+        delete[] ditherError;
+        ditherError = nullptr;
+    }
+
+    if (showEvents) {
+        vEventGroupDelete(showEvents);
+        showEvents = nullptr;
+    }
 
     ESP_LOGI(TAG, "AddressableLED destroyed");
 }
@@ -264,18 +385,52 @@ bool AddressableLED::init()
     ESP_LOGI(TAG, "Initializing AddressableLED on GPIO %d (%s backend)",
              pin, backend == TransportBackend::SPI ? "SPI" : "RMT");
 
+    // 3-bit pulses are 417ns steps: T1H = 833ns, over SK6812's 750ns limit
+    if (backend == TransportBackend::SPI && spiEncoding == SpiEncoding::BITS_3 &&
+        ledType != LedType::WS2812B) {
+        ESP_LOGE(TAG, "SpiEncoding::BITS_3 is WS2812B only (SK6812 T1H out of spec)");
+        return false;
+    }
+
     // Allocate double buffers (shared by both backends)
     frontBuffer = new uint8_t[bufferSize];
     backBuffer = new uint8_t[bufferSize];
 
     if (!frontBuffer || !backBuffer) {
-        ESP_LOGE(TAG, "Failed to allocate buffers (%d bytes each)", bufferSize);
+        ESP_LOGE(TAG, "Failed to allocate buffers (%u bytes each)", (unsigned)bufferSize);
         return false;
     }
 
     memset(frontBuffer, 0, bufferSize);
     memset(backBuffer, 0, bufferSize);
-    ESP_LOGI(TAG, "Allocated double buffers: %d bytes each", bufferSize);
+    ESP_LOGI(TAG, "Allocated double buffers: %u bytes each", (unsigned)bufferSize);
+
+    // 16-bit pixels and per-channel carry for dithering
+    if (ditherEnabled) {
+        preciseBuffer = new uint16_t[bufferSize];
+        ditherError = new uint8_t[bufferSize];
+
+        if (!preciseBuffer || !ditherError) {
+            ESP_LOGE(TAG, "Failed to allocate dither buffers (%u bytes)", (unsigned)(bufferSize * 3));
+            return false;
+        }
+
+        memset(preciseBuffer, 0, bufferSize * sizeof(uint16_t));
+
+        // Golden-ratio steps spread the starting carries evenly
+        for (size_t i = 0; i < bufferSize; i++) {
+            ditherError[i] = (uint8_t)(i * 158);
+        }
+        ESP_LOGI(TAG, "Dithering enabled: %u bytes", (unsigned)(bufferSize * 3));
+    }
+
+    // Completion signalling for show()/showAsync()
+    if (!showEvents) showEvents = xEventGroupCreate();
+    if (!showEvents) {
+        ESP_LOGE(TAG, "Failed to create event group");
+        return false;
+    }
+    xEventGroupSetBits(showEvents, ADDRESSABLE_EVENT_IDLE);
 
     // Init the selected backend
     bool ok = (backend == TransportBackend::SPI) ? initSpi() : initRmt();
@@ -320,6 +475,15 @@ bool AddressableLED::initRmt()
     }
     ESP_LOGI(TAG, "Encoder created");
 
+    // Must be registered while the channel is still disabled
+    rmt_tx_event_callbacks_t callbacks = {};
+    callbacks.on_trans_done = rmtDoneCallback;
+    err = rmt_tx_register_event_callbacks(rmtChannel, &callbacks, this);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register RMT callback: %s", esp_err_to_name(err));
+        return false;
+    }
+
     err = rmt_enable(rmtChannel);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Failed to enable RMT: %s", esp_err_to_name(err));
@@ -342,15 +506,21 @@ bool AddressableLED::initRmt()
  * can read it directly without CPU involvement during transmission.
  *
  * BUFFER SIZING:
- *     Each LED color byte → 8 SPI bytes (one per bit)
- *     Total pixel data = bufferSize × 8
- *     Plus SPI_RESET_BYTES for the reset pulse
+ *     Each LED color byte → 8 SPI bytes (BITS_8) or 3 SPI bytes (BITS_3)
+ *     Total pixel data = (bufferSize + 1 LED of padding) × that
+ *     Plus the reset pulse
  *     Rounded up to 4-byte alignment for DMA
+ *
+ *     300 RGB LEDs:  BITS_8 = 7480 bytes,  BITS_3 = 2808 bytes
  */
 bool AddressableLED::initSpi()
 {
+    const bool threeBit = spiEncoding == SpiEncoding::BITS_3;
+    const uint32_t clockHz = threeBit ? SPI3_CLOCK_HZ : SPI_CLOCK_HZ;
+
     // Calculate SPI buffer size
-    spiBufferSize = ((bufferSize + bytesPerLed * 1) * 8) + SPI_RESET_BYTES;
+    spiBufferSize = (bufferSize + bytesPerLed * 1) * spiBytesPerByte() +
+                    (threeBit ? SPI3_RESET_BYTES : SPI_RESET_BYTES);
 
     // Round up to 4-byte alignment for DMA
     spiBufferSize = (spiBufferSize + 3) & ~3;
@@ -358,11 +528,11 @@ bool AddressableLED::initSpi()
     // Allocate DMA-capable memory for the SPI buffer
     spiBuffer = (uint8_t*)heap_caps_malloc(spiBufferSize, MALLOC_CAP_DMA);
     if (!spiBuffer) {
-        ESP_LOGE(TAG, "Failed to allocate SPI buffer (%d bytes)", spiBufferSize);
+        ESP_LOGE(TAG, "Failed to allocate SPI buffer (%u bytes)", (unsigned)spiBufferSize);
         return false;
     }
     memset(spiBuffer, 0, spiBufferSize);
-    ESP_LOGI(TAG, "Allocated SPI buffer: %d bytes (DMA-capable)", spiBufferSize);
+    ESP_LOGI(TAG, "Allocated SPI buffer: %u bytes (DMA-capable)", (unsigned)spiBufferSize);
 
     // Configure SPI bus — MOSI is our data line, no CLK/MISO needed externally
     spi_bus_config_t bus_cfg = {};
@@ -391,11 +561,12 @@ bool AddressableLED::initSpi()
 
     // Add SPI device
     spi_device_interface_config_t dev_cfg = {};
-    dev_cfg.clock_speed_hz = SPI_CLOCK_HZ;
+    dev_cfg.clock_speed_hz = clockHz;
     dev_cfg.mode = 1;               // CPOL=0, CPHA=0
     dev_cfg.spics_io_num = -1;      // No CS — always transmitting
     dev_cfg.queue_size = 1;
     dev_cfg.flags = SPI_DEVICE_HALFDUPLEX | SPI_DEVICE_NO_DUMMY;
+    dev_cfg.post_cb = spiDoneCallback;  // Frame done (ISR context)
 
     err = spi_bus_add_device(host, &dev_cfg, &spiDevice);
     if (err != ESP_OK) {
@@ -403,7 +574,8 @@ bool AddressableLED::initSpi()
         spi_bus_free(host);
         return false;
     }
-    ESP_LOGI(TAG, "SPI device added (clock=%d Hz)", SPI_CLOCK_HZ);
+    ESP_LOGI(TAG, "SPI device added (clock=%d Hz, %d SPI bits per LED bit)",
+             (int)clockHz, threeBit ? 3 : 8);
 
     return true;
 }
@@ -480,39 +652,151 @@ void AddressableLED::show()
         return;
     }
 
+    if (!waitShowDone(pdMS_TO_TICKS(ADDRESSABLE_SHOW_TIMEOUT_MS))) {
+        ESP_LOGE(TAG, "Previous frame still sending");
+        return;
+    }
+
+    if (showAsync() && !waitShowDone(pdMS_TO_TICKS(ADDRESSABLE_SHOW_TIMEOUT_MS))) {
+        ESP_LOGE(TAG, "Frame not sent within %d ms", ADDRESSABLE_SHOW_TIMEOUT_MS);
+    }
+}
+
+
+/*
+ * =============================================================================
+ * SHOW — ASYNC
+ * =============================================================================
+ *
+ *     setPixel() ──► back ──swap──► front ──► RMT encoder / SPI encoding ──► wire
+ *                     ▲                │
+ *                     └──── copy ──────┘
+ *
+ * The front buffer (and, for SPI, the encoded buffer) is read by the
+ * peripheral until the done interrupt, so the next swap has to wait for
+ * it. Copying the sent frame back keeps setPixel() incremental: pixels
+ * that are not set again keep their color.
+ */
+bool AddressableLED::showAsync()
+{
+    if (!initialized) {
+        ESP_LOGW(TAG, "showAsync() called before init()");
+        return false;
+    }
+    if (sending) {
+        stats.missedFrames++;
+        return false;
+    }
+    collectSpiResult();
+
+    if (preciseBuffer) ditherToBackBuffer();
+
     // Swap double buffers
     uint8_t* temp = frontBuffer;
     frontBuffer = backBuffer;
     backBuffer = temp;
+    memcpy(backBuffer, frontBuffer, bufferSize);
 
-    if (backend == TransportBackend::SPI) {
-        showSpi();
-    } else {
-        showRmt();
+    xEventGroupClearBits(showEvents, ADDRESSABLE_EVENT_IDLE);
+    sending = true;
+    showStartUs = esp_timer_get_time();
+
+    bool ok = (backend == TransportBackend::SPI) ? showSpi() : showRmt();
+    if (!ok) {
+        sending = false;
+        stats.failedFrames++;
+        xEventGroupSetBits(showEvents, ADDRESSABLE_EVENT_IDLE);
+        return false;
+    }
+
+    stats.frames++;
+    return true;
+}
+
+
+bool AddressableLED::waitShowDone(TickType_t timeout)
+{
+    if (!showEvents) return true;
+
+    if (sending) {
+        int64_t start = esp_timer_get_time();
+        xEventGroupWaitBits(showEvents, ADDRESSABLE_EVENT_IDLE, pdFALSE, pdTRUE, timeout);
+        stats.waitUs += esp_timer_get_time() - start;
+        if (sending) return false;
+    }
+
+    collectSpiResult();
+    return true;
+}
+
+
+void AddressableLED::setShowCallback(AddressableLEDShowCallback callback, void* arg)
+{
+    showCallbackArg = arg;
+    showCallback = callback;
+}
+
+
+void AddressableLED::collectSpiResult()
+{
+    // A queued SPI transaction must be taken back before the next one
+    if (!spiResultPending) return;
+
+    spi_transaction_t* done = nullptr;
+    if (spi_device_get_trans_result(spiDevice, &done, pdMS_TO_TICKS(ADDRESSABLE_SHOW_TIMEOUT_MS)) == ESP_OK) {
+        spiResultPending = false;
     }
 }
 
 
+void IRAM_ATTR AddressableLED::frameDone(BaseType_t* woken)
+{
+    uint32_t us = (uint32_t)(esp_timer_get_time() - showStartUs);
+    stats.lastFrameUs = us;
+    if (us > stats.maxFrameUs) stats.maxFrameUs = us;
+
+    sending = false;
+    xEventGroupSetBitsFromISR(showEvents, ADDRESSABLE_EVENT_IDLE, woken);
+
+    if (showCallback) showCallback(showCallbackArg);
+}
+
+
+bool IRAM_ATTR AddressableLED::rmtDoneCallback(rmt_channel_handle_t,
+                                               const rmt_tx_done_event_data_t*, void* arg)
+{
+    BaseType_t woken = pdFALSE;
+    static_cast<AddressableLED*>(arg)->frameDone(&woken);
+    return woken == pdTRUE;
+}
+
+
+void IRAM_ATTR AddressableLED::spiDoneCallback(spi_transaction_t* trans)
+{
+    BaseType_t woken = pdFALSE;
+    static_cast<AddressableLED*>(trans->user)->frameDone(&woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+
 /*
  * =============================================================================
  * SHOW — RMT
  * =============================================================================
  */
-void AddressableLED::showRmt()
+bool AddressableLED::showRmt()
 {
     rmt_transmit_config_t tx_config = {};
     tx_config.loop_count = 0;
 
+    // Returns once queued; rmtDoneCallback() fires when the frame is out
     esp_err_t err = rmt_transmit(rmtChannel, rmtEncoder, frontBuffer, bufferSize, &tx_config);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "RMT transmit failed: %s", esp_err_to_name(err));
-        return;
+        return false;
     }
 
-    err = rmt_tx_wait_all_done(rmtChannel, pdMS_TO_TICKS(1000));
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "RMT wait failed: %s", esp_err_to_name(err));
-    }
+    return true;
 }
 
 
@@ -522,25 +806,30 @@ void AddressableLED::showRmt()
  * =============================================================================
  *
  * 1. Encode the front buffer (pixel data) into the SPI buffer (bit-expanded)
- * 2. Transmit via SPI with DMA
- * 3. Block until done
+ * 2. Queue the DMA transaction
+ * 3. spiDoneCallback() fires when it is out; waitShowDone() collects it
  *
  * The reset pulse is just the trailing zeros in the SPI buffer.
  */
-void AddressableLED::showSpi()
+bool AddressableLED::showSpi()
 {
     // Encode pixel data → SPI bit patterns
     encodeSpiBuffer();
 
     // Set up SPI transaction
-    spi_transaction_t txn = {};
-    txn.length = spiBufferSize * 8;   // Length in bits
-    txn.tx_buffer = spiBuffer;
+    spiTxn = {};
+    spiTxn.length = spiBufferSize * 8;   // Length in bits
+    spiTxn.tx_buffer = spiBuffer;
+    spiTxn.user = this;
 
-    esp_err_t err = spi_device_transmit(spiDevice, &txn);
+    esp_err_t err = spi_device_queue_trans(spiDevice, &spiTxn, 0);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "SPI transmit failed: %s", esp_err_to_name(err));
+        return false;
     }
+
+    spiResultPending = true;
+    return true;
 }
 
 
@@ -549,25 +838,103 @@ void AddressableLED::showSpi()
  * SPI BUFFER ENCODING
  * =============================================================================
  *
- * Converts the front buffer (raw pixel bytes) into the SPI buffer where
- * each input bit becomes one SPI byte:
- *
- *     Input bit 1 → 0xF8 (11111000)
- *     Input bit 0 → 0xC0 (11000000)
+ * Converts the front buffer (raw pixel bytes) into the SPI buffer, one
+ * table lookup per nibble (BITS_8) or byte (BITS_3). See the tables at
+ * the top of this file.
  *
- * The trailing SPI_RESET_BYTES are left as 0x00 (written once at init).
+ * One LED of zero padding comes first (absorbs leading junk), and the
+ * trailing reset bytes are left as 0x00 (written once at init).
  */
 void AddressableLED::encodeSpiBuffer()
 {
-    // Skip 2 LEDs worth of SPI bytes (padding to absorb leading junk)
-    size_t padBytes = bytesPerLed * 1 * 8;  // 1 LED × 4 bytes × 8 SPI bytes per bit
-    size_t outIdx = padBytes;
+    size_t padBytes = bytesPerLed * 1 * spiBytesPerByte();
+    const uint8_t* in = frontBuffer;
+    const uint8_t* end = frontBuffer + bufferSize;
+
+    if (spiEncoding == SpiEncoding::BITS_3) {
+        uint8_t* out = spiBuffer + padBytes;
+        while (in < end) {
+            const uint8_t* bits = SPI3_BYTE_TABLE.bytes[*in++];
+            out[0] = bits[0];
+            out[1] = bits[1];
+            out[2] = bits[2];
+            out += 3;
+        }
+        return;
+    }
+
+    // padBytes is a multiple of 8 and spiBuffer is word-aligned
+    uint32_t* out = (uint32_t*)(spiBuffer + padBytes);
+    while (in < end) {
+        uint8_t byte = *in++;
+        out[0] = SPI_NIBBLE_TABLE.words[byte >> 4];
+        out[1] = SPI_NIBBLE_TABLE.words[byte & 0x0F];
+        out += 2;
+    }
+}
+
+
+uint8_t AddressableLED::spiBytesPerByte() const
+{
+    return spiEncoding == SpiEncoding::BITS_3 ? 3 : 8;
+}
+
+
+void AddressableLED::setSpiEncoding(SpiEncoding encoding)
+{
+    if (initialized) {
+        ESP_LOGW(TAG, "setSpiEncoding() must be called before init()");
+        return;
+    }
+    spiEncoding = encoding;
+}
+
+
+SpiEncoding AddressableLED::getSpiEncoding() const { return spiEncoding; }
+
+
+/*
+ * =============================================================================
+ * DITHERING
+ * =============================================================================
+ *
+ * One add per channel: the 8.8 value plus last frame's carry. The high
+ * byte is sent, the low byte is carried:
+ *
+ *     value 0x0140 (1.25), carry 0xC0:   0x0140 + 0xC0 = 0x0200  → send 2, carry 0x00
+ *
+ * Values stop at 255 × 256, so value + carry fits in 16 bits. Black
+ * (0) and full (255 × 256) never flicker.
+ */
+void AddressableLED::setDithering(bool enable)
+{
+    if (initialized && !preciseBuffer) {
+        if (enable) ESP_LOGW(TAG, "setDithering() must be called before init()");
+        return;
+    }
+    ditherEnabled = enable;
+}
+
+
+bool AddressableLED::getDithering() const { return ditherEnabled; }
+
+
+void AddressableLED::ditherToBackBuffer()
+{
+    const uint16_t* src = preciseBuffer;
+    uint8_t* carry = ditherError;
+    uint8_t* dst = backBuffer;
+
+    if (!ditherEnabled) {
+        // Paused: nearest level, the same bytes every frame
+        for (size_t i = 0; i < bufferSize; i++) dst[i] = (src[i] + 0x80) >> 8;
+        return;
+    }
 
     for (size_t i = 0; i < bufferSize; i++) {
-        uint8_t byte = frontBuffer[i];
-        for (int bit = 7; bit >= 0; bit--) {
-            spiBuffer[outIdx++] = (byte & (1 << bit)) ? SPI_BIT_1 : SPI_BIT_0;
-        }
+        uint16_t sum = src[i] + carry[i];
+        dst[i] = sum >> 8;
+        carry[i] = (uint8_t)sum;
     }
 }
 
@@ -599,113 +966,157 @@ ColorOrder AddressableLED::getDefaultOrder(LedType type)
 }
 
 
-uint8_t AddressableLED::applyCorrections(uint8_t value) const
+/*
+ * =============================================================================
+ * CORRECTION TABLE
+ * =============================================================================
+ *
+ * Gamma and brightness fused into one lookup per channel byte:
+ *
+ *     correctionLut[v] = gamma(v) × brightness / 255
+ *
+ * Rebuilt only when setBrightness() / setGammaCorrection() change it.
+ * Like before, pixels already in the buffer keep their old values.
+ * correctionLut16 is the 8.8 fixed-point twin used with dithering.
+ */
+void AddressableLED::rebuildCorrectionLut()
 {
-    uint8_t corrected = gammaEnabled ? GAMMA_TABLE[value] : value;
-    return (uint8_t)(((uint16_t)corrected * brightness) / 255);
+    for (int v = 0; v < 256; v++) {
+        uint8_t corrected = gammaEnabled ? GAMMA_TABLE[v] : v;
+        correctionLut[v] = (uint8_t)(((uint16_t)corrected * brightness) / 255);
+
+        // Max 255 × 256 = 65280, so the dither carry (< 256) never overflows
+        uint32_t corrected16 = gammaEnabled ? GAMMA16_TABLE[v] : (uint32_t)v << 8;
+        correctionLut16[v] = (uint16_t)((corrected16 * brightness + 127) / 255);
+    }
 }
 
 
 /*
  * =============================================================================
- * WRITE TO BUFFER
+ * COLOR ORDER SWIZZLE
  * =============================================================================
+ *
+ * Byte position of each channel inside one LED, per ColorOrder
+ * (NO = channel not sent):
+ *
+ *     GRBW:   r → 1, g → 0, b → 2, w → 3        buffer: [G][R][B][W]
+ *
+ * swizzleRun() is instantiated once per order, so the positions are
+ * constants in the inner loop. The order is dispatched once per run of
+ * pixels, not once per pixel.
  */
-void AddressableLED::writeToBuffer(uint16_t index, uint8_t r, uint8_t g, uint8_t b,
-                                    uint8_t w, uint8_t ww, uint8_t cw)
+namespace {
+
+constexpr uint8_t NO = 0xFF;
+
+struct Swizzle {
+    uint8_t r, g, b, w, ww, cw;
+};
+
+constexpr Swizzle swizzleFor(ColorOrder order)
 {
-    if (index >= numLeds) return;
+    switch (order) {
+        case ColorOrder::RGB:   return {0, 1, 2, NO, NO, NO};
+        case ColorOrder::BGR:   return {2, 1, 0, NO, NO, NO};
+        case ColorOrder::BRG:   return {1, 2, 0, NO, NO, NO};
+        case ColorOrder::RBG:   return {0, 2, 1, NO, NO, NO};
+        case ColorOrder::GBR:   return {2, 0, 1, NO, NO, NO};
+        case ColorOrder::GRBW:  return {1, 0, 2, 3, NO, NO};
+        case ColorOrder::RGBW:  return {0, 1, 2, 3, NO, NO};
+        case ColorOrder::BGRW:  return {2, 1, 0, 3, NO, NO};
+        case ColorOrder::WGRB:  return {2, 1, 3, 0, NO, NO};
+        case ColorOrder::GRBWW: return {1, 0, 2, NO, 3, 4};
+        case ColorOrder::RGBWW: return {0, 1, 2, NO, 3, 4};
+        case ColorOrder::GRB:
+        default:                return {1, 0, 2, NO, NO, NO};
+    }
+}
 
-    size_t offset = index * bytesPerLed;
+// All six channels (setPixel() / fill())
+struct LedChannels {
+    uint8_t r, g, b, w, ww, cw;
+};
 
-    uint8_t cr  = applyCorrections(r);
-    uint8_t cg  = applyCorrections(g);
-    uint8_t cb  = applyCorrections(b);
-    uint8_t cw1 = applyCorrections(w);
-    uint8_t cww = applyCorrections(ww);
-    uint8_t ccw = applyCorrections(cw);
+// Channels a pixel type does not have are 0
+inline uint8_t channelW(const RGB&) { return 0; }
+inline uint8_t channelW(const RGBW& p) { return p.w; }
+inline uint8_t channelW(const LedChannels& p) { return p.w; }
+inline uint8_t channelWW(const RGB&) { return 0; }
+inline uint8_t channelWW(const RGBW&) { return 0; }
+inline uint8_t channelWW(const LedChannels& p) { return p.ww; }
+inline uint8_t channelCW(const RGB&) { return 0; }
+inline uint8_t channelCW(const RGBW&) { return 0; }
+inline uint8_t channelCW(const LedChannels& p) { return p.cw; }
+
+template<ColorOrder ORDER, typename Pixel, typename Out>
+void swizzleRun(Out* dst, uint8_t stride, const Pixel* src, uint16_t count, const Out* lut)
+{
+    constexpr Swizzle s = swizzleFor(ORDER);
+
+    for (uint16_t i = 0; i < count; i++, src++, dst += stride) {
+        dst[s.r] = lut[src->r];
+        dst[s.g] = lut[src->g];
+        dst[s.b] = lut[src->b];
+        if constexpr (s.w != NO)  dst[s.w]  = lut[channelW(*src)];
+        if constexpr (s.ww != NO) dst[s.ww] = lut[channelWW(*src)];
+        if constexpr (s.cw != NO) dst[s.cw] = lut[channelCW(*src)];
+    }
+}
 
-    switch (colorOrder) {
+// Out is uint8_t (back buffer) or uint16_t (dithering buffer)
+template<typename Pixel, typename Out>
+void swizzleRunFor(ColorOrder order, Out* dst, uint8_t stride, const Pixel* src, uint16_t count,
+                   const Out* lut)
+{
+    switch (order) {
+        case ColorOrder::RGB:   swizzleRun<ColorOrder::RGB>(dst, stride, src, count, lut);   break;
+        case ColorOrder::BGR:   swizzleRun<ColorOrder::BGR>(dst, stride, src, count, lut);   break;
+        case ColorOrder::BRG:   swizzleRun<ColorOrder::BRG>(dst, stride, src, count, lut);   break;
+        case ColorOrder::RBG:   swizzleRun<ColorOrder::RBG>(dst, stride, src, count, lut);   break;
+        case ColorOrder::GBR:   swizzleRun<ColorOrder::GBR>(dst, stride, src, count, lut);   break;
+        case ColorOrder::GRBW:  swizzleRun<ColorOrder::GRBW>(dst, stride, src, count, lut);  break;
+        case ColorOrder::RGBW:  swizzleRun<ColorOrder::RGBW>(dst, stride, src, count, lut);  break;
+        case ColorOrder::BGRW:  swizzleRun<ColorOrder::BGRW>(dst, stride, src, count, lut);  break;
+        case ColorOrder::WGRB:  swizzleRun<ColorOrder::WGRB>(dst, stride, src, count, lut);  break;
+        case ColorOrder::GRBWW: swizzleRun<ColorOrder::GRBWW>(dst, stride, src, count, lut); break;
+        case ColorOrder::RGBWW: swizzleRun<ColorOrder::RGBWW>(dst, stride, src, count, lut); break;
         case ColorOrder::GRB:
-            backBuffer[offset + 0] = cg;
-            backBuffer[offset + 1] = cr;
-            backBuffer[offset + 2] = cb;
-            break;
-        case ColorOrder::RGB:
-            backBuffer[offset + 0] = cr;
-            backBuffer[offset + 1] = cg;
-            backBuffer[offset + 2] = cb;
-            break;
-        case ColorOrder::BGR:
-            backBuffer[offset + 0] = cb;
-            backBuffer[offset + 1] = cg;
-            backBuffer[offset + 2] = cr;
-            break;
-        case ColorOrder::BRG:
-            backBuffer[offset + 0] = cb;
-            backBuffer[offset + 1] = cr;
-            backBuffer[offset + 2] = cg;
-            break;
-        case ColorOrder::RBG:
-            backBuffer[offset + 0] = cr;
-            backBuffer[offset + 1] = cb;
-            backBuffer[offset + 2] = cg;
-            break;
-        case ColorOrder::GBR:
-            backBuffer[offset + 0] = cg;
-            backBuffer[offset + 1] = cb;
-            backBuffer[offset + 2] = cr;
-            break;
+        default:                swizzleRun<ColorOrder::GRB>(dst, stride, src, count, lut);   break;
+    }
+}
 
-        case ColorOrder::GRBW:
-            backBuffer[offset + 0] = cg;
-            backBuffer[offset + 1] = cr;
-            backBuffer[offset + 2] = cb;
-            backBuffer[offset + 3] = cw1;
-            break;
-        case ColorOrder::RGBW:
-            backBuffer[offset + 0] = cr;
-            backBuffer[offset + 1] = cg;
-            backBuffer[offset + 2] = cb;
-            backBuffer[offset + 3] = cw1;
-            break;
-        case ColorOrder::BGRW:
-            backBuffer[offset + 0] = cb;
-            backBuffer[offset + 1] = cg;
-            backBuffer[offset + 2] = cr;
-            backBuffer[offset + 3] = cw1;
-            break;
-        case ColorOrder::WGRB:
-            backBuffer[offset + 0] = cw1;
-            backBuffer[offset + 1] = cg;
-            backBuffer[offset + 2] = cr;
-            backBuffer[offset + 3] = cb;
-            break;
+}  // namespace
 
-        case ColorOrder::GRBWW:
-            backBuffer[offset + 0] = cg;
-            backBuffer[offset + 1] = cr;
-            backBuffer[offset + 2] = cb;
-            backBuffer[offset + 3] = cww;
-            backBuffer[offset + 4] = ccw;
-            break;
-        case ColorOrder::RGBWW:
-            backBuffer[offset + 0] = cr;
-            backBuffer[offset + 1] = cg;
-            backBuffer[offset + 2] = cb;
-            backBuffer[offset + 3] = cww;
-            backBuffer[offset + 4] = ccw;
-            break;
 
-        default:
-            backBuffer[offset + 0] = cg;
-            backBuffer[offset + 1] = cr;
-            backBuffer[offset + 2] = cb;
-            break;
+template<typename Pixel>
+void AddressableLED::writePixels(uint16_t offset, const Pixel* pixels, uint16_t count)
+{
+    if (offset >= numLeds) return;
+    if (count > numLeds - offset) count = numLeds - offset;
+
+    size_t start = (size_t)offset * bytesPerLed;
+    if (preciseBuffer) {
+        swizzleRunFor(colorOrder, preciseBuffer + start, bytesPerLed, pixels, count, correctionLut16);
+    } else {
+        swizzleRunFor(colorOrder, backBuffer + start, bytesPerLed, pixels, count, correctionLut);
     }
 }
 
 
+/*
+ * =============================================================================
+ * WRITE TO BUFFER
+ * =============================================================================
+ */
+void AddressableLED::writeToBuffer(uint16_t index, uint8_t r, uint8_t g, uint8_t b,
+                                    uint8_t w, uint8_t ww, uint8_t cw)
+{
+    LedChannels pixel = {r, g, b, w, ww, cw};
+    writePixels(index, &pixel, 1);
+}
+
+
 /*
  * =============================================================================
  * SET PIXEL — ALL OVERLOADS
@@ -753,23 +1164,163 @@ void AddressableLED::setPixel(uint16_t index, uint8_t r, uint8_t g, uint8_t b,
  */
 void AddressableLED::fill(uint8_t r, uint8_t g, uint8_t b)
 {
-    for (uint16_t i = 0; i < numLeds; i++) setPixel(i, r, g, b);
+    fillRange(0, numLeds, r, g, b);
 }
 
 void AddressableLED::fill(uint8_t r, uint8_t g, uint8_t b, uint8_t w)
 {
-    for (uint16_t i = 0; i < numLeds; i++) setPixel(i, r, g, b, w);
+    fillRange(0, numLeds, r, g, b, w);
 }
 
 void AddressableLED::fill(uint8_t r, uint8_t g, uint8_t b, uint8_t ww, uint8_t cw)
 {
-    for (uint16_t i = 0; i < numLeds; i++) setPixel(i, r, g, b, ww, cw);
+    fillRange(0, numLeds, r, g, b, ww, cw);
 }
 
 void AddressableLED::clear()
 {
     if (!initialized) return;
     memset(backBuffer, 0, bufferSize);
+    if (preciseBuffer) memset(preciseBuffer, 0, bufferSize * sizeof(uint16_t));
+}
+
+
+/*
+ * =============================================================================
+ * BULK WRITES
+ * =============================================================================
+ */
+void AddressableLED::fillRange(uint16_t start, uint16_t count, uint8_t r, uint8_t g, uint8_t b)
+{
+    if (!initialized) { ESP_LOGW(TAG, "fillRange called before init()"); return; }
+    fillChannels(start, count, r, g, b, 0, 0, 0);
+}
+
+void AddressableLED::fillRange(uint16_t start, uint16_t count, uint8_t r, uint8_t g, uint8_t b,
+                               uint8_t w)
+{
+    if (!initialized) { ESP_LOGW(TAG, "fillRange called before init()"); return; }
+    if (ledType == LedType::WS2812B) {
+        ESP_LOGW(TAG, "fillRange(RGBW) called on WS2812B strip - W ignored");
+        w = 0;
+    }
+    fillChannels(start, count, r, g, b, w, 0, 0);
+}
+
+void AddressableLED::fillRange(uint16_t start, uint16_t count, uint8_t r, uint8_t g, uint8_t b,
+                               uint8_t ww, uint8_t cw)
+{
+    if (!initialized) { ESP_LOGW(TAG, "fillRange called before init()"); return; }
+    if (ledType == LedType::WS2812B) {
+        ESP_LOGW(TAG, "fillRange(RGBWW) called on WS2812B - WW/CW ignored");
+        fillChannels(start, count, r, g, b, 0, 0, 0);
+        return;
+    }
+    if (ledType == LedType::SK6812_RGBW) {
+        ESP_LOGW(TAG, "fillRange(RGBWW) called on RGBW strip - CW ignored, WW used as W");
+        fillChannels(start, count, r, g, b, ww, 0, 0);
+        return;
+    }
+    fillChannels(start, count, r, g, b, 0, ww, cw);
+}
+
+
+void AddressableLED::fillChannels(uint16_t start, uint16_t count, uint8_t r, uint8_t g, uint8_t b,
+                                  uint8_t w, uint8_t ww, uint8_t cw)
+{
+    if (start >= numLeds || count == 0) return;
+    if (count > numLeds - start) count = numLeds - start;
+
+    // Correct and order the color once, then double the copied run
+    writeToBuffer(start, r, g, b, w, ww, cw);
+
+    size_t elem = preciseBuffer ? sizeof(uint16_t) : 1;
+    uint8_t* run = preciseBuffer ? (uint8_t*)(preciseBuffer + (size_t)start * bytesPerLed)
+                                 : backBuffer + (size_t)start * bytesPerLed;
+    size_t total = (size_t)count * bytesPerLed * elem;
+    size_t done = bytesPerLed * elem;
+    while (done < total) {
+        size_t n = (done < total - done) ? done : total - done;
+        memcpy(run + done, run, n);
+        done += n;
+    }
+}
+
+
+/*
+ * 8.8 input: between two table entries the corrected value is
+ * interpolated, so a scaled-down color keeps its fraction through gamma:
+ *
+ *     input 0x1780 (23.5):   lut16[23] + (lut16[24] - lut16[23]) × 0x80 / 256
+ */
+uint16_t AddressableLED::correct16(uint16_t value) const
+{
+    if (value >= 0xFF00) return correctionLut16[255];
+
+    uint8_t index = value >> 8;
+    int32_t low = correctionLut16[index];
+    int32_t high = correctionLut16[index + 1];
+    return (uint16_t)(low + (((high - low) * (value & 0xFF)) >> 8));
+}
+
+
+void AddressableLED::fill16(uint16_t r, uint16_t g, uint16_t b, uint16_t w)
+{
+    if (!initialized) { ESP_LOGW(TAG, "fill16 called before init()"); return; }
+    if (ledType == LedType::WS2812B && w) {
+        ESP_LOGW(TAG, "fill16(RGBW) called on WS2812B strip - W ignored");
+        w = 0;
+    }
+
+    if (!preciseBuffer) {
+        auto round8 = [](uint16_t v) { return (uint8_t)(v >= 0xFF00 ? 255 : (v + 0x80) >> 8); };
+        fillChannels(0, numLeds, round8(r), round8(g), round8(b), round8(w), 0, 0);
+        return;
+    }
+
+    // Same channel rules as fill(r, g, b, w): W is not sent on RGBWW strips
+    Swizzle s = swizzleFor(colorOrder);
+    uint16_t* led = preciseBuffer;
+    led[s.r] = correct16(r);
+    led[s.g] = correct16(g);
+    led[s.b] = correct16(b);
+    if (s.w != NO)  led[s.w] = correct16(w);
+    if (s.ww != NO) led[s.ww] = 0;
+    if (s.cw != NO) led[s.cw] = 0;
+
+    for (uint16_t i = 1; i < numLeds; i++) {
+        memcpy(led + (size_t)i * bytesPerLed, led, bytesPerLed * sizeof(uint16_t));
+    }
+}
+
+
+void AddressableLED::setPixels(const RGB* pixels, uint16_t count, uint16_t offset)
+{
+    if (!initialized) { ESP_LOGW(TAG, "setPixels called before init()"); return; }
+    writePixels(offset, pixels, count);
+}
+
+void AddressableLED::setPixels(const RGBW* pixels, uint16_t count, uint16_t offset)
+{
+    if (!initialized) { ESP_LOGW(TAG, "setPixels called before init()"); return; }
+    writePixels(offset, pixels, count);
+}
+
+
+void AddressableLED::writeNative(const uint8_t* data, size_t length, uint16_t offset)
+{
+    if (!initialized) { ESP_LOGW(TAG, "writeNative called before init()"); return; }
+    if (offset >= numLeds) return;
+
+    size_t room = (size_t)(numLeds - offset) * bytesPerLed;
+    if (length > room) length = room;
+
+    if (preciseBuffer) {
+        uint16_t* dst = preciseBuffer + (size_t)offset * bytesPerLed;
+        for (size_t i = 0; i < length; i++) dst[i] = (uint16_t)data[i] << 8;
+        return;
+    }
+    memcpy(backBuffer + (size_t)offset * bytesPerLed, data, length);
 }
 
 
@@ -778,9 +1329,22 @@ void AddressableLED::clear()
  * BRIGHTNESS / GAMMA
  * =============================================================================
  */
-void AddressableLED::setBrightness(uint8_t newBrightness) { brightness = newBrightness; }
+void AddressableLED::setBrightness(uint8_t newBrightness)
+{
+    if (newBrightness == brightness) return;
+    brightness = newBrightness;
+    rebuildCorrectionLut();
+}
+
 uint8_t AddressableLED::getBrightness() const { return brightness; }
-void AddressableLED::setGammaCorrection(bool enable) { gammaEnabled = enable; }
+
+void AddressableLED::setGammaCorrection(bool enable)
+{
+    if (enable == gammaEnabled) return;
+    gammaEnabled = enable;
+    rebuildCorrectionLut();
+}
+
 bool AddressableLED::isGammaCorrectionEnabled() const { return gammaEnabled; }
 
 
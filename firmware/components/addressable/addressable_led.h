@@ -113,25 +113,39 @@
  * SPI BACKEND:
  *     - Uses SPI peripheral's MOSI line
  *     - Encodes each LED data bit as multiple SPI bits
- *     - "Bit 1" → 0b11111000 (high for 5 SPI clocks, low for 3)
- *     - "Bit 0" → 0b11000000 (high for 2 SPI clocks, low for 6)
- *     - At ~6.4 MHz SPI clock, each SPI bit is ~156ns → correct LED timing
+ *     - "Bit 1" → 0b11111100 (high for 6 SPI clocks, low for 2)
+ *     - "Bit 0" → 0b11100000 (high for 3 SPI clocks, low for 5)
+ *     - At 8 MHz SPI clock, each SPI bit is 125ns → correct LED timing
  *     - Uses DMA for zero-CPU transmission
  *     - Needs SPI-capable GPIO for MOSI
  * 
  *     SPI BIT ENCODING (visual):
  * 
- *         LED bit "1" → SPI byte 0xF8:
- *         ┌─────────────┐
- *         │ 1 1 1 1 1 │ 0 0 0
- *         └─────────────┘
- *          ~780ns HIGH    ~470ns LOW   ← matches T1H/T1L spec
+ *         LED bit "1" → SPI byte 0xFC:
+ *         ┌───────────────┐
+ *         │ 1 1 1 1 1 1 │ 0 0
+ *         └───────────────┘
+ *          ~750ns HIGH    ~250ns LOW   ← matches T1H/T1L spec
  * 
- *         LED bit "0" → SPI byte 0xC0:
- *         ┌───┐
- *         │1 1│ 0 0 0 0 0 0
- *         └───┘
- *          ~312ns HIGH    ~937ns LOW   ← matches T0H/T0L spec
+ *         LED bit "0" → SPI byte 0xE0:
+ *         ┌───────┐
+ *         │1 1 1│ 0 0 0 0 0
+ *         └───────┘
+ *          ~375ns HIGH    ~625ns LOW   ← matches T0H/T0L spec
+ * 
+ *     3-BIT MODE (setSpiEncoding(SpiEncoding::BITS_3)):
+ * 
+ *         LED bit "1" → 110, LED bit "0" → 100 at 2.4 MHz (~417ns per bit)
+ * 
+ *     The DMA buffer holds 3 SPI bytes per LED byte instead of 8:
+ * 
+ *         300 RGB LEDs:   8-bit mode  7.3 KB      3-bit mode  2.7 KB
+ * 
+ *     so much longer strips fit in internal DMA RAM. The pulses are
+ *     coarser (417ns steps): still inside WS2812B timing, but the 833ns
+ *     T1H is past the SK6812 maximum (~750ns). WS2812B only: init()
+ *     fails for SK6812 types. Use the default if a strip shows random
+ *     colors.
  * 
  * WHEN TO USE WHICH:
  *     - RMT: Default choice, works everywhere, proven reliable
@@ -139,6 +153,53 @@
  *            where DMA helps, or when RMT channels are all in use
  * 
  * =============================================================================
+ * BLOCKING vs ASYNC SHOW
+ * =============================================================================
+ * 
+ * Every LED bit takes 1.25µs on the wire, so a frame takes:
+ * 
+ *     300 LEDs × 24 bits × 1.25µs ≈ 9 ms  (+ 0.3 ms reset)
+ * 
+ * show() waits for all of it. showAsync() starts the transfer and
+ * returns at once; the RMT "transmit done" or SPI post-transaction
+ * interrupt marks the end. The next frame can be computed meanwhile:
+ * 
+ *     task:   compute N ─ showAsync ─ compute N+1 ─ waitShowDone ─ showAsync
+ *                              │                        ▲
+ *     wire:                    └──── frame N (9 ms) ────┘ callback
+ * 
+ * The frame on the wire is read straight from the front buffer, so
+ * showAsync() refuses to swap buffers while it is still being sent
+ * (counted as a missed frame). setPixel() only ever writes the back
+ * buffer and is always safe.
+ * 
+ * =============================================================================
+ * TEMPORAL DITHERING
+ * =============================================================================
+ * 
+ * After gamma, the darkest 8-bit levels are far apart: a fade from 5%
+ * to 0% has only a handful of steps, and each one is a visible jump.
+ * 
+ *     input:    0 ... 23   24 ... 35   36 ...
+ *     8-bit:    0          1           2          ← 0 → 1 is a big jump
+ * 
+ * setDithering(true) keeps every channel at 16 bits (8.8 fixed point)
+ * and rounds to 8 bits in showAsync(). The part that was rounded away
+ * is carried to the next frame, so over a few frames the LED averages
+ * the exact 16-bit level:
+ * 
+ *     level 1.25:   frame  1  2  3  4  1  2  3  4
+ *                   sent   1  1  1  2  1  1  1  2   → average 1.25
+ * 
+ * Each channel starts at a different carry, so LEDs with the same
+ * color do not flicker in step and even a single frame is spatially
+ * dithered. It only looks smooth when frames keep coming (an effect
+ * task, or show() at 100+ fps); a static picture shows one dither
+ * pattern, and a new one on every show(). Pause it with
+ * setDithering(false) while nothing animates: frames are then rounded
+ * to the nearest level. Costs 3 bytes of RAM per channel.
+ * 
+ * =============================================================================
  * USAGE EXAMPLES
  * =============================================================================
  * 
@@ -170,8 +231,38 @@
 #include <driver/rmt_encoder.h>
 #include <driver/gpio.h>
 #include <driver/spi_master.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include "led_pixel.h"
+
+
+// Async show
+#define ADDRESSABLE_EVENT_IDLE          BIT0    // Event group bit: no frame being sent
+#define ADDRESSABLE_SHOW_TIMEOUT_MS     1000    // Longest frame show() waits for
+
+
+/**
+ * @brief Called when a frame has been sent.
+ *
+ * @warning Runs in ISR context: keep it short, IRAM-safe, no logging.
+ *          Typical use: xTaskNotifyFromISR() or xSemaphoreGiveFromISR().
+ */
+typedef void (*AddressableLEDShowCallback)(void* arg);
+
+
+/**
+ * @brief Frame counters.
+ */
+struct AddressableLEDStats {
+    uint32_t frames;            ///< Frames sent
+    uint32_t missedFrames;      ///< showAsync() calls refused (previous frame still sending)
+    uint32_t failedFrames;      ///< Transfers that could not be started
+    uint32_t lastFrameUs;       ///< Wire time of the last frame (start → done interrupt)
+    uint32_t maxFrameUs;
+    uint64_t waitUs;            ///< Total time spent blocked in show() / waitShowDone()
+};
 
 
 /*
@@ -244,6 +335,16 @@ enum class TransportBackend {
 };
 
 
+/**
+ * @enum SpiEncoding
+ * @brief SPI bits per LED data bit (SPI backend only).
+ */
+enum class SpiEncoding {
+    BITS_8,     ///< 8 SPI bits at 8 MHz (default). Most timing margin.
+    BITS_3      ///< 3 SPI bits at 2.4 MHz. 62% smaller DMA buffer. WS2812B only.
+};
+
+
 /*
  * =============================================================================
  * ADDRESSABLE LED CLASS
@@ -360,6 +461,65 @@ public:
     void fill(uint8_t r, uint8_t g, uint8_t b, uint8_t ww, uint8_t cw);
     void clear();
 
+    /**
+     * @brief Set count LEDs starting at start to one color.
+     *
+     * @details The color is corrected and ordered once, then copied.
+     *          Same channel rules as setPixel(). Clipped to the strip.
+     */
+    void fillRange(uint16_t start, uint16_t count, uint8_t r, uint8_t g, uint8_t b);
+    void fillRange(uint16_t start, uint16_t count, uint8_t r, uint8_t g, uint8_t b, uint8_t w);
+    void fillRange(uint16_t start, uint16_t count, uint8_t r, uint8_t g, uint8_t b,
+                   uint8_t ww, uint8_t cw);
+
+    /**
+     * @brief fill() with channels in 8.8 fixed point (0 to 255 × 256).
+     *
+     * @details With dithering the fraction goes through gamma and
+     *          brightness too, so a color scaled down in software (a
+     *          dimmer percentage) keeps more than 8 bits. Without
+     *          dithering the channels are rounded to 8 bits first.
+     *
+     * @code
+     *     // 3% of full red, not rounded to 7/255 before gamma
+     *     strip.fill16(255 * 256 * 3 / 100, 0, 0);
+     * @endcode
+     */
+    void fill16(uint16_t r, uint16_t g, uint16_t b, uint16_t w = 0);
+
+    /**
+     * @brief Set count LEDs from an array (gamma, brightness and color
+     *        order applied).
+     *
+     * @param pixels Colors for LEDs offset to offset + count - 1.
+     * @param count  Number of pixels (clipped to the strip).
+     * @param offset First LED.
+     *
+     * @details
+     * Same result as count setPixel() calls, with one bounds check and
+     * one color-order dispatch for the whole run. W is ignored on
+     * WS2812B and RGBWW strips (as with setPixel()).
+     *
+     * @code
+     *     RGB frame[300];
+     *     renderEffect(frame);
+     *     strip.setPixels(frame, 300);
+     *     strip.show();
+     * @endcode
+     */
+    void setPixels(const RGB* pixels, uint16_t count, uint16_t offset = 0);
+    void setPixels(const RGBW* pixels, uint16_t count, uint16_t offset = 0);
+
+    /**
+     * @brief Copy bytes that are already in strip format into the buffer.
+     *
+     * @param data   getBytesPerLed() bytes per LED, in the strip's color
+     *               order. No gamma or brightness is applied.
+     * @param length Number of bytes (clipped to the strip).
+     * @param offset First LED.
+     */
+    void writeNative(const uint8_t* data, size_t length, uint16_t offset = 0);
+
 
     /* ═══════════════════════════════════════════════════════════════════
      * BRIGHTNESS CONTROL
@@ -384,21 +544,97 @@ public:
     /**
      * @brief Send buffer data to the LED strip.
      *
-     * Swaps double buffers and transmits via the configured backend.
-     * Blocks until transmission completes.
+     * Waits for a running async frame, swaps double buffers and transmits
+     * via the configured backend. Blocks until transmission completes.
      */
     void show();
 
+    /**
+     * @brief Start sending the buffer in the background.
+     *
+     * @details
+     * Swaps the buffers and returns right after starting the transfer.
+     * The back buffer keeps the frame just sent, so setPixel() calls for
+     * the next frame can start immediately.
+     *
+     * @return false if the previous frame is still being sent (counted in
+     *         missedFrames) or the transfer could not be started.
+     *
+     * @par Example:
+     * @code
+     *     while (true) {
+     *         computeFrame(strip);         // Previous frame still on the wire
+     *         strip.waitShowDone();
+     *         strip.showAsync();
+     *     }
+     * @endcode
+     */
+    bool showAsync();
+
+    /**
+     * @brief Check if a frame is still being sent.
+     */
+    bool isBusy() const { return sending; }
+
+    /**
+     * @brief Block until the running frame (if any) is sent.
+     * @return true if no frame is being sent anymore.
+     */
+    bool waitShowDone(TickType_t timeout = portMAX_DELAY);
+
+    /**
+     * @brief Set a function called after each frame (nullptr = none).
+     */
+    void setShowCallback(AddressableLEDShowCallback callback, void* arg = nullptr);
+
+    /**
+     * @brief Event group with ADDRESSABLE_EVENT_IDLE (set while idle).
+     */
+    EventGroupHandle_t getEventGroup() const { return showEvents; }
+
+    /**
+     * @brief Get frame counters.
+     */
+    const AddressableLEDStats& getStats() const { return stats; }
+
+    /**
+     * @brief Reset frame counters.
+     */
+    void resetStats() { stats = {}; }
+
 
     /* ═══════════════════════════════════════════════════════════════════
      * UTILITY METHODS
      * ═══════════════════════════════════════════════════════════════════ */
 
+    bool isInitialized() const { return initialized; }
     uint16_t getNumLeds() const;
     LedType getLedType() const;
     uint8_t getBytesPerLed() const;
     TransportBackend getBackend() const;
 
+    /**
+     * @brief Select the SPI bit encoding (SPI backend only).
+     *
+     * @note Call before init(): the DMA buffer and clock depend on it.
+     *       init() rejects BITS_3 for SK6812 types (T1H out of spec).
+     */
+    void setSpiEncoding(SpiEncoding encoding);
+    SpiEncoding getSpiEncoding() const;
+
+    /**
+     * @brief Keep pixels at 16 bits per channel and dither to 8 bits in show().
+     *
+     * @details Smooth fades at low brightness. See TEMPORAL DITHERING.
+     *          After init() (if it was enabled before), false pauses the
+     *          dithering: frames are rounded to the nearest level, so a
+     *          picture that is shown once stays stable. true resumes it.
+     *
+     * @note Call with true before init(): the 16-bit buffer is allocated there.
+     */
+    void setDithering(bool enable);
+    bool getDithering() const;
+
 
 private:
 
@@ -426,27 +662,66 @@ private:
 
     /* ── SPI backend resources ──────────────────────────────────────── */
     spi_device_handle_t spiDevice;
-    uint8_t* spiBuffer;         ///< Expanded buffer: 8 SPI bytes per LED data byte
+    uint8_t* spiBuffer;         ///< Expanded buffer: 8 (or 3) SPI bytes per LED data byte
     size_t spiBufferSize;
+    SpiEncoding spiEncoding;
+    spi_transaction_t spiTxn;   ///< In flight until its result is collected
+    bool spiResultPending;
+
+    /* ── Async show ─────────────────────────────────────────────────── */
+    volatile bool sending;              ///< Frame on the wire (cleared by the done ISR)
+    EventGroupHandle_t showEvents;      ///< ADDRESSABLE_EVENT_IDLE
+    AddressableLEDShowCallback showCallback;
+    void* showCallbackArg;
+    int64_t showStartUs;
+    AddressableLEDStats stats;
 
     /* ── Gamma ──────────────────────────────────────────────────────── */
     static constexpr float GAMMA_VALUE = 2.2f;
     static const uint8_t GAMMA_TABLE[256];
+    static const uint16_t GAMMA16_TABLE[256];
+    uint8_t correctionLut[256];     ///< Gamma × brightness, rebuilt by the setters
+    uint16_t correctionLut16[256];  ///< Same in 8.8 fixed point (dithering)
+
+    /* ── Dithering ──────────────────────────────────────────────────── */
+    bool ditherEnabled;             ///< Before init(): allocate; after: carry (else round)
+    uint16_t* preciseBuffer;        ///< 16-bit back buffer, strip byte order
+    uint8_t* ditherError;           ///< Fraction carried to the next frame, per channel
 
     /* ── Helpers ────────────────────────────────────────────────────── */
-    uint8_t applyCorrections(uint8_t value) const;
+    void rebuildCorrectionLut();
     void writeToBuffer(uint16_t index, uint8_t r, uint8_t g, uint8_t b,
                        uint8_t w = 0, uint8_t ww = 0, uint8_t cw = 0);
+    uint16_t correct16(uint16_t value) const;
+    void fillChannels(uint16_t start, uint16_t count, uint8_t r, uint8_t g, uint8_t b,
+                      uint8_t w, uint8_t ww, uint8_t cw);
+    void ditherToBackBuffer();
+
+    /** @brief Correct, reorder and store a run of pixels (one order dispatch). */
+    template<typename Pixel>
+    void writePixels(uint16_t offset, const Pixel* pixels, uint16_t count);
     static uint8_t calcBytesPerLed(LedType type);
     static ColorOrder getDefaultOrder(LedType type);
 
     /* ── Backend init/show ──────────────────────────────────────────── */
     bool initRmt();
     bool initSpi();
-    void showRmt();
-    void showSpi();
+    bool showRmt();
+    bool showSpi();
     bool createEncoder();
 
+    /** @brief Take back a finished SPI transaction (queue depth is 1). */
+    void collectSpiResult();
+
+    /** @brief Called from the RMT/SPI done interrupt. */
+    void frameDone(BaseType_t* woken);
+    static bool rmtDoneCallback(rmt_channel_handle_t channel,
+                                const rmt_tx_done_event_data_t* event, void* arg);
+    static void spiDoneCallback(spi_transaction_t* trans);
+
     /** @brief Expand pixel buffer into SPI bit-encoded buffer. */
     void encodeSpiBuffer();
+
+    /** @brief SPI bytes per LED data byte (8 or 3). */
+    uint8_t spiBytesPerByte() const;
 };
\ No newline at end of file
@@ -0,0 +1,220 @@
+/**
+ * @file led_effect_engine.cpp
+ * @brief Frame-paced LED effect task.
+ */
+
+#include "led_effect_engine.h"
+#include <esp_log.h>
+#include <esp_timer.h>
+
+
+static const char* TAG = "LedEffectEngine";
+
+
+/*
+ * =============================================================================
+ * CONSTRUCTOR / DESTRUCTOR
+ * =============================================================================
+ */
+LedEffectEngine::LedEffectEngine(AddressableLED& strip)
+    : strip(strip),
+      lock(portMUX_INITIALIZER_UNLOCKED),
+      pendingEffect(nullptr),
+      pendingFadeMs(0),
+      effectPending(false),
+      level(255),
+      running(false),
+      taskHandle(nullptr),
+      period(1),
+      periodUs(0),
+      statsStartUs(0),
+      stats{}
+{
+}
+
+LedEffectEngine::~LedEffectEngine()
+{
+    stop();
+}
+
+
+/*
+ * =============================================================================
+ * START / STOP
+ * =============================================================================
+ */
+bool LedEffectEngine::start(uint8_t fps)
+{
+    if (running) return true;
+
+    if (!strip.isInitialized()) {
+        ESP_LOGE(TAG, "Strip not initialized");
+        return false;
+    }
+
+    if (fps == 0) fps = 1;
+    if (fps > LED_EFFECT_MAX_FPS) fps = LED_EFFECT_MAX_FPS;
+
+    if (!mixer.begin(strip.getNumLeds())) {
+        ESP_LOGE(TAG, "Out of memory for %d LED frames", strip.getNumLeds());
+        return false;
+    }
+
+    period = pdMS_TO_TICKS(1000 / fps);
+    if (period == 0) period = 1;
+    periodUs = period * portTICK_PERIOD_MS * 1000;
+
+    resetStats();
+
+    running = true;
+    BaseType_t ret = xTaskCreate(
+        effectTask, "led_effects", LED_EFFECT_TASK_STACK,
+        this, LED_EFFECT_TASK_PRIORITY, &taskHandle
+    );
+    if (ret != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create effect task");
+        running = false;
+        taskHandle = nullptr;
+        return false;
+    }
+
+    ESP_LOGI(TAG, "Started: %d LEDs at %lu fps", strip.getNumLeds(),
+             (unsigned long)(1000000 / periodUs));
+    return true;
+}
+
+
+void LedEffectEngine::stop()
+{
+    if (!running) return;
+
+    running = false;
+
+    // The task finishes its frame and deletes itself
+    while (taskHandle) vTaskDelay(1);
+
+    strip.waitShowDone(pdMS_TO_TICKS(ADDRESSABLE_SHOW_TIMEOUT_MS));
+}
+
+
+/*
+ * =============================================================================
+ * CONTROL
+ * =============================================================================
+ */
+void LedEffectEngine::setEffect(LedEffect* effect, uint16_t fadeMs)
+{
+    portENTER_CRITICAL(&lock);
+    pendingEffect = effect;
+    pendingFadeMs = fadeMs;
+    effectPending = true;
+    portEXIT_CRITICAL(&lock);
+}
+
+void LedEffectEngine::setLevel(uint8_t newLevel)
+{
+    portENTER_CRITICAL(&lock);
+    level = newLevel;
+    portEXIT_CRITICAL(&lock);
+}
+
+
+/*
+ * =============================================================================
+ * STATS
+ * =============================================================================
+ */
+LedEffectStats LedEffectEngine::getStats() const
+{
+    portENTER_CRITICAL(&lock);
+    LedEffectStats s = stats;
+    int64_t startUs = statsStartUs;
+    portEXIT_CRITICAL(&lock);
+
+    s.runUs = (uint64_t)(esp_timer_get_time() - startUs);
+    return s;
+}
+
+void LedEffectEngine::resetStats()
+{
+    portENTER_CRITICAL(&lock);
+    stats = {};
+    statsStartUs = esp_timer_get_time();
+    portEXIT_CRITICAL(&lock);
+}
+
+uint8_t LedEffectEngine::getCpuLoad() const
+{
+    LedEffectStats s = getStats();
+    if (s.runUs == 0) return 0;
+
+    uint64_t pct = s.totalRenderUs * 100 / s.runUs;
+    return (pct > 100) ? 100 : (uint8_t)pct;
+}
+
+
+/*
+ * =============================================================================
+ * EFFECT TASK
+ * =============================================================================
+ *
+ * Effects get the time since start() in milliseconds, so animations
+ * keep their speed even when frames are late.
+ */
+void LedEffectEngine::effectTask(void* arg)
+{
+    LedEffectEngine* engine = static_cast<LedEffectEngine*>(arg);
+
+    int64_t startUs = esp_timer_get_time();
+    TickType_t wake = xTaskGetTickCount();
+
+    while (engine->running) {
+        engine->renderFrame((uint32_t)((esp_timer_get_time() - startUs) / 1000));
+        vTaskDelayUntil(&wake, engine->period);
+    }
+
+    engine->taskHandle = nullptr;
+    vTaskDelete(nullptr);
+}
+
+
+void LedEffectEngine::renderFrame(uint32_t nowMs)
+{
+    int64_t startUs = esp_timer_get_time();
+
+    portENTER_CRITICAL(&lock);
+    bool change = effectPending;
+    LedEffect* effect = pendingEffect;
+    uint16_t fadeMs = pendingFadeMs;
+    effectPending = false;
+    uint8_t frameLevel = level;
+    portEXIT_CRITICAL(&lock);
+
+    // begin() may allocate: done here, once per switch, not per frame
+    if (change && !mixer.setEffect(effect, nowMs, fadeMs)) {
+        ESP_LOGE(TAG, "Effect '%s' failed to start", effect->name());
+    }
+    mixer.setLevel(frameLevel);
+
+    const RGB* frame = mixer.render(nowMs);
+    strip.setPixels(frame, mixer.getCount());
+
+    int64_t renderedUs = esp_timer_get_time();
+
+    // The previous frame may still be going out
+    if (!strip.waitShowDone(pdMS_TO_TICKS(ADDRESSABLE_SHOW_TIMEOUT_MS))) {
+        ESP_LOGW(TAG, "Previous frame did not finish");
+    }
+    strip.showAsync();
+
+    int64_t doneUs = esp_timer_get_time();
+    uint32_t renderUs = (uint32_t)(renderedUs - startUs);
+
+    portENTER_CRITICAL(&lock);
+    stats.frames++;
+    stats.lastRenderUs = renderUs;
+    if (renderUs > stats.maxRenderUs) stats.maxRenderUs = renderUs;
+    stats.totalRenderUs += renderUs;
+    if (doneUs - startUs > (int64_t)periodUs) stats.lateFrames++;
+    portEXIT_CRITICAL(&lock);
+}
@@ -0,0 +1,194 @@
+/**
+ * @file led_effect_engine.h
+ * @brief Runs LED effects on an AddressableLED strip from its own task.
+ *
+ * @details
+ * A FreeRTOS task wakes at a fixed frame rate (vTaskDelayUntil), renders
+ * the current effect through a LedEffectMixer (led_effects.h), copies it
+ * into the strip with setPixels() and starts the transfer with
+ * showAsync(). The next frame is rendered while this one is still
+ * being sent.
+ *
+ * Render time is measured every frame, so getStats() shows how much of
+ * the frame budget the effects use.
+ *
+ * @par Usage
+ * @code
+ * AddressableLED strip(GPIO_NUM_4, 144);
+ * strip.init();
+ *
+ * static FireEffect fire;
+ * static RainbowEffect rainbow;
+ *
+ * LedEffectEngine engine(strip);
+ * engine.start();                      // 50 fps
+ * engine.setEffect(&fire);
+ * ...
+ * engine.setEffect(&rainbow, 1500);     // 1.5 s crossfade
+ *
+ * LedEffectStats s = engine.getStats();
+ * ESP_LOGI(TAG, "render %lu us, load %u%%", s.lastRenderUs, engine.getCpuLoad());
+ * @endcode
+ */
+
+/*
+ * =============================================================================
+ * BEGINNER'S GUIDE: FRAME PACING
+ * =============================================================================
+ *
+ * vTaskDelay(20) waits 20 ms after the frame work is done, so the frame
+ * rate drifts with how long rendering took. vTaskDelayUntil() waits
+ * until 20 ms after the previous wake-up instead:
+ *
+ *     vTaskDelay:       |render|──20 ms──|render|──20 ms──|     period = 20 + render
+ *     vTaskDelayUntil:  |render|─────────|render|─────────|     period = 20
+ *                       ◄──── 20 ms ────►
+ *
+ * Each frame:
+ *
+ *     wake ─ render effect(s) ─ setPixels ─ wait for previous frame ─ showAsync ─ sleep
+ *            ◄──── renderUs ────────────►
+ *
+ * setPixels() writes the strip's back buffer, so rendering does not have
+ * to wait for the previous frame to finish sending.
+ *
+ * The period is rounded to whole RTOS ticks. With the default 100 Hz
+ * tick that means 10 ms steps: 50, 33 or 25 fps work exactly, 60 fps
+ * becomes 50. Set CONFIG_FREERTOS_HZ=1000 for finer rates.
+ *
+ * A frame is LATE when render plus the wait overran the frame period.
+ * Effects are driven by the clock, so late frames make the animation
+ * choppy but not slower.
+ *
+ * =============================================================================
+ * STRIP OWNERSHIP
+ * =============================================================================
+ *
+ * While the engine runs it owns the strip: don't call setPixel(), fill()
+ * or show() from other tasks. Pixels are written as RGB, so the white
+ * channel of RGBW strips stays off.
+ *
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <stdint.h>
+#include "addressable_led.h"
+#include "led_effects.h"
+
+
+#define LED_EFFECT_TASK_STACK       3072
+#define LED_EFFECT_TASK_PRIORITY    5
+#define LED_EFFECT_DEFAULT_FPS      50      // 20 ms: a whole number of ticks at CONFIG_FREERTOS_HZ=100
+#define LED_EFFECT_MAX_FPS          200
+
+
+/**
+ * @brief Frame and CPU-time counters.
+ */
+struct LedEffectStats {
+    uint32_t frames;            ///< Frames rendered
+    uint32_t lateFrames;        ///< Frames that overran the frame period
+    uint32_t lastRenderUs;      ///< Effects + crossfade + setPixels, last frame
+    uint32_t maxRenderUs;       ///< Longest render
+    uint64_t totalRenderUs;     ///< Sum of all renders
+    uint64_t runUs;             ///< Time the counters cover
+};
+
+
+/**
+ * @class LedEffectEngine
+ * @brief Frame-paced effect task for one strip.
+ */
+class LedEffectEngine {
+
+public:
+
+    /**
+     * @param strip Initialized strip. Must outlive the engine.
+     */
+    explicit LedEffectEngine(AddressableLED& strip);
+    ~LedEffectEngine();
+
+    LedEffectEngine(const LedEffectEngine&) = delete;
+    LedEffectEngine& operator=(const LedEffectEngine&) = delete;
+
+
+    /**
+     * @brief Allocate the frame buffers and start the task.
+     *
+     * @param fps Frames per second (1..LED_EFFECT_MAX_FPS), rounded to
+     *            whole RTOS ticks.
+     *
+     * @return false if the strip is not initialized or allocation failed.
+     */
+    bool start(uint8_t fps = LED_EFFECT_DEFAULT_FPS);
+
+    /**
+     * @brief Stop the task after its current frame.
+     *
+     * @details The strip keeps showing the last frame.
+     */
+    void stop();
+
+    bool isRunning() const { return running; }
+
+
+    /**
+     * @brief Switch to another effect.
+     *
+     * @param effect Effect to show (nullptr = fade to black).
+     * @param fadeMs Crossfade from the current effect (0 = cut).
+     *
+     * @details Takes effect on the next frame. The effect's begin() runs
+     *          in the engine task; keep the effect alive while selected.
+     */
+    void setEffect(LedEffect* effect, uint16_t fadeMs = 0);
+
+    /**
+     * @brief Master level applied after mixing (0-255).
+     */
+    void setLevel(uint8_t level);
+
+
+    /**
+     * @brief Get frame and render-time counters.
+     */
+    LedEffectStats getStats() const;
+
+    /**
+     * @brief Reset the counters.
+     */
+    void resetStats();
+
+    /**
+     * @brief Share of wall time spent rendering (percent).
+     */
+    uint8_t getCpuLoad() const;
+
+
+private:
+
+    AddressableLED& strip;
+    LedEffectMixer mixer;           // Only touched by the task once started
+
+    // Requests from other tasks, picked up at the start of a frame
+    mutable portMUX_TYPE lock;
+    LedEffect* pendingEffect;
+    uint16_t pendingFadeMs;
+    bool effectPending;
+    uint8_t level;
+
+    volatile bool running;
+    TaskHandle_t taskHandle;
+    TickType_t period;
+    uint32_t periodUs;
+    int64_t statsStartUs;
+    LedEffectStats stats;
+
+    static void effectTask(void* arg);
+    void renderFrame(uint32_t nowMs);
+};
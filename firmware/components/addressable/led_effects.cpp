@@ -0,0 +1,455 @@
+/**
+ * @file led_effects.cpp
+ * @brief Fixed-point LED effects and crossfading mixer.
+ *
+ * @details
+ * Builds with ESP-IDF and with a plain host compiler (no IDF headers).
+ */
+
+#include "led_effects.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+/*
+ * =============================================================================
+ * SINE AND COLOR
+ * =============================================================================
+ *
+ * A quarter sine wave, scaled to ±127. The other three quarters are
+ * mirror images:
+ *
+ *     theta:   0 ──── 64 ──── 128 ──── 192 ──── 255
+ *     sin8:  128 ──► 255 ──► 128 ──►   1 ──► 128
+ */
+static const uint8_t QUARTER_SINE[65] = {
+      0,   3,   6,   9,  12,  16,  19,  22,  25,  28,  31,  34,  37,
+     40,  43,  46,  49,  51,  54,  57,  60,  63,  65,  68,  71,  73,
+     76,  78,  81,  83,  85,  88,  90,  92,  94,  96,  98, 100, 102,
+    104, 106, 107, 109, 111, 112, 113, 115, 116, 117, 118, 120, 121,
+    122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127, 127,
+};
+
+uint8_t sin8(uint8_t theta)
+{
+    uint8_t i = theta & 63;
+    switch (theta >> 6) {
+        case 0:  return 128 + QUARTER_SINE[i];
+        case 1:  return 128 + QUARTER_SINE[64 - i];
+        case 2:  return 128 - QUARTER_SINE[i];
+        default: return 128 - QUARTER_SINE[64 - i];
+    }
+}
+
+
+/*
+ * The hue circle is split into six 43-step regions. Inside a region one
+ * channel ramps while the other two stay put:
+ *
+ *     region:   0      1      2      3      4      5
+ *     R:       255    ↘      0      0     ↗     255
+ *     G:       ↗     255    255     ↘      0      0
+ *     B:        0      0     ↗     255    255     ↘
+ */
+RGB hsvToRgb8(uint8_t hue, uint8_t sat, uint8_t val)
+{
+    if (sat == 0) return {val, val, val};
+
+    uint16_t h6 = (uint16_t)hue * 6;
+    uint8_t region = h6 >> 8;
+    uint8_t rem = h6 & 0xFF;
+
+    uint8_t p = scale8(val, 255 - sat);
+    uint8_t q = scale8(val, 255 - scale8(sat, rem));
+    uint8_t t = scale8(val, 255 - scale8(sat, 255 - rem));
+
+    switch (region) {
+        case 0:  return {val, t, p};
+        case 1:  return {q, val, p};
+        case 2:  return {p, val, t};
+        case 3:  return {p, q, val};
+        case 4:  return {t, p, val};
+        default: return {val, p, q};
+    }
+}
+
+
+/*
+ * =============================================================================
+ * RAINBOW
+ * =============================================================================
+ */
+void RainbowEffect::render(RGB* out, uint16_t count, uint32_t timeMs)
+{
+    if (count == 0) return;
+
+    uint32_t hue = effectPhase16(timeMs, periodMs);
+    uint32_t step = ((uint32_t)repeats << 16) / count;      // Q16 hue per LED
+
+    for (uint16_t i = 0; i < count; i++, hue += step) {
+        out[i] = hsvToRgb8((uint8_t)(hue >> 8), saturation, value);
+    }
+}
+
+
+/*
+ * =============================================================================
+ * CHASE
+ * =============================================================================
+ *
+ * Positions are in 1/256 LED (Q8). d is how far an LED is behind the
+ * head, wrapping around the end of the strip:
+ *
+ *     LED:     0   1   2   3   4   5   6
+ *     level:       ░   ▒   ▓   █   ▏           head at 4.1, tail 4
+ *                  ◄──── tail ────┘ └ next LED, lit by the fraction
+ */
+void ChaseEffect::render(RGB* out, uint16_t count, uint32_t timeMs)
+{
+    if (count == 0) return;
+
+    uint32_t stripQ8 = (uint32_t)count << 8;
+    uint32_t head = ((uint32_t)effectPhase16(timeMs, periodMs) * count) >> 8;
+    uint32_t tailQ8 = (uint32_t)tail << 8;
+    uint32_t fadePerQ8 = (255u << 16) / tailQ8;              // Q16 level lost per Q8 step
+
+    uint32_t led = 0;
+    for (uint16_t i = 0; i < count; i++, led += 256) {
+        uint32_t d = (head >= led) ? head - led : head + stripQ8 - led;
+        uint8_t level;
+
+        if (d < tailQ8) {
+            level = 255 - (uint8_t)((d * fadePerQ8) >> 16);
+        } else if (stripQ8 - d < 256) {
+            level = 255 - (uint8_t)(stripQ8 - d);           // Just ahead of the head
+        } else {
+            level = 0;
+        }
+
+        out[i] = blendRgb(background, color, level);
+    }
+}
+
+
+/*
+ * =============================================================================
+ * TWINKLE
+ * =============================================================================
+ *
+ * Spawning and fading run off the elapsed time. The fractional parts
+ * are carried to the next frame, so at 100 fps and at 20 fps the same
+ * number of twinkles appear and they fade at the same speed.
+ */
+TwinkleEffect::~TwinkleEffect()
+{
+    free(levels);
+}
+
+bool TwinkleEffect::begin(uint16_t count)
+{
+    if (count != levelCount || !levels) {
+        free(levels);
+        levels = (uint8_t*)calloc(count ? count : 1, 1);
+        levelCount = levels ? count : 0;
+        if (!levels) return false;
+    }
+    memset(levels, 0, levelCount);
+
+    rng.seed(seed);
+    spawnAcc = 0;
+    fadeAcc = 0;
+    started = false;
+    return true;
+}
+
+void TwinkleEffect::render(RGB* out, uint16_t count, uint32_t timeMs)
+{
+    if (!levels || count != levelCount) {
+        memset(out, 0, (size_t)count * sizeof(RGB));
+        return;
+    }
+
+    if (!started) {
+        started = true;
+        lastMs = timeMs;
+    }
+    uint32_t dt = timeMs - lastMs;
+    lastMs = timeMs;
+    if (dt > 1000) dt = 1000;                               // Long stall: don't burst
+
+    fadeAcc += dt * (255u << 8) / fadeMs;
+    uint32_t fade = fadeAcc >> 8;
+    fadeAcc &= 0xFF;
+    if (fade > 255) fade = 255;
+
+    for (uint16_t i = 0; i < count; i++) {
+        levels[i] = (levels[i] > fade) ? levels[i] - fade : 0;
+    }
+
+    spawnAcc += (uint32_t)perSecond * dt;
+    while (spawnAcc >= 1000) {
+        spawnAcc -= 1000;
+        levels[rng.next16(count)] = 255;
+    }
+
+    for (uint16_t i = 0; i < count; i++) {
+        uint8_t l = levels[i];
+        out[i] = scaleRgb(color, scale8(l, l));             // Squared: quick drop, long glow
+    }
+}
+
+
+/*
+ * =============================================================================
+ * FIRE
+ * =============================================================================
+ *
+ * Each step, every cell cools a little, heat drifts upward (each cell
+ * becomes the average of the two below it, weighted to the nearer one)
+ * and sometimes a spark lands near the bottom:
+ *
+ *     heat:   [230][190][140][ 90][ 40][ 10][  0]   LED 0 = base
+ *     color:   yel  ora  red  red  dim   .    .
+ *
+ * ÷3 is done as × 85 >> 8.
+ */
+FireEffect::~FireEffect()
+{
+    free(heat);
+}
+
+bool FireEffect::begin(uint16_t count)
+{
+    if (count != heatCount || !heat) {
+        free(heat);
+        heat = (uint8_t*)calloc(count ? count : 1, 1);
+        heatCount = heat ? count : 0;
+        if (!heat) return false;
+    }
+    memset(heat, 0, heatCount);
+
+    uint32_t cool = (count ? (uint32_t)cooling * 10 / count : 0) + 2;
+    coolMax = (cool > 255) ? 255 : (uint8_t)cool;
+
+    rng.seed(seed);
+    started = false;
+    return true;
+}
+
+void FireEffect::step()
+{
+    for (uint16_t i = 0; i < heatCount; i++) {
+        uint8_t c = rng.next8(coolMax);
+        heat[i] = (heat[i] > c) ? heat[i] - c : 0;
+    }
+
+    for (uint16_t k = heatCount; k-- > 2; ) {
+        heat[k] = (uint8_t)((((uint16_t)heat[k - 1] + heat[k - 2] + heat[k - 2]) * 85) >> 8);
+    }
+
+    if (rng.next8() < sparking) {
+        uint8_t y = rng.next8(heatCount < 7 ? heatCount : 7);
+        uint16_t h = heat[y] + rng.next8(160, 255);
+        heat[y] = (h > 255) ? 255 : (uint8_t)h;
+    }
+}
+
+void FireEffect::render(RGB* out, uint16_t count, uint32_t timeMs)
+{
+    if (!heat || count != heatCount) {
+        memset(out, 0, (size_t)count * sizeof(RGB));
+        return;
+    }
+
+    if (!started) {
+        started = true;
+        lastMs = timeMs - stepMs;                           // Step once on the first frame
+    }
+
+    uint32_t steps = (timeMs - lastMs) / stepMs;
+    if (steps > 4) {
+        steps = 4;                                          // Stalled: catch up a little only
+        lastMs = timeMs;
+    } else {
+        lastMs += steps * stepMs;
+    }
+    while (steps--) step();
+
+    for (uint16_t i = 0; i < count; i++) {
+        out[i] = heatColor(heat[i]);
+    }
+}
+
+/*
+ * Temperature 0..255 is squeezed to 0..191 and split in three bands of
+ * 64. Inside each band one channel ramps up:
+ *
+ *     0-63: red ramps    64-127: green ramps    128-191: blue ramps
+ */
+RGB FireEffect::heatColor(uint8_t temperature)
+{
+    uint8_t t192 = scale8(temperature, 191);
+    uint8_t ramp = (t192 & 63) << 2;
+
+    if (t192 & 128) return {255, 255, ramp};
+    if (t192 & 64)  return {255, ramp, 0};
+    return {ramp, 0, 0};
+}
+
+
+/*
+ * =============================================================================
+ * BREATHE
+ * =============================================================================
+ */
+void BreatheEffect::render(RGB* out, uint16_t count, uint32_t timeMs)
+{
+    uint8_t phase = effectPhase16(timeMs, periodMs) >> 8;
+    uint8_t wave = sin8(phase + 192);                       // Starts at the bottom
+    uint8_t level = minLevel + scale8(wave, 255 - minLevel);
+
+    RGB c = scaleRgb(color, level);
+    for (uint16_t i = 0; i < count; i++) out[i] = c;
+}
+
+
+/*
+ * =============================================================================
+ * GRADIENT
+ * =============================================================================
+ *
+ * Scrolling uses a triangle wave over the strip, so both ends are a:
+ *
+ *     still:       a ──────────────► b
+ *     scrolling:   a ──────► b ──────► a    (shifted by the phase)
+ */
+void GradientEffect::render(RGB* out, uint16_t count, uint32_t timeMs)
+{
+    if (count == 0) return;
+
+    if (periodMs == 0) {
+        uint32_t step = (count > 1) ? (255u << 16) / (count - 1) : 0;
+        uint32_t pos = 1u << 15;                            // Round to nearest
+        for (uint16_t i = 0; i < count; i++, pos += step) {
+            out[i] = blendRgb(a, b, (uint8_t)(pos >> 16));
+        }
+        return;
+    }
+
+    uint32_t step = (1u << 17) / count;                     // Two ramps per strip, Q16
+    uint32_t pos = effectPhase16(timeMs, periodMs);
+    for (uint16_t i = 0; i < count; i++, pos += step) {
+        uint16_t p = (uint16_t)pos;
+        uint8_t t = (p < 32768) ? (p >> 7) : ((65535 - p) >> 7);
+        out[i] = blendRgb(a, b, t);
+    }
+}
+
+
+/*
+ * =============================================================================
+ * MIXER
+ * =============================================================================
+ */
+LedEffectMixer::LedEffectMixer()
+    : frame(nullptr),
+      scratch(nullptr),
+      count(0),
+      current(nullptr),
+      next(nullptr),
+      fadeStartMs(0),
+      fadeMs(0),
+      fading(false),
+      level(255)
+{
+}
+
+LedEffectMixer::~LedEffectMixer()
+{
+    free(frame);
+    free(scratch);
+}
+
+bool LedEffectMixer::begin(uint16_t count)
+{
+    free(frame);
+    free(scratch);
+    frame = (RGB*)calloc(count ? count : 1, sizeof(RGB));
+    scratch = (RGB*)calloc(count ? count : 1, sizeof(RGB));
+    if (!frame || !scratch) {
+        free(frame);
+        free(scratch);
+        frame = nullptr;
+        scratch = nullptr;
+        this->count = 0;
+        return false;
+    }
+    this->count = count;
+
+    // Effects already selected were prepared for the old length
+    if (current && !current->begin(count)) current = nullptr;
+    if (next && !next->begin(count)) next = nullptr;
+    return true;
+}
+
+bool LedEffectMixer::setEffect(LedEffect* effect, uint32_t nowMs, uint16_t fadeMs)
+{
+    if (effect == getEffect()) return true;
+
+    // The outgoing effect is already running: fading back must not restart it
+    bool running = (effect == current);
+    if (effect && !running && !effect->begin(count)) return false;
+
+    if (fadeMs == 0) {
+        current = effect;
+        next = nullptr;
+        fading = false;
+        return true;
+    }
+
+    if (fading) current = next;
+    next = effect;
+    fadeStartMs = nowMs;
+    this->fadeMs = fadeMs;
+    fading = true;
+    return true;
+}
+
+void LedEffectMixer::renderEffect(LedEffect* effect, RGB* out, uint32_t nowMs)
+{
+    if (effect) {
+        effect->render(out, count, nowMs);
+    } else {
+        memset(out, 0, (size_t)count * sizeof(RGB));
+    }
+}
+
+const RGB* LedEffectMixer::render(uint32_t nowMs)
+{
+    if (!frame) return nullptr;
+
+    uint32_t elapsed = nowMs - fadeStartMs;
+    if (fading && elapsed >= fadeMs) {
+        current = next;
+        next = nullptr;
+        fading = false;
+    }
+
+    renderEffect(current, frame, nowMs);
+
+    if (fading) {
+        renderEffect(next, scratch, nowMs);
+        uint8_t t = (uint8_t)(elapsed * 255 / fadeMs);
+        for (uint16_t i = 0; i < count; i++) {
+            frame[i] = blendRgb(frame[i], scratch[i], t);
+        }
+    }
+
+    if (level != 255) {
+        for (uint16_t i = 0; i < count; i++) {
+            frame[i] = scaleRgb(frame[i], level);
+        }
+    }
+
+    return frame;
+}
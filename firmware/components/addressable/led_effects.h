@@ -0,0 +1,442 @@
+/**
+ * @file led_effects.h
+ * @brief Fixed-point LED effects and a crossfading mixer.
+ *
+ * @details
+ * The hardware-independent half of LedEffectEngine. Effects render one
+ * frame of RGB pixels for a given time in milliseconds; the mixer runs
+ * the current effect, crossfades to the next one and applies a master
+ * level:
+ *
+ *     LedEffect (rainbow, fire, ...) ──► LedEffectMixer ──► RGB frame
+ *                                         crossfade, level        │
+ *                                                                 ▼
+ *                              LedEffectEngine task ──► strip.setPixels()
+ *
+ * Nothing in this file touches RMT, SPI or FreeRTOS, so frames can be
+ * rendered on a PC (firmware/tools/led_effects_render.cpp) and compared
+ * against saved golden images.
+ *
+ * @par Usage
+ * @code
+ * FireEffect fire;
+ * RainbowEffect rainbow(4000);
+ *
+ * LedEffectMixer mixer;
+ * mixer.begin(144);
+ * mixer.setEffect(&fire, 0, 0);
+ * const RGB* frame = mixer.render(16);
+ *
+ * mixer.setEffect(&rainbow, 5000, 1000);   // 1 s crossfade from fire
+ * @endcode
+ */
+
+/*
+ * =============================================================================
+ * BEGINNER'S GUIDE: FIXED-POINT ANIMATION
+ * =============================================================================
+ *
+ * Floats are slow on the ESP32-C6 (no FPU) and even on the S3 an effect
+ * runs its math for every LED, every frame. Everything here uses whole
+ * numbers with an implied scale instead:
+ *
+ *     Q8   0..255    means 0.0 .. 1.0      (brightness, blend amount)
+ *     Q16  0..65535  means 0.0 .. 1.0      (animation phase, hue)
+ *
+ *     50% of 200:   scale8(200, 128)  =  200 × 129 >> 8  =  100
+ *
+ * Time is turned into a phase once per frame:
+ *
+ *     phase16 = (timeMs % periodMs) × 65536 / periodMs
+ *
+ *     0 ms ──────────── periodMs/2 ─────────── periodMs
+ *     0                 32768                   65535 → 0
+ *
+ * and each LED adds a fixed step to it, so the per-LED work is adds,
+ * shifts and table lookups. Effects render from the clock, not from a
+ * frame count: a dropped frame does not slow the animation down.
+ *
+ * =============================================================================
+ * MEMORY
+ * =============================================================================
+ *
+ * Effects with per-LED state (twinkle, fire) allocate it in begin(),
+ * which the mixer calls when the effect is selected. The mixer allocates
+ * its two frame buffers in its own begin(). Rendering a frame never
+ * allocates.
+ *
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "led_pixel.h"
+
+
+/*
+ * =============================================================================
+ * Q8 / Q16 HELPERS
+ * =============================================================================
+ */
+
+/** @brief v × scale / 256, where scale 255 keeps v unchanged. */
+inline uint8_t scale8(uint8_t v, uint8_t scale) {
+    return (uint8_t)(((uint16_t)v * (scale + 1)) >> 8);
+}
+
+/** @brief Mix a and b; amount 0 gives a, 255 gives b. */
+inline uint8_t blend8(uint8_t a, uint8_t b, uint8_t amount) {
+    uint16_t w = amount + (amount >> 7);                // 0..256
+    return (uint8_t)(((uint16_t)a * (256 - w) + (uint16_t)b * w) >> 8);
+}
+
+inline RGB scaleRgb(RGB c, uint8_t scale) {
+    return {scale8(c.r, scale), scale8(c.g, scale), scale8(c.b, scale)};
+}
+
+inline RGB blendRgb(RGB a, RGB b, uint8_t amount) {
+    return {blend8(a.r, b.r, amount), blend8(a.g, b.g, amount), blend8(a.b, b.b, amount)};
+}
+
+/** @brief Sine of a Q8 angle (256 = full turn), 1..255 centered on 128. */
+uint8_t sin8(uint8_t theta);
+
+/** @brief Hue, saturation and value (all Q8) to RGB. */
+RGB hsvToRgb8(uint8_t hue, uint8_t sat, uint8_t val);
+
+/** @brief Position inside a repeating period as Q16 (periodMs 0 → 0). */
+inline uint16_t effectPhase16(uint32_t timeMs, uint16_t periodMs) {
+    if (periodMs == 0) return 0;
+    return (uint16_t)(((timeMs % periodMs) << 16) / periodMs);
+}
+
+
+/**
+ * @brief Small deterministic PRNG (xorshift32) for twinkle and fire.
+ *
+ * @details Seeded explicitly so host renders are reproducible.
+ */
+class EffectRandom {
+public:
+    explicit EffectRandom(uint32_t seed = 0x2545F491) : state(seed ? seed : 1) {}
+
+    void seed(uint32_t s) { state = s ? s : 1; }
+
+    uint32_t next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    uint8_t next8() { return (uint8_t)(next() >> 24); }
+
+    /** @brief Uniform in [0, limit). */
+    uint8_t next8(uint8_t limit) { return (uint8_t)(((uint16_t)next8() * limit) >> 8); }
+
+    /** @brief Uniform in [low, high). */
+    uint8_t next8(uint8_t low, uint8_t high) { return low + next8(high - low); }
+
+    uint16_t next16(uint16_t limit) { return (uint16_t)(((next() >> 16) * limit) >> 16); }
+
+private:
+    uint32_t state;
+};
+
+
+/*
+ * =============================================================================
+ * EFFECT INTERFACE
+ * =============================================================================
+ */
+
+/**
+ * @class LedEffect
+ * @brief One animation. Renders a whole frame for a point in time.
+ */
+class LedEffect {
+public:
+    virtual ~LedEffect() {}
+
+    /**
+     * @brief Prepare for a strip of count LEDs and restart the animation.
+     *
+     * @details Called by the mixer when the effect is selected. The only
+     *          place an effect may allocate.
+     *
+     * @return false if out of memory (the effect is not selected).
+     */
+    virtual bool begin(uint16_t count) { (void)count; return true; }
+
+    /**
+     * @brief Render count pixels for timeMs (time since the engine started).
+     */
+    virtual void render(RGB* out, uint16_t count, uint32_t timeMs) = 0;
+
+    /** @brief Short name for logs and the host renderer. */
+    virtual const char* name() const = 0;
+};
+
+
+/*
+ * =============================================================================
+ * EFFECTS
+ * =============================================================================
+ */
+
+/**
+ * @brief Hue wheel scrolling along the strip.
+ */
+class RainbowEffect : public LedEffect {
+public:
+    /**
+     * @param periodMs Time for one full hue cycle at a point (0 = still).
+     * @param repeats  Number of full hue wheels along the strip.
+     */
+    RainbowEffect(uint16_t periodMs = 5000, uint8_t repeats = 1,
+                  uint8_t saturation = 255, uint8_t value = 255)
+        : periodMs(periodMs), repeats(repeats), saturation(saturation), value(value) {}
+
+    void render(RGB* out, uint16_t count, uint32_t timeMs) override;
+    const char* name() const override { return "rainbow"; }
+
+private:
+    uint16_t periodMs;
+    uint8_t repeats;
+    uint8_t saturation;
+    uint8_t value;
+};
+
+
+/**
+ * @brief A head with a fading tail running along the strip.
+ *
+ * @details The head moves in 1/256 LED steps and is spread over two
+ *          LEDs, so slow chases glide instead of jumping.
+ */
+class ChaseEffect : public LedEffect {
+public:
+    /**
+     * @param periodMs Time for the head to travel the whole strip.
+     * @param tail     Tail length in LEDs (1..255).
+     */
+    ChaseEffect(RGB color = {255, 255, 255}, RGB background = {0, 0, 0},
+                uint16_t periodMs = 3000, uint8_t tail = 8)
+        : color(color), background(background), periodMs(periodMs), tail(tail ? tail : 1) {}
+
+    void render(RGB* out, uint16_t count, uint32_t timeMs) override;
+    const char* name() const override { return "chase"; }
+
+private:
+    RGB color;
+    RGB background;
+    uint16_t periodMs;
+    uint8_t tail;
+};
+
+
+/**
+ * @brief Random LEDs flash up and fade out.
+ */
+class TwinkleEffect : public LedEffect {
+public:
+    /**
+     * @param perSecond New twinkles per second across the whole strip.
+     * @param fadeMs    Time for a twinkle to fade from full to off.
+     */
+    TwinkleEffect(RGB color = {255, 200, 120}, uint16_t perSecond = 20,
+                  uint16_t fadeMs = 800, uint32_t seed = 1)
+        : color(color), perSecond(perSecond), fadeMs(fadeMs ? fadeMs : 1),
+          seed(seed), levels(nullptr), levelCount(0), lastMs(0),
+          spawnAcc(0), fadeAcc(0), started(false) {}
+    ~TwinkleEffect() override;
+
+    TwinkleEffect(const TwinkleEffect&) = delete;
+    TwinkleEffect& operator=(const TwinkleEffect&) = delete;
+
+    bool begin(uint16_t count) override;
+    void render(RGB* out, uint16_t count, uint32_t timeMs) override;
+    const char* name() const override { return "twinkle"; }
+
+private:
+    RGB color;
+    uint16_t perSecond;
+    uint16_t fadeMs;
+    uint32_t seed;
+    EffectRandom rng;
+    uint8_t* levels;            // Q8 brightness per LED
+    uint16_t levelCount;
+    uint32_t lastMs;
+    uint32_t spawnAcc;          // Twinkles owed × 1000
+    uint32_t fadeAcc;           // Fade owed, Q8 steps × 256
+    bool started;
+};
+
+
+/**
+ * @brief Flickering flame rising from LED 0 (heat simulation).
+ *
+ * @details Sparks are added near LED 0, heat drifts up the strip and
+ *          cools. The simulation steps at a fixed rate, independent of
+ *          the frame rate.
+ */
+class FireEffect : public LedEffect {
+public:
+    /**
+     * @param cooling  How fast heat fades (20..100, higher = shorter flames;
+     *                 long strips need more to keep the tip dark).
+     * @param sparking Chance of a new spark per step (Q8, higher = busier).
+     * @param stepMs   Simulation step.
+     */
+    FireEffect(uint8_t cooling = 55, uint8_t sparking = 120, uint8_t stepMs = 16,
+               uint32_t seed = 1)
+        : cooling(cooling), sparking(sparking), stepMs(stepMs ? stepMs : 1), seed(seed),
+          heat(nullptr), heatCount(0), coolMax(0), lastMs(0), started(false) {}
+    ~FireEffect() override;
+
+    FireEffect(const FireEffect&) = delete;
+    FireEffect& operator=(const FireEffect&) = delete;
+
+    bool begin(uint16_t count) override;
+    void render(RGB* out, uint16_t count, uint32_t timeMs) override;
+    const char* name() const override { return "fire"; }
+
+    /** @brief Black → red → yellow → white heat palette. */
+    static RGB heatColor(uint8_t temperature);
+
+private:
+    uint8_t cooling;
+    uint8_t sparking;
+    uint8_t stepMs;
+    uint32_t seed;
+    EffectRandom rng;
+    uint8_t* heat;
+    uint16_t heatCount;
+    uint8_t coolMax;            // Largest random cooling per step
+    uint32_t lastMs;
+    bool started;
+
+    void step();
+};
+
+
+/**
+ * @brief Whole strip fading in and out on a sine curve.
+ */
+class BreatheEffect : public LedEffect {
+public:
+    /**
+     * @param periodMs One full in-and-out breath.
+     * @param minLevel Darkest point (Q8), so the strip never goes fully off.
+     */
+    BreatheEffect(RGB color = {255, 120, 40}, uint16_t periodMs = 4000, uint8_t minLevel = 8)
+        : color(color), periodMs(periodMs), minLevel(minLevel) {}
+
+    void render(RGB* out, uint16_t count, uint32_t timeMs) override;
+    const char* name() const override { return "breathe"; }
+
+private:
+    RGB color;
+    uint16_t periodMs;
+    uint8_t minLevel;
+};
+
+
+/**
+ * @brief Two-color gradient, optionally scrolling.
+ *
+ * @details periodMs 0 gives a still a → b gradient from first to last
+ *          LED. Otherwise a → b → a scrolls along the strip so the wrap
+ *          point is invisible.
+ */
+class GradientEffect : public LedEffect {
+public:
+    GradientEffect(RGB a = {255, 0, 80}, RGB b = {0, 80, 255}, uint16_t periodMs = 0)
+        : a(a), b(b), periodMs(periodMs) {}
+
+    void render(RGB* out, uint16_t count, uint32_t timeMs) override;
+    const char* name() const override { return "gradient"; }
+
+private:
+    RGB a;
+    RGB b;
+    uint16_t periodMs;
+};
+
+
+/*
+ * =============================================================================
+ * MIXER
+ * =============================================================================
+ */
+
+/**
+ * @class LedEffectMixer
+ * @brief Renders the current effect and crossfades to the next one.
+ *
+ * @details
+ *
+ *     fade:     ──────────┬──────────────────┬──────────
+ *     current:    effect A│  A × (1 - t)     │  effect B
+ *     next:               │  + B × t         │
+ *                     setEffect(B)      fadeMs later
+ *
+ * Selecting another effect mid-fade makes the one fading in the outgoing
+ * effect and restarts the fade. nullptr renders black, so fading to
+ * nullptr fades the strip out.
+ */
+class LedEffectMixer {
+public:
+    LedEffectMixer();
+    ~LedEffectMixer();
+
+    LedEffectMixer(const LedEffectMixer&) = delete;
+    LedEffectMixer& operator=(const LedEffectMixer&) = delete;
+
+    /**
+     * @brief Allocate the two frame buffers for count LEDs.
+     */
+    bool begin(uint16_t count);
+
+    /**
+     * @brief Select an effect (calls its begin()).
+     *
+     * @param effect Effect to show, or nullptr for black.
+     * @param nowMs  Time the fade starts (same clock as render()).
+     * @param fadeMs Crossfade length (0 = switch on the next frame).
+     *
+     * @return false if the effect's begin() failed (nothing changes).
+     */
+    bool setEffect(LedEffect* effect, uint32_t nowMs, uint16_t fadeMs);
+
+    /** @brief Master level (Q8) applied to the mixed frame. */
+    void setLevel(uint8_t level) { this->level = level; }
+    uint8_t getLevel() const { return level; }
+
+    /**
+     * @brief Render the frame for nowMs.
+     *
+     * @return count pixels, valid until the next render().
+     */
+    const RGB* render(uint32_t nowMs);
+
+    /** @brief The selected effect (the one fading in during a fade). */
+    LedEffect* getEffect() const { return fading ? next : current; }
+    bool isFading() const { return fading; }
+    uint16_t getCount() const { return count; }
+
+private:
+    RGB* frame;                 // Output (and the outgoing effect during a fade)
+    RGB* scratch;               // Incoming effect during a fade
+    uint16_t count;
+    LedEffect* current;
+    LedEffect* next;
+    uint32_t fadeStartMs;
+    uint16_t fadeMs;
+    bool fading;
+    uint8_t level;
+
+    void renderEffect(LedEffect* effect, RGB* out, uint32_t nowMs);
+};
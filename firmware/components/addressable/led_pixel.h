@@ -0,0 +1,28 @@
+/**
+ * @file led_pixel.h
+ * @brief Pixel structs shared by AddressableLED and the effects engine.
+ *
+ * @details
+ * Kept free of ESP-IDF headers so led_effects.cpp also builds on a PC.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+
+/**
+ * @brief One RGB pixel for setPixels().
+ */
+struct RGB {
+    uint8_t r, g, b;
+};
+
+/**
+ * @brief One RGBW pixel for setPixels().
+ */
+struct RGBW {
+    uint8_t r, g, b, w;
+};
+
+static_assert(sizeof(RGB) == 3 && sizeof(RGBW) == 4, "pixel arrays are sent as packed bytes");
@@ -8,6 +8,7 @@
  */
 
 #include "epaper.h"
+#include <esp_attr.h>
 #include <esp_log.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
@@ -74,7 +75,19 @@ EPaper::EPaper(gpio_num_t mosiPin, gpio_num_t sckPin, gpio_num_t csPin,
       initialized(false),
       bufferBW(nullptr),
       bufferRed(nullptr),
+      shadowBW(nullptr),
+      shadowRed(nullptr),
       bufferSize(0),
+      shadowValid(false),
+      partialCount(0),
+      fullAreaPercent(EPAPER_FULL_AREA_PERCENT),
+      maxPartials(EPAPER_MAX_PARTIALS),
+      refreshing(false),
+      partialOutPending(false),
+      busyIsrReady(false),
+      readyEvents(nullptr),
+      readyCallback(nullptr),
+      readyCallbackArg(nullptr),
       rotation(0),
       width(EPAPER_WIDTH),
       height(EPAPER_HEIGHT),
@@ -90,8 +103,13 @@ EPaper::EPaper(gpio_num_t mosiPin, gpio_num_t sckPin, gpio_num_t csPin,
  * =============================================================================
  */
 EPaper::~EPaper() {
+    if (busyIsrReady) gpio_isr_handler_remove(busyPin);
+    if (readyEvents) vEventGroupDelete(readyEvents);
+    
     if (bufferBW) free(bufferBW);
     if (bufferRed) free(bufferRed);
+    if (shadowBW) free(shadowBW);
+    if (shadowRed) free(shadowRed);
     
     if (initialized && spiDevice) {
         spi_bus_remove_device(spiDevice);
@@ -120,11 +138,18 @@ bool EPaper::init() {
     bufferBW = (uint8_t*)malloc(bufferSize);
     bufferRed = (uint8_t*)malloc(bufferSize);
     
-    if (!bufferBW || !bufferRed) {
+    // Shadow copies of what the panel shows, for refresh()
+    shadowBW = (uint8_t*)malloc(bufferSize);
+    shadowRed = (uint8_t*)malloc(bufferSize);
+    
+    if (!bufferBW || !bufferRed || !shadowBW || !shadowRed) {
         ESP_LOGE(TAG, "Failed to allocate frame buffers");
         return false;
     }
     
+    shadowValid = false;    // Panel content unknown until the first update()
+    partialCount = 0;
+    
     // Initialize to white
     memset(bufferBW, 0xFF, bufferSize);   // 0xFF = white for BW
     memset(bufferRed, 0x00, bufferSize);  // 0x00 = no red
@@ -148,8 +173,9 @@ bool EPaper::init() {
     io_conf.pin_bit_mask = (1ULL << rstPin);
     gpio_config(&io_conf);
 
-    // BUSY pin (input!)
+    // BUSY pin (input!), falling edge = refresh finished
     io_conf.mode = GPIO_MODE_INPUT;
+    io_conf.intr_type = GPIO_INTR_NEGEDGE;
     io_conf.pin_bit_mask = (1ULL << busyPin);
     gpio_config(&io_conf);
 
@@ -217,17 +243,8 @@ bool EPaper::init() {
     sendCommand(CMD_DATA_ENTRY_MODE);
     sendData(0x03);
     
-    // Set RAM X address
-    sendCommand(CMD_SET_RAM_X_START_END);
-    sendData(0x00);
-    sendData((EPAPER_WIDTH - 1) / 8);
-    
-    // Set RAM Y address
-    sendCommand(CMD_SET_RAM_Y_START_END);
-    sendData(0x00);
-    sendData(0x00);
-    sendData((EPAPER_HEIGHT - 1) & 0xFF);
-    sendData(((EPAPER_HEIGHT - 1) >> 8) & 0xFF);
+    // RAM window: whole panel
+    setRamWindow(0, (EPAPER_WIDTH - 1) / 8, 0, EPAPER_HEIGHT - 1);
     
     // Border waveform
     sendCommand(CMD_BORDER_WAVEFORM_CONTROL);
@@ -244,6 +261,25 @@ bool EPaper::init() {
     sendCommand(CMD_MASTER_ACTIVATION);
     waitBusy();
 
+    /*
+     * -------------------------------------------------------------------------
+     * STEP 7: BUSY interrupt (asynchronous refresh)
+     * -------------------------------------------------------------------------
+     * 
+     * Without it everything still works, but refreshes block (polling) and
+     * updateAsync()/refreshAsync() refuse to start.
+     */
+    if (!readyEvents) readyEvents = xEventGroupCreate();
+    
+    err = gpio_install_isr_service(0);
+    if (readyEvents && (err == ESP_OK || err == ESP_ERR_INVALID_STATE)) {
+        gpio_isr_handler_add(busyPin, busyIsr, this);
+        busyIsrReady = true;
+        xEventGroupSetBits(readyEvents, EPAPER_EVENT_READY);
+    } else {
+        ESP_LOGW(TAG, "No BUSY interrupt: refresh will block");
+    }
+
     initialized = true;
     ESP_LOGI(TAG, "E-Paper initialized successfully (buffer: %d bytes)", bufferSize);
     return true;
@@ -305,6 +341,27 @@ void EPaper::sendData(const uint8_t* data, size_t len) {
 }
 
 
+void EPaper::setRamWindow(int16_t x0, int16_t x1, int16_t y0, int16_t y1) {
+    sendCommand(CMD_SET_RAM_X_START_END);
+    sendData(x0);
+    sendData(x1);
+    
+    sendCommand(CMD_SET_RAM_Y_START_END);
+    sendData(y0 & 0xFF);
+    sendData((y0 >> 8) & 0xFF);
+    sendData(y1 & 0xFF);
+    sendData((y1 >> 8) & 0xFF);
+    
+    // Start position
+    sendCommand(CMD_SET_RAM_X_ADDRESS);
+    sendData(x0);
+    
+    sendCommand(CMD_SET_RAM_Y_ADDRESS);
+    sendData(y0 & 0xFF);
+    sendData((y0 >> 8) & 0xFF);
+}
+
+
 /*
  * =============================================================================
  * DISPLAY UPDATE
@@ -321,15 +378,20 @@ void EPaper::clear(uint8_t color) {
 
 
 void EPaper::update() {
+    finishRefresh();
+    
     ESP_LOGI(TAG, "Updating display (this takes ~2 seconds)...");
     
-    // Set RAM position to start
-    sendCommand(CMD_SET_RAM_X_ADDRESS);
-    sendData(0x00);
+    startFull();
+    finishRefresh();
     
-    sendCommand(CMD_SET_RAM_Y_ADDRESS);
-    sendData(0x00);
-    sendData(0x00);
+    ESP_LOGI(TAG, "Display update complete");
+}
+
+
+void EPaper::startFull() {
+    // Whole panel (a partial update may have left a smaller window)
+    setRamWindow(0, (EPAPER_WIDTH - 1) / 8, 0, EPAPER_HEIGHT - 1);
     
     // Write B/W data
     sendCommand(CMD_WRITE_RAM_BW);
@@ -339,18 +401,20 @@ void EPaper::update() {
     sendCommand(CMD_WRITE_RAM_RED);
     sendData(bufferRed, bufferSize);
     
-    // Trigger display update
-    sendCommand(CMD_DISPLAY_UPDATE_CONTROL_2);
-    sendData(0xF7);  // Display mode 2 (full update)
+    // Panel will show the buffers, ghosting cleared
+    memcpy(shadowBW, bufferBW, bufferSize);
+    memcpy(shadowRed, bufferRed, bufferSize);
+    shadowValid = true;
+    partialCount = 0;
     
-    sendCommand(CMD_MASTER_ACTIVATION);
-    waitBusy();
-    
-    ESP_LOGI(TAG, "Display update complete");
+    // Trigger display update
+    activate(0xF7);  // Display mode 2 (full update)
 }
 
 
 void EPaper::sleep() {
+    finishRefresh();
+    
     sendCommand(CMD_DEEP_SLEEP_MODE);
     sendData(0x01);  // Enter deep sleep
     ESP_LOGI(TAG, "Display entering deep sleep");
@@ -423,16 +487,12 @@ void EPaper::drawPixel(int16_t x, int16_t y, uint8_t color) {
 
 
 void EPaper::drawHLine(int16_t x, int16_t y, int16_t w, uint8_t color) {
-    for (int16_t i = 0; i < w; i++) {
-        drawPixel(x + i, y, color);
-    }
+    fillRect(x, y, w, 1, color);
 }
 
 
 void EPaper::drawVLine(int16_t x, int16_t y, int16_t h, uint8_t color) {
-    for (int16_t i = 0; i < h; i++) {
-        drawPixel(x, y + i, color);
-    }
+    fillRect(x, y, 1, h, color);
 }
 
 
@@ -473,9 +533,80 @@ void EPaper::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color)
 }
 
 
+/*
+ * -----------------------------------------------------------------------------
+ * BYTE-WISE FILLS
+ * -----------------------------------------------------------------------------
+ *
+ * drawPixel() transforms every point through the rotation and changes one
+ * bit in each buffer. For rectangles that is wasted work: a rotated
+ * rectangle is still a rectangle in the buffer, so only two corners need
+ * the transform. Each buffer row is then filled a byte at a time:
+ *
+ *     bits:   ...xxxxx|████████|████████|████xxxx...
+ *             edge byte  memset   memset  edge byte
+ *             (masked)                    (masked)
+ *
+ * A full-width bar on the 122x250 panel costs 16 bytes per row instead of
+ * 122 pixel writes. drawHLine() and drawVLine() are 1-pixel-wide
+ * rectangles, so drawRect(), fillCircle() and scaled text use it too.
+ */
+
 void EPaper::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color) {
-    for (int16_t j = 0; j < h; j++) {
-        drawHLine(x, y + j, w, color);
+    if (color > EPAPER_RED) return;
+
+    // Apply offset, clip to the screen (same rules as drawPixel)
+    x += xOffset;
+    y += yOffset;
+
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > width) w = width - x;
+    if (y + h > height) h = height - y;
+    if (w <= 0 || h <= 0) return;
+
+    // Opposite corners in buffer space
+    int16_t x0, y0, x1, y1;
+    getBufferPosition(x, y, &x0, &y0);
+    getBufferPosition(x + w - 1, y + h - 1, &x1, &y1);
+
+    if (x0 > x1) { int16_t t = x0; x0 = x1; x1 = t; }
+    if (y0 > y1) { int16_t t = y0; y0 = y1; y1 = t; }
+
+    fillBufferRect(x0, y0, x1, y1, color);
+}
+
+
+void EPaper::fillBufferRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color) {
+    const uint16_t bytesPerRow = (EPAPER_WIDTH + 7) / 8;
+
+    uint8_t bwValue = (color == EPAPER_BLACK) ? 0x00 : 0xFF;
+    uint8_t redValue = (color == EPAPER_RED) ? 0xFF : 0x00;
+
+    int16_t firstByte = x0 / 8;
+    int16_t lastByte = x1 / 8;
+    uint8_t firstMask = 0xFF >> (x0 % 8);           // Bits from x0 to byte end
+    uint8_t lastMask = (uint8_t)(0xFF << (7 - x1 % 8));  // Bits up to x1
+    if (firstByte == lastByte) firstMask &= lastMask;
+
+    int16_t middle = lastByte - firstByte - 1;      // Whole bytes between edges
+
+    for (int16_t row = y0; row <= y1; row++) {
+        uint8_t* bw = bufferBW + row * bytesPerRow;
+        uint8_t* red = bufferRed + row * bytesPerRow;
+
+        bw[firstByte] = (bw[firstByte] & ~firstMask) | (bwValue & firstMask);
+        red[firstByte] = (red[firstByte] & ~firstMask) | (redValue & firstMask);
+
+        if (lastByte == firstByte) continue;
+
+        if (middle > 0) {
+            memset(bw + firstByte + 1, bwValue, middle);
+            memset(red + firstByte + 1, redValue, middle);
+        }
+
+        bw[lastByte] = (bw[lastByte] & ~lastMask) | (bwValue & lastMask);
+        red[lastByte] = (red[lastByte] & ~lastMask) | (redValue & lastMask);
     }
 }
 
@@ -531,7 +662,7 @@ void EPaper::fillCircle(int16_t cx, int16_t cy, int16_t radius, uint8_t color) {
 uint8_t EPaper::drawChar(int16_t x, int16_t y, char c, uint8_t color, uint8_t size) {
     if (c < 32 || c > 126) c = '?';
     
-    const uint8_t* charData = &font5x7[(c - 32) * 5];
+    const uint8_t* charData = &FONT_5X7[(c - 32) * 5];
     
     for (uint8_t col = 0; col < 5; col++) {
         uint8_t colData = charData[col];
@@ -698,61 +829,333 @@ void EPaper::partialUpdate(int16_t x, int16_t y, int16_t w, int16_t h) {
     if (w <= 0 || h <= 0) return;
     
     // Round X to byte boundaries (8 pixels)
-    int16_t x0 = (x / 8) * 8;
-    int16_t x1 = ((x + w + 7) / 8) * 8 - 1;
-    int16_t y0 = y;
-    int16_t y1 = y + h - 1;
-    
-    // Enter partial mode
-    sendCommand(CMD_PARTIAL_IN);
+    Window win;
+    win.x0 = x / 8;
+    win.x1 = (x + w - 1) / 8;
+    win.y0 = y;
+    win.y1 = y + h - 1;
     
-    // Set partial RAM window
-    sendCommand(CMD_SET_RAM_X_START_END);
-    sendData(x0 / 8);
-    sendData(x1 / 8);
-    
-    sendCommand(CMD_SET_RAM_Y_START_END);
-    sendData(y0 & 0xFF);
-    sendData((y0 >> 8) & 0xFF);
-    sendData(y1 & 0xFF);
-    sendData((y1 >> 8) & 0xFF);
+    finishRefresh();
+    startPartial(&win, 1);
+    finishRefresh();
     
-    // Set start position
-    sendCommand(CMD_SET_RAM_X_ADDRESS);
-    sendData(x0 / 8);
+    // Keep the shadow in step with what the panel now shows
+    uint16_t bytesPerRow = (EPAPER_WIDTH + 7) / 8;
+    uint16_t rowBytes = win.x1 - win.x0 + 1;
+    for (int16_t row = win.y0; row <= win.y1; row++) {
+        uint16_t rowOffset = row * bytesPerRow + win.x0;
+        memcpy(&shadowBW[rowOffset], &bufferBW[rowOffset], rowBytes);
+        memcpy(&shadowRed[rowOffset], &bufferRed[rowOffset], rowBytes);
+    }
+    if (partialCount < 255) partialCount++;
     
-    sendCommand(CMD_SET_RAM_Y_ADDRESS);
-    sendData(y0 & 0xFF);
-    sendData((y0 >> 8) & 0xFF);
+    ESP_LOGI(TAG, "Partial update complete");
+}
+
+
+void EPaper::writeWindow(const Window& win) {
+    setRamWindow(win.x0, win.x1, win.y0, win.y1);
     
-    // Calculate buffer region to send
     uint16_t bytesPerRow = (EPAPER_WIDTH + 7) / 8;
-    uint16_t partialBytesPerRow = (x1 - x0 + 1) / 8;
+    uint16_t rowBytes = win.x1 - win.x0 + 1;
+    uint16_t rows = win.y1 - win.y0 + 1;
+    uint16_t start = win.y0 * bytesPerRow + win.x0;
     
-    // Write B/W data for partial region
+    // Full-width windows are contiguous in the buffer: one transfer
     sendCommand(CMD_WRITE_RAM_BW);
-    for (int16_t row = y0; row <= y1; row++) {
-        uint16_t rowOffset = row * bytesPerRow + (x0 / 8);
-        sendData(&bufferBW[rowOffset], partialBytesPerRow);
+    if (rowBytes == bytesPerRow) {
+        sendData(&bufferBW[start], rowBytes * rows);
+    } else {
+        for (uint16_t i = 0; i < rows; i++) {
+            sendData(&bufferBW[start + i * bytesPerRow], rowBytes);
+        }
     }
     
-    // Write Red data for partial region
     sendCommand(CMD_WRITE_RAM_RED);
-    for (int16_t row = y0; row <= y1; row++) {
-        uint16_t rowOffset = row * bytesPerRow + (x0 / 8);
-        sendData(&bufferRed[rowOffset], partialBytesPerRow);
+    if (rowBytes == bytesPerRow) {
+        sendData(&bufferRed[start], rowBytes * rows);
+    } else {
+        for (uint16_t i = 0; i < rows; i++) {
+            sendData(&bufferRed[start + i * bytesPerRow], rowBytes);
+        }
+    }
+}
+
+
+void EPaper::startPartial(const Window* windows, int count) {
+    // Enter partial mode, left again once the waveform is done
+    sendCommand(CMD_PARTIAL_IN);
+    partialOutPending = true;
+    
+    for (int i = 0; i < count; i++) {
+        writeWindow(windows[i]);
     }
     
     // Trigger partial update (faster waveform)
+    activate(0xFF);  // Partial update mode
+}
+
+
+/*
+ * =============================================================================
+ * AUTOMATIC REFRESH
+ * =============================================================================
+ * 
+ * partialUpdate() needs the caller to know which region changed, and to
+ * count partials to schedule full refreshes against ghosting. refresh()
+ * does both itself, from a copy of what the panel shows (the shadow):
+ * 
+ *     1. Compare buffer and shadow row by row (16 bytes per row)
+ *     2. Changed rows → first/last changed byte column
+ *     3. Rows close together (≤ EPAPER_WINDOW_GAP_ROWS apart) share a window
+ * 
+ *         ┌─────────────────┐
+ *         │   ┌───┐         │ ← window 1 (clock digits)
+ *         │   └───┘         │
+ *         │                 │
+ *         │ ┌─────────────┐ │ ← window 2 (status line)
+ *         │ └─────────────┘ │
+ *         └─────────────────┘
+ * 
+ * DECISION:
+ * 
+ *     nothing changed                     → no-op (no SPI, no flash)
+ *     red changed                         → full (partial waveform
+ *                                           does not drive red well)
+ *     changed area ≥ fullAreaPercent      → full (big change, clean it up)
+ *     partialCount ≥ maxPartials          → full (ghosting)
+ *     otherwise                           → partial
+ * 
+ * All partial windows are written to display RAM first, then ONE partial
+ * waveform updates them together. The rest of RAM still holds the last
+ * image, so it stays as it is.
+ * 
+ * Cost: two more buffers (2 x 4000 bytes) for the shadow.
+ */
+
+EPaperRefresh EPaper::refresh() {
+    finishRefresh();
+    
+    EPaperRefresh result = startRefresh();
+    finishRefresh();
+    
+    return result;
+}
+
+
+EPaperRefresh EPaper::startRefresh() {
+    // Panel content unknown (just initialized): start from a clean full refresh
+    if (!shadowValid) {
+        startFull();
+        return EPAPER_REFRESH_FULL;
+    }
+    
+    Window windows[EPAPER_MAX_WINDOWS];
+    bool redChanged = false;
+    int count = findChanges(windows, &redChanged);
+    
+    if (count == 0) {
+        ESP_LOGD(TAG, "Refresh: nothing changed");
+        return EPAPER_REFRESH_NONE;
+    }
+    
+    uint32_t area = 0;
+    for (int i = 0; i < count; i++) {
+        area += (uint32_t)(windows[i].x1 - windows[i].x0 + 1) *
+                (windows[i].y1 - windows[i].y0 + 1);
+    }
+    
+    if (redChanged || partialCount >= maxPartials ||
+        area * 100 >= (uint32_t)bufferSize * fullAreaPercent) {
+        ESP_LOGI(TAG, "Refresh: full (area %lu bytes, red %d, partials %d)",
+                 (unsigned long)area, redChanged, partialCount);
+        startFull();
+        return EPAPER_REFRESH_FULL;
+    }
+    
+    ESP_LOGI(TAG, "Refresh: %d partial window(s), %lu bytes", count, (unsigned long)area);
+    
+    startPartial(windows, count);
+    
+    // Windows cover every changed byte: the panel will match the buffers
+    memcpy(shadowBW, bufferBW, bufferSize);
+    memcpy(shadowRed, bufferRed, bufferSize);
+    if (partialCount < 255) partialCount++;
+    
+    return EPAPER_REFRESH_PARTIAL;
+}
+
+
+int EPaper::findChanges(Window* windows, bool* redChanged) {
+    const int16_t bytesPerRow = (EPAPER_WIDTH + 7) / 8;
+    int count = 0;
+    
+    *redChanged = false;
+    
+    for (int16_t row = 0; row < EPAPER_HEIGHT; row++) {
+        const uint8_t* bw = bufferBW + row * bytesPerRow;
+        const uint8_t* red = bufferRed + row * bytesPerRow;
+        const uint8_t* oldBW = shadowBW + row * bytesPerRow;
+        const uint8_t* oldRed = shadowRed + row * bytesPerRow;
+        
+        bool bwDiff = memcmp(bw, oldBW, bytesPerRow) != 0;
+        bool redDiff = memcmp(red, oldRed, bytesPerRow) != 0;
+        if (!bwDiff && !redDiff) continue;
+        if (redDiff) *redChanged = true;
+        
+        // First/last changed byte column of this row
+        int16_t first = 0;
+        while (bw[first] == oldBW[first] && red[first] == oldRed[first]) first++;
+        int16_t last = bytesPerRow - 1;
+        while (bw[last] == oldBW[last] && red[last] == oldRed[last]) last--;
+        
+        Window* win = count > 0 ? &windows[count - 1] : nullptr;
+        
+        if (win && (row - win->y1 - 1 <= EPAPER_WINDOW_GAP_ROWS || count == EPAPER_MAX_WINDOWS)) {
+            // Close to the last window (or out of windows): grow it
+            win->y1 = row;
+            if (first < win->x0) win->x0 = first;
+            if (last > win->x1) win->x1 = last;
+        } else {
+            windows[count].x0 = first;
+            windows[count].x1 = last;
+            windows[count].y0 = row;
+            windows[count].y1 = row;
+            count++;
+        }
+    }
+    
+    return count;
+}
+
+
+void EPaper::setRefreshPolicy(uint8_t fullAreaPercent, uint8_t maxPartials) {
+    this->fullAreaPercent = fullAreaPercent;
+    this->maxPartials = maxPartials;
+    ESP_LOGI(TAG, "Refresh policy: full at %d%% changed or after %d partials",
+             fullAreaPercent, maxPartials);
+}
+
+
+/*
+ * =============================================================================
+ * ASYNCHRONOUS REFRESH
+ * =============================================================================
+ * 
+ * A refresh has two parts with very different durations:
+ * 
+ *     SPI: buffers → display RAM       ~20 ms at 4 MHz (8000 bytes)
+ *     Waveform: particles move         0.3 sec (partial) to 2+ sec (full)
+ * 
+ * During the waveform the controller holds BUSY high and the ESP32 has
+ * nothing to do. The blocking calls poll BUSY every 10 ms; the async
+ * calls return right after the SPI part:
+ * 
+ *     updateAsync()  ─ SPI ─┐
+ *                           │ returns, task keeps running
+ *     BUSY          ________│‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾\______
+ *                                                               │
+ *                                          ISR: refreshing = false,
+ *                                          EPAPER_EVENT_READY, callback
+ * 
+ * RULES WHILE BUSY:
+ *     - Drawing into the buffers is fine: the frame already sits in
+ *       display RAM, the buffers are only read again at the next refresh
+ *     - Async calls are rejected (return false)
+ *     - Blocking calls (update, refresh, partialUpdate, sleep) first wait
+ *       for the running refresh to finish
+ * 
+ * Partial refreshes leave partial mode (CMD_PARTIAL_OUT) at the start of
+ * the next call, since no command can be sent from the ISR.
+ */
+
+bool EPaper::updateAsync() {
+    if (!busyIsrReady || refreshing) return false;
+    
+    finishRefresh();
+    startFull();
+    return true;
+}
+
+
+bool EPaper::refreshAsync(EPaperRefresh* result) {
+    if (!busyIsrReady || refreshing) return false;
+    
+    finishRefresh();
+    EPaperRefresh started = startRefresh();
+    if (result) *result = started;
+    return true;
+}
+
+
+bool EPaper::waitReady(TickType_t timeout) {
+    if (!refreshing) return true;
+    if (!busyIsrReady) return false;
+    
+    xEventGroupWaitBits(readyEvents, EPAPER_EVENT_READY, pdFALSE, pdTRUE, timeout);
+    return !refreshing;
+}
+
+
+void EPaper::setReadyCallback(EPaperReadyCallback callback, void* arg) {
+    readyCallback = callback;
+    readyCallbackArg = arg;
+}
+
+
+void EPaper::activate(uint8_t mode) {
     sendCommand(CMD_DISPLAY_UPDATE_CONTROL_2);
-    sendData(0xFF);  // Partial update mode
+    sendData(mode);
+    
+    // Busy BEFORE the waveform starts: the BUSY edge can't come earlier
+    if (readyEvents) xEventGroupClearBits(readyEvents, EPAPER_EVENT_READY);
+    refreshing = true;
     
     sendCommand(CMD_MASTER_ACTIVATION);
-    vTaskDelay(pdMS_TO_TICKS(10));
-    waitBusy();
+}
+
+
+void EPaper::finishRefresh() {
+    while (refreshing) {
+        if (!busyIsrReady) {
+            vTaskDelay(pdMS_TO_TICKS(10));  // Let BUSY rise before polling it
+            waitBusy();
+            refreshing = false;
+            break;
+        }
+        
+        EventBits_t bits = xEventGroupWaitBits(readyEvents, EPAPER_EVENT_READY, pdFALSE, pdTRUE,
+                                               pdMS_TO_TICKS(EPAPER_REFRESH_TIMEOUT_MS));
+        if (!(bits & EPAPER_EVENT_READY)) {
+            // Edge lost (noise, wrong pin): fall back to the BUSY level
+            ESP_LOGW(TAG, "No BUSY edge after %d ms, polling", EPAPER_REFRESH_TIMEOUT_MS);
+            waitBusy();
+            refreshing = false;
+            xEventGroupSetBits(readyEvents, EPAPER_EVENT_READY);
+        } else if (refreshing) {
+            // Bit still set by the previous refresh (ISR bits arrive late)
+            vTaskDelay(1);
+        }
+    }
     
-    // Exit partial mode
-    sendCommand(CMD_PARTIAL_OUT);
+    if (partialOutPending) {
+        sendCommand(CMD_PARTIAL_OUT);
+        partialOutPending = false;
+    }
+}
+
+
+void IRAM_ATTR EPaper::busyIsr(void* arg) {
+    EPaper* epd = static_cast<EPaper*>(arg);
     
-    ESP_LOGI(TAG, "Partial update complete");
+    // Edges outside a refresh (init, reset) are not ours
+    if (!epd->refreshing) return;
+    epd->refreshing = false;
+    
+    BaseType_t woken = pdFALSE;
+    xEventGroupSetBitsFromISR(epd->readyEvents, EPAPER_EVENT_READY, &woken);
+    
+    if (epd->readyCallback) epd->readyCallback(epd->readyCallbackArg);
+    
+    portYIELD_FROM_ISR(woken);
 }
@@ -84,6 +84,10 @@
  *         sendCommand(...);
  *         waitBusy();        // Wait for display to finish
  *         sendCommand(...);
+ *     
+ *     The driver also watches BUSY with an interrupt: updateAsync() and
+ *     refreshAsync() return right away and the falling edge of BUSY
+ *     reports the end of the refresh (event group bit or callback).
  * 
  * =============================================================================
  * FRAME BUFFER
@@ -154,6 +158,8 @@
 
 #include <driver/spi_master.h>
 #include <driver/gpio.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -173,6 +179,41 @@
 #define EPAPER_RED      2
 
 
+/**
+ * @brief Result of EPaper::refresh()
+ */
+enum EPaperRefresh {
+    EPAPER_REFRESH_NONE,        // Buffers match the panel, nothing sent
+    EPAPER_REFRESH_PARTIAL,     // Changed windows sent, fast waveform
+    EPAPER_REFRESH_FULL         // Whole panel, full waveform
+};
+
+
+/**
+ * @brief Default refresh() policy
+ */
+#define EPAPER_FULL_AREA_PERCENT    40      // Changed area that forces a full refresh
+#define EPAPER_MAX_PARTIALS         10      // Partial refreshes before a full one
+#define EPAPER_MAX_WINDOWS          4       // Partial windows per refresh
+#define EPAPER_WINDOW_GAP_ROWS      8       // Unchanged rows merged into a window
+
+
+/**
+ * @brief Asynchronous refresh
+ */
+#define EPAPER_EVENT_READY          BIT0    // Event group bit: no refresh running
+#define EPAPER_REFRESH_TIMEOUT_MS   20000   // Longest refresh before falling back to polling
+
+
+/**
+ * @brief Called when a refresh finishes (BUSY falling edge).
+ *
+ * @warning Runs in ISR context: keep it short, IRAM-safe, no logging.
+ *          Typical use: xTaskNotifyFromISR() or xSemaphoreGiveFromISR().
+ */
+typedef void (*EPaperReadyCallback)(void* arg);
+
+
 /**
  * @class EPaper
  * @brief E-Paper display driver over SPI.
@@ -184,6 +225,7 @@
  * - Drawing primitives
  * - Text rendering
  * - Full and partial refresh
+ * - Automatic refresh from buffer changes (refresh())
  */
 class EPaper {
 
@@ -235,6 +277,118 @@ public:
     void update();
 
 
+    /**
+     * @brief Send only what changed since the last refresh.
+     *
+     * @return What was done: nothing, a partial or a full refresh.
+     *
+     * @details
+     * Compares the frame buffers with a copy of what the panel shows and
+     * picks the cheapest refresh on its own:
+     * - nothing changed → no SPI traffic at all
+     * - small changes → up to EPAPER_MAX_WINDOWS partial windows, one
+     *   fast waveform (~0.3 sec)
+     * - large changes, red changes, or too many partials in a row
+     *   (ghosting) → full update()
+     *
+     * @par Example:
+     * @code
+     *     while (true) {
+     *         display.fillRect(10, 100, 100, 30, EPAPER_WHITE);
+     *         display.drawString(10, 100, getTimeString(), EPAPER_BLACK);
+     *         display.refresh();   // No region, no counter to manage
+     *         vTaskDelay(pdMS_TO_TICKS(60000));
+     *     }
+     * @endcode
+     */
+    EPaperRefresh refresh();
+
+
+    /**
+     * @brief Start a full update and return without waiting (~2 sec refresh).
+     *
+     * @return false if a refresh is still running (or no BUSY interrupt).
+     *
+     * @details
+     * The buffers are sent to display RAM before this returns; only the
+     * waveform runs in the background. Drawing the next frame into the
+     * buffers right away is safe.
+     *
+     * Completion: EPAPER_EVENT_READY in getEventGroup(), the callback of
+     * setReadyCallback(), or isBusy() going false.
+     */
+    bool updateAsync();
+
+
+    /**
+     * @brief Like refresh(), but returns as soon as the waveform started.
+     *
+     * @param result Optional: what was started (EPAPER_REFRESH_NONE =
+     *               nothing changed, nothing to wait for).
+     *
+     * @return false if a refresh is still running (or no BUSY interrupt).
+     *
+     * @par Example:
+     * @code
+     *     display.drawString(10, 100, getTimeString(), EPAPER_BLACK);
+     *     display.refreshAsync();
+     *     
+     *     // Task keeps polling encoders/radio while the panel refreshes
+     *     while (display.isBusy()) {
+     *         handleInputs();
+     *         vTaskDelay(pdMS_TO_TICKS(20));
+     *     }
+     * @endcode
+     */
+    bool refreshAsync(EPaperRefresh* result = nullptr);
+
+
+    /**
+     * @brief Check if a refresh waveform is still running.
+     */
+    bool isBusy() const { return refreshing; }
+
+
+    /**
+     * @brief Block until the running refresh (if any) finishes.
+     *
+     * @param timeout Max ticks to wait.
+     *
+     * @return true if no refresh is running anymore.
+     */
+    bool waitReady(TickType_t timeout = portMAX_DELAY);
+
+
+    /**
+     * @brief Set a function called when each refresh finishes.
+     *
+     * @param callback Function, ISR context (nullptr = none).
+     * @param arg Passed to the callback.
+     */
+    void setReadyCallback(EPaperReadyCallback callback, void* arg = nullptr);
+
+
+    /**
+     * @brief Event group with EPAPER_EVENT_READY (set while idle).
+     */
+    EventGroupHandle_t getEventGroup() const { return readyEvents; }
+
+
+    /**
+     * @brief Tune when refresh() falls back to a full update.
+     *
+     * @param fullAreaPercent Changed area (% of the panel) that forces a full refresh.
+     * @param maxPartials Partial refreshes in a row before a full one (ghosting).
+     */
+    void setRefreshPolicy(uint8_t fullAreaPercent, uint8_t maxPartials);
+
+
+    /**
+     * @brief Partial refreshes since the last full one.
+     */
+    uint8_t getPartialCount() const { return partialCount; }
+
+
     /**
      * @brief Put display into deep sleep mode.
      *
@@ -390,6 +544,8 @@ public:
      *         display.update();
      *     }
      * @endcode
+     *
+     * @note refresh() finds the changed region and counts partials itself.
      */
     void partialUpdate(int16_t x, int16_t y, int16_t w, int16_t h);
 
@@ -420,7 +576,30 @@ private:
 
     uint8_t* bufferBW;      // Black/White buffer
     uint8_t* bufferRed;     // Red buffer
+    uint8_t* shadowBW;      // What the panel shows (last refresh)
+    uint8_t* shadowRed;
     uint16_t bufferSize;
+    bool shadowValid;       // false until the first full update
+
+    uint8_t partialCount;       // Partial refreshes since the last full one
+    uint8_t fullAreaPercent;    // refresh(): area that forces a full refresh
+    uint8_t maxPartials;        // refresh(): ghosting limit
+
+    volatile bool refreshing;       // Waveform running (cleared by BUSY ISR)
+    bool partialOutPending;         // Partial mode still to be left
+    bool busyIsrReady;              // BUSY interrupt installed (async allowed)
+    EventGroupHandle_t readyEvents; // EPAPER_EVENT_READY
+    EPaperReadyCallback readyCallback;
+    void* readyCallbackArg;
+
+
+    /**
+     * @brief Changed region in buffer space (byte columns, rows).
+     */
+    struct Window {
+        int16_t x0, x1;     // First/last byte column
+        int16_t y0, y1;     // First/last row
+    };
 
     uint8_t rotation;
     uint16_t width;
@@ -448,6 +627,69 @@ private:
     void sendData(const uint8_t* data, size_t len);
 
 
+    /**
+     * @brief Set the RAM window (byte columns, rows) and move the address there.
+     */
+    void setRamWindow(int16_t x0, int16_t x1, int16_t y0, int16_t y1);
+
+
+    /**
+     * @brief Send one window of both buffers to display RAM.
+     */
+    void writeWindow(const Window& win);
+
+
+    /**
+     * @brief Start a waveform (0xF7 full, 0xFF partial) and mark the display busy.
+     */
+    void activate(uint8_t mode);
+
+
+    /**
+     * @brief Send both buffers and start a full refresh (no wait).
+     */
+    void startFull();
+
+
+    /**
+     * @brief Send the windows and start one partial refresh (no wait).
+     */
+    void startPartial(const Window* windows, int count);
+
+
+    /**
+     * @brief Pick and start the refresh for refresh()/refreshAsync() (no wait).
+     */
+    EPaperRefresh startRefresh();
+
+
+    /**
+     * @brief Wait for a running refresh, then leave partial mode if needed.
+     *
+     * @details
+     * Called before every command sequence: the controller must not get
+     * commands while BUSY is high.
+     */
+    void finishRefresh();
+
+
+    /**
+     * @brief BUSY falling edge: refresh done.
+     */
+    static void busyIsr(void* arg);
+
+
+    /**
+     * @brief Find the rows/columns that differ from the shadow buffers.
+     *
+     * @param windows Output, up to EPAPER_MAX_WINDOWS entries.
+     * @param redChanged Set to true if the red buffer differs anywhere.
+     *
+     * @return Number of windows (0 = nothing changed).
+     */
+    int findChanges(Window* windows, bool* redChanged);
+
+
     /**
      * @brief Wait for BUSY pin to go low.
      */
@@ -464,4 +706,14 @@ private:
      * @brief Convert x,y to buffer position based on rotation.
      */
     void getBufferPosition(int16_t x, int16_t y, int16_t* bufX, int16_t* bufY);
+
+
+    /**
+     * @brief Fill a rectangle given in buffer coordinates (clipped, x0 <= x1, y0 <= y1).
+     *
+     * @details
+     * Edge bytes are masked, whole bytes in between are memset, in both
+     * bufferBW and bufferRed.
+     */
+    void fillBufferRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color);
 };
@@ -1,16 +1,18 @@
 /**
  * @file gc9a01.cpp
- * @brief GC9A01 round TFT display driver implementation (ESP-IDF).
+ * @brief GC9A01 TFT display driver implementation (ESP-IDF).
  *
  * @details
- * Implements SPI communication and drawing primitives for GC9A01.
+ * Implements the GC9A01 init sequence and panel-specific features.
+ * SPI transport and drawing primitives live in shared/rgb565_display.h.
  */
 
 #include "gc9a01.h"
 #include <esp_log.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
-#include "font_5x7.h"
+#include <math.h>
+
 
 static const char* TAG = "GC9A01";
 
@@ -39,6 +41,71 @@ static const char* TAG = "GC9A01";
 #define GC9A01_COLMOD       0x3A    // Pixel format
 
 
+/*
+ * =============================================================================
+ * INITIALIZATION TABLE
+ * =============================================================================
+ * 
+ * Format: command, argc [| DISPLAY_INIT_DELAY], args..., [delay ms]
+ * (see shared/rgb565_display.h)
+ */
+const uint8_t GC9A01Panel::INIT_TABLE[] = {
+    // Enable inter-register access
+    0xEF, 0,
+    0xEB, 1, 0x14,
+    0xFE, 0,                                    // Inter-register enable 1
+    0xEF, 0,                                    // Inter-register enable 2
+    0xEB, 1, 0x14,
+    0x84, 1, 0x40,
+    0x85, 1, 0xFF,
+    0x86, 1, 0xFF,
+    0x87, 1, 0xFF,
+    0x88, 1, 0x0A,
+    0x89, 1, 0x21,
+    0x8A, 1, 0x00,
+    0x8B, 1, 0x80,
+    0x8C, 1, 0x01,
+    0x8D, 1, 0x01,
+    0x8E, 1, 0xFF,
+    0x8F, 1, 0xFF,
+    0xB6, 2, 0x00, 0x00,                        // Display function control
+    GC9A01_MADCTL, 1, 0x48,                     // Memory access control
+    GC9A01_COLMOD, 1, 0x05,                     // Pixel format: 16-bit RGB565
+    0x90, 4, 0x08, 0x08, 0x08, 0x08,
+    0xBD, 1, 0x06,
+    0xBC, 1, 0x00,
+    0xFF, 3, 0x60, 0x01, 0x04,
+    0xC3, 1, 0x13,                              // Voltage regulator 1a
+    0xC4, 1, 0x13,                              // Voltage regulator 1b
+    0xC9, 1, 0x22,                              // Voltage regulator 2a
+    0xBE, 1, 0x11,
+    0xE1, 2, 0x10, 0x0E,
+    0xDF, 3, 0x21, 0x0C, 0x02,
+    // Gamma settings
+    0xF0, 6, 0x45, 0x09, 0x08, 0x08, 0x26, 0x2A,
+    0xF1, 6, 0x43, 0x70, 0x72, 0x36, 0x37, 0x6F,
+    0xF2, 6, 0x45, 0x09, 0x08, 0x08, 0x26, 0x2A,
+    0xF3, 6, 0x43, 0x70, 0x72, 0x36, 0x37, 0x6F,
+    0xED, 2, 0x1B, 0x0B,
+    0xAE, 1, 0x77,
+    0xCD, 1, 0x63,
+    0x70, 9, 0x07, 0x07, 0x04, 0x0E, 0x0F, 0x09, 0x07, 0x08, 0x03,
+    0xE8, 1, 0x34,
+    0x62, 12, 0x18, 0x0D, 0x71, 0xED, 0x70, 0x70, 0x18, 0x0F, 0x71, 0xEF, 0x70, 0x70,
+    0x63, 12, 0x18, 0x11, 0x71, 0xF1, 0x70, 0x70, 0x18, 0x13, 0x71, 0xF3, 0x70, 0x70,
+    0x64, 7, 0x28, 0x29, 0xF1, 0x01, 0xF1, 0x00, 0x07,
+    0x66, 10, 0x3C, 0x00, 0xCD, 0x67, 0x45, 0x45, 0x10, 0x00, 0x00, 0x00,
+    0x67, 10, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x01, 0x54, 0x10, 0x32, 0x98,
+    0x74, 7, 0x10, 0x85, 0x80, 0x00, 0x00, 0x4E, 0x00,
+    0x98, 2, 0x3E, 0x07,
+    0x35, 0,                                    // Tearing effect line on
+    GC9A01_INVON, 0,                            // Inversion on (looks better on most panels)
+    GC9A01_SLPOUT, DISPLAY_INIT_DELAY, 120,     // Sleep out
+    GC9A01_DISPON, DISPLAY_INIT_DELAY, 20,      // Display on
+    0x00, DISPLAY_INIT_END
+};
+
+
 /*
  * =============================================================================
  * CONSTRUCTOR
@@ -47,36 +114,17 @@ static const char* TAG = "GC9A01";
 GC9A01::GC9A01(gpio_num_t mosiPin, gpio_num_t sckPin, gpio_num_t csPin,
                gpio_num_t dcPin, gpio_num_t rstPin, gpio_num_t blkPin,
                spi_host_device_t spiHost)
-    : mosiPin(mosiPin),
+    : Rgb565Display(dcPin, rstPin, spiHost),
+      mosiPin(mosiPin),
       sckPin(sckPin),
       csPin(csPin),
-      dcPin(dcPin),
-      rstPin(rstPin),
       blkPin(blkPin),
-      spiHost(spiHost),
-      spiDevice(nullptr),
-      initialized(false),
-      rotation(0),
-      width(GC9A01_WIDTH),
-      height(GC9A01_HEIGHT),
-      partialMode(false)
+      partialMode(false),
+      roundMode(false)
 {
 }
 
 
-/*
- * =============================================================================
- * DESTRUCTOR
- * =============================================================================
- */
-GC9A01::~GC9A01() {
-    if (initialized && spiDevice) {
-        spi_bus_remove_device(spiDevice);
-        // Don't free bus - might be shared with other displays
-    }
-}
-
-
 /*
  * =============================================================================
  * INITIALIZATION
@@ -88,25 +136,12 @@ bool GC9A01::init() {
 
     /*
      * -------------------------------------------------------------------------
-     * STEP 1: Configure control pins (DC, RST, BLK)
+     * STEP 1: Backlight pin
      * -------------------------------------------------------------------------
      */
-    gpio_config_t io_conf = {};
-    io_conf.mode = GPIO_MODE_OUTPUT;
-    io_conf.pull_up_en = GPIO_PULLUP_DISABLE;
-    io_conf.pull_down_en = GPIO_PULLDOWN_DISABLE;
-    io_conf.intr_type = GPIO_INTR_DISABLE;
-
-    // DC pin
-    io_conf.pin_bit_mask = (1ULL << dcPin);
-    gpio_config(&io_conf);
-
-    // RST pin
-    io_conf.pin_bit_mask = (1ULL << rstPin);
-    gpio_config(&io_conf);
-
-    // BLK pin (if specified)
     if (blkPin != GPIO_NUM_NC) {
+        gpio_config_t io_conf = {};
+        io_conf.mode = GPIO_MODE_OUTPUT;
         io_conf.pin_bit_mask = (1ULL << blkPin);
         gpio_config(&io_conf);
         gpio_set_level(blkPin, 1);  // Backlight on
@@ -114,293 +149,30 @@ bool GC9A01::init() {
 
     /*
      * -------------------------------------------------------------------------
-     * STEP 2: Configure SPI bus
-     * -------------------------------------------------------------------------
-     */
-    spi_bus_config_t busConfig = {};
-    busConfig.mosi_io_num = mosiPin;
-    busConfig.miso_io_num = -1;         // Not used
-    busConfig.sclk_io_num = sckPin;
-    busConfig.quadwp_io_num = -1;
-    busConfig.quadhd_io_num = -1;
-    busConfig.max_transfer_sz = 240 * 240 * 2 + 8;  // Full screen + overhead
-
-    esp_err_t err = spi_bus_initialize(spiHost, &busConfig, SPI_DMA_CH_AUTO);
-    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
-        ESP_LOGE(TAG, "SPI bus init failed: %s", esp_err_to_name(err));
-        return false;
-    }
-    // ESP_ERR_INVALID_STATE means bus already initialized - that's OK for shared bus
-
-    /*
-     * -------------------------------------------------------------------------
-     * STEP 3: Add SPI device
+     * STEP 2: DC/RST pins, SPI bus (no MISO), SPI device and DMA buffers
      * -------------------------------------------------------------------------
+     * 
+     * The bus may already be initialized by another display - that's OK.
      */
-    spi_device_interface_config_t devConfig = {};
-    devConfig.clock_speed_hz = 40 * 1000 * 1000;    // 40 MHz
-    devConfig.mode = 0;                              // SPI mode 0
-    devConfig.spics_io_num = csPin;
-    devConfig.queue_size = 7;
-
-    err = spi_bus_add_device(spiHost, &devConfig, &spiDevice);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "SPI device add failed: %s", esp_err_to_name(err));
-        spi_bus_free(spiHost);
+    if (!beginSpi(mosiPin, GPIO_NUM_NC, sckPin, csPin)) {
         return false;
     }
 
     /*
      * -------------------------------------------------------------------------
-     * STEP 4: Hardware reset
+     * STEP 3: Hardware reset
      * -------------------------------------------------------------------------
      */
     hardwareReset();
 
     /*
      * -------------------------------------------------------------------------
-     * STEP 5: Send initialization sequence
+     * STEP 4: Send initialization sequence
      * -------------------------------------------------------------------------
      * 
      * This is the magic sequence from the GC9A01 datasheet/reference code.
      */
-    
-    // Enable inter-register access
-    sendCommand(0xEF);
-    
-    sendCommand(0xEB);
-    sendData(0x14);
-    
-    sendCommand(0xFE);  // Inter-register enable 1
-    sendCommand(0xEF);  // Inter-register enable 2
-    
-    sendCommand(0xEB);
-    sendData(0x14);
-    
-    sendCommand(0x84);
-    sendData(0x40);
-    
-    sendCommand(0x85);
-    sendData(0xFF);
-    
-    sendCommand(0x86);
-    sendData(0xFF);
-    
-    sendCommand(0x87);
-    sendData(0xFF);
-    
-    sendCommand(0x88);
-    sendData(0x0A);
-    
-    sendCommand(0x89);
-    sendData(0x21);
-    
-    sendCommand(0x8A);
-    sendData(0x00);
-    
-    sendCommand(0x8B);
-    sendData(0x80);
-    
-    sendCommand(0x8C);
-    sendData(0x01);
-    
-    sendCommand(0x8D);
-    sendData(0x01);
-    
-    sendCommand(0x8E);
-    sendData(0xFF);
-    
-    sendCommand(0x8F);
-    sendData(0xFF);
-    
-    sendCommand(0xB6);      // Display function control
-    sendData(0x00);
-    sendData(0x00);
-    
-    sendCommand(GC9A01_MADCTL);  // Memory access control
-    sendData(0x48);
-    
-    sendCommand(GC9A01_COLMOD);  // Pixel format
-    sendData(0x05);              // 16-bit RGB565
-    
-    sendCommand(0x90);
-    sendData(0x08);
-    sendData(0x08);
-    sendData(0x08);
-    sendData(0x08);
-    
-    sendCommand(0xBD);
-    sendData(0x06);
-    
-    sendCommand(0xBC);
-    sendData(0x00);
-    
-    sendCommand(0xFF);
-    sendData(0x60);
-    sendData(0x01);
-    sendData(0x04);
-    
-    sendCommand(0xC3);      // Voltage regulator 1a
-    sendData(0x13);
-    
-    sendCommand(0xC4);      // Voltage regulator 1b
-    sendData(0x13);
-    
-    sendCommand(0xC9);      // Voltage regulator 2a
-    sendData(0x22);
-    
-    sendCommand(0xBE);
-    sendData(0x11);
-    
-    sendCommand(0xE1);
-    sendData(0x10);
-    sendData(0x0E);
-    
-    sendCommand(0xDF);
-    sendData(0x21);
-    sendData(0x0C);
-    sendData(0x02);
-    
-    // Gamma settings
-    sendCommand(0xF0);
-    sendData(0x45);
-    sendData(0x09);
-    sendData(0x08);
-    sendData(0x08);
-    sendData(0x26);
-    sendData(0x2A);
-    
-    sendCommand(0xF1);
-    sendData(0x43);
-    sendData(0x70);
-    sendData(0x72);
-    sendData(0x36);
-    sendData(0x37);
-    sendData(0x6F);
-    
-    sendCommand(0xF2);
-    sendData(0x45);
-    sendData(0x09);
-    sendData(0x08);
-    sendData(0x08);
-    sendData(0x26);
-    sendData(0x2A);
-    
-    sendCommand(0xF3);
-    sendData(0x43);
-    sendData(0x70);
-    sendData(0x72);
-    sendData(0x36);
-    sendData(0x37);
-    sendData(0x6F);
-    
-    sendCommand(0xED);
-    sendData(0x1B);
-    sendData(0x0B);
-    
-    sendCommand(0xAE);
-    sendData(0x77);
-    
-    sendCommand(0xCD);
-    sendData(0x63);
-    
-    sendCommand(0x70);
-    sendData(0x07);
-    sendData(0x07);
-    sendData(0x04);
-    sendData(0x0E);
-    sendData(0x0F);
-    sendData(0x09);
-    sendData(0x07);
-    sendData(0x08);
-    sendData(0x03);
-    
-    sendCommand(0xE8);
-    sendData(0x34);
-    
-    sendCommand(0x62);
-    sendData(0x18);
-    sendData(0x0D);
-    sendData(0x71);
-    sendData(0xED);
-    sendData(0x70);
-    sendData(0x70);
-    sendData(0x18);
-    sendData(0x0F);
-    sendData(0x71);
-    sendData(0xEF);
-    sendData(0x70);
-    sendData(0x70);
-    
-    sendCommand(0x63);
-    sendData(0x18);
-    sendData(0x11);
-    sendData(0x71);
-    sendData(0xF1);
-    sendData(0x70);
-    sendData(0x70);
-    sendData(0x18);
-    sendData(0x13);
-    sendData(0x71);
-    sendData(0xF3);
-    sendData(0x70);
-    sendData(0x70);
-    
-    sendCommand(0x64);
-    sendData(0x28);
-    sendData(0x29);
-    sendData(0xF1);
-    sendData(0x01);
-    sendData(0xF1);
-    sendData(0x00);
-    sendData(0x07);
-    
-    sendCommand(0x66);
-    sendData(0x3C);
-    sendData(0x00);
-    sendData(0xCD);
-    sendData(0x67);
-    sendData(0x45);
-    sendData(0x45);
-    sendData(0x10);
-    sendData(0x00);
-    sendData(0x00);
-    sendData(0x00);
-    
-    sendCommand(0x67);
-    sendData(0x00);
-    sendData(0x3C);
-    sendData(0x00);
-    sendData(0x00);
-    sendData(0x00);
-    sendData(0x01);
-    sendData(0x54);
-    sendData(0x10);
-    sendData(0x32);
-    sendData(0x98);
-    
-    sendCommand(0x74);
-    sendData(0x10);
-    sendData(0x85);
-    sendData(0x80);
-    sendData(0x00);
-    sendData(0x00);
-    sendData(0x4E);
-    sendData(0x00);
-    
-    sendCommand(0x98);
-    sendData(0x3E);
-    sendData(0x07);
-    
-    sendCommand(0x35);      // Tearing effect line on
-    
-    sendCommand(GC9A01_INVON);  // Inversion on (looks better on most panels)
-    
-    sendCommand(GC9A01_SLPOUT); // Sleep out
-    vTaskDelay(pdMS_TO_TICKS(120));
-    
-    sendCommand(GC9A01_DISPON); // Display on
-    vTaskDelay(pdMS_TO_TICKS(20));
+    runInitTable(GC9A01Panel::INIT_TABLE);
 
     initialized = true;
 
@@ -412,346 +184,6 @@ bool GC9A01::init() {
 }
 
 
-/*
- * =============================================================================
- * LOW-LEVEL SPI FUNCTIONS
- * =============================================================================
- */
-
-void GC9A01::hardwareReset() {
-    gpio_set_level(rstPin, 1);
-    vTaskDelay(pdMS_TO_TICKS(10));
-    gpio_set_level(rstPin, 0);
-    vTaskDelay(pdMS_TO_TICKS(10));
-    gpio_set_level(rstPin, 1);
-    vTaskDelay(pdMS_TO_TICKS(120));
-}
-
-
-void GC9A01::sendCommand(uint8_t cmd) {
-    gpio_set_level(dcPin, 0);  // Command mode
-    
-    spi_transaction_t trans = {};
-    trans.length = 8;
-    trans.tx_buffer = &cmd;
-    spi_device_polling_transmit(spiDevice, &trans);
-}
-
-
-void GC9A01::sendData(uint8_t data) {
-    gpio_set_level(dcPin, 1);  // Data mode
-    
-    spi_transaction_t trans = {};
-    trans.length = 8;
-    trans.tx_buffer = &data;
-    spi_device_polling_transmit(spiDevice, &trans);
-}
-
-
-void GC9A01::sendData(const uint8_t* data, size_t len) {
-    if (len == 0) return;
-    
-    gpio_set_level(dcPin, 1);  // Data mode
-    
-    spi_transaction_t trans = {};
-    trans.length = len * 8;
-    trans.tx_buffer = data;
-    spi_device_polling_transmit(spiDevice, &trans);
-}
-
-
-void GC9A01::sendData16(uint16_t data) {
-    uint8_t buf[2] = {(uint8_t)(data >> 8), (uint8_t)(data & 0xFF)};
-    sendData(buf, 2);
-}
-
-
-void GC9A01::setWindow(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
-    sendCommand(GC9A01_CASET);  // Column address
-    sendData16(x0);
-    sendData16(x1);
-    
-    sendCommand(GC9A01_RASET);  // Row address
-    sendData16(y0);
-    sendData16(y1);
-    
-    sendCommand(GC9A01_RAMWR);  // Memory write
-}
-
-
-/*
- * =============================================================================
- * DRAWING FUNCTIONS
- * =============================================================================
- */
-
-void GC9A01::fillScreen(uint16_t color) {
-    fillRect(0, 0, width, height, color);
-}
-
-
-void GC9A01::drawPixel(int16_t x, int16_t y, uint16_t color) {
-    if (x < 0 || x >= width || y < 0 || y >= height) return;
-    
-    setWindow(x, y, x, y);
-    sendData16(color);
-}
-
-
-void GC9A01::drawHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
-    if (y < 0 || y >= height || x >= width) return;
-    if (x < 0) { w += x; x = 0; }
-    if (x + w > width) w = width - x;
-    if (w <= 0) return;
-    
-    setWindow(x, y, x + w - 1, y);
-    
-    uint8_t hi = color >> 8;
-    uint8_t lo = color & 0xFF;
-    
-    gpio_set_level(dcPin, 1);
-    
-    // Send pixels in chunks for efficiency
-    uint8_t buf[64];
-    int bufIdx = 0;
-    
-    for (int i = 0; i < w; i++) {
-        buf[bufIdx++] = hi;
-        buf[bufIdx++] = lo;
-        
-        if (bufIdx >= 64) {
-            spi_transaction_t trans = {};
-            trans.length = bufIdx * 8;
-            trans.tx_buffer = buf;
-            spi_device_polling_transmit(spiDevice, &trans);
-            bufIdx = 0;
-        }
-    }
-    
-    if (bufIdx > 0) {
-        spi_transaction_t trans = {};
-        trans.length = bufIdx * 8;
-        trans.tx_buffer = buf;
-        spi_device_polling_transmit(spiDevice, &trans);
-    }
-}
-
-
-void GC9A01::drawVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
-    if (x < 0 || x >= width || y >= height) return;
-    if (y < 0) { h += y; y = 0; }
-    if (y + h > height) h = height - y;
-    if (h <= 0) return;
-    
-    setWindow(x, y, x, y + h - 1);
-    
-    uint8_t hi = color >> 8;
-    uint8_t lo = color & 0xFF;
-    
-    gpio_set_level(dcPin, 1);
-    
-    uint8_t buf[64];
-    int bufIdx = 0;
-    
-    for (int i = 0; i < h; i++) {
-        buf[bufIdx++] = hi;
-        buf[bufIdx++] = lo;
-        
-        if (bufIdx >= 64) {
-            spi_transaction_t trans = {};
-            trans.length = bufIdx * 8;
-            trans.tx_buffer = buf;
-            spi_device_polling_transmit(spiDevice, &trans);
-            bufIdx = 0;
-        }
-    }
-    
-    if (bufIdx > 0) {
-        spi_transaction_t trans = {};
-        trans.length = bufIdx * 8;
-        trans.tx_buffer = buf;
-        spi_device_polling_transmit(spiDevice, &trans);
-    }
-}
-
-
-void GC9A01::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
-    // Special cases for horizontal/vertical lines
-    if (y0 == y1) {
-        if (x0 > x1) { int16_t t = x0; x0 = x1; x1 = t; }
-        drawHLine(x0, y0, x1 - x0 + 1, color);
-        return;
-    }
-    if (x0 == x1) {
-        if (y0 > y1) { int16_t t = y0; y0 = y1; y1 = t; }
-        drawVLine(x0, y0, y1 - y0 + 1, color);
-        return;
-    }
-
-    // Bresenham's line algorithm
-    int16_t dx = abs(x1 - x0);
-    int16_t dy = abs(y1 - y0);
-    int16_t sx = (x0 < x1) ? 1 : -1;
-    int16_t sy = (y0 < y1) ? 1 : -1;
-    int16_t err = dx - dy;
-
-    while (true) {
-        drawPixel(x0, y0, color);
-        
-        if (x0 == x1 && y0 == y1) break;
-        
-        int16_t e2 = 2 * err;
-        if (e2 > -dy) { err -= dy; x0 += sx; }
-        if (e2 < dx) { err += dx; y0 += sy; }
-    }
-}
-
-
-void GC9A01::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
-    drawHLine(x, y, w, color);
-    drawHLine(x, y + h - 1, w, color);
-    drawVLine(x, y, h, color);
-    drawVLine(x + w - 1, y, h, color);
-}
-
-
-void GC9A01::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
-    if (x >= width || y >= height) return;
-    if (x < 0) { w += x; x = 0; }
-    if (y < 0) { h += y; y = 0; }
-    if (x + w > width) w = width - x;
-    if (y + h > height) h = height - y;
-    if (w <= 0 || h <= 0) return;
-    
-    setWindow(x, y, x + w - 1, y + h - 1);
-    
-    uint8_t hi = color >> 8;
-    uint8_t lo = color & 0xFF;
-    
-    gpio_set_level(dcPin, 1);
-    
-    // Send in larger chunks for speed
-    uint8_t buf[512];
-    int totalPixels = w * h;
-    int pixelsSent = 0;
-    
-    while (pixelsSent < totalPixels) {
-        int bufIdx = 0;
-        int pixelsInBuf = 0;
-        
-        while (bufIdx < 510 && pixelsSent + pixelsInBuf < totalPixels) {
-            buf[bufIdx++] = hi;
-            buf[bufIdx++] = lo;
-            pixelsInBuf++;
-        }
-        
-        spi_transaction_t trans = {};
-        trans.length = bufIdx * 8;
-        trans.tx_buffer = buf;
-        spi_device_polling_transmit(spiDevice, &trans);
-        
-        pixelsSent += pixelsInBuf;
-    }
-}
-
-
-void GC9A01::drawCircle(int16_t cx, int16_t cy, int16_t radius, uint16_t color) {
-    int16_t x = radius;
-    int16_t y = 0;
-    int16_t err = 0;
-
-    while (x >= y) {
-        drawPixel(cx + x, cy + y, color);
-        drawPixel(cx + y, cy + x, color);
-        drawPixel(cx - y, cy + x, color);
-        drawPixel(cx - x, cy + y, color);
-        drawPixel(cx - x, cy - y, color);
-        drawPixel(cx - y, cy - x, color);
-        drawPixel(cx + y, cy - x, color);
-        drawPixel(cx + x, cy - y, color);
-
-        y++;
-        if (err <= 0) err += 2 * y + 1;
-        if (err > 0) { x--; err -= 2 * x + 1; }
-    }
-}
-
-
-void GC9A01::fillCircle(int16_t cx, int16_t cy, int16_t radius, uint16_t color) {
-    drawVLine(cx, cy - radius, 2 * radius + 1, color);
-    
-    int16_t x = radius;
-    int16_t y = 0;
-    int16_t err = 0;
-
-    while (x >= y) {
-        drawVLine(cx + x, cy - y, 2 * y + 1, color);
-        drawVLine(cx - x, cy - y, 2 * y + 1, color);
-        drawVLine(cx + y, cy - x, 2 * x + 1, color);
-        drawVLine(cx - y, cy - x, 2 * x + 1, color);
-
-        y++;
-        if (err <= 0) err += 2 * y + 1;
-        if (err > 0) { x--; err -= 2 * x + 1; }
-    }
-}
-
-
-/*
- * =============================================================================
- * TEXT FUNCTIONS
- * =============================================================================
- */
-
-uint8_t GC9A01::drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) {
-    if (c < 32 || c > 126) c = '?';
-    
-    const uint8_t* charData = &FONT_5X7[(c - 32) * 5];
-    
-    for (uint8_t col = 0; col < 5; col++) {
-        uint8_t colData = charData[col];
-        
-        for (uint8_t row = 0; row < 7; row++) {
-            uint16_t pixelColor = (colData & (1 << row)) ? color : bg;
-            
-            if (size == 1) {
-                if (pixelColor != bg || color == bg) {
-                    drawPixel(x + col, y + row, pixelColor);
-                }
-            } else {
-                fillRect(x + col * size, y + row * size, size, size, pixelColor);
-            }
-        }
-    }
-    
-    // Spacing column
-    if (size == 1) {
-        for (uint8_t row = 0; row < 7; row++) {
-            drawPixel(x + 5, y + row, bg);
-        }
-    } else {
-        fillRect(x + 5 * size, y, size, 7 * size, bg);
-    }
-    
-    return 6 * size;
-}
-
-
-void GC9A01::drawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size) {
-    int16_t cursorX = x;
-    
-    while (*str) {
-        if (*str == '\n') {
-            y += 8 * size;
-            cursorX = x;
-        } else {
-            cursorX += drawChar(cursorX, y, *str, color, bg, size);
-        }
-        str++;
-    }
-}
-
-
 /*
  * =============================================================================
  * DISPLAY CONTROL
@@ -765,36 +197,6 @@ void GC9A01::setBacklight(bool on) {
 }
 
 
-void GC9A01::setRotation(uint8_t r) {
-    rotation = r & 3;
-    
-    sendCommand(GC9A01_MADCTL);
-    
-    switch (rotation) {
-        case 0:
-            sendData(0x48);
-            width = GC9A01_WIDTH;
-            height = GC9A01_HEIGHT;
-            break;
-        case 1:
-            sendData(0x28);
-            width = GC9A01_HEIGHT;
-            height = GC9A01_WIDTH;
-            break;
-        case 2:
-            sendData(0x88);
-            width = GC9A01_WIDTH;
-            height = GC9A01_HEIGHT;
-            break;
-        case 3:
-            sendData(0xE8);
-            width = GC9A01_HEIGHT;
-            height = GC9A01_WIDTH;
-            break;
-    }
-}
-
-
 void GC9A01::setInverted(bool invert) {
     sendCommand(invert ? GC9A01_INVON : GC9A01_INVOFF);
 }
@@ -880,40 +282,69 @@ bool GC9A01::isPartialMode() const {
 }
 
 
-void GC9A01::beginWrite(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
-    setWindow(x0, y0, x1, y1);
-    gpio_set_level(dcPin, 1);  // Data mode for pixel streaming
-}
+/*
+ * =============================================================================
+ * ROUND MODE
+ * =============================================================================
+ * 
+ * The panel RAM is a 240x240 square, the glass is a circle inside it.
+ * Everything sent to the four corners is invisible:
+ * 
+ *     ┌──────────────┐
+ *     │░░░/‾‾‾‾‾‾\░░░│   ░ = hidden (inset), sent for nothing
+ *     │░/          \░│
+ *     │|   visible  |│      Square: 240 x 240 = 57,600 pixels
+ *     │░\          /░│      Circle: π x 120² ≈ 45,239 pixels
+ *     │░░░\______/░░░│      → ~21% of a full fill is wasted
+ *     └──────────────┘
+ * 
+ * ROUND_INSETS holds, per row, how many pixels are hidden at each end.
+ * The core then sends one window per group of rows with the same span.
+ * 
+ * The insets are rounded DOWN to multiples of ROUND_INSET_STEP:
+ *     - Exact insets:  139 row groups (windows), 20.7% fewer bytes
+ *     - Step of 4:      51 row groups,            19.6% fewer bytes
+ * Each window costs a few small command transfers, so the coarser table
+ * is faster overall. Rounding down never hides a visible pixel.
+ * 
+ * The circle is symmetric, so the same table works for every rotation.
+ */
 
+#define ROUND_INSET_STEP    4
 
-void GC9A01::pushPixels(const uint16_t* colors, int32_t count) {
-    if (count <= 0) return;
-    
-    // Swap bytes for SPI (big-endian) and send in chunks
-    uint8_t buf[512];
-    int32_t sent = 0;
-    
-    while (sent < count) {
-        int bufIdx = 0;
-        while (bufIdx < 510 && sent < count) {
-            buf[bufIdx++] = colors[sent] >> 8;
-            buf[bufIdx++] = colors[sent] & 0xFF;
-            sent++;
-        }
-        
-        spi_transaction_t trans = {};
-        trans.length = bufIdx * 8;
-        trans.tx_buffer = buf;
-        spi_device_polling_transmit(spiDevice, &trans);
+static uint8_t ROUND_INSETS[GC9A01_HEIGHT];
+static bool roundInsetsReady = false;
+
+
+/**
+ * @brief Fill ROUND_INSETS (once).
+ */
+static void buildRoundInsets() {
+    const float r = GC9A01_WIDTH / 2.0f;
+
+    for (int y = 0; y < GC9A01_HEIGHT; y++) {
+        // Row edge closest to the centre (keeps partly visible pixels)
+        float dy = (y < GC9A01_HEIGHT / 2) ? (GC9A01_HEIGHT / 2 - (y + 1)) : (y - GC9A01_HEIGHT / 2);
+        float half = sqrtf(r * r - dy * dy);
+        int inset = (int)floorf(r - half);
+
+        ROUND_INSETS[y] = (uint8_t)(inset / ROUND_INSET_STEP * ROUND_INSET_STEP);
     }
+    roundInsetsReady = true;
 }
 
 
-void GC9A01::endWrite() {
-    // No-op for now, reserved for future DMA completion wait
+void GC9A01::setRoundMode(bool enable) {
+    if (enable && !roundInsetsReady) {
+        buildRoundInsets();
+    }
+
+    setRowInsets(enable ? ROUND_INSETS : nullptr);
+    roundMode = enable;
+    ESP_LOGI(TAG, "Round mode %s", enable ? "on" : "off");
 }
 
 
-uint16_t GC9A01::color565(uint8_t r, uint8_t g, uint8_t b) {
-    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
-}
\ No newline at end of file
+bool GC9A01::isRoundMode() const {
+    return roundMode;
+}
@@ -122,6 +122,7 @@
 #include <driver/gpio.h>
 #include <stdint.h>
 #include <string.h>
+#include "../shared/rgb565_display.h"
 
 
 /**
@@ -146,6 +147,27 @@
 #define COLOR_GRAY      0x8410
 
 
+/**
+ * @brief ILI9341 panel traits for the shared RGB565 core.
+ */
+struct ILI9341Panel {
+    static constexpr const char* NAME = "ILI9341";
+    static constexpr uint16_t WIDTH = ILI9341_WIDTH;
+    static constexpr uint16_t HEIGHT = ILI9341_HEIGHT;
+    static constexpr int SPI_CLOCK_HZ = 20 * 1000 * 1000;  // 20 MHz
+    static constexpr uint8_t CMD_COLUMN = 0x2A;             // CASET
+    static constexpr uint8_t CMD_ROW = 0x2B;                // PASET
+    static constexpr uint8_t CMD_WRITE = 0x2C;              // RAMWR
+    static constexpr bool WINDOW_16BIT = true;
+    static constexpr bool HAS_ROTATION = true;
+    static constexpr uint8_t CMD_MADCTL = 0x36;
+    static constexpr uint8_t MADCTL[4] = {0x48, 0x28, 0x88, 0xE8};
+    static constexpr uint16_t RESET_PULSE_MS = 10;
+    static constexpr uint16_t RESET_SETTLE_MS = 120;
+    static const uint8_t INIT_TABLE[];                      // Defined in ili9341.cpp
+};
+
+
 /**
  * @class ILI9341
  * @brief ILI9341 TFT display driver over SPI.
@@ -158,8 +180,11 @@
  * - Text rendering with built-in font
  * - Color utilities
  * - Rotation support
+ *
+ * Drawing, text, rotation, offsets and the DMA pixel queue come from
+ * Rgb565Display (shared/rgb565_display.h).
  */
-class ILI9341 {
+class ILI9341 : public Rgb565Display<ILI9341Panel> {
 
 public:
 
@@ -181,12 +206,6 @@ public:
             spi_host_device_t spiHost = SPI2_HOST);
 
 
-    /**
-     * @brief Destroy the ILI9341 instance.
-     */
-    ~ILI9341();
-
-
     /**
      * @brief Initialize SPI and display.
      *
@@ -207,132 +226,6 @@ public:
     bool isSpiInitialized() const { return initialized; }
 
 
-    /**
-     * @brief Fill entire screen with a color.
-     *
-     * @param color RGB565 color value.
-     */
-    void fillScreen(uint16_t color);
-
-
-    /**
-     * @brief Draw a single pixel.
-     *
-     * @param x X coordinate.
-     * @param y Y coordinate.
-     * @param color RGB565 color value.
-     */
-    void drawPixel(int16_t x, int16_t y, uint16_t color);
-
-
-    /**
-     * @brief Draw a horizontal line.
-     *
-     * @param x Starting X position.
-     * @param y Y position.
-     * @param w Line width in pixels.
-     * @param color RGB565 color value.
-     */
-    void drawHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
-
-
-    /**
-     * @brief Draw a vertical line.
-     *
-     * @param x X position.
-     * @param y Starting Y position.
-     * @param h Line height in pixels.
-     * @param color RGB565 color value.
-     */
-    void drawVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
-
-
-    /**
-     * @brief Draw a line between two points.
-     *
-     * @param x0 Start X.
-     * @param y0 Start Y.
-     * @param x1 End X.
-     * @param y1 End Y.
-     * @param color RGB565 color value.
-     */
-    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
-
-
-    /**
-     * @brief Draw a rectangle outline.
-     *
-     * @param x Top-left X.
-     * @param y Top-left Y.
-     * @param w Rectangle width.
-     * @param h Rectangle height.
-     * @param color RGB565 color value.
-     */
-    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
-
-
-    /**
-     * @brief Draw a filled rectangle.
-     *
-     * @param x Top-left X.
-     * @param y Top-left Y.
-     * @param w Rectangle width.
-     * @param h Rectangle height.
-     * @param color RGB565 color value.
-     */
-    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
-
-
-    /**
-     * @brief Draw a circle outline.
-     *
-     * @param cx Center X.
-     * @param cy Center Y.
-     * @param radius Circle radius.
-     * @param color RGB565 color value.
-     */
-    void drawCircle(int16_t cx, int16_t cy, int16_t radius, uint16_t color);
-
-
-    /**
-     * @brief Draw a filled circle.
-     *
-     * @param cx Center X.
-     * @param cy Center Y.
-     * @param radius Circle radius.
-     * @param color RGB565 color value.
-     */
-    void fillCircle(int16_t cx, int16_t cy, int16_t radius, uint16_t color);
-
-
-    /**
-     * @brief Draw a single character.
-     *
-     * @param x Top-left X position.
-     * @param y Top-left Y position.
-     * @param c Character to draw.
-     * @param color Text color (RGB565).
-     * @param bg Background color (RGB565).
-     * @param size Font scale (1 = 5x7, 2 = 10x14, etc.)
-     *
-     * @return Width of character drawn.
-     */
-    uint8_t drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size = 1);
-
-
-    /**
-     * @brief Draw a string.
-     *
-     * @param x Starting X position.
-     * @param y Starting Y position.
-     * @param str Null-terminated string.
-     * @param color Text color (RGB565).
-     * @param bg Background color (RGB565).
-     * @param size Font scale (1 = 5x7, 2 = 10x14, etc.)
-     */
-    void drawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg = COLOR_BLACK, uint8_t size = 1);
-
-
     /**
      * @brief Set backlight on/off.
      *
@@ -341,14 +234,6 @@ public:
     void setBacklight(bool on);
 
 
-    /**
-     * @brief Set display rotation.
-     *
-     * @param rotation 0, 1, 2, or 3 (0° / 90° / 180° / 270°).
-     */
-    void setRotation(uint8_t rotation);
-
-
     /**
      * @brief Invert display colors.
      *
@@ -357,42 +242,6 @@ public:
     void setInverted(bool invert);
 
 
-    /**
-     * @brief Set display memory offset.
-     *
-     * @param x X offset (positive = shift right, negative = shift left).
-     * @param y Y offset (positive = shift down, negative = shift up).
-     *
-     * @details
-     * Shifts where content appears on the display. Useful for:
-     * - Compensating for physically misaligned panels
-     * - Centering content
-     * - Adjusting for bezels or enclosures
-     *
-     * @par Example:
-     * @code
-     *     // Panel is mounted 10px too far right
-     *     display.setOffset(-10, 0);
-     *     
-     *     // Center 200x200 content on 240x320 display
-     *     display.setOffset(20, 60);
-     * @endcode
-     */
-    void setOffset(int16_t x, int16_t y);
-
-
-    /**
-     * @brief Get current X offset.
-     */
-    int16_t getOffsetX() const;
-
-
-    /**
-     * @brief Get current Y offset.
-     */
-    int16_t getOffsetY() const;
-
-
     /**
      * @brief Enable partial display mode (only refresh specified rows).
      *
@@ -480,92 +329,17 @@ public:
     uint16_t getScrollHeight() const;
 
 
-    /**
-     * @brief Convert 24-bit RGB to RGB565.
-     *
-     * @param r Red (0-255).
-     * @param g Green (0-255).
-     * @param b Blue (0-255).
-     * @return RGB565 color value.
-     */
-    static uint16_t color565(uint8_t r, uint8_t g, uint8_t b);
-
-
-    /**
-     * @brief Get current display width (changes with rotation).
-     */
-    uint16_t getWidth() const { return width; }
-
-
-    /**
-     * @brief Get current display height (changes with rotation).
-     */
-    uint16_t getHeight() const { return height; }
-
-
 private:
 
     gpio_num_t mosiPin;
     gpio_num_t misoPin;
     gpio_num_t sckPin;
     gpio_num_t csPin;
-    gpio_num_t dcPin;
-    gpio_num_t rstPin;
     gpio_num_t ledPin;
-    spi_host_device_t spiHost;
-    spi_device_handle_t spiDevice;
-    bool initialized;
 
-    uint8_t rotation;
-    uint16_t width;
-    uint16_t height;
-
-    int16_t xOffset;                // Display X offset (can be negative)
-    int16_t yOffset;                // Display Y offset (can be negative)
     bool partialMode;               // Track if partial mode is active
     bool scrollEnabled;             // Track if scrolling is set up
     uint16_t scrollTopFixed;        // Top fixed area height
     uint16_t scrollBottomFixed;     // Bottom fixed area height
     uint16_t scrollHeight;          // Scrollable area height
-
-
-    /**
-     * @brief Send a command byte.
-     */
-    void sendCommand(uint8_t cmd);
-
-
-    /**
-     * @brief Send a data byte.
-     */
-    void sendData(uint8_t data);
-
-
-    /**
-     * @brief Send multiple data bytes.
-     */
-    void sendData(const uint8_t* data, size_t len);
-
-
-    /**
-     * @brief Send 16-bit data (for colors).
-     */
-    void sendData16(uint16_t data);
-
-
-    /**
-     * @brief Set the drawing window.
-     *
-     * @param x0 Start X.
-     * @param y0 Start Y.
-     * @param x1 End X.
-     * @param y1 End Y.
-     */
-    void setWindow(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
-
-
-    /**
-     * @brief Hardware reset the display.
-     */
-    void hardwareReset();
 };
@@ -8,6 +8,7 @@
 
 #include "xpt2046.h"
 #include <esp_log.h>
+#include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 
@@ -49,6 +50,9 @@ static const char* TAG = "XPT2046";
 #define CMD_READ_Z1     (XPT2046_START | XPT2046_Z1_POS | XPT2046_PD_NONE)
 #define CMD_READ_Z2     (XPT2046_START | XPT2046_Z2_POS | XPT2046_PD_NONE)
 
+// Last conversion of a burst: power down afterwards, which re-enables T_IRQ
+#define CMD_READ_Y_PD   (XPT2046_START | XPT2046_Y_POS | XPT2046_PD_FULL)
+
 
 /*
  * =============================================================================
@@ -67,8 +71,22 @@ XPT2046::XPT2046(spi_host_device_t spiHost, gpio_num_t csPin, gpio_num_t irqPin)
       calYMax(3800),
       screenWidth(240),
       screenHeight(320),
-      rotation(0)
+      rotation(0),
+      samples(XPT2046_DEFAULT_SAMPLES),
+      configLock(portMUX_INITIALIZER_UNLOCKED),
+      taskHandle(nullptr),
+      eventsRunning(false),
+      isrInstalled(false),
+      interval(1),
+      stats{},
+      penDown(false),
+      penX(0),
+      penY(0),
+      penRawX(0),
+      penRawY(0),
+      penPressure(0)
 {
+    updateCalibration();
 }
 
 
@@ -78,6 +96,7 @@ XPT2046::XPT2046(spi_host_device_t spiHost, gpio_num_t csPin, gpio_num_t irqPin)
  * =============================================================================
  */
 XPT2046::~XPT2046() {
+    stopEvents();
     if (initialized && spiDevice) {
         spi_bus_remove_device(spiDevice);
     }
@@ -134,6 +153,7 @@ bool XPT2046::init() {
  * =============================================================================
  */
 bool XPT2046::isTouched() {
+    if (eventsRunning) return penDown;
 
     //to debug
       uint16_t z = readChannel(CMD_READ_Z1);
@@ -167,42 +187,87 @@ uint16_t XPT2046::readChannel(uint8_t command) {
 }
 
 
+/*
+ * =============================================================================
+ * BURST READ
+ * =============================================================================
+ * 
+ * Each conversion takes 16 clocks when the next command byte overlaps the
+ * low bits of the previous result:
+ * 
+ *     MOSI:  CMD0  00    CMD1  00    CMD2  00    00
+ *     MISO:  --    R0hi  R0lo  R1hi  R1lo  R2hi  R2lo
+ * 
+ * So 16 conversions are one 33-byte transaction (~140 µs at 2 MHz)
+ * instead of 16 separate 3-byte ones.
+ */
+void XPT2046::readBurst(const uint8_t* commands, uint8_t count, uint16_t* results) {
+    uint8_t txData[2 * (2 + 2 * XPT2046_MAX_SAMPLES) + 1] = {0};
+    uint8_t rxData[sizeof(txData)] = {0};
+
+    for (uint8_t i = 0; i < count; i++) txData[2 * i] = commands[i];
+
+    spi_transaction_t trans = {};
+    trans.length = (2 * count + 1) * 8;
+    trans.tx_buffer = txData;
+    trans.rx_buffer = rxData;
+
+    spi_device_polling_transmit(spiDevice, &trans);
+
+    for (uint8_t i = 0; i < count; i++) {
+        results[i] = (((rxData[2 * i + 1] << 8) | rxData[2 * i + 2]) >> 3) & 0x0FFF;
+    }
+}
+
+
+XPT2046Sample XPT2046::readSample() {
+    uint8_t n;
+    XPT2046FilterConfig config;
+
+    portENTER_CRITICAL(&configLock);
+    n = samples;
+    config = filterConfig;
+    portEXIT_CRITICAL(&configLock);
+
+    // Z first, then each axis in a row (the drivers settle once per axis)
+    uint8_t commands[2 + 2 * XPT2046_MAX_SAMPLES];
+    uint16_t results[2 + 2 * XPT2046_MAX_SAMPLES];
+    uint8_t count = 0;
+
+    commands[count++] = CMD_READ_Z1;
+    commands[count++] = CMD_READ_Z2;
+    for (uint8_t i = 0; i < n; i++) commands[count++] = CMD_READ_X;
+    for (uint8_t i = 0; i < n; i++) commands[count++] = CMD_READ_Y;
+    commands[count - 1] = CMD_READ_Y_PD;
+
+    readBurst(commands, count, results);
+
+    return xpt2046FilterBurst(&results[2], &results[2 + n], n, results[0], results[1], config);
+}
+
+
 /*
  * =============================================================================
  * RAW POSITION
  * =============================================================================
  */
 bool XPT2046::getRawPosition(int16_t* x, int16_t* y) {
-    if (!isTouched()) {
-        return false;
-    }
-    
-    // Take multiple readings and average (reduces noise)
-    const int samples = 4;
-    int32_t sumX = 0, sumY = 0;
-    int validSamples = 0;
-    
-    for (int i = 0; i < samples; i++) {
-        if (!isTouched()) break;
-        
-        uint16_t rawX = readChannel(CMD_READ_X);
-        uint16_t rawY = readChannel(CMD_READ_Y);
-        
-        // Ignore outliers (common with resistive touch)
-        if (rawX > 100 && rawX < 4000 && rawY > 100 && rawY < 4000) {
-            sumX += rawX;
-            sumY += rawY;
-            validSamples++;
-        }
+    if (eventsRunning) {
+        if (!penDown) return false;
+        *x = penRawX;
+        *y = penRawY;
+        return true;
     }
-    
-    if (validSamples < 2) {
+
+    // One burst: median of several readings, outliers rejected
+    XPT2046Sample s = readSample();
+    if (s.state != XPT2046SampleState::PRESSED) {
         return false;
     }
-    
-    *x = sumX / validSamples;
-    *y = sumY / validSamples;
-    
+
+    *x = s.rawX;
+    *y = s.rawY;
+
     return true;
 }
 
@@ -213,41 +278,25 @@ bool XPT2046::getRawPosition(int16_t* x, int16_t* y) {
  * =============================================================================
  */
 bool XPT2046::getPosition(int16_t* x, int16_t* y) {
+    if (eventsRunning) {
+        if (!penDown) return false;
+        *x = penX;
+        *y = penY;
+        return true;
+    }
+
     int16_t rawX, rawY;
     
     if (!getRawPosition(&rawX, &rawY)) {
         return false;
     }
     
-    // Map raw to screen coordinates
-    int16_t screenX = mapValue(rawX, calXMin, calXMax, 0, screenWidth - 1);
-    int16_t screenY = mapValue(rawY, calYMin, calYMax, 0, screenHeight - 1);
-    
-    // Clamp to screen bounds
-    if (screenX < 0) screenX = 0;
-    if (screenX >= screenWidth) screenX = screenWidth - 1;
-    if (screenY < 0) screenY = 0;
-    if (screenY >= screenHeight) screenY = screenHeight - 1;
-    
-    // Apply rotation
-    switch (rotation) {
-        case 0:  // No rotation
-            *x = screenX;
-            *y = screenY;
-            break;
-        case 1:  // 90° CW
-            *x = screenY;
-            *y = screenWidth - 1 - screenX;
-            break;
-        case 2:  // 180°
-            *x = screenWidth - 1 - screenX;
-            *y = screenHeight - 1 - screenY;
-            break;
-        case 3:  // 270° CW (90° CCW)
-            *x = screenHeight - 1 - screenY;
-            *y = screenX;
-            break;
-    }
+    // Map raw to screen coordinates (clamped, rotation applied)
+    portENTER_CRITICAL(&configLock);
+    XPT2046Calibration cal = calibration;
+    portEXIT_CRITICAL(&configLock);
+
+    cal.map(rawX, rawY, x, y);
     
     return true;
 }
@@ -259,6 +308,8 @@ bool XPT2046::getPosition(int16_t* x, int16_t* y) {
  * =============================================================================
  */
 uint16_t XPT2046::getPressure() {
+    if (eventsRunning) return penDown ? penPressure : 0;
+
     if (!isTouched()) {
         return 0;
     }
@@ -287,6 +338,7 @@ void XPT2046::setCalibration(int16_t xMin, int16_t xMax, int16_t yMin, int16_t y
     calXMax = xMax;
     calYMin = yMin;
     calYMax = yMax;
+    updateCalibration();
     
     ESP_LOGI(TAG, "Calibration set: X[%d-%d] Y[%d-%d]", xMin, xMax, yMin, yMax);
 }
@@ -295,29 +347,202 @@ void XPT2046::setCalibration(int16_t xMin, int16_t xMax, int16_t yMin, int16_t y
 void XPT2046::setScreenSize(uint16_t width, uint16_t height) {
     screenWidth = width;
     screenHeight = height;
+    updateCalibration();
 }
 
 
 void XPT2046::setRotation(uint8_t r) {
     rotation = r & 3;
+    updateCalibration();
+}
+
+
+void XPT2046::setOversampling(uint8_t n) {
+    if (n < 1) n = 1;
+    if (n > XPT2046_MAX_SAMPLES) n = XPT2046_MAX_SAMPLES;
+
+    portENTER_CRITICAL(&configLock);
+    samples = n;
+    portEXIT_CRITICAL(&configLock);
+}
+
+
+void XPT2046::setFilterConfig(const XPT2046FilterConfig& config) {
+    portENTER_CRITICAL(&configLock);
+    filterConfig = config;
+    portEXIT_CRITICAL(&configLock);
+}
+
+
+void XPT2046::updateCalibration() {
+    XPT2046Calibration cal;
+    cal.set(calXMin, calXMax, calYMin, calYMax, screenWidth, screenHeight, rotation);
+
+    portENTER_CRITICAL(&configLock);
+    calibration = cal;
+    portEXIT_CRITICAL(&configLock);
 }
 
 
 /*
  * =============================================================================
- * HELPER: MAP VALUE
+ * EVENT MODE
  * =============================================================================
+ * 
+ *     T_IRQ falls ─► penIsr ─► task wakes, disables the interrupt
+ *                                  │
+ *                      ┌───────────┴───────────┐
+ *                      │ burst → filter → map  │ every intervalMs
+ *                      │ → tracker → queue     │ while the pen is down
+ *                      └───────────┬───────────┘
+ *                                  │ UP
+ *                  re-enable the interrupt, sleep
+ * 
+ * The interrupt stays off while sampling: the conversions themselves
+ * toggle T_IRQ.
  */
-int16_t XPT2046::mapValue(int16_t value, int16_t inMin, int16_t inMax, int16_t outMin, int16_t outMax) {
-    // Handle inverted ranges
-    if (inMin > inMax) {
-        int16_t temp = inMin;
-        inMin = inMax;
-        inMax = temp;
-        int16_t tempOut = outMin;
-        outMin = outMax;
-        outMax = tempOut;
+bool XPT2046::startEvents(uint16_t intervalMs) {
+    if (!initialized) {
+        ESP_LOGE(TAG, "Not initialized - call init() first");
+        return false;
     }
-    
-    return (int32_t)(value - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+    if (eventsRunning) return true;
+
+    interval = pdMS_TO_TICKS(intervalMs);
+    if (interval == 0) interval = 1;
+
+    if (!isrInstalled) {
+        esp_err_t err = gpio_install_isr_service(0);
+        if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+            ESP_LOGE(TAG, "ISR service failed: %s", esp_err_to_name(err));
+            return false;
+        }
+        gpio_set_intr_type(irqPin, GPIO_INTR_NEGEDGE);
+        gpio_intr_disable(irqPin);
+        gpio_isr_handler_add(irqPin, penIsr, this);
+        isrInstalled = true;
+    }
+
+    eventsRunning = true;
+    BaseType_t ret = xTaskCreate(
+        samplingTask, "xpt2046", XPT2046_TASK_STACK,
+        this, XPT2046_TASK_PRIORITY, &taskHandle
+    );
+    if (ret != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create sampling task");
+        eventsRunning = false;
+        taskHandle = nullptr;
+        return false;
+    }
+
+    ESP_LOGI(TAG, "Event mode started (%d ms, %d samples)", intervalMs, samples);
+    return true;
+}
+
+
+void XPT2046::stopEvents() {
+    if (!eventsRunning) return;
+
+    eventsRunning = false;
+    TaskHandle_t task = taskHandle;
+    if (task) xTaskNotifyGive(task);
+
+    // The task finishes its burst, posts a pending UP and deletes itself
+    while (taskHandle) vTaskDelay(1);
+
+    if (isrInstalled) {
+        gpio_intr_disable(irqPin);
+        gpio_isr_handler_remove(irqPin);
+        isrInstalled = false;
+    }
+}
+
+
+XPT2046EventStats XPT2046::getEventStats() const {
+    XPT2046EventStats s = stats;
+    s.dropped = events.getDropped();
+    return s;
+}
+
+
+void IRAM_ATTR XPT2046::penIsr(void* arg) {
+    XPT2046* touch = static_cast<XPT2046*>(arg);
+    if (!touch->taskHandle) return;
+
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(touch->taskHandle, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+
+void XPT2046::samplingTask(void* arg) {
+    XPT2046* touch = static_cast<XPT2046*>(arg);
+    XPT2046Tracker tracker;
+
+    while (touch->eventsRunning) {
+        // Idle: sleep until the pen goes down (it may already be down).
+        // Dropping stale wakeups can also drop stopEvents()' notify, so
+        // look at the flag again before blocking: a stop after this check
+        // notifies after the drop and ends the wait.
+        ulTaskNotifyTake(pdTRUE, 0);
+        gpio_intr_enable(touch->irqPin);
+        if (touch->eventsRunning && gpio_get_level(touch->irqPin) != 0) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+        gpio_intr_disable(touch->irqPin);
+        if (!touch->eventsRunning) break;
+
+        touch->stats.wakeups++;
+
+        // Pen down: sample at a fixed rate until UP
+        TickType_t wake = xTaskGetTickCount();
+        do {
+            touch->trackBurst(tracker);
+            vTaskDelayUntil(&wake, touch->interval);
+        } while (tracker.isDown() && touch->eventsRunning);
+    }
+
+    // Stopped mid-touch: close it so the UI does not see a stuck pen
+    if (tracker.isDown()) {
+        XPT2046Event up = {XPT2046EventType::UP, tracker.getX(), tracker.getY(), 0, esp_timer_get_time()};
+        touch->events.post(up);
+        touch->penDown = false;
+    }
+
+    touch->taskHandle = nullptr;
+    vTaskDelete(nullptr);
+}
+
+
+void XPT2046::trackBurst(XPT2046Tracker& tracker) {
+    int64_t start = esp_timer_get_time();
+
+    XPT2046Sample s = readSample();
+
+    portENTER_CRITICAL(&configLock);
+    XPT2046Calibration cal = calibration;
+    XPT2046FilterConfig config = filterConfig;
+    portEXIT_CRITICAL(&configLock);
+
+    XPT2046Event event;
+    if (tracker.update(s, cal, config, start, &event)) {
+        stats.events++;
+        events.post(event);
+    }
+
+    if (s.state == XPT2046SampleState::PRESSED) {
+        penRawX = s.rawX;
+        penRawY = s.rawY;
+        penPressure = s.pressure;
+    } else if (s.state == XPT2046SampleState::NOISY) {
+        stats.noisy++;
+    }
+    penX = tracker.getX();
+    penY = tracker.getY();
+    penDown = tracker.isDown();
+
+    uint32_t us = (uint32_t)(esp_timer_get_time() - start);
+    stats.bursts++;
+    stats.lastBurstUs = us;
+    if (us > stats.maxBurstUs) stats.maxBurstUs = us;
 }
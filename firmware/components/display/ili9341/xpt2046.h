@@ -99,6 +99,28 @@
  *     You can run calibration once and save the values.
  * 
  * =============================================================================
+ * POLLING vs EVENTS
+ * =============================================================================
+ * 
+ *     Polling: every getPosition() call runs an SPI burst, touched or not.
+ *     
+ *     Events: startEvents() starts a sampling task that sleeps until the
+ *     controller pulls T_IRQ low (pen down). While the pen is down it
+ *     samples every intervalMs, filters each burst (see xpt2046_filter.h)
+ *     and posts DOWN / MOVE / UP events:
+ *     
+ *         T_IRQ:    ────┐▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁┌──────────
+ *         task:   sleep │ burst  burst  burst  burst │ sleep
+ *         queue:        DOWN   MOVE          MOVE   UP
+ *     
+ *     The UI calls pollEvent(), which only reads the queue: no SPI, no
+ *     locks, nothing to do while the screen is idle. A drag is reported
+ *     at most intervalMs (+ one burst, ~0.2 ms) after the pen moved.
+ *     
+ *     In event mode isTouched() / getPosition() / getPressure() return
+ *     the task's latest result instead of talking to the chip.
+ * 
+ * =============================================================================
  * USAGE EXAMPLE
  * =============================================================================
  * 
@@ -127,6 +149,14 @@
  *         }
  *     }
  * 
+ *     // Event mode
+ *     touch.startEvents();
+ *     
+ *     XPT2046Event e;
+ *     while (touch.pollEvent(&e)) {
+ *         if (e.type == XPT2046EventType::DOWN) printf("Down at %d, %d\n", e.x, e.y);
+ *     }
+ * 
  * =============================================================================
  */
 
@@ -134,7 +164,31 @@
 
 #include <driver/spi_master.h>
 #include <driver/gpio.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include <stdint.h>
+#include "xpt2046_filter.h"
+
+
+// Event mode
+#define XPT2046_TASK_STACK          3072
+#define XPT2046_TASK_PRIORITY       6       // Above the UI task: keeps drag latency bounded
+#define XPT2046_DEFAULT_SAMPLES     7       // X and Y readings per burst
+#define XPT2046_EVENT_QUEUE_SIZE    16
+
+
+/**
+ * @brief Sampling task counters.
+ */
+struct XPT2046EventStats {
+    uint32_t wakeups;       ///< Pen-down interrupts that woke the task
+    uint32_t bursts;        ///< Bursts read
+    uint32_t noisy;         ///< Bursts rejected by the filter
+    uint32_t events;        ///< Events produced
+    uint32_t dropped;       ///< Events lost because pollEvent() fell behind
+    uint32_t lastBurstUs;   ///< SPI + filter time of the last burst
+    uint32_t maxBurstUs;
+};
 
 
 /**
@@ -241,6 +295,62 @@ public:
     void setRotation(uint8_t rotation);
 
 
+    /**
+     * @brief Set the number of X/Y readings per burst.
+     *
+     * @param samples 1 to XPT2046_MAX_SAMPLES (default: 7).
+     */
+    void setOversampling(uint8_t samples);
+
+
+    /**
+     * @brief Set filter thresholds (pressure, outliers, move, release).
+     */
+    void setFilterConfig(const XPT2046FilterConfig& config);
+
+
+    /**
+     * @brief Start the interrupt-driven sampling task.
+     *
+     * @param intervalMs Sampling period while the pen is down.
+     * @return false if not initialized or the task/interrupt failed.
+     */
+    bool startEvents(uint16_t intervalMs = 10);
+
+
+    /**
+     * @brief Stop the sampling task (back to polling).
+     */
+    void stopEvents();
+
+
+    /**
+     * @brief true while the sampling task runs.
+     */
+    bool isEventMode() const { return eventsRunning; }
+
+
+    /**
+     * @brief Take the oldest touch event. Never blocks.
+     *
+     * @note Call from one task only (the queue has a single consumer).
+     * @return false if there is no event.
+     */
+    bool pollEvent(XPT2046Event* event) { return events.poll(event); }
+
+
+    /**
+     * @brief Get sampling task counters.
+     */
+    XPT2046EventStats getEventStats() const;
+
+
+    /**
+     * @brief Reset sampling task counters.
+     */
+    void resetEventStats() { stats = {}; }
+
+
 private:
 
     spi_host_device_t spiHost;
@@ -260,6 +370,28 @@ private:
     uint16_t screenHeight;
     uint8_t rotation;
 
+    // Filtering (shared with the sampling task, guarded by configLock)
+    XPT2046Calibration calibration;
+    XPT2046FilterConfig filterConfig;
+    uint8_t samples;
+    portMUX_TYPE configLock;
+
+    // Event mode
+    XPT2046EventQueue<XPT2046_EVENT_QUEUE_SIZE> events;
+    TaskHandle_t taskHandle;
+    volatile bool eventsRunning;
+    bool isrInstalled;
+    TickType_t interval;
+    XPT2046EventStats stats;
+
+    // Latest result of the sampling task (answers the polled API)
+    volatile bool penDown;
+    volatile int16_t penX;
+    volatile int16_t penY;
+    volatile uint16_t penRawX;
+    volatile uint16_t penRawY;
+    volatile uint16_t penPressure;
+
 
     /**
      * @brief Read a value from XPT2046.
@@ -271,7 +403,39 @@ private:
 
 
     /**
-     * @brief Map raw value to screen coordinate.
+     * @brief Run several conversions in one SPI transaction.
+     *
+     * @details
+     * Uses the 16-clocks-per-conversion mode: the next command byte is
+     * sent while the previous result is still being clocked out.
+     *
+     * @param commands Command bytes.
+     * @param count Number of commands (at most 2 + 2 × XPT2046_MAX_SAMPLES).
+     * @param results 12-bit ADC value per command.
      */
-    int16_t mapValue(int16_t value, int16_t inMin, int16_t inMax, int16_t outMin, int16_t outMax);
+    void readBurst(const uint8_t* commands, uint8_t count, uint16_t* results);
+
+
+    /**
+     * @brief Read and filter Z1, Z2, then samples × X and samples × Y.
+     *
+     * @details The last conversion powers down, which re-arms T_IRQ.
+     */
+    XPT2046Sample readSample();
+
+
+    /**
+     * @brief Recompute the fixed-point mapping after a setter.
+     */
+    void updateCalibration();
+
+
+    /**
+     * @brief Read one burst, track it, post the event (sampling task).
+     */
+    void trackBurst(XPT2046Tracker& tracker);
+
+
+    static void penIsr(void* arg);
+    static void samplingTask(void* arg);
 };
@@ -0,0 +1,418 @@
+/**
+ * @file xpt2046_filter.h
+ * @brief Touch sample filtering, calibration and event tracking for XPT2046.
+ *
+ * @details
+ * The hardware-independent half of the XPT2046 event mode. The sampling
+ * task reads a burst of raw conversions and passes it through here:
+ *
+ *     burst ──► xpt2046FilterBurst() ──► XPT2046Calibration::map()
+ *                 median + outliers         raw → pixels (fixed point)
+ *                                                 │
+ *     UI ◄── XPT2046EventQueue ◄── XPT2046Tracker ◄┘
+ *              lock-free ring        DOWN / MOVE / UP
+ *
+ * Nothing in this file touches SPI, GPIO or FreeRTOS, so recorded raw
+ * ADC sequences can be replayed through it on a PC.
+ */
+
+/*
+ * =============================================================================
+ * BEGINNER'S GUIDE: WHY RESISTIVE TOUCH NEEDS FILTERING
+ * =============================================================================
+ *
+ * A resistive panel is two sheets of film pressed together. The ADC
+ * reading wobbles while the contact settles, and when the pen lands or
+ * lifts, single readings jump to nonsense:
+ *
+ *     X readings in one burst:   1822 1819 1825 3391 1820 1823 1821
+ *                                                 ^^^^ outlier
+ *
+ *     average (old code):  2046   ← about 15 pixels off
+ *     median:              1822
+ *
+ * So each burst is sorted, readings far from the median are dropped and
+ * the rest averaged. If fewer than half survive, the pen is probably
+ * landing or lifting: the burst is marked NOISY and ignored instead of
+ * making the cursor jump.
+ *
+ * =============================================================================
+ * FIXED-POINT CALIBRATION
+ * =============================================================================
+ *
+ * The pixel scale is computed once when the calibration changes, as a
+ * 16.16 fixed-point number:
+ *
+ *     scale = (width - 1) << 16 / (xMax - xMin)       e.g. 239 / 3600 ≈ 4351
+ *     x     = ((raw - xMin) × scale + 0.5) >> 16
+ *
+ * One multiply and a shift per axis, no division per sample. An inverted
+ * panel (xMin > xMax) simply gets a negative scale.
+ *
+ * =============================================================================
+ * EVENTS
+ * =============================================================================
+ *
+ *     pen:       ───┐████████████████████████┌────
+ *     samples:      P   P   P   N   P   P    R   R
+ *     events:       DOWN    MOVE    MOVE         UP
+ *
+ *     P = pressed, N = noisy (held), R = released
+ *
+ * MOVE is only sent after the position changed by moveThreshold pixels,
+ * so a resting pen produces no traffic. UP needs releaseSamples released
+ * bursts in a row, so one bad reading does not break a drag.
+ *
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include <stdlib.h>
+
+
+/**
+ * @brief Largest number of X (or Y) readings per burst.
+ */
+#define XPT2046_MAX_SAMPLES     15
+
+
+/**
+ * @brief Filter and tracker settings.
+ */
+struct XPT2046FilterConfig {
+    uint16_t pressureThreshold = 400;   ///< Pressure (z1 + 4095 - z2) that counts as touched
+    uint16_t rawMin = 100;              ///< Readings outside rawMin..rawMax are rejected
+    uint16_t rawMax = 4000;
+    uint16_t maxDeviation = 48;         ///< Largest distance from the median (raw counts)
+    uint8_t moveThreshold = 2;          ///< Pixels the pen must move for a MOVE event
+    uint8_t releaseSamples = 2;         ///< Released bursts in a row before UP
+};
+
+
+/**
+ * @brief Result of filtering one burst.
+ */
+enum class XPT2046SampleState : uint8_t {
+    RELEASED,       ///< Pressure below threshold
+    PRESSED,        ///< Valid position
+    NOISY           ///< Pressed, but the readings disagree (landing/lifting)
+};
+
+
+/**
+ * @brief One filtered burst.
+ */
+struct XPT2046Sample {
+    XPT2046SampleState state;
+    uint16_t rawX;          ///< Filtered raw X (PRESSED only)
+    uint16_t rawY;          ///< Filtered raw Y (PRESSED only)
+    uint16_t pressure;      ///< z1 + 4095 - z2
+};
+
+
+/**
+ * @brief Touch event type.
+ */
+enum class XPT2046EventType : uint8_t {
+    DOWN,           ///< Pen touched the screen
+    MOVE,           ///< Pen moved while down
+    UP              ///< Pen lifted (at the last known position)
+};
+
+
+/**
+ * @brief A timestamped touch event.
+ */
+struct XPT2046Event {
+    XPT2046EventType type;
+    int16_t x;              ///< Screen pixel (rotation applied)
+    int16_t y;
+    uint16_t pressure;
+    int64_t timeUs;         ///< esp_timer_get_time() when the burst started
+};
+
+
+/**
+ * @brief Filter one axis: median, outlier rejection, average.
+ *
+ * @param samples Raw readings (not modified).
+ * @param count Number of readings (1 to XPT2046_MAX_SAMPLES).
+ * @param config Range and deviation limits.
+ * @param out Filtered value.
+ *
+ * @return false if fewer than half of the readings are usable.
+ */
+inline bool xpt2046FilterAxis(const uint16_t* samples, uint8_t count,
+                              const XPT2046FilterConfig& config, uint16_t* out) {
+    if (count == 0 || count > XPT2046_MAX_SAMPLES) return false;
+
+    // Insertion sort of the in-range readings (at most 15)
+    uint16_t sorted[XPT2046_MAX_SAMPLES];
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        uint16_t v = samples[i];
+        if (v < config.rawMin || v > config.rawMax) continue;
+        uint8_t j = n++;
+        while (j > 0 && sorted[j - 1] > v) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = v;
+    }
+
+    const uint8_t needed = count / 2 + 1;
+    if (n < needed) return false;
+
+    const int32_t median = sorted[n / 2];
+    uint32_t sum = 0;
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        if (abs((int32_t)sorted[i] - median) <= config.maxDeviation) {
+            sum += sorted[i];
+            kept++;
+        }
+    }
+    if (kept < needed) return false;
+
+    *out = (uint16_t)((sum + kept / 2) / kept);
+    return true;
+}
+
+
+/**
+ * @brief Filter one burst of X/Y/Z readings.
+ *
+ * @param xs X readings.
+ * @param ys Y readings.
+ * @param count Readings per axis.
+ * @param z1 Z1 reading.
+ * @param z2 Z2 reading.
+ * @param config Filter settings.
+ */
+inline XPT2046Sample xpt2046FilterBurst(const uint16_t* xs, const uint16_t* ys, uint8_t count,
+                                        uint16_t z1, uint16_t z2,
+                                        const XPT2046FilterConfig& config) {
+    XPT2046Sample s = {XPT2046SampleState::RELEASED, 0, 0, 0};
+
+    int32_t z = (int32_t)z1 + 4095 - z2;
+    s.pressure = z < 0 ? 0 : (uint16_t)z;
+    if (z1 == 0 || s.pressure < config.pressureThreshold) return s;
+
+    if (xpt2046FilterAxis(xs, count, config, &s.rawX) &&
+        xpt2046FilterAxis(ys, count, config, &s.rawY)) {
+        s.state = XPT2046SampleState::PRESSED;
+    } else {
+        s.state = XPT2046SampleState::NOISY;
+    }
+    return s;
+}
+
+
+/**
+ * @brief Raw → screen mapping in 16.16 fixed point.
+ */
+struct XPT2046Calibration {
+
+    /**
+     * @brief Precompute the mapping.
+     *
+     * @param xMin Raw X at the left edge.
+     * @param xMax Raw X at the right edge.
+     * @param yMin Raw Y at the top edge.
+     * @param yMax Raw Y at the bottom edge.
+     * @param width Screen width in rotation 0.
+     * @param height Screen height in rotation 0.
+     * @param rotation 0-3, as the display.
+     */
+    void set(int16_t xMin, int16_t xMax, int16_t yMin, int16_t yMax,
+             uint16_t width, uint16_t height, uint8_t rotation) {
+        this->xMin = xMin;
+        this->yMin = yMin;
+        this->width = width ? width : 1;
+        this->height = height ? height : 1;
+        this->rotation = rotation & 3;
+        xScale = xMax != xMin ? ((int32_t)(this->width - 1) << 16) / (xMax - xMin) : 0;
+        yScale = yMax != yMin ? ((int32_t)(this->height - 1) << 16) / (yMax - yMin) : 0;
+    }
+
+
+    /**
+     * @brief Map a filtered raw position to screen pixels.
+     */
+    void map(uint16_t rawX, uint16_t rawY, int16_t* x, int16_t* y) const {
+        int32_t sx = (int32_t)(((int64_t)(rawX - xMin) * xScale + 0x8000) >> 16);
+        int32_t sy = (int32_t)(((int64_t)(rawY - yMin) * yScale + 0x8000) >> 16);
+
+        if (sx < 0) sx = 0;
+        if (sx >= width) sx = width - 1;
+        if (sy < 0) sy = 0;
+        if (sy >= height) sy = height - 1;
+
+        switch (rotation) {
+            case 0:  *x = sx;               *y = sy;                break;
+            case 1:  *x = sy;               *y = width - 1 - sx;    break;
+            case 2:  *x = width - 1 - sx;   *y = height - 1 - sy;   break;
+            default: *x = height - 1 - sy;  *y = sx;                break;
+        }
+    }
+
+    int16_t xMin = 200;
+    int16_t yMin = 200;
+    int32_t xScale = 0;             // Pixels per raw count, 16.16 (negative if inverted)
+    int32_t yScale = 0;
+    uint16_t width = 240;
+    uint16_t height = 320;
+    uint8_t rotation = 0;
+};
+
+
+/**
+ * @brief Turns filtered bursts into DOWN/MOVE/UP events.
+ */
+class XPT2046Tracker {
+
+public:
+
+    /**
+     * @brief Feed one burst.
+     *
+     * @param sample Filtered burst.
+     * @param cal Calibration to map the position.
+     * @param config moveThreshold / releaseSamples.
+     * @param timeUs Burst timestamp.
+     * @param event Output, valid when true is returned.
+     *
+     * @return true if the burst produced an event.
+     */
+    bool update(const XPT2046Sample& sample, const XPT2046Calibration& cal,
+                const XPT2046FilterConfig& config, int64_t timeUs, XPT2046Event* event) {
+        switch (sample.state) {
+            case XPT2046SampleState::NOISY:
+                return false;   // Hold: neither a position nor a release
+
+            case XPT2046SampleState::RELEASED:
+                if (!down || ++releaseCount < config.releaseSamples) return false;
+                down = false;
+                *event = {XPT2046EventType::UP, lastX, lastY, 0, timeUs};
+                return true;
+
+            case XPT2046SampleState::PRESSED:
+                break;
+        }
+
+        int16_t x, y;
+        cal.map(sample.rawX, sample.rawY, &x, &y);
+        releaseCount = 0;
+
+        XPT2046EventType type = XPT2046EventType::MOVE;
+        if (!down) {
+            down = true;
+            type = XPT2046EventType::DOWN;
+        } else if (abs(x - lastX) < config.moveThreshold && abs(y - lastY) < config.moveThreshold) {
+            return false;
+        }
+
+        lastX = x;
+        lastY = y;
+        *event = {type, x, y, sample.pressure, timeUs};
+        return true;
+    }
+
+    /** @brief true between DOWN and UP. */
+    bool isDown() const { return down; }
+
+    /** @brief Last reported position. */
+    int16_t getX() const { return lastX; }
+    int16_t getY() const { return lastY; }
+
+    /** @brief Forget the pen (no UP is sent). */
+    void reset() { down = false; releaseCount = 0; }
+
+private:
+
+    bool down = false;
+    uint8_t releaseCount = 0;
+    int16_t lastX = 0;
+    int16_t lastY = 0;
+};
+
+
+/**
+ * @brief Single-producer/single-consumer event ring.
+ *
+ * @details
+ * The sampling task posts, one UI task polls. Neither side locks or
+ * blocks: each only writes its own index. The last slot is kept for UP
+ * while the pen is down, so a full queue drops MOVEs (and whole touches)
+ * but never leaves a DOWN without its UP.
+ *
+ * @tparam SIZE Slots (power of two).
+ */
+template<uint8_t SIZE = 16>
+class XPT2046EventQueue {
+
+    static_assert(SIZE >= 4 && (SIZE & (SIZE - 1)) == 0, "SIZE must be a power of two >= 4");
+
+public:
+
+    /**
+     * @brief Producer: add an event.
+     *
+     * @return false if it was dropped.
+     */
+    bool post(const XPT2046Event& event) {
+        uint32_t head = this->head.load(std::memory_order_relaxed);
+        uint32_t used = head - tail.load(std::memory_order_acquire);
+        uint32_t room = SIZE - used;
+
+        bool fits;
+        switch (event.type) {
+            case XPT2046EventType::DOWN: fits = room >= 2; break;
+            case XPT2046EventType::MOVE: fits = penPosted && room >= 2; break;
+            default:                     fits = penPosted && room >= 1; break;
+        }
+
+        if (!fits) {
+            dropped++;
+            return false;
+        }
+
+        penPosted = event.type != XPT2046EventType::UP;
+        slots[head & (SIZE - 1)] = event;
+        this->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consumer: take the oldest event.
+     *
+     * @return false if the queue is empty.
+     */
+    bool poll(XPT2046Event* event) {
+        uint32_t tail = this->tail.load(std::memory_order_relaxed);
+        if (tail == head.load(std::memory_order_acquire)) return false;
+
+        *event = slots[tail & (SIZE - 1)];
+        this->tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** @brief Consumer: true if an event is waiting. */
+    bool isEmpty() const {
+        return tail.load(std::memory_order_relaxed) == head.load(std::memory_order_acquire);
+    }
+
+    /** @brief Events dropped because the consumer fell behind. */
+    uint32_t getDropped() const { return dropped; }
+
+private:
+
+    XPT2046Event slots[SIZE];
+    std::atomic<uint32_t> head{0};      // Written by the producer only
+    std::atomic<uint32_t> tail{0};      // Written by the consumer only
+    bool penPosted = false;             // Producer: DOWN posted, UP not yet
+    uint32_t dropped = 0;
+};
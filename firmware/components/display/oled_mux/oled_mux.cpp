@@ -0,0 +1,163 @@
+/**
+ * @file oled_mux.cpp
+ * @brief Several SSD1306 OLEDs behind a PCA9548A multiplexer (ESP-IDF).
+ */
+
+#include "oled_mux.h"
+#include <esp_log.h>
+
+
+static const char* TAG = "OledMux";
+
+
+/*
+ * =============================================================================
+ * CONSTRUCTOR / DESTRUCTOR
+ * =============================================================================
+ */
+OledMux::OledMux(PCA9548A& mux, uint8_t address)
+    : mux(mux),
+      address(address)
+{
+}
+
+
+OledMux::~OledMux() {
+    // Panels are released by their unique_ptr; each waits for its own flush
+}
+
+
+/*
+ * =============================================================================
+ * PANELS
+ * =============================================================================
+ */
+bool OledMux::addPanel(uint8_t channel) {
+    if (channel >= PCA9548A_NUM_CHANNELS) {
+        ESP_LOGE(TAG, "Invalid channel: %d (must be 0-7)", channel);
+        return false;
+    }
+    if (panels[channel]) return true;
+
+    waitIdle();
+    if (!mux.selectChannel(channel)) {
+        ESP_LOGE(TAG, "Failed to select channel %d", channel);
+        return false;
+    }
+
+    std::unique_ptr<SSD1306> oled(new SSD1306(mux.getBusHandle(), address));
+    if (!oled->init()) {
+        ESP_LOGE(TAG, "No display on channel %d", channel);
+        return false;
+    }
+
+    panels[channel] = std::move(oled);
+    ESP_LOGI(TAG, "Display added on channel %d", channel);
+    return true;
+}
+
+
+SSD1306* OledMux::panel(uint8_t channel) {
+    if (channel >= PCA9548A_NUM_CHANNELS) return nullptr;
+    return panels[channel].get();
+}
+
+
+SSD1306* OledMux::select(uint8_t channel) {
+    if (channel >= PCA9548A_NUM_CHANNELS || !panels[channel]) return nullptr;
+    waitIdle();
+    if (!mux.selectChannel(channel)) return nullptr;
+    return panels[channel].get();
+}
+
+
+uint8_t OledMux::getPanelMask() const {
+    uint8_t mask = 0;
+    for (uint8_t ch = 0; ch < PCA9548A_NUM_CHANNELS; ch++) {
+        if (panels[ch]) mask |= (1 << ch);
+    }
+    return mask;
+}
+
+
+/*
+ * =============================================================================
+ * FLUSH
+ * =============================================================================
+ * 
+ * Start on the selected channel (free), then go up and wrap around:
+ * 
+ *     selected = CH2, dirty = CH0 CH2 CH3    →   CH2, CH3, CH0
+ * 
+ * Each other dirty panel costs one select write; the last one stays
+ * selected, so the next flush of that panel costs none.
+ * 
+ * A panel started with flushAsync() is still on the wire with its channel
+ * selected. Every path that selects a channel waits for it first:
+ * 
+ *     flushAsync(CH0)   [sel CH0] [CH0 windows ........]
+ *     flush()                                          │ waitIdle() → [sel CH1] [CH1 ...]
+ */
+uint8_t OledMux::flush() {
+    uint8_t dirty = 0;
+    for (uint8_t ch = 0; ch < PCA9548A_NUM_CHANNELS; ch++) {
+        if (panels[ch] && panels[ch]->isDirty()) dirty |= (1 << ch);
+    }
+    if (!dirty) return 0;
+
+    waitIdle();
+
+    uint8_t start = 0;
+    uint8_t selected = mux.getSelectedChannels();
+    for (uint8_t ch = 0; ch < PCA9548A_NUM_CHANNELS; ch++) {
+        if (selected == (1 << ch)) start = ch;
+    }
+
+    uint8_t sent = 0;
+    for (uint8_t i = 0; i < PCA9548A_NUM_CHANNELS; i++) {
+        uint8_t ch = (start + i) % PCA9548A_NUM_CHANNELS;
+        if (!(dirty & (1 << ch))) continue;
+
+        if (!mux.selectChannel(ch)) {
+            ESP_LOGE(TAG, "Failed to select channel %d", ch);
+            continue;
+        }
+        panels[ch]->update();
+        sent++;
+    }
+    return sent;
+}
+
+
+bool OledMux::flush(uint8_t channel) {
+    if (channel >= PCA9548A_NUM_CHANNELS || !panels[channel]) return false;
+    if (!panels[channel]->isDirty()) return true;
+
+    waitIdle();
+    if (!mux.selectChannel(channel)) {
+        ESP_LOGE(TAG, "Failed to select channel %d", channel);
+        return false;
+    }
+    panels[channel]->update();
+    return true;
+}
+
+
+bool OledMux::flushAsync(uint8_t channel) {
+    if (channel >= PCA9548A_NUM_CHANNELS || !panels[channel]) return false;
+    if (!panels[channel]->isDirty()) return true;
+
+    waitIdle();
+    if (!mux.selectChannel(channel)) {
+        ESP_LOGE(TAG, "Failed to select channel %d", channel);
+        return false;
+    }
+    return panels[channel]->updateAsync();
+}
+
+
+void OledMux::waitIdle() {
+    for (uint8_t ch = 0; ch < PCA9548A_NUM_CHANNELS; ch++) {
+        if (panels[ch]) panels[ch]->waitFlush();
+    }
+}
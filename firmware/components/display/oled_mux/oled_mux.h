@@ -0,0 +1,191 @@
+/**
+ * @file oled_mux.h
+ * @brief Several SSD1306 OLEDs behind a PCA9548A multiplexer (ESP-IDF).
+ *
+ * @details
+ * This component owns one SSD1306 per mux channel and does the channel
+ * switching for them. Draw into any panel at any time; flush() sends
+ * only the panels that changed, with as few channel switches as possible.
+ *
+ * @note
+ * - All panels use the same I2C address (usually 0x3C)
+ * - Send panels through the mux (flush(), flushAsync()), never with
+ *   update()/updateAsync() on the panel itself: only the mux knows
+ *   which channel is routed
+ * - Before switching channels the mux waits for a running flushAsync(),
+ *   so calls that switch may block for the rest of that transfer
+ */
+
+/*
+ * =============================================================================
+ * BEGINNER'S GUIDE: SHARING ONE BUS BETWEEN IDENTICAL DISPLAYS
+ * =============================================================================
+ * 
+ * =============================================================================
+ * THE COST OF SWITCHING
+ * =============================================================================
+ * 
+ *     Every display sits on its own mux channel. Before talking to one,
+ *     the mux register has to point at its channel:
+ * 
+ *         [mux: CH0] [OLED data ...] [mux: CH1] [OLED data ...] ...
+ * 
+ *     Done by hand, every frame selects every channel and pushes every
+ *     panel, even if only one clock digit on one panel changed:
+ * 
+ *         4 panels × (1 select + 7 transfers, ~1 KB)  → ~4.2 KB per frame
+ * 
+ * =============================================================================
+ * WHAT OledMux DOES
+ * =============================================================================
+ * 
+ *     1. Skip clean panels: SSD1306::isDirty() compares the drawn pages
+ *        with what the panel already shows. No bus traffic.
+ * 
+ *     2. Skip redundant selects: PCA9548A remembers the selected channel
+ *        and does not write the register again.
+ * 
+ *     3. Order the flushes: start with the panel whose channel is already
+ *        selected, then go up from there and wrap around. Each other dirty
+ *        panel costs exactly one select.
+ * 
+ *         Last flush ended on CH2, dirty panels CH0, CH2, CH3:
+ * 
+ *             CH2 (no select) → CH3 → CH0       2 selects instead of 3
+ * 
+ *     A frame where one digit changed on one panel is then one window on
+ *     one panel: a select (if needed) and two short transfers.
+ * 
+ * =============================================================================
+ * USAGE EXAMPLE
+ * =============================================================================
+ * 
+ *     #include "pca9548a.h"
+ *     #include "oled_mux.h"
+ *     
+ *     PCA9548A mux(GPIO_NUM_21, GPIO_NUM_22);
+ *     mux.init();
+ *     
+ *     OledMux oleds(mux);
+ *     oleds.addPanel(0);
+ *     oleds.addPanel(1);
+ *     
+ *     oleds.panel(0)->drawString(0, 0, "Living room");
+ *     oleds.panel(1)->drawString(0, 0, "Kitchen");
+ *     oleds.flush();                       // Both panels sent
+ *     
+ *     oleds.panel(1)->drawString(0, 16, "21.5C");
+ *     oleds.flush();                       // Only CH1, no select write
+ *     
+ *     oleds.select(0)->setContrast(0x20);  // Direct commands: select first
+ * 
+ * =============================================================================
+ */
+
+#pragma once
+
+#include "ssd1306.h"
+#include "pca9548a.h"
+#include <stdint.h>
+#include <memory>
+
+
+/**
+ * @class OledMux
+ * @brief SSD1306 panels keyed by PCA9548A channel.
+ */
+class OledMux {
+
+public:
+
+    /**
+     * @brief Construct a manager for panels behind a multiplexer.
+     *
+     * @param mux Initialized multiplexer (owns the I2C bus).
+     * @param address I2C address of the panels (default 0x3C).
+     */
+    OledMux(PCA9548A& mux, uint8_t address = SSD1306_ADDR_DEFAULT);
+
+
+    /**
+     * @brief Destroy the manager and its panels.
+     */
+    ~OledMux();
+
+
+    /**
+     * @brief Create and initialize the panel on a channel.
+     *
+     * @param channel Mux channel (0-7).
+     * @return true if the panel is ready (also if it already existed).
+     */
+    bool addPanel(uint8_t channel);
+
+
+    /**
+     * @brief Get the panel on a channel for drawing (no bus access).
+     *
+     * @return Panel, or nullptr if none was added on that channel.
+     */
+    SSD1306* panel(uint8_t channel);
+
+
+    /**
+     * @brief Route the mux to a panel for direct commands.
+     *
+     * @details Use for setContrast(), setInverted(), setDisplayOn(), right
+     *          away: any later mux call may route to another channel.
+     *          Waits for a running flushAsync() first.
+     *
+     * @return Panel, or nullptr if none was added or the select failed.
+     */
+    SSD1306* select(uint8_t channel);
+
+
+    /**
+     * @brief Send all panels that changed.
+     *
+     * @return Number of panels sent.
+     */
+    uint8_t flush();
+
+
+    /**
+     * @brief Send one panel if it changed.
+     *
+     * @return true if the panel is up to date afterwards.
+     */
+    bool flush(uint8_t channel);
+
+
+    /**
+     * @brief Start sending one panel in the background.
+     *
+     * @details The channel stays selected until the transfer is done;
+     *          the next call that switches channels waits for it.
+     *          Drawing into any panel meanwhile is fine.
+     *
+     * @return false if there is no such panel, the select failed or the
+     *         panel's flush task could not start.
+     */
+    bool flushAsync(uint8_t channel);
+
+
+    /**
+     * @brief Block until no panel has a flush running.
+     */
+    void waitIdle();
+
+
+    /**
+     * @brief Bitmask of channels with a panel (bit 0 = CH0).
+     */
+    uint8_t getPanelMask() const;
+
+
+private:
+
+    PCA9548A& mux;
+    uint8_t address;
+    std::unique_ptr<SSD1306> panels[PCA9548A_NUM_CHANNELS];
+};
@@ -0,0 +1,398 @@
+/**
+ * @file arc_spans.h
+ * @brief Span-based arc (ring segment) rasterizer shared by the display drivers.
+ *
+ * @details
+ * Turns a ring segment (centre, inner/outer radius, start/end angle) into
+ * horizontal spans, without any per-pixel math:
+ *
+ * - ArcSpanTable caches the row extents of one radius pair (no sqrt per row)
+ * - ArcSweep turns the start/end angles into two direction vectors once
+ * - arcRowSpans() clips one row against both directions (two divisions)
+ *
+ * Used by Rgb565Display::fillArc() and fillArcDelta(), so a full arc and
+ * a delta slice draw exactly the same pixels.
+ *
+ * @par Usage
+ * @code
+ * #include "gc9a01.h"
+ *
+ * ArcSpanTable ring;
+ * ring.init(40, 100);                                 // Once per radius pair
+ *
+ * display.fillArc(ring, 120, 120, 0, 270, COLOR_ORANGE);
+ * display.fillArcDelta(ring, 120, 120, 0, 270, 300,   // Level 75% → 83%:
+ *                      COLOR_ORANGE, COLOR_BLACK);    // only the new slice
+ * @endcode
+ */
+
+/*
+ * =============================================================================
+ * BEGINNER'S GUIDE: ARCS AS SPANS
+ * =============================================================================
+ *
+ * The naive way to draw a dial arc tests every pixel of the bounding box:
+ * "is it inside the ring? is its angle between start and end?" That is a
+ * square root per row and an atan2 (or a lookup) per pixel.
+ *
+ * Two observations remove all of it:
+ *
+ *     1. RING EXTENT PER ROW: on row dy, the ring covers
+ *
+ *            inner ≤ |dx| ≤ outer,  outer = √(R² − dy²),  inner = ⌈√(r² − dy²)⌉
+ *
+ *        These only depend on the radii, so they are computed ONCE per
+ *        radius pair and stored in a table (2 x int16 per row).
+ *
+ *     2. ANGLES ARE HALF-PLANES: "clockwise of the start angle" is a
+ *        straight line through the centre. On one row, a line splits the
+ *        x axis at a single point:
+ *
+ *                    start ray
+ *                       ╲
+ *             ───────────╳━━━━━━━━━━  row dy: x ≥ split is clockwise
+ *                         ╲
+ *                          ● centre
+ *
+ *        split = dy · sx / sy   (one division per row and per ray)
+ *
+ *     So each half-row of the ring (left of centre, right of centre) is
+ *     cut at most twice and gives at most two spans:
+ *
+ *             row:   ░░░░░▓▓▓▓▓▓      ▓▓▓▓░░░░░
+ *                    ─left half─  hole ─right half─
+ *
+ * DIRECTIONS: 0° = top, clockwise (like a clock or a dial).
+ *
+ * DELTA DRAWING: a level dial going from 40% to 45% only needs the slice
+ * between the two angles. Shrinking erases the slice WITHOUT its start ray
+ * (that ray still belongs to the arc that stays), and without its end ray
+ * when shrinking from a full ring (that ray is also the arc's start).
+ *
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <esp_heap_caps.h>
+#include <esp_log.h>
+#include <math.h>
+#include <stdint.h>
+
+
+/**
+ * @brief Start/end directions of an arc, ready for row clipping.
+ */
+struct ArcSweep {
+    int32_t sx, sy;     ///< Start direction (x1024, screen Y down)
+    int32_t ex, ey;     ///< End direction (x1024)
+    int16_t degrees;    ///< Sweep in degrees (360 = full ring)
+    bool startOpen;     ///< Leave out the start ray itself
+    bool endOpen;       ///< Leave out the end ray itself
+
+    /**
+     * @brief Build a sweep from angles.
+     *
+     * @param startDeg Start angle (0 = top, clockwise).
+     * @param endDeg End angle (>= startDeg + 360 = full ring).
+     * @param startOpen true = pixels exactly on the start ray are excluded.
+     * @param endOpen true = pixels exactly on the end ray are excluded.
+     */
+    static ArcSweep fromDegrees(int startDeg, int endDeg,
+                                bool startOpen = false, bool endOpen = false) {
+        ArcSweep s;
+        float a = startDeg * (float)M_PI / 180.0f;
+        float b = endDeg * (float)M_PI / 180.0f;
+        s.sx = lroundf(sinf(a) * 1024.0f);
+        s.sy = lroundf(-cosf(a) * 1024.0f);
+        s.ex = lroundf(sinf(b) * 1024.0f);
+        s.ey = lroundf(-cosf(b) * 1024.0f);
+        s.degrees = (endDeg - startDeg) >= 360 ? 360 : (int16_t)(endDeg - startDeg);
+        s.startOpen = startOpen;
+        s.endOpen = endOpen;
+        return s;
+    }
+};
+
+
+/**
+ * @brief One horizontal span, relative to the arc centre.
+ */
+struct ArcSpan {
+    int16_t dx0;        ///< First column (dx)
+    int16_t dx1;        ///< Last column (dx), inclusive
+};
+
+
+/*
+ * -----------------------------------------------------------------------------
+ * Row helpers
+ * -----------------------------------------------------------------------------
+ */
+
+/**
+ * @brief Floor square root of a non-negative integer.
+ */
+inline int32_t arcIsqrt(int32_t v) {
+    if (v <= 0) return 0;
+    int32_t r = (int32_t)sqrtf((float)v);
+    while (r * r > v) r--;
+    while ((r + 1) * (r + 1) <= v) r++;
+    return r;
+}
+
+
+/**
+ * @brief Ring extent of one row: pixels with inner ≤ |dx| ≤ outer.
+ *
+ * @return false if the row misses the ring.
+ */
+inline bool arcRowExtent(int32_t dy, int32_t innerR, int32_t outerR,
+                         int16_t& inner, int16_t& outer) {
+    int32_t dySq = dy * dy;
+    if (dySq > outerR * outerR) return false;
+
+    outer = (int16_t)arcIsqrt(outerR * outerR - dySq);
+
+    int32_t holeSq = innerR * innerR - dySq;
+    int32_t in = arcIsqrt(holeSq);
+    if (in * in < holeSq) in++;         // Round up: dx² + dy² ≥ innerR²
+    inner = (int16_t)in;
+
+    return inner <= outer;
+}
+
+
+/**
+ * @brief Floor/ceil of a / b for any signs (b != 0).
+ */
+inline int32_t arcFloorDiv(int32_t a, int32_t b) {
+    int32_t q = a / b;
+    return (q * b != a && ((a < 0) != (b < 0))) ? q - 1 : q;
+}
+
+inline int32_t arcCeilDiv(int32_t a, int32_t b) {
+    int32_t q = a / b;
+    return (q * b != a && ((a < 0) == (b < 0))) ? q + 1 : q;
+}
+
+
+/**
+ * @brief Columns of row dy on the clockwise side of the start ray.
+ *
+ * @details
+ * cross(start, p) = sx·dy − sy·dx ≥ 0 (> 0 when startOpen).
+ */
+inline void arcStartSide(const ArcSweep& s, int32_t dy, int32_t& lo, int32_t& hi) {
+    int32_t num = s.sx * dy;
+    lo = INT16_MIN;
+    hi = INT16_MAX;
+
+    if (s.sy == 0) {
+        bool in = s.startOpen ? num > 0 : num >= 0;
+        if (!in) { lo = 1; hi = 0; }
+    } else if (s.sy > 0) {
+        hi = s.startOpen ? arcCeilDiv(num, s.sy) - 1 : arcFloorDiv(num, s.sy);
+    } else {
+        lo = s.startOpen ? arcFloorDiv(num, s.sy) + 1 : arcCeilDiv(num, s.sy);
+    }
+}
+
+
+/**
+ * @brief Columns of row dy on the counter-clockwise side of the end ray.
+ *
+ * @details
+ * cross(p, end) = dx·ey − dy·ex ≥ 0 (> 0 when endOpen).
+ */
+inline void arcEndSide(const ArcSweep& s, int32_t dy, int32_t& lo, int32_t& hi) {
+    int32_t num = s.ex * dy;
+    lo = INT16_MIN;
+    hi = INT16_MAX;
+
+    if (s.ey == 0) {
+        bool in = s.endOpen ? -num > 0 : -num >= 0;
+        if (!in) { lo = 1; hi = 0; }
+    } else if (s.ey > 0) {
+        lo = s.endOpen ? arcFloorDiv(num, s.ey) + 1 : arcCeilDiv(num, s.ey);
+    } else {
+        hi = s.endOpen ? arcCeilDiv(num, s.ey) - 1 : arcFloorDiv(num, s.ey);
+    }
+}
+
+
+/**
+ * @brief Clip one ring segment [a, b] (dx) to the sweep.
+ *
+ * @return Number of spans written to out (0 to 2).
+ */
+inline int arcClipSegment(int32_t a, int32_t b, int32_t sLo, int32_t sHi,
+                          int32_t eLo, int32_t eHi, int16_t degrees, ArcSpan* out) {
+    if (degrees >= 360) {
+        out[0] = {(int16_t)a, (int16_t)b};
+        return 1;
+    }
+
+    if (degrees <= 180) {
+        // Inside both half-planes
+        int32_t lo = a, hi = b;
+        if (sLo > lo) lo = sLo;
+        if (eLo > lo) lo = eLo;
+        if (sHi < hi) hi = sHi;
+        if (eHi < hi) hi = eHi;
+        if (lo > hi) return 0;
+        out[0] = {(int16_t)lo, (int16_t)hi};
+        return 1;
+    }
+
+    // Inside either half-plane: up to two pieces, merged if they touch
+    int32_t lo1 = a > sLo ? a : sLo, hi1 = b < sHi ? b : sHi;
+    int32_t lo2 = a > eLo ? a : eLo, hi2 = b < eHi ? b : eHi;
+    bool has1 = lo1 <= hi1, has2 = lo2 <= hi2;
+
+    if (has1 && has2) {
+        if (lo2 < lo1) {
+            int32_t t = lo1; lo1 = lo2; lo2 = t;
+            t = hi1; hi1 = hi2; hi2 = t;
+        }
+        if (lo2 <= hi1 + 1) {
+            out[0] = {(int16_t)lo1, (int16_t)(hi2 > hi1 ? hi2 : hi1)};
+            return 1;
+        }
+        out[0] = {(int16_t)lo1, (int16_t)hi1};
+        out[1] = {(int16_t)lo2, (int16_t)hi2};
+        return 2;
+    }
+    if (has1) { out[0] = {(int16_t)lo1, (int16_t)hi1}; return 1; }
+    if (has2) { out[0] = {(int16_t)lo2, (int16_t)hi2}; return 1; }
+    return 0;
+}
+
+
+/**
+ * @brief All spans of one arc row.
+ *
+ * @param dy Row relative to the centre.
+ * @param inner Ring extent from arcRowExtent().
+ * @param outer Ring extent from arcRowExtent().
+ * @param sweep Start/end directions.
+ * @param out Receives up to 4 spans (2 per half-row), left to right.
+ *
+ * @return Number of spans.
+ */
+inline int arcRowSpans(int32_t dy, int16_t inner, int16_t outer,
+                       const ArcSweep& sweep, ArcSpan* out) {
+    int32_t sLo, sHi, eLo, eHi;
+    arcStartSide(sweep, dy, sLo, sHi);
+    arcEndSide(sweep, dy, eLo, eHi);
+
+    if (inner == 0) {
+        return arcClipSegment(-outer, outer, sLo, sHi, eLo, eHi, sweep.degrees, out);
+    }
+
+    int n = arcClipSegment(-outer, -inner, sLo, sHi, eLo, eHi, sweep.degrees, out);
+    return n + arcClipSegment(inner, outer, sLo, sHi, eLo, eHi, sweep.degrees, out + n);
+}
+
+
+/**
+ * @class ArcSpanTable
+ * @brief Cached row extents of one ring (inner/outer radius pair).
+ *
+ * @details
+ * Build once at startup for each ring the UI draws; drawing an arc of any
+ * sweep then needs no square roots.
+ */
+class ArcSpanTable {
+
+public:
+
+    ArcSpanTable() : innerR(0), outerR(-1), rows(nullptr) {}
+
+    ~ArcSpanTable() {
+        heap_caps_free(rows);
+    }
+
+    ArcSpanTable(const ArcSpanTable&) = delete;
+    ArcSpanTable& operator=(const ArcSpanTable&) = delete;
+
+
+    /**
+     * @brief Compute the row extents of a ring.
+     *
+     * @param inner Inner radius (0 = filled pie).
+     * @param outer Outer radius.
+     *
+     * @return true if successful, false on bad radii or out of memory.
+     */
+    bool init(int16_t inner, int16_t outer) {
+        if (inner < 0) inner = 0;
+        if (outer < 0 || inner > outer) return false;
+
+        heap_caps_free(rows);
+        rows = (Row*)heap_caps_malloc(sizeof(Row) * (outer + 1), MALLOC_CAP_8BIT);
+        if (!rows) {
+            ESP_LOGE("ArcSpanTable", "Allocation failed (%u bytes)",
+                     (unsigned)(sizeof(Row) * (outer + 1)));
+            outerR = -1;
+            return false;
+        }
+
+        innerR = inner;
+        outerR = outer;
+
+        // Symmetric: only |dy| = 0..outer is stored
+        for (int16_t dy = 0; dy <= outer; dy++) {
+            if (!arcRowExtent(dy, inner, outer, rows[dy].inner, rows[dy].outer)) {
+                rows[dy].inner = 1;     // Empty row
+                rows[dy].outer = 0;
+            }
+        }
+        return true;
+    }
+
+
+    /**
+     * @brief Check if init() succeeded.
+     */
+    bool isReady() const { return rows != nullptr; }
+
+
+    int16_t getInnerRadius() const { return innerR; }
+    int16_t getOuterRadius() const { return outerR; }
+
+
+    /**
+     * @brief Call sink(dy, dx0, dx1) for every span of an arc, top to bottom.
+     *
+     * @param sweep Start/end directions (ArcSweep::fromDegrees()).
+     * @param sink Callable taking (int16_t dy, int16_t dx0, int16_t dx1).
+     */
+    template <typename Sink>
+    void forEachSpan(const ArcSweep& sweep, Sink sink) const {
+        if (!rows || sweep.degrees <= 0) return;
+
+        ArcSpan spans[4];
+        for (int16_t dy = -outerR; dy <= outerR; dy++) {
+            const Row& row = rows[dy < 0 ? -dy : dy];
+            if (row.inner > row.outer) continue;
+
+            int n = arcRowSpans(dy, row.inner, row.outer, sweep, spans);
+            for (int i = 0; i < n; i++) {
+                sink(dy, spans[i].dx0, spans[i].dx1);
+            }
+        }
+    }
+
+
+private:
+
+    struct Row {
+        int16_t inner;      // First |dx| inside the ring
+        int16_t outer;      // Last |dx| inside the ring
+    };
+
+    int16_t innerR;
+    int16_t outerR;
+    Row* rows;              // outerR + 1 entries, indexed by |dy|
+};
@@ -345,3 +345,71 @@ inline constexpr uint8_t FONT_5X7_FIRST_CHAR = 32;
  * @brief Last ASCII character in font (tilde).
  */
 inline constexpr uint8_t FONT_5X7_LAST_CHAR = 126;
+
+/**
+ * @brief Width of one character cell in pixels (5 glyph columns + 1 spacing).
+ */
+inline constexpr uint8_t FONT_5X7_CELL_WIDTH = 6;
+
+
+/*
+ * =============================================================================
+ * TEXT RUN EXPANSION (RGB565)
+ * =============================================================================
+ * 
+ * Drawing text pixel by pixel costs a full window setup per font pixel.
+ * Instead, a driver opens ONE window around a whole run of characters and
+ * streams it row by row. This helper produces one screen row of that run:
+ * 
+ *     "Hi" at size 1, row 3:
+ *     
+ *         col:  0 1 2 3 4 5 | 6 7 8 9 10 11
+ *               █ █ █ █ █ · | · · █ · ·  ·      ← fg/bg pixels, big-endian
+ *               ─── 'H' ───   ─── 'i' ───
+ *     
+ *     Column 5 of each cell is the spacing column (always background).
+ * 
+ * With scaling, every font pixel becomes a size×size block, so one font
+ * row repeats for `size` screen rows and each column for `size` pixels.
+ */
+
+/**
+ * @brief Expand part of one screen row of a text run into RGB565 bytes.
+ *
+ * @param str Characters of the run (no newlines).
+ * @param row Screen row relative to the top of the run (0 to 7*size-1).
+ * @param col First screen column relative to the left of the run.
+ * @param count Number of pixels to produce.
+ * @param color Foreground color (RGB565).
+ * @param bg Background color (RGB565).
+ * @param size Font scale (1 = 5x7, 2 = 10x14, etc.)
+ * @param out Output buffer, receives count * 2 bytes (high byte first).
+ *
+ * @return Pointer just past the last byte written.
+ */
+inline uint8_t* font5x7RenderRow(const char* str, int16_t row, int16_t col, int16_t count,
+                                 uint16_t color, uint16_t bg, uint8_t size, uint8_t* out) {
+    const uint8_t rowMask = 1 << (row / size);
+    const int16_t cellWidth = FONT_5X7_CELL_WIDTH * size;
+
+    int16_t charIdx = col / cellWidth;
+    int16_t inCell = col % cellWidth;
+
+    while (count > 0) {
+        char c = str[charIdx];
+        if (c < FONT_5X7_FIRST_CHAR || c > FONT_5X7_LAST_CHAR) c = '?';
+        const uint8_t* glyph = &FONT_5X7[(c - FONT_5X7_FIRST_CHAR) * FONT_5X7_WIDTH];
+
+        for (; inCell < cellWidth && count > 0; inCell++, count--) {
+            uint8_t fontCol = inCell / size;
+            uint16_t px = (fontCol < FONT_5X7_WIDTH && (glyph[fontCol] & rowMask)) ? color : bg;
+            *out++ = px >> 8;
+            *out++ = px & 0xFF;
+        }
+
+        inCell = 0;
+        charIdx++;
+    }
+
+    return out;
+}
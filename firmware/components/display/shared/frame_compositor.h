@@ -0,0 +1,299 @@
+/**
+ * @file frame_compositor.h
+ * @brief Naive full-frame drawing for the RGB565 displays, only changed
+ *        tiles sent.
+ *
+ * @details
+ * For UI code that simply redraws the whole screen every frame: the
+ * frame is drawn into memory one band at a time (Rgb565Display::
+ * beginCapture()), each tile of the band is compared with the same tile
+ * of the previous frame, and only the tiles that differ go over SPI.
+ *
+ * - Exact compare against a copy of the previous frame (PSRAM if there
+ *   is any, else internal RAM), so a tile is never skipped by mistake
+ * - Neighbouring changed tiles of a band share one window
+ * - Frame timing and counters come out of getStats()
+ *
+ * Works with any Rgb565Display driver (GC9A01, ILI9341, ST7789, SSD1357).
+ * Screens built from widgets are better served by UiScreen (ui_screen.h),
+ * which knows its damage without comparing pixels.
+ *
+ * @par Usage
+ * @code
+ * FrameCompositor<GC9A01> ui(display);
+ * ui.begin();
+ *
+ * while (true) {
+ *     ui.render([&](GC9A01& d) {                  // Everything, every frame
+ *         d.fillScreen(COLOR_BLACK);
+ *         d.fillArc(ring, 120, 120, 0, level * 36 / 10, COLOR_ORANGE);
+ *         d.drawString(100, 114, "42%", COLOR_WHITE, COLOR_BLACK, 2);
+ *     });
+ *     display.flush();
+ * }
+ * @endcode
+ */
+
+/*
+ * =============================================================================
+ * BEGINNER'S GUIDE: DRAWING NAIVELY, SENDING LITTLE
+ * =============================================================================
+ *
+ * Drawn straight to the panel, a full redraw is 115 KB of SPI traffic on
+ * 240 x 240, even if only "41%" turned into "42%". The compositor keeps
+ * the panel's current image and sends the difference:
+ *
+ *     Screen split into bands (16 rows) and tiles (48 columns):
+ *
+ *         ┌────┬────┬────┬────┬────┐
+ *         │    │    │    │    │    │  ← band 0
+ *         ├────┼────┼────┼────┼────┤
+ *         │    │ ▓▓ │ ▓▓ │    │    │  ← band 1: text changed here
+ *         ├────┼────┼────┼────┼────┤
+ *         │    │    │    │    │    │
+ *         └────┴────┴────┴────┴────┘
+ *
+ *     For each band:
+ *       1. CAPTURE: call the draw function with drawing clipped to the
+ *          band and redirected into the band buffer (7.5 KB)
+ *       2. DIFF:    compare every tile with the previous frame
+ *       3. PUSH:    runs of changed tiles, one window each; the previous
+ *                   frame copy is updated
+ *
+ * The draw function runs once per band, so CPU time grows with the band
+ * count while SPI time only grows with what changed. Shapes outside the
+ * band are clipped before they reach any pixel, which keeps the repeats
+ * cheap.
+ *
+ * Pixels drawn on the display outside render() are not known to the
+ * compositor: call invalidate() afterwards to send everything again.
+ *
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <stdint.h>
+#include <string.h>
+
+
+/**
+ * @brief Timing and counters of the last frame and since resetStats().
+ */
+struct CompositorStats {
+    uint32_t frames;        ///< render() calls
+    uint32_t lastUs;        ///< CPU time of the last frame (pixels queued, not sent)
+    uint32_t maxUs;         ///< Slowest frame
+    uint64_t totalUs;       ///< All frames (average = totalUs / frames)
+    uint16_t tilesTotal;    ///< Tiles on screen
+    uint16_t lastTiles;     ///< Tiles sent in the last frame
+    uint16_t lastWindows;   ///< Windows opened in the last frame
+    uint32_t lastBytes;     ///< Pixel bytes sent in the last frame
+    uint64_t totalBytes;    ///< Pixel bytes sent by all frames
+};
+
+
+/**
+ * @class FrameCompositor
+ * @brief Captures naive full-frame drawing band by band, sends changed tiles.
+ *
+ * @tparam Display Any Rgb565Display driver.
+ */
+template <typename Display>
+class FrameCompositor {
+
+public:
+
+    /**
+     * @brief Create a compositor for a display.
+     *
+     * @param display Initialized driver (must outlive the compositor).
+     * @param bandRows Rows drawn per pass of the draw function.
+     * @param tileWidth Columns per tile (the unit of change).
+     */
+    explicit FrameCompositor(Display& display, uint16_t bandRows = 16, uint16_t tileWidth = 48)
+        : display(display), bandRows(bandRows ? bandRows : 1), tileWidth(tileWidth ? tileWidth : 1),
+          band(nullptr), previous(nullptr), valid(false), stats{} {}
+
+    ~FrameCompositor() {
+        heap_caps_free(band);
+        heap_caps_free(previous);
+    }
+
+    FrameCompositor(const FrameCompositor&) = delete;
+    FrameCompositor& operator=(const FrameCompositor&) = delete;
+
+
+    /**
+     * @brief Allocate the band buffer and the previous frame.
+     *
+     * @return false if either allocation failed.
+     *
+     * @details
+     * The previous frame (width * height * 2 bytes, 112.5 KB on 240 x
+     * 240) goes to PSRAM when there is some, else to internal RAM. The
+     * first render() sends the whole screen.
+     */
+    bool begin() {
+        const size_t w = display.getWidth();
+        const size_t h = display.getHeight();
+
+        heap_caps_free(band);
+        heap_caps_free(previous);
+        band = (uint8_t*)heap_caps_malloc(w * bandRows * 2, MALLOC_CAP_8BIT);
+        previous = (uint8_t*)heap_caps_malloc(w * h * 2, MALLOC_CAP_SPIRAM);
+        if (!previous) previous = (uint8_t*)heap_caps_malloc(w * h * 2, MALLOC_CAP_8BIT);
+
+        if (!band || !previous) {
+            heap_caps_free(band);
+            heap_caps_free(previous);
+            band = nullptr;
+            previous = nullptr;
+            return false;
+        }
+
+        valid = false;
+        stats = {};
+        stats.tilesTotal = (uint16_t)(((w + tileWidth - 1) / tileWidth) * ((h + bandRows - 1) / bandRows));
+        return true;
+    }
+
+
+    /**
+     * @brief True once begin() succeeded.
+     */
+    bool isReady() const { return band != nullptr; }
+
+
+    /**
+     * @brief Send the whole screen on the next render().
+     */
+    void invalidate() { valid = false; }
+
+
+    /**
+     * @brief Draw a frame and send the tiles that changed.
+     *
+     * @param draw Callable taking Display&; draws the whole frame. It is
+     *             called once per band, with drawing clipped to the band.
+     * @return false if begin() was not called (nothing drawn).
+     *
+     * @details
+     * The draw function must paint every pixel (start with fillScreen()
+     * or a background): the band buffer is not cleared between bands.
+     */
+    template <typename Draw>
+    bool render(Draw&& draw) {
+        if (!band) return false;
+        int64_t start = esp_timer_get_time();
+
+        const int16_t w = (int16_t)display.getWidth();
+        const int16_t h = (int16_t)display.getHeight();
+        uint16_t tiles = 0;
+        uint16_t windows = 0;
+        uint32_t bytes = 0;
+
+        for (int16_t y = 0; y < h; y += bandRows) {
+            const int16_t rows = (int16_t)(h - y < bandRows ? h - y : bandRows);
+
+            display.beginCapture(band, 0, y, w, rows);
+            display.setClipRect(0, y, w, rows);
+            draw(display);
+            display.clearClipRect();
+            display.endCapture();
+
+            // Runs of changed tiles: [runStart, x)
+            int16_t runStart = -1;
+            for (int16_t x = 0; x <= w; x += tileWidth) {
+                bool changed = false;
+                if (x < w) {
+                    int16_t tw = (int16_t)(w - x < tileWidth ? w - x : tileWidth);
+                    changed = !valid || tileDiffers(x, y, tw, rows);
+                    if (changed) tiles++;
+                }
+                if (changed && runStart < 0) runStart = x;
+                if (!changed && runStart >= 0) {
+                    int16_t runEnd = x < w ? x : w;
+                    bytes += push(runStart, y, runEnd - runStart, rows);
+                    windows++;
+                    runStart = -1;
+                }
+            }
+        }
+
+        valid = true;
+
+        uint32_t us = (uint32_t)(esp_timer_get_time() - start);
+        stats.frames++;
+        stats.lastUs = us;
+        if (us > stats.maxUs) stats.maxUs = us;
+        stats.totalUs += us;
+        stats.lastTiles = tiles;
+        stats.lastWindows = windows;
+        stats.lastBytes = bytes;
+        stats.totalBytes += bytes;
+        return true;
+    }
+
+
+    /**
+     * @brief Frame timing and counters.
+     */
+    const CompositorStats& getStats() const { return stats; }
+
+
+    /**
+     * @brief Reset the frame timing and counters.
+     */
+    void resetStats() {
+        uint16_t total = stats.tilesTotal;
+        stats = {};
+        stats.tilesTotal = total;
+    }
+
+
+private:
+
+    Display& display;
+    const uint16_t bandRows;
+    const uint16_t tileWidth;
+    uint8_t* band;              // One band of the frame being drawn
+    uint8_t* previous;          // What the panel shows (valid = false: unknown)
+    bool valid;
+    CompositorStats stats;
+
+
+    /**
+     * @brief Compare a tile of the band with the previous frame.
+     */
+    bool tileDiffers(int16_t x, int16_t y, int16_t tw, int16_t rows) const {
+        const size_t stride = (size_t)display.getWidth() * 2;
+        for (int16_t r = 0; r < rows; r++) {
+            const uint8_t* now = band + r * stride + x * 2;
+            const uint8_t* before = previous + (y + r) * stride + x * 2;
+            if (memcmp(now, before, (size_t)tw * 2) != 0) return true;
+        }
+        return false;
+    }
+
+
+    /**
+     * @brief Send a run of tiles in one window and remember it as shown.
+     *
+     * @return Pixel bytes sent.
+     */
+    uint32_t push(int16_t x, int16_t y, int16_t rw, int16_t rows) {
+        const size_t stride = (size_t)display.getWidth() * 2;
+
+        display.beginWrite(x, y, x + rw - 1, y + rows - 1);
+        for (int16_t r = 0; r < rows; r++) {
+            const uint8_t* src = band + r * stride + x * 2;
+            display.pushBytes(src, (size_t)rw * 2);
+            memcpy(previous + (y + r) * stride + x * 2, src, (size_t)rw * 2);
+        }
+        display.endWrite();
+        return (uint32_t)rw * rows * 2;
+    }
+};
@@ -0,0 +1,200 @@
+/**
+ * @file glyph_cache.h
+ * @brief Small LRU cache of pre-colored glyph cells for drawText().
+ *
+ * @details
+ * Rendering an anti-aliased glyph means unpacking its coverage bits and
+ * looking up a blended color for every pixel. Labels that are redrawn
+ * often (a percentage, a clock) use the same few glyphs in the same
+ * colors, so the finished RGB565 cells are kept and later copied
+ * straight into the DMA buffers.
+ *
+ * Entries are keyed by font, character, text color and background. The
+ * least recently used one is replaced when the cache is full. Cells
+ * larger than a slot are simply rendered every time.
+ *
+ * @par Usage
+ * @code
+ * GlyphCache cache(12, 1200);            // 12 slots of up to 1200 bytes
+ * cache.begin();
+ *
+ * display.drawText(x, y, bigFont, "75%", COLOR_ORANGE, COLOR_BLACK, &cache);
+ * @endcode
+ */
+
+/*
+ * =============================================================================
+ * SIZING THE CACHE
+ * =============================================================================
+ *
+ * A cell is advance × line height × 2 bytes. For a 28 px digit font with
+ * 16 px advances: 16 × 28 × 2 = 896 bytes per glyph.
+ *
+ *     "0"-"9" + "%" in one color  →  11 slots × 896 B ≈ 10 KB
+ *
+ * Slots are only filled when a glyph is drawn, so an unused cache costs
+ * just its allocation. getStats() shows whether the hit rate justifies
+ * the RAM.
+ *
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <esp_heap_caps.h>
+#include <esp_log.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "packed_font.h"
+
+
+/**
+ * @brief Hit/miss counters.
+ */
+struct GlyphCacheStats {
+    uint32_t hits;          ///< Glyphs copied from the cache
+    uint32_t misses;        ///< Glyphs rendered into a slot
+    uint32_t uncached;      ///< Glyphs rendered without a slot (too big / all in use)
+};
+
+
+/**
+ * @class GlyphCache
+ * @brief Fixed-size LRU cache of rendered glyph cells.
+ */
+class GlyphCache {
+
+public:
+
+    /**
+     * @param slots Number of cached glyphs.
+     * @param slotBytes Largest cell (advance × line height × 2) a slot holds.
+     */
+    GlyphCache(uint8_t slots = 12, uint16_t slotBytes = 1024)
+        : slotCount(slots), slotBytes(slotBytes), entries(nullptr), pool(nullptr),
+          clock(0), stats{} {}
+
+    ~GlyphCache() {
+        free(entries);
+        heap_caps_free(pool);
+    }
+
+    GlyphCache(const GlyphCache&) = delete;
+    GlyphCache& operator=(const GlyphCache&) = delete;
+
+
+    /**
+     * @brief Allocate the slots.
+     *
+     * @return false if out of memory (drawText() then renders uncached).
+     */
+    bool begin() {
+        entries = (Entry*)calloc(slotCount, sizeof(Entry));
+        pool = (uint8_t*)heap_caps_malloc((size_t)slotCount * slotBytes, MALLOC_CAP_8BIT);
+        if (!entries || !pool) {
+            ESP_LOGE(TAG, "Out of memory (%u bytes)", (unsigned)(slotCount * slotBytes));
+            free(entries);
+            heap_caps_free(pool);
+            entries = nullptr;
+            pool = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+
+    /**
+     * @brief Drop every cached cell (e.g. after the font data moved).
+     */
+    void clear() {
+        if (entries) memset(entries, 0, slotCount * sizeof(Entry));
+    }
+
+
+    /**
+     * @brief Start a new draw call.
+     *
+     * @details
+     * Cells found or added after this are pinned until the next call, so
+     * a string with many different glyphs cannot evict its own cells.
+     */
+    void beginDraw() { clock++; }
+
+
+    /**
+     * @brief Get a glyph cell, rendering it into a slot on a miss.
+     *
+     * @return The cell (advance × lineHeight, big-endian RGB565), or
+     *         nullptr if it must be rendered without the cache.
+     */
+    const uint8_t* get(const PackedFont& font, const PackedFont::Glyph& g, char c,
+                       uint16_t color, uint16_t bg, const uint8_t lut[][2]) {
+        size_t bytes = (size_t)g.advance * font.lineHeight * 2;
+        if (!entries || bytes > slotBytes) {
+            stats.uncached++;
+            return nullptr;
+        }
+
+        Entry* victim = nullptr;
+        for (uint8_t i = 0; i < slotCount; i++) {
+            Entry& e = entries[i];
+            if (e.used && e.font == font.data && e.c == c && e.color == color && e.bg == bg) {
+                e.used = clock;
+                stats.hits++;
+                return pool + (size_t)i * slotBytes;
+            }
+            if (e.used != clock && (!victim || e.used < victim->used)) victim = &e;
+        }
+
+        if (!victim) {  // Every slot holds a glyph of the current string
+            stats.uncached++;
+            return nullptr;
+        }
+
+        uint8_t* cell = pool + (size_t)(victim - entries) * slotBytes;
+        for (uint8_t row = 0; row < font.lineHeight; row++) {
+            font.renderRow(g, row, 0, g.advance, lut, cell + (size_t)row * g.advance * 2);
+        }
+
+        victim->font = font.data;
+        victim->c = c;
+        victim->color = color;
+        victim->bg = bg;
+        victim->used = clock;
+        stats.misses++;
+        return cell;
+    }
+
+
+    /**
+     * @brief Get hit/miss counters.
+     */
+    const GlyphCacheStats& getStats() const { return stats; }
+
+
+    /**
+     * @brief Reset hit/miss counters.
+     */
+    void resetStats() { stats = {}; }
+
+
+private:
+
+    static constexpr const char* TAG = "GlyphCache";
+
+    struct Entry {
+        const uint8_t* font;        // PackedFont::data of the cached glyph
+        uint32_t used;              // Draw call that last used it (0 = empty)
+        uint16_t color;
+        uint16_t bg;
+        char c;
+    };
+
+    uint8_t slotCount;
+    uint16_t slotBytes;
+    Entry* entries;
+    uint8_t* pool;
+    uint32_t clock;                 // Current draw call
+    GlyphCacheStats stats;
+};
@@ -0,0 +1,296 @@
+/**
+ * @file packed_font.h
+ * @brief Proportional, optionally anti-aliased fonts for the RGB565 displays.
+ *
+ * @details
+ * Fonts are converted on the PC (firmware/tools/font_convert.py) from a
+ * TTF/OTF at a chosen pixel size, or from a BDF bitmap font, and drawn
+ * with Rgb565Display::drawText(). Like rgb565_asset.h, the data is read
+ * in place from flash (EMBED_FILES, a generated C array, or a mapped
+ * partition).
+ *
+ * - Proportional advance per glyph (no kerning)
+ * - 1, 2 or 4 bits per pixel (2/4/16 coverage levels for anti-aliasing)
+ * - Any contiguous character range (e.g. just "0" to "9" plus "%")
+ *
+ * @par Usage
+ * @code
+ * #include "digits_28.h"                  // font_convert.py --header
+ *
+ * PackedFont big;
+ * big.open(digits_28, digits_28_size);
+ *
+ * int16_t w = big.textWidth("75%");
+ * display.drawText(120 - w / 2, 100, big, "75%", COLOR_ORANGE, COLOR_BLACK);
+ * @endcode
+ */
+
+/*
+ * =============================================================================
+ * BEGINNER'S GUIDE: PROPORTIONAL AND ANTI-ALIASED TEXT
+ * =============================================================================
+ *
+ * The built-in 5x7 font gives every character the same 6-pixel cell and
+ * grows by repeating pixels (size 3 = blocky 15x21). A converted font is
+ * rasterized at the real size instead, and each character only takes
+ * the width it needs:
+ *
+ *     fixed:         │ i │ m │ 1 │        proportional:   │i│ m │1│
+ *
+ * ANTI-ALIASING: with 2 or 4 bits per pixel, each pixel stores how much
+ * of it the glyph covers (0 = background, max = text color). Edge pixels
+ * get a color in between, so curves look smooth instead of stair-stepped:
+ *
+ *     1 bpp:  ░░██      4 bpp:  ░▒▓█
+ *             ░███              ▒▓██
+ *
+ * Text is drawn opaque: the coverage is blended between the text and the
+ * background color once per draw (at most 16 colors), not per pixel.
+ *
+ * =============================================================================
+ * GLYPH CELLS
+ * =============================================================================
+ *
+ * Every glyph has a cell: its advance wide, the font's line height tall.
+ * The bitmap sits inside the cell at (xOffset, yOffset); the converter
+ * crops anything that would stick out, so cells never overlap and a
+ * string is just its cells side by side:
+ *
+ *     ┌──────┬────┬──────┐  ← line top (y passed to drawText)
+ *     │      │    │      │
+ *     │ ┌──┐ │┌─┐ │ ┌──┐ │
+ *     │ │7 │ ││5│ │ │% │ │  ← baseline at ascent
+ *     │ └──┘ │└─┘ │ └──┘ │
+ *     └──────┴────┴──────┘
+ *       cell   cell  cell
+ *
+ * =============================================================================
+ * FILE LAYOUT (little-endian)
+ * =============================================================================
+ *
+ *     Offset  Size   Field
+ *     ──────  ─────  ──────────────────────────────────────────
+ *     0       4      Magic "PFNT"
+ *     4       1      Version (1)
+ *     5       1      Bits per pixel (1, 2 or 4)
+ *     6       1      First character
+ *     7       1      Last character
+ *     8       1      Line height (pixels)
+ *     9       1      Ascent (line top to baseline)
+ *     10      2      Reserved (0)
+ *     12      10×N   Glyph table, one entry per character:
+ *                      u32 bitmap offset, u8 width, u8 height,
+ *                      u8 advance, u8 xOffset, u8 yOffset, u8 reserved
+ *     ...            Bitmaps: rows top to bottom, MSB-first, each row
+ *                    starting on a byte boundary
+ *
+ * Characters outside the range (or with advance 0) are drawn as '?' if
+ * the font has it, otherwise skipped.
+ *
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+
+/**
+ * @brief Fixed header size in bytes.
+ */
+inline constexpr size_t PACKED_FONT_HEADER_SIZE = 12;
+
+/**
+ * @brief Glyph table entry size in bytes.
+ */
+inline constexpr size_t PACKED_FONT_GLYPH_SIZE = 10;
+
+
+/**
+ * @brief Blend table for one text/background pair: coverage → wire bytes.
+ *
+ * @param color Text color (RGB565).
+ * @param bg Background color (RGB565).
+ * @param bpp Bits per pixel of the font.
+ * @param lut Output: (1 << bpp) entries of big-endian RGB565.
+ */
+inline void packedFontBlendLut(uint16_t color, uint16_t bg, uint8_t bpp, uint8_t lut[][2]) {
+    const int max = (1 << bpp) - 1;
+    const int fr = color >> 11, fg = (color >> 5) & 0x3F, fb = color & 0x1F;
+    const int br = bg >> 11, bgG = (bg >> 5) & 0x3F, bb = bg & 0x1F;
+
+    for (int a = 0; a <= max; a++) {
+        uint16_t c = ((br + ((fr - br) * a + max / 2) / max) << 11) |
+                     ((bgG + ((fg - bgG) * a + max / 2) / max) << 5) |
+                     (bb + ((fb - bb) * a + max / 2) / max);
+        lut[a][0] = c >> 8;
+        lut[a][1] = c & 0xFF;
+    }
+}
+
+
+/**
+ * @brief A parsed font, pointing into the original (flash) data.
+ */
+struct PackedFont {
+
+    /**
+     * @brief Metrics and bitmap position of one character.
+     */
+    struct Glyph {
+        uint32_t offset;    ///< Bitmap offset from the start of the bitmaps
+        uint8_t width;      ///< Bitmap width
+        uint8_t height;     ///< Bitmap height
+        uint8_t advance;    ///< Cell width (pen moves by this much)
+        uint8_t xOffset;    ///< Bitmap left edge in the cell
+        uint8_t yOffset;    ///< Bitmap top edge in the cell (from line top)
+    };
+
+    const uint8_t* data = nullptr;      ///< Start of the font (identifies it in caches)
+    uint8_t bpp = 1;
+    uint8_t first = 0;
+    uint8_t last = 0;
+    uint8_t lineHeight = 0;
+    uint8_t ascent = 0;
+
+
+    /**
+     * @brief Check the header and every glyph entry.
+     *
+     * @param fontData Start of the font (any alignment).
+     * @param size Size of the font in bytes.
+     *
+     * @return false if the data is not a valid font.
+     */
+    bool open(const uint8_t* fontData, size_t size) {
+        data = nullptr;
+        if (!fontData || size < PACKED_FONT_HEADER_SIZE) return false;
+        if (memcmp(fontData, "PFNT", 4) != 0 || fontData[4] != 1) return false;
+
+        uint8_t b = fontData[5];
+        uint8_t f = fontData[6];
+        uint8_t l = fontData[7];
+        if ((b != 1 && b != 2 && b != 4) || l < f || fontData[8] == 0) return false;
+
+        size_t count = l - f + 1;
+        size_t bitmapStart = PACKED_FONT_HEADER_SIZE + count * PACKED_FONT_GLYPH_SIZE;
+        if (bitmapStart > size) return false;
+
+        table = fontData + PACKED_FONT_HEADER_SIZE;
+        bitmaps = fontData + bitmapStart;
+        bpp = b;
+        first = f;
+        last = l;
+        lineHeight = fontData[8];
+        ascent = fontData[9];
+
+        // Bitmaps must fit their cell and the file: drawing never checks again
+        for (size_t i = 0; i < count; i++) {
+            Glyph g = entry(i);
+            if (g.xOffset + g.width > g.advance || g.yOffset + g.height > lineHeight ||
+                g.offset + (size_t)stride(g) * g.height > size - bitmapStart) {
+                return false;
+            }
+        }
+
+        fallback = ('?' >= first && '?' <= last && entry('?' - first).advance) ? '?' - first : -1;
+        data = fontData;
+        return true;
+    }
+
+
+    /**
+     * @brief True after a successful open().
+     */
+    bool isValid() const { return data != nullptr; }
+
+
+    /**
+     * @brief Glyph for a character ('?' or an empty glyph if missing).
+     */
+    Glyph glyph(char c) const {
+        uint8_t u = (uint8_t)c;
+        if (u >= first && u <= last) {
+            Glyph g = entry(u - first);
+            if (g.advance) return g;
+        }
+        if (fallback >= 0) return entry(fallback);
+        return Glyph{0, 0, 0, 0, 0, 0};
+    }
+
+
+    /**
+     * @brief Width in pixels of len characters (no newlines).
+     */
+    uint16_t textWidth(const char* str, size_t len) const {
+        uint16_t w = 0;
+        for (size_t i = 0; i < len; i++) w += glyph(str[i]).advance;
+        return w;
+    }
+
+
+    /**
+     * @brief Width in pixels of the widest line of a string.
+     */
+    uint16_t textWidth(const char* str) const {
+        uint16_t widest = 0;
+        while (true) {
+            const char* lineEnd = strchr(str, '\n');
+            size_t len = lineEnd ? (size_t)(lineEnd - str) : strlen(str);
+            uint16_t w = textWidth(str, len);
+            if (w > widest) widest = w;
+            if (!lineEnd) return widest;
+            str = lineEnd + 1;
+        }
+    }
+
+
+    /**
+     * @brief Render part of one row of a glyph cell as wire bytes.
+     *
+     * @param g Glyph from glyph().
+     * @param row Cell row (0 to lineHeight-1).
+     * @param col Cell column of the first pixel.
+     * @param count Pixels to render (col + count <= advance).
+     * @param lut Blend table from packedFontBlendLut().
+     * @param dst Output, 2 × count bytes.
+     */
+    void renderRow(const Glyph& g, uint8_t row, uint8_t col, uint8_t count,
+                   const uint8_t lut[][2], uint8_t* dst) const {
+        // Rows above/below the bitmap, and columns beside it, are background
+        bool inRows = row >= g.yOffset && row < g.yOffset + g.height;
+        const uint8_t* bits = inRows ? bitmaps + g.offset + (size_t)(row - g.yOffset) * stride(g) : nullptr;
+        const uint8_t mask = (1 << bpp) - 1;
+
+        for (uint8_t i = 0; i < count; i++) {
+            uint8_t a = 0;
+            int bx = col + i - g.xOffset;
+            if (bits && bx >= 0 && bx < g.width) {
+                uint32_t bit = (uint32_t)bx * bpp;
+                a = (bits[bit >> 3] >> (8 - bpp - (bit & 7))) & mask;
+            }
+            dst[2 * i] = lut[a][0];
+            dst[2 * i + 1] = lut[a][1];
+        }
+    }
+
+
+private:
+
+    const uint8_t* table = nullptr;
+    const uint8_t* bitmaps = nullptr;
+    int16_t fallback = -1;              // Glyph index of '?' (-1 = none)
+
+
+    Glyph entry(size_t index) const {
+        const uint8_t* e = table + index * PACKED_FONT_GLYPH_SIZE;
+        return Glyph{
+            (uint32_t)e[0] | ((uint32_t)e[1] << 8) | ((uint32_t)e[2] << 16) | ((uint32_t)e[3] << 24),
+            e[4], e[5], e[6], e[7], e[8]
+        };
+    }
+
+    uint16_t stride(const Glyph& g) const { return ((uint16_t)g.width * bpp + 7) / 8; }
+};
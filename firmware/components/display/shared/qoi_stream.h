@@ -0,0 +1,428 @@
+/**
+ * @file qoi_stream.h
+ * @brief Streaming QOI image decoder that draws into an RGB565 display.
+ *
+ * @details
+ * Decodes a QOI image (https://qoiformat.org) chunk by chunk, as the
+ * bytes arrive, and streams the pixels into one display window. No
+ * framebuffer: the decoder state is under 500 bytes whatever the image
+ * size, and the pixels go out through the driver's DMA buffers.
+ *
+ * Chunks can be any size and split the data anywhere, so the same code
+ * draws from:
+ * - Flash (embedded file or esp_partition_mmap(), one big chunk)
+ * - HTTP (WiFiHttpClient::getStream(), one chunk per network read)
+ * - ESP-NOW (one chunk per received packet, in order)
+ *
+ * Works with any Rgb565Display driver (GC9A01, ILI9341, ST7789, SSD1357).
+ *
+ * @note
+ * - The alpha channel is ignored (pixels are drawn opaque)
+ * - Images larger than the screen, or partly off screen, are clipped
+ *
+ * @par Usage
+ * @code
+ * QoiStream<ILI9341> qoi(display);
+ * qoi.begin(0, 0);
+ * int status = WiFiHttpClient::getStream("http://intercom.local/snapshot.qoi",
+ *     [](const uint8_t* data, size_t len, void* ctx) {
+ *         return static_cast<QoiStream<ILI9341>*>(ctx)->feed(data, len);
+ *     }, &qoi);
+ * if (!qoi.finish()) ESP_LOGW(TAG, "Image incomplete (HTTP %d)", status);
+ * @endcode
+ *
+ * finish() matters when the stream ends early (network error, 404, the
+ * callback gave up): the display window is still open with pixels
+ * staged, and the driver may hold the bus until endWrite().
+ *
+ * Any QOI encoder works, for example:
+ * python3 -c "from PIL import Image; Image.open('in.png').save('out.qoi')"
+ */
+
+/*
+ * =============================================================================
+ * BEGINNER'S GUIDE: QOI AND STREAMING
+ * =============================================================================
+ *
+ * A 320x240 RGB565 screen is 150 KB, too much to decode into RAM first.
+ * QOI ("Quite OK Image") is a lossless format simple enough to decode one
+ * pixel at a time, in order, with almost no state:
+ *
+ *     14-byte header (width, height, channels)
+ *     ops, each producing one or more pixels:
+ *
+ *     Op       Bytes  Meaning
+ *     ───────  ─────  ───────────────────────────────────────────
+ *     INDEX    1      Reuse one of the last 64 colors (by hash)
+ *     DIFF     1      Previous pixel ± a small difference
+ *     LUMA     2      Previous pixel + a green-based difference
+ *     RUN      1      Previous pixel repeated 1-62 times
+ *     RGB      4      Literal color
+ *     RGBA     5      Literal color with alpha
+ *
+ *     8-byte end marker
+ *
+ * The decoder only keeps the previous pixel and the 64-entry color table.
+ * An op split between two chunks (e.g. an RGB op at the end of a network
+ * packet) is held in a 5-byte carry buffer until the rest arrives.
+ *
+ *     feed(chunk) ─► decode ops ─► RGB565 ─► stage (64 px) ─► pushBytes()
+ *                                                              │
+ *                          display window (beginWrite) ◄───────┘
+ *
+ * Typical sizes: UI screenshots shrink to 5-20% of raw, photos to about
+ * 50-70%, so less data has to come over the air too.
+ *
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+
+/**
+ * @brief Streaming QOI decoder drawing into a display.
+ *
+ * @tparam Display Any Rgb565Display driver.
+ */
+template <typename Display>
+class QoiStream {
+
+public:
+
+    /**
+     * @brief Pixels staged before each pushBytes() call.
+     */
+    static constexpr uint16_t STAGE_PIXELS = 64;
+
+
+    explicit QoiStream(Display& display) : display(display) {
+        begin(0, 0);
+    }
+
+
+    /**
+     * @brief Start a new image.
+     *
+     * @param x Screen X of the image's left edge (may be off screen).
+     * @param y Screen Y of the image's top edge (may be off screen).
+     */
+    void begin(int16_t x, int16_t y) {
+        originX = x;
+        originY = y;
+        state = State::HEADER;
+        carryLen = 0;
+        width = height = 0;
+        pixelsLeft = 0;
+        stageCount = 0;
+        px[0] = px[1] = px[2] = 0;
+        px[3] = 255;
+        memset(index, 0, sizeof(index));
+    }
+
+
+    /**
+     * @brief Decode the next chunk of the file.
+     *
+     * @param data Chunk (any size, may split ops anywhere).
+     * @param len Chunk length in bytes.
+     *
+     * @return false if the data is not a valid QOI image (stop feeding).
+     *         Bytes after the last pixel are ignored.
+     */
+    bool feed(const uint8_t* data, size_t len) {
+        const uint8_t* end = data + len;
+
+        while (data < end) {
+            switch (state) {
+                case State::HEADER:
+                    data = takeHeader(data, end);
+                    break;
+
+                case State::PIXELS:
+                    data = takePixels(data, end);
+                    break;
+
+                case State::DONE:
+                    return true;
+
+                case State::FAILED:
+                case State::STOPPED:
+                    return false;
+            }
+        }
+        return state != State::FAILED && state != State::STOPPED;
+    }
+
+
+    /**
+     * @brief End the image, complete or not.
+     *
+     * @details Call after the last feed(). If the data stopped before
+     *          the last visible pixel, the staged pixels are sent and the
+     *          display window is closed (the rest of it keeps its old
+     *          content). Further feed() calls are rejected until begin().
+     *
+     * @return true if the whole image was drawn.
+     */
+    bool finish() {
+        if (state == State::PIXELS) {
+            flushStage();
+            display.endWrite();
+            state = State::STOPPED;
+        }
+        return state == State::DONE;
+    }
+
+
+    /**
+     * @brief True once every visible pixel has been drawn.
+     */
+    bool isDone() const { return state == State::DONE; }
+
+
+    /**
+     * @brief True if the header was invalid (or wider/taller than 65535).
+     */
+    bool hasError() const { return state == State::FAILED; }
+
+
+    /**
+     * @brief Image width (0 until the header has arrived).
+     */
+    uint32_t getWidth() const { return width; }
+
+
+    /**
+     * @brief Image height (0 until the header has arrived).
+     */
+    uint32_t getHeight() const { return height; }
+
+
+private:
+
+    enum class State : uint8_t { HEADER, PIXELS, DONE, FAILED, STOPPED };
+
+    static constexpr size_t HEADER_SIZE = 14;
+    static constexpr uint8_t OP_INDEX = 0x00;
+    static constexpr uint8_t OP_DIFF = 0x40;
+    static constexpr uint8_t OP_LUMA = 0x80;
+    static constexpr uint8_t OP_RUN = 0xC0;
+    static constexpr uint8_t OP_RGB = 0xFE;
+    static constexpr uint8_t OP_RGBA = 0xFF;
+    static constexpr uint8_t OP_MASK = 0xC0;
+
+    Display& display;
+    int16_t originX, originY;
+    State state;
+
+    uint8_t carry[HEADER_SIZE];     // Header or an op split across chunks
+    uint8_t carryLen;
+
+    uint32_t width, height;
+    uint32_t pixelsLeft;            // Pixels until the last visible row ends
+    uint32_t col, row;              // Position of the next pixel in the image
+    uint32_t visX0, visX1;          // Visible image columns
+    uint32_t visY0, visY1;          // Visible image rows
+    bool rowVisible;
+
+    uint8_t px[4];                  // Previous pixel (RGBA)
+    uint8_t index[64][4];           // Recently seen colors, by hash
+
+    uint8_t stage[STAGE_PIXELS * 2];
+    uint16_t stageCount;
+
+
+    /**
+     * @brief Collect the header and open the display window.
+     */
+    const uint8_t* takeHeader(const uint8_t* data, const uint8_t* end) {
+        size_t n = HEADER_SIZE - carryLen;
+        if (n > (size_t)(end - data)) n = end - data;
+        memcpy(carry + carryLen, data, n);
+        carryLen += n;
+        data += n;
+        if (carryLen < HEADER_SIZE) return data;
+        carryLen = 0;
+
+        width = read32(carry + 4);
+        height = read32(carry + 8);
+        uint8_t channels = carry[12];
+
+        if (memcmp(carry, "qoif", 4) != 0 || width == 0 || height == 0 ||
+            width > 0xFFFF || height > 0xFFFF || (channels != 3 && channels != 4)) {
+            state = State::FAILED;
+            return end;
+        }
+
+        // Clip the image to the screen (in image coordinates)
+        int32_t x0 = originX < 0 ? -originX : 0;
+        int32_t y0 = originY < 0 ? -originY : 0;
+        int32_t x1 = (int32_t)display.getWidth() - 1 - originX;
+        int32_t y1 = (int32_t)display.getHeight() - 1 - originY;
+        if (x1 > (int32_t)width - 1) x1 = width - 1;
+        if (y1 > (int32_t)height - 1) y1 = height - 1;
+
+        if (x0 > x1 || y0 > y1) {
+            state = State::DONE;    // Entirely off screen
+            return end;
+        }
+
+        visX0 = x0;
+        visX1 = x1;
+        visY0 = y0;
+        visY1 = y1;
+        col = 0;
+        row = 0;
+        rowVisible = visY0 == 0;
+        pixelsLeft = (visY1 + 1) * width;  // Rows below the screen are not decoded
+
+        display.beginWrite(originX + x0, originY + y0, originX + x1, originY + y1);
+        state = State::PIXELS;
+        return data;
+    }
+
+
+    /**
+     * @brief Decode ops until the chunk or the image ends.
+     */
+    const uint8_t* takePixels(const uint8_t* data, const uint8_t* end) {
+        // Finish an op left over from the previous chunk
+        if (carryLen > 0) {
+            size_t need = opLength(carry[0]) - carryLen;
+            size_t n = need < (size_t)(end - data) ? need : end - data;
+            memcpy(carry + carryLen, data, n);
+            carryLen += n;
+            data += n;
+            if (n < need) return data;
+            carryLen = 0;
+            decodeOp(carry);
+        }
+
+        while (pixelsLeft > 0 && data < end) {
+            size_t n = opLength(*data);
+            if (n > (size_t)(end - data)) {
+                carryLen = end - data;
+                memcpy(carry, data, carryLen);
+                return end;
+            }
+            decodeOp(data);
+            data += n;
+        }
+
+        if (pixelsLeft == 0) {
+            flushStage();
+            display.endWrite();
+            state = State::DONE;
+        }
+        return data;
+    }
+
+
+    static size_t opLength(uint8_t op) {
+        if (op == OP_RGB) return 4;
+        if (op == OP_RGBA) return 5;
+        if ((op & OP_MASK) == OP_LUMA) return 2;
+        return 1;
+    }
+
+
+    /**
+     * @brief Decode one complete op and emit its pixels.
+     */
+    void decodeOp(const uint8_t* op) {
+        uint8_t b = op[0];
+        uint32_t run = 1;
+
+        if (b == OP_RGB) {
+            px[0] = op[1];
+            px[1] = op[2];
+            px[2] = op[3];
+        } else if (b == OP_RGBA) {
+            memcpy(px, op + 1, 4);
+        } else {
+            switch (b & OP_MASK) {
+                case OP_INDEX:
+                    memcpy(px, index[b], 4);
+                    break;
+
+                case OP_DIFF:
+                    px[0] += ((b >> 4) & 3) - 2;
+                    px[1] += ((b >> 2) & 3) - 2;
+                    px[2] += (b & 3) - 2;
+                    break;
+
+                case OP_LUMA: {
+                    int dg = (b & 0x3F) - 32;
+                    px[0] += dg - 8 + (op[1] >> 4);
+                    px[1] += dg;
+                    px[2] += dg - 8 + (op[1] & 0x0F);
+                    break;
+                }
+
+                default:    // OP_RUN
+                    run = (b & 0x3F) + 1;
+                    break;
+            }
+        }
+
+        memcpy(index[(px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) & 63], px, 4);
+
+        if (run > pixelsLeft) run = pixelsLeft;
+        pixelsLeft -= run;
+        emit(((px[0] & 0xF8) << 8) | ((px[1] & 0xFC) << 3) | (px[2] >> 3), run);
+    }
+
+
+    /**
+     * @brief Place count pixels of one color, dropping the clipped ones.
+     */
+    void emit(uint16_t color, uint32_t count) {
+        // Common case: one visible pixel in the middle of a row
+        if (count == 1 && rowVisible && col >= visX0 && col <= visX1 && col + 1 < width) {
+            stage[2 * stageCount] = color >> 8;
+            stage[2 * stageCount + 1] = color & 0xFF;
+            if (++stageCount == STAGE_PIXELS) flushStage();
+            col++;
+            return;
+        }
+
+        while (count > 0) {
+            uint32_t n = width - col;
+            if (n > count) n = count;
+
+            if (rowVisible) {
+                uint32_t a = col > visX0 ? col : visX0;
+                uint32_t b = col + n - 1 < visX1 ? col + n - 1 : visX1;
+                for (uint32_t i = a; i <= b; i++) {
+                    stage[2 * stageCount] = color >> 8;
+                    stage[2 * stageCount + 1] = color & 0xFF;
+                    if (++stageCount == STAGE_PIXELS) flushStage();
+                }
+            }
+
+            col += n;
+            count -= n;
+            if (col == width) {
+                col = 0;
+                row++;
+                rowVisible = row >= visY0 && row <= visY1;
+            }
+        }
+    }
+
+
+    void flushStage() {
+        if (stageCount == 0) return;
+        display.pushBytes(stage, (size_t)stageCount * 2);
+        stageCount = 0;
+    }
+
+
+    static uint32_t read32(const uint8_t* p) {
+        return ((uint32_t)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+    }
+};
@@ -0,0 +1,258 @@
+/**
+ * @file rgb565_asset.h
+ * @brief Compressed RGB565 image format for icons and sprites.
+ *
+ * @details
+ * Images are converted on the PC (firmware/tools/rgb565_asset.py) and
+ * drawn straight from flash with Rgb565Display::drawBitmap() /
+ * drawSprite(). Rows are decoded directly into the DMA buffers; nothing
+ * is copied to RAM first.
+ *
+ * The data can live anywhere the CPU can read:
+ * - Embedded in the app (EMBED_FILES or a generated C array, in rodata)
+ * - A data partition mapped with esp_partition_mmap()
+ *
+ * @par Usage
+ * @code
+ * extern const uint8_t bulb_start[] asm("_binary_bulb_r565_start");
+ * extern const uint8_t bulb_end[]   asm("_binary_bulb_r565_end");
+ *
+ * Rgb565Asset bulb;
+ * if (bulb.open(bulb_start, bulb_end - bulb_start)) {
+ *     display.drawSprite(20, 40, bulb);
+ * }
+ * @endcode
+ */
+
+/*
+ * =============================================================================
+ * BEGINNER'S GUIDE: WHY COMPRESS ICONS?
+ * =============================================================================
+ *
+ * A raw 48x48 RGB565 icon is 48 × 48 × 2 = 4608 bytes. UI icons are
+ * mostly flat colors, so long stretches of a row repeat the same pixel:
+ *
+ *     raw:   ■■■■■■■■■■■■□□□□■■■■■■■■■■■■      28 pixels = 56 bytes
+ *     RLE:   [12 × ■] [4 × □] [12 × ■]          3 packets =  9 bytes
+ *
+ * Icons with few colors compress further with a palette: each pixel
+ * becomes a 1-byte index into a table of up to 256 RGB565 colors.
+ *
+ * =============================================================================
+ * FILE LAYOUT (little-endian header, big-endian pixels)
+ * =============================================================================
+ *
+ *     Offset  Size  Field
+ *     ──────  ────  ─────────────────────────────────────────────
+ *     0       4     Magic "R565"
+ *     4       1     Version (1)
+ *     5       1     Encoding: 0 = raw, 1 = RLE, 2 = palette + RLE
+ *     6       2     Flags: bit 0 = transparent key is valid
+ *     8       2     Width
+ *     10      2     Height
+ *     12      2     Transparent key (RGB565)
+ *     14      2     Palette entries (0-256)
+ *     16      2×P   Palette, big-endian RGB565
+ *     ...     4×H   Row index (RLE encodings only): offset of each row
+ *                   from the start of the pixel data
+ *     ...           Pixel data
+ *
+ * Pixels are stored big-endian, the order the panel wants on the wire,
+ * so raw rows and RLE literals are plain copies.
+ *
+ * RLE PACKETS (one row never continues into the next):
+ *
+ *     1nnnnnnn  value           run: value repeated n+1 times (1-128)
+ *     0nnnnnnn  value × (n+1)   literal: n+1 different values
+ *
+ *     value = 2 bytes RGB565 (RLE) or 1 byte palette index (palette)
+ *
+ * The row index lets clipped draws start in the middle of the image
+ * without decoding the rows above.
+ *
+ * =============================================================================
+ * TRANSPARENCY
+ * =============================================================================
+ *
+ * One RGB565 value is chosen as the key (the converter uses it for
+ * transparent PNG pixels). drawSprite() leaves key pixels untouched;
+ * drawBitmap() draws them like any other color.
+ *
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+
+/**
+ * @brief Pixel encodings.
+ */
+inline constexpr uint8_t RGB565_ASSET_RAW = 0;
+inline constexpr uint8_t RGB565_ASSET_RLE = 1;
+inline constexpr uint8_t RGB565_ASSET_PALETTE = 2;
+
+/**
+ * @brief Header flag: the transparent key is valid.
+ */
+inline constexpr uint16_t RGB565_ASSET_HAS_KEY = 0x0001;
+
+/**
+ * @brief Fixed header size in bytes.
+ */
+inline constexpr size_t RGB565_ASSET_HEADER_SIZE = 16;
+
+
+/**
+ * @brief A parsed image, pointing into the original (flash) data.
+ */
+struct Rgb565Asset {
+    uint16_t width = 0;
+    uint16_t height = 0;
+    uint8_t encoding = RGB565_ASSET_RAW;
+    bool hasKey = false;
+    uint16_t key = 0;                   ///< Transparent color (RGB565)
+    uint16_t paletteSize = 0;
+    const uint8_t* palette = nullptr;   ///< Big-endian RGB565 entries
+    const uint8_t* rowIndex = nullptr;  ///< height × uint32 LE (RLE encodings)
+    const uint8_t* pixels = nullptr;
+    size_t pixelBytes = 0;
+
+
+    /**
+     * @brief Check the header and point at the image data.
+     *
+     * @param data Start of the asset (any alignment).
+     * @param size Size of the asset in bytes.
+     *
+     * @return false if the data is not a valid asset.
+     */
+    bool open(const uint8_t* data, size_t size) {
+        width = height = 0;
+        if (!data || size < RGB565_ASSET_HEADER_SIZE) return false;
+        if (memcmp(data, "R565", 4) != 0 || data[4] != 1) return false;
+
+        uint8_t enc = data[5];
+        uint16_t flags = read16(data + 6);
+        uint16_t w = read16(data + 8);
+        uint16_t h = read16(data + 10);
+        uint16_t entries = read16(data + 14);
+
+        if (enc > RGB565_ASSET_PALETTE || w == 0 || h == 0 || entries > 256) return false;
+        if (enc == RGB565_ASSET_PALETTE && entries == 0) return false;
+
+        size_t offset = RGB565_ASSET_HEADER_SIZE + (size_t)entries * 2;
+        size_t indexBytes = enc == RGB565_ASSET_RAW ? 0 : (size_t)h * 4;
+        if (offset + indexBytes > size) return false;
+
+        size_t dataBytes = size - offset - indexBytes;
+        if (enc == RGB565_ASSET_RAW && dataBytes < (size_t)w * h * 2) return false;
+
+        // Every row must start inside the pixel data
+        for (uint16_t y = 0; y < (indexBytes ? h : 0); y++) {
+            if (read32(data + offset + (size_t)y * 4) >= dataBytes) return false;
+        }
+
+        encoding = enc;
+        hasKey = (flags & RGB565_ASSET_HAS_KEY) != 0;
+        key = read16(data + 12);
+        paletteSize = entries;
+        palette = data + RGB565_ASSET_HEADER_SIZE;
+        rowIndex = indexBytes ? data + offset : nullptr;
+        pixels = data + offset + indexBytes;
+        pixelBytes = dataBytes;
+        width = w;
+        height = h;
+        return true;
+    }
+
+
+    /**
+     * @brief Decode part of a row as big-endian RGB565.
+     *
+     * @param y Row (0 to height-1).
+     * @param x0 First column to decode.
+     * @param count Pixels to decode (x0 + count <= width).
+     * @param dst Output, 2 × count bytes.
+     *
+     * @details
+     * RLE rows are walked packet by packet; packets left of x0 are
+     * skipped without expanding them. Corrupt rows end early (the rest of
+     * dst is left as is).
+     */
+    void decodeRow(uint16_t y, uint16_t x0, uint16_t count, uint8_t* dst) const {
+        if (encoding == RGB565_ASSET_RAW) {
+            memcpy(dst, pixels + ((size_t)y * width + x0) * 2, (size_t)count * 2);
+            return;
+        }
+
+        const bool indexed = encoding == RGB565_ASSET_PALETTE;
+        const size_t valueBytes = indexed ? 1 : 2;
+        const uint8_t* src = pixels + read32(rowIndex + (size_t)y * 4);
+        const uint8_t* end = pixels + pixelBytes;
+        uint32_t skip = x0;
+
+        while (count > 0 && src < end) {
+            uint8_t ctrl = *src++;
+            bool run = (ctrl & 0x80) != 0;
+            uint32_t n = (ctrl & 0x7F) + 1;
+            size_t packetBytes = run ? valueBytes : n * valueBytes;
+            if (src + packetBytes > end) return;
+
+            if (skip >= n) {
+                skip -= n;
+                src += packetBytes;
+                continue;
+            }
+
+            uint32_t take = n - skip;
+            if (take > count) take = count;
+
+            if (run) {
+                uint8_t hi, lo;
+                color(src, indexed, hi, lo);
+                for (uint32_t i = 0; i < take; i++) {
+                    dst[2 * i] = hi;
+                    dst[2 * i + 1] = lo;
+                }
+            } else if (indexed) {
+                for (uint32_t i = 0; i < take; i++) {
+                    color(src + skip + i, true, dst[2 * i], dst[2 * i + 1]);
+                }
+            } else {
+                memcpy(dst, src + skip * 2, take * 2);
+            }
+
+            dst += take * 2;
+            count -= take;
+            skip = 0;
+            src += packetBytes;
+        }
+    }
+
+
+private:
+
+    static uint16_t read16(const uint8_t* p) { return p[0] | (p[1] << 8); }
+
+    static uint32_t read32(const uint8_t* p) {
+        return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+
+    /**
+     * @brief Big-endian bytes of one stored value (RGB565 or palette index).
+     */
+    void color(const uint8_t* value, bool indexed, uint8_t& hi, uint8_t& lo) const {
+        if (indexed) {
+            uint16_t i = *value < paletteSize ? *value : 0;
+            hi = palette[2 * i];
+            lo = palette[2 * i + 1];
+        } else {
+            hi = value[0];
+            lo = value[1];
+        }
+    }
+};
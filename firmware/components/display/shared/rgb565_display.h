@@ -0,0 +1,1780 @@
+/**
+ * @file rgb565_display.h
+ * @brief Shared core for the SPI RGB565 display drivers (ESP-IDF).
+ *
+ * @details
+ * ILI9341, ST7789, GC9A01 and SSD1357 all speak the same language:
+ * open a window (column range, row range, write RAM), then stream
+ * big-endian RGB565 pixels with DC high. This header implements that
+ * once, as a template specialized at compile time by a panel traits
+ * struct:
+ *
+ * - SPI transport (blocking or queued ping-pong DMA)
+ * - Address window with caching (see window_cache.h)
+ * - Clipping (screen and an optional clip rectangle), fills, lines,
+ *   circles, arcs (see arc_spans.h)
+ * - 5x7 text runs (see font_5x7.h)
+ * - Proportional anti-aliased text (see packed_font.h, glyph_cache.h)
+ * - Compressed bitmaps and sprites (see rgb565_asset.h)
+ * - Batch pixel writes (beginWrite / pushPixels / endWrite)
+ * - Drawing into memory (beginCapture / endCapture) for composing
+ * - Rotation and offsets
+ * - Row masks for panels that do not show the whole RAM (round glass)
+ *
+ * The drivers keep only what is really panel-specific: pins, backlight,
+ * the init table, partial mode and scrolling.
+ *
+ * @par Panel traits
+ * @code
+ * struct MyPanel {
+ *     static constexpr const char* NAME = "MYPANEL";   // Log tag
+ *     static constexpr uint16_t WIDTH = 240;           // Native width
+ *     static constexpr uint16_t HEIGHT = 320;          // Native height
+ *     static constexpr int SPI_CLOCK_HZ = 20000000;
+ *     static constexpr uint8_t CMD_COLUMN = 0x2A;      // Column range command
+ *     static constexpr uint8_t CMD_ROW = 0x2B;         // Row range command
+ *     static constexpr uint8_t CMD_WRITE = 0x2C;       // Write RAM command
+ *     static constexpr bool WINDOW_16BIT = true;       // 16-bit or 8-bit range params
+ *     static constexpr bool HAS_ROTATION = true;       // MADCTL rotation supported
+ *     static constexpr uint8_t CMD_MADCTL = 0x36;
+ *     static constexpr uint8_t MADCTL[4] = {0x48, 0x28, 0x88, 0xE8};
+ *     static constexpr uint16_t RESET_PULSE_MS = 10;   // RST low time
+ *     static constexpr uint16_t RESET_SETTLE_MS = 120; // Wait after RST high
+ *     static const uint8_t INIT_TABLE[];               // See runInitTable()
+ * };
+ *
+ * class MyDisplay : public Rgb565Display<MyPanel> { ... };
+ * @endcode
+ */
+
+/*
+ * =============================================================================
+ * WHY A SHARED TEMPLATE?
+ * =============================================================================
+ *
+ * The four RGB565 drivers used to carry their own copies of drawHLine,
+ * fillRect, drawCircle, drawChar... with the same 64/512-byte buffers.
+ * Every optimization had to be written four times, and usually only
+ * landed in one driver.
+ *
+ * With a template, each driver gets its own specialized copy generated
+ * by the compiler:
+ *
+ *     Rgb565Display<ILI9341Panel>   → CASET/PASET, 16-bit, 4 rotations
+ *     Rgb565Display<SSD1357Panel>   → 0x15/0x75, 8-bit, no rotation
+ *
+ * Panel constants (window commands, parameter width, buffer sizes) fold
+ * at compile time: no virtual calls, no runtime "which panel" branches.
+ *
+ * =============================================================================
+ * INIT TABLES
+ * =============================================================================
+ *
+ * Instead of hundreds of sendCommand()/sendData() calls, each panel
+ * describes its power-up sequence as bytes:
+ *
+ *     command, argc [| DISPLAY_INIT_DELAY], args..., [delay ms]
+ *     ...
+ *     0x00, DISPLAY_INIT_END
+ *
+ *     Example:
+ *         0x3A, 1, 0x55,                       // Pixel format: RGB565
+ *         0x11, DISPLAY_INIT_DELAY, 120,       // Sleep out, wait 120 ms
+ *         0x00, DISPLAY_INIT_END
+ *
+ * Parameters of one command go out in a single SPI transaction.
+ *
+ * =============================================================================
+ * PIXEL PIPELINE
+ * =============================================================================
+ *
+ * Pixels are produced straight into one of two DMA buffers (internal RAM).
+ * In queued mode (default) the filled buffer is handed to
+ * spi_device_queue_trans() and the CPU moves on to the other one:
+ *
+ *     CPU:   fill A ─ fill B ─ wait A, fill A ─ wait B, fill B ─ ...
+ *     SPI:          send A ─── send B ──────── send A ──────── ...
+ *
+ * DC stays high for the whole time pixels are queued: every command first
+ * waits for the queue to drain (flush), so no pre-transfer callback is
+ * needed to switch DC in the middle of the queue.
+ *
+ * A buffer that already holds the right solid color is reused as-is, so
+ * a big fill costs one buffer write per buffer, not per chunk.
+ *
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <driver/spi_master.h>
+#include <driver/gpio.h>
+#include <esp_heap_caps.h>
+#include <esp_log.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arc_spans.h"
+#include "font_5x7.h"
+#include "glyph_cache.h"
+#include "packed_font.h"
+#include "rgb565_asset.h"
+#include "span_raster.h"
+#include "window_cache.h"
+
+
+/**
+ * @brief Init table flag: a delay byte (ms) follows the arguments.
+ */
+inline constexpr uint8_t DISPLAY_INIT_DELAY = 0x80;
+
+/**
+ * @brief Init table terminator (in the argc position).
+ */
+inline constexpr uint8_t DISPLAY_INIT_END = 0xFF;
+
+
+/**
+ * @class Rgb565Display
+ * @brief Drawing core shared by the SPI RGB565 drivers.
+ *
+ * @tparam Panel Traits struct describing the controller (see file header).
+ */
+template <typename Panel>
+class Rgb565Display {
+
+public:
+
+    /**
+     * @brief Size of each DMA pixel buffer in bytes (fixed per panel).
+     */
+    static constexpr size_t BUF_BYTES =
+        (size_t)Panel::WIDTH * Panel::HEIGHT * 2 < 4096
+            ? (size_t)Panel::WIDTH * Panel::HEIGHT * 2 : 4096;
+
+    /**
+     * @brief Pixels per DMA buffer.
+     */
+    static constexpr size_t BUF_PIXELS = BUF_BYTES / 2;
+
+    /**
+     * @brief Fills up to this many pixels skip the DMA queue (blocking send).
+     */
+    static constexpr uint32_t SMALL_FILL_PIXELS = 16;
+
+    /**
+     * @brief Longest screen row in any rotation (sprite line buffer size).
+     */
+    static constexpr uint16_t LINE_PIXELS =
+        Panel::WIDTH > Panel::HEIGHT ? Panel::WIDTH : Panel::HEIGHT;
+
+    /**
+     * @brief Characters per drawText() window (longer lines use several).
+     */
+    static constexpr uint8_t FONT_RUN_CHARS = 32;
+
+    static_assert(BUF_BYTES % 4 == 0, "DMA buffer must hold whole 32-bit words");
+
+
+    Rgb565Display(const Rgb565Display&) = delete;
+    Rgb565Display& operator=(const Rgb565Display&) = delete;
+
+
+    /**
+     * @brief Fill entire screen with a color.
+     *
+     * @param color RGB565 color value.
+     */
+    void fillScreen(uint16_t color) {
+        fillRect(0, 0, width, height, color);
+    }
+
+
+    /**
+     * @brief Draw a single pixel.
+     *
+     * @param x X coordinate.
+     * @param y Y coordinate.
+     * @param color RGB565 color value.
+     */
+    void drawPixel(int16_t x, int16_t y, uint16_t color) {
+        if (x < clipX0 || x > clipX1 || y < clipY0 || y > clipY1) return;
+
+        setWindow(x, y, x, y);
+        sendData16(color);
+    }
+
+
+    /**
+     * @brief Draw a horizontal line.
+     *
+     * @param x Starting X position.
+     * @param y Y position.
+     * @param w Line width in pixels.
+     * @param color RGB565 color value.
+     */
+    void drawHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+        fillRect(x, y, w, 1, color);
+    }
+
+
+    /**
+     * @brief Draw a vertical line.
+     *
+     * @param x X position.
+     * @param y Starting Y position.
+     * @param h Line height in pixels.
+     * @param color RGB565 color value.
+     */
+    void drawVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+        fillRect(x, y, 1, h, color);
+    }
+
+
+    /**
+     * @brief Draw a line between two points.
+     *
+     * @param x0 Start X.
+     * @param y0 Start Y.
+     * @param x1 End X.
+     * @param y1 End Y.
+     * @param color RGB565 color value.
+     */
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+        if (y0 == y1) {
+            if (x0 > x1) { int16_t t = x0; x0 = x1; x1 = t; }
+            drawHLine(x0, y0, x1 - x0 + 1, color);
+            return;
+        }
+        if (x0 == x1) {
+            if (y0 > y1) { int16_t t = y0; y0 = y1; y1 = t; }
+            drawVLine(x0, y0, y1 - y0 + 1, color);
+            return;
+        }
+
+        // Bresenham, sent as horizontal/vertical runs (see span_raster.h)
+        auto sink = spanSink(color);
+        rasterLine(x0, y0, x1, y1, sink);
+        sink.flush();
+    }
+
+
+    /**
+     * @brief Draw a closed polygon outline.
+     *
+     * @param xy Vertices as x0, y0, x1, y1, ...
+     * @param count Number of vertices.
+     * @param color RGB565 color value.
+     */
+    void drawPolygon(const int16_t* xy, int count, uint16_t color) {
+        auto sink = spanSink(color);
+        rasterPolygon(xy, count, sink);
+        sink.flush();
+    }
+
+
+    /**
+     * @brief Draw a rectangle outline.
+     *
+     * @param x Top-left X.
+     * @param y Top-left Y.
+     * @param w Rectangle width.
+     * @param h Rectangle height.
+     * @param color RGB565 color value.
+     */
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        drawHLine(x, y, w, color);
+        drawHLine(x, y + h - 1, w, color);
+        drawVLine(x, y, h, color);
+        drawVLine(x + w - 1, y, h, color);
+    }
+
+
+    /**
+     * @brief Draw a filled rectangle.
+     *
+     * @param x Top-left X.
+     * @param y Top-left Y.
+     * @param w Rectangle width.
+     * @param h Rectangle height.
+     * @param color RGB565 color value.
+     */
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        if (!clip(x, y, w, h)) return;
+
+        if (rowInsets) {
+            fillMasked(x, y, x + w - 1, y + h - 1, color);
+            return;
+        }
+
+        setWindow(x, y, x + w - 1, y + h - 1);
+        writeColor(color, (uint32_t)w * h);
+    }
+
+
+    /**
+     * @brief Draw a circle outline.
+     *
+     * @param cx Center X.
+     * @param cy Center Y.
+     * @param radius Circle radius.
+     * @param color RGB565 color value.
+     */
+    void drawCircle(int16_t cx, int16_t cy, int16_t radius, uint16_t color) {
+        auto sink = spanSink(color);
+        rasterCircle(cx, cy, radius, sink);
+        sink.flush();
+    }
+
+
+    /**
+     * @brief Draw a filled circle.
+     *
+     * @param cx Center X.
+     * @param cy Center Y.
+     * @param radius Circle radius.
+     * @param color RGB565 color value.
+     *
+     * @details
+     * One horizontal span per row; rows of equal width share one rectangle.
+     */
+    void fillCircle(int16_t cx, int16_t cy, int16_t radius, uint16_t color) {
+        auto sink = spanSink(color);
+        rasterFillCircle(cx, cy, radius, sink);
+        sink.flush();
+    }
+
+
+    /**
+     * @brief Draw a ring segment (filled arc).
+     *
+     * @param arc Row extents of the ring (ArcSpanTable::init() done).
+     * @param cx Center X.
+     * @param cy Center Y.
+     * @param startDeg Start angle (0 = top, clockwise).
+     * @param endDeg End angle (startDeg + 360 or more = full ring).
+     * @param color RGB565 color value.
+     *
+     * @details
+     * Rendered as at most two spans per half-row (see arc_spans.h).
+     */
+    void fillArc(const ArcSpanTable& arc, int16_t cx, int16_t cy,
+                 int startDeg, int endDeg, uint16_t color) {
+        if (endDeg <= startDeg) return;
+        fillArcSpans(arc, cx, cy, ArcSweep::fromDegrees(startDeg, endDeg), color);
+    }
+
+
+    /**
+     * @brief Move the end of an arc, drawing only the slice that changed.
+     *
+     * @param arc Row extents of the ring.
+     * @param cx Center X.
+     * @param cy Center Y.
+     * @param startDeg Fixed start of the arc.
+     * @param oldEndDeg End angle currently on screen.
+     * @param newEndDeg End angle to show.
+     * @param color Arc color (RGB565).
+     * @param bg Background color for the erased slice (RGB565).
+     *
+     * @details
+     * Growing paints [old, new] in color; shrinking paints (new, old] in
+     * bg. Meant for level dials where only the end moves.
+     */
+    void fillArcDelta(const ArcSpanTable& arc, int16_t cx, int16_t cy, int startDeg,
+                      int oldEndDeg, int newEndDeg, uint16_t color, uint16_t bg) {
+        if (newEndDeg > oldEndDeg) {
+            int from = oldEndDeg > startDeg ? oldEndDeg : startDeg;
+            if (newEndDeg > from) {
+                fillArcSpans(arc, cx, cy, ArcSweep::fromDegrees(from, newEndDeg), color);
+            }
+        } else if (newEndDeg < oldEndDeg && oldEndDeg > startDeg) {
+            // Keep the new end ray unless the arc is now empty, and the
+            // start ray when the old end was a full turn (same ray)
+            bool empty = newEndDeg <= startDeg;
+            bool wasFull = oldEndDeg >= startDeg + 360;
+            int from = empty ? startDeg : newEndDeg;
+            int to = wasFull ? startDeg + 360 : oldEndDeg;
+            fillArcSpans(arc, cx, cy,
+                         ArcSweep::fromDegrees(from, to, !empty, wasFull && !empty), bg);
+        }
+    }
+
+
+    /**
+     * @brief Draw a single character.
+     *
+     * @param x Top-left X position.
+     * @param y Top-left Y position.
+     * @param c Character to draw.
+     * @param color Text color (RGB565).
+     * @param bg Background color (RGB565).
+     * @param size Font scale (1 = 5x7, 2 = 10x14, etc.)
+     *
+     * @return Width of character drawn.
+     */
+    uint8_t drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size = 1) {
+        drawTextRun(x, y, &c, 1, color, bg, size);
+        return FONT_5X7_CELL_WIDTH * size;
+    }
+
+
+    /**
+     * @brief Draw a string.
+     *
+     * @param x Starting X position.
+     * @param y Starting Y position.
+     * @param str Null-terminated string ('\n' starts a new line).
+     * @param color Text color (RGB565).
+     * @param bg Background color (RGB565).
+     * @param size Font scale (1 = 5x7, 2 = 10x14, etc.)
+     */
+    void drawString(int16_t x, int16_t y, const char* str, uint16_t color,
+                    uint16_t bg = 0x0000, uint8_t size = 1) {
+        while (*str) {
+            const char* lineEnd = strchr(str, '\n');
+            size_t len = lineEnd ? (size_t)(lineEnd - str) : strlen(str);
+
+            drawTextRun(x, y, str, len, color, bg, size);
+
+            if (!lineEnd) break;
+            str = lineEnd + 1;
+            y += 8 * size;
+        }
+    }
+
+
+    /**
+     * @brief Draw a string in a converted font (see packed_font.h).
+     *
+     * @param x Left edge.
+     * @param y Top of the line (the baseline is font.ascent below).
+     * @param font Font opened with PackedFont::open().
+     * @param str Null-terminated string ('\n' starts a new line).
+     * @param color Text color (RGB565).
+     * @param bg Background color (RGB565); anti-aliased edges blend into it.
+     * @param cache Optional glyph cache: repeated glyphs are copied
+     *              instead of rendered.
+     *
+     * @details
+     * Text is opaque: each line is one window of its glyph cells (width
+     * from font.textWidth(), height font.lineHeight), streamed row by row
+     * through the DMA buffers.
+     */
+    void drawText(int16_t x, int16_t y, const PackedFont& font, const char* str,
+                  uint16_t color, uint16_t bg = 0x0000, GlyphCache* cache = nullptr) {
+        if (!font.isValid()) return;
+
+        uint8_t lut[16][2];
+        packedFontBlendLut(color, bg, font.bpp, lut);
+
+        while (*str) {
+            const char* lineEnd = strchr(str, '\n');
+            size_t len = lineEnd ? (size_t)(lineEnd - str) : strlen(str);
+
+            int16_t penX = x;
+            for (size_t done = 0; done < len; done += FONT_RUN_CHARS) {
+                size_t n = len - done < FONT_RUN_CHARS ? len - done : FONT_RUN_CHARS;
+                penX += drawFontRun(penX, y, font, str + done, n, color, bg, lut, cache);
+            }
+
+            if (!lineEnd) break;
+            str = lineEnd + 1;
+            y += font.lineHeight;
+        }
+    }
+
+
+    /**
+     * @brief Draw an image, every pixel opaque.
+     *
+     * @param x Left edge (may be off screen).
+     * @param y Top edge (may be off screen).
+     * @param asset Image opened with Rgb565Asset::open().
+     *
+     * @details
+     * One window for the visible part; rows are decoded from flash
+     * straight into the DMA buffers. The transparent key, if any, is
+     * drawn as a normal color (see drawSprite()).
+     */
+    void drawBitmap(int16_t x, int16_t y, const Rgb565Asset& asset) {
+        int16_t cx = x, cy = y, w = asset.width, h = asset.height;
+        if (!clip(cx, cy, w, h)) return;
+
+        uint16_t sx = cx - x;
+        uint16_t sy = cy - y;
+
+        // Round glass: go through the masked stream, one row at a time
+        if (rowInsets) {
+            uint8_t line[LINE_PIXELS * 2];
+            beginWrite(cx, cy, cx + w - 1, cy + h - 1);
+            for (int16_t row = 0; row < h; row++) {
+                asset.decodeRow(sy + row, sx, w, line);
+                pushBytes(line, (size_t)w * 2);
+            }
+            endWrite();
+            return;
+        }
+
+        setWindow(cx, cy, cx + w - 1, cy + h - 1);
+
+        uint8_t* buf = pixelBuffer();
+        size_t bufIdx = 0;
+
+        for (int16_t row = 0; row < h; row++) {
+            int16_t done = 0;
+
+            // Rows wider than the buffer are split across several bursts
+            while (done < w) {
+                if (bufIdx + 2 > BUF_BYTES) {
+                    sendPixelBuffer(bufIdx);
+                    buf = pixelBuffer();
+                    bufIdx = 0;
+                }
+
+                int16_t n = (BUF_BYTES - bufIdx) / 2;
+                if (n > w - done) n = w - done;
+
+                asset.decodeRow(sy + row, sx + done, n, &buf[bufIdx]);
+                bufIdx += n * 2;
+                done += n;
+            }
+        }
+
+        sendPixelBuffer(bufIdx);
+    }
+
+
+    /**
+     * @brief Draw an image, leaving transparent-key pixels untouched.
+     *
+     * @param x Left edge (may be off screen).
+     * @param y Top edge (may be off screen).
+     * @param asset Image opened with Rgb565Asset::open().
+     *
+     * @details
+     * Each row is cut into runs of opaque pixels, one window per run.
+     * A run with the same columns as the one on the row above continues
+     * that window, so a sprite with a solid middle costs few commands.
+     * Without a key this is drawBitmap().
+     */
+    void drawSprite(int16_t x, int16_t y, const Rgb565Asset& asset) {
+        if (!asset.hasKey) {
+            drawBitmap(x, y, asset);
+            return;
+        }
+
+        int16_t cx = x, cy = y, w = asset.width, h = asset.height;
+        if (!clip(cx, cy, w, h)) return;
+
+        const uint8_t keyHi = asset.key >> 8;
+        const uint8_t keyLo = asset.key & 0xFF;
+        const int16_t bottom = cy + h - 1;
+
+        uint8_t line[LINE_PIXELS * 2];
+        int16_t openX0 = 0, openX1 = -1;   // Columns of the open window
+        int16_t openNextY = -1;            // Row the open window writes next
+
+        for (int16_t py = cy; py <= bottom; py++) {
+            asset.decodeRow(py - y, cx - x, w, line);
+
+            int16_t i = 0;
+            while (i < w) {
+                // Skip transparent pixels, then take the opaque run
+                while (i < w && line[2 * i] == keyHi && line[2 * i + 1] == keyLo) i++;
+                int16_t start = i;
+                while (i < w && !(line[2 * i] == keyHi && line[2 * i + 1] == keyLo)) i++;
+                if (start == i) break;
+
+                int16_t a = cx + start;
+                int16_t b = cx + i - 1;
+                if (rowInsets) {
+                    int16_t va, vb;
+                    visibleSpan(py, a, b, va, vb);
+                    if (va > vb) continue;
+                    start += va - a;
+                    a = va;
+                    b = vb;
+                }
+
+                if (a != openX0 || b != openX1 || py != openNextY) {
+                    setWindow(a, py, b, bottom);
+                    openX0 = a;
+                    openX1 = b;
+                }
+                openNextY = py + 1;
+
+                appendBytes(&line[2 * start], (size_t)(b - a + 1) * 2);
+            }
+        }
+
+        sendPending();
+    }
+
+
+    /**
+     * @brief Begin a batch pixel write to a rectangular window.
+     *
+     * After calling this, use pushPixels() to stream pixel data row by
+     * row, then call endWrite(). Avoids per-scanline window setup.
+     * With a row mask (setRowInsets()), hidden pixels of the stream are
+     * dropped instead of sent.
+     *
+     * @param x0 Start X.
+     * @param y0 Start Y.
+     * @param x1 End X.
+     * @param y1 End Y.
+     */
+    void beginWrite(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+        streamMasked = rowInsets != nullptr;
+        if (!streamMasked) {
+            setWindow(x0, y0, x1, y1);
+            return;
+        }
+
+        streamX0 = x0;
+        streamX1 = x1;
+        streamY1 = y1;
+        streamX = x0;
+        streamY = y0;
+        streamGroupEnd = y0 - 1;
+        openStreamRow();
+    }
+
+
+    /**
+     * @brief Push pixels into the current write window.
+     *
+     * @param colors Array of RGB565 pixel values (native byte order).
+     * @param count Number of pixels.
+     *
+     * @details
+     * Pixels collect in the current DMA buffer and go out when it is full
+     * or at endWrite(), so many short pushes still make few transfers.
+     */
+    void pushPixels(const uint16_t* colors, int32_t count) {
+        if (streamMasked) {
+            pushMasked(count, [&](int32_t skip, int32_t n) { appendPixels(colors + skip, n); });
+        } else {
+            appendPixels(colors, count);
+        }
+    }
+
+
+    /**
+     * @brief Push pixels that are already in wire order.
+     *
+     * @param data Big-endian RGB565 bytes (high byte first).
+     * @param bytes Number of bytes (2 per pixel).
+     *
+     * @details
+     * Same as pushPixels() without the byte swap: for off-screen buffers
+     * rendered in panel order (see beginCapture()).
+     */
+    void pushBytes(const uint8_t* data, size_t bytes) {
+        if (streamMasked) {
+            pushMasked(bytes / 2, [&](int32_t skip, int32_t n) { appendBytes(data + skip * 2, n * 2); });
+        } else {
+            appendBytes(data, bytes);
+        }
+    }
+
+
+    /**
+     * @brief End a batch pixel write.
+     *
+     * @details
+     * Sends the partly filled buffer. Does not wait for queued pixels;
+     * call flush() for that.
+     */
+    void endWrite() {
+        sendPending();
+    }
+
+
+    /**
+     * @brief Draw into memory instead of the panel.
+     *
+     * @param buf Big-endian RGB565 pixels, w * h * 2 bytes, row after row.
+     * @param x Left edge of the screen rectangle buf stands for.
+     * @param y Top edge.
+     * @param w Width.
+     * @param h Height.
+     *
+     * @details
+     * Until endCapture(), drawing calls write their pixels into buf
+     * (pixels outside the rectangle are dropped) and nothing goes over
+     * SPI. Row insets are ignored meanwhile: the whole rectangle is drawn,
+     * the mask applies when buf is sent. Pixels of buf that nothing drew
+     * keep their old value.
+     *
+     * @par Example:
+     * @code
+     *     display.beginCapture(buf, 0, 100, 240, 16);
+     *     display.fillRect(0, 100, 240, 16, COLOR_BLACK);
+     *     display.drawString(10, 104, "Overlapping", COLOR_WHITE, COLOR_BLACK);
+     *     display.endCapture();
+     *
+     *     display.beginWrite(0, 100, 239, 115);   // Each pixel sent once
+     *     display.pushBytes(buf, 240 * 16 * 2);
+     *     display.endWrite();
+     * @endcode
+     */
+    void beginCapture(uint8_t* buf, int16_t x, int16_t y, int16_t w, int16_t h) {
+        sendPending();              // Belongs to the panel
+
+        captureBuf = buf;
+        captureX = x;
+        captureY = y;
+        captureW = w;
+        captureH = h;
+        captureInsets = rowInsets;
+        rowInsets = nullptr;
+        captureWindow(x, y, x + w - 1, y + h - 1);
+    }
+
+
+    /**
+     * @brief Draw on the panel again (see beginCapture()).
+     */
+    void endCapture() {
+        sendPending();              // Belongs to the capture
+        captureBuf = nullptr;
+        rowInsets = captureInsets;
+    }
+
+
+    /**
+     * @brief Limit drawing to a rectangle.
+     *
+     * @param x Left edge.
+     * @param y Top edge.
+     * @param w Width.
+     * @param h Height.
+     *
+     * @details
+     * Every drawing call is cut to this rectangle (and the screen), so a
+     * caller can repaint part of the screen by drawing whole shapes (see
+     * ui_screen.h). The raw beginWrite() stream is not clipped. Reset by
+     * clearClipRect() and by setRotation().
+     */
+    void setClipRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+        clearClipRect();
+        if (!clip(x, y, w, h)) {
+            clipX0 = clipY0 = 0;    // Empty: nothing is drawn
+            clipX1 = clipY1 = -1;
+            return;
+        }
+        clipX0 = x;
+        clipY0 = y;
+        clipX1 = x + w - 1;
+        clipY1 = y + h - 1;
+    }
+
+
+    /**
+     * @brief Draw on the whole screen again.
+     */
+    void clearClipRect() {
+        clipX0 = 0;
+        clipY0 = 0;
+        clipX1 = width - 1;
+        clipY1 = height - 1;
+    }
+
+
+    /**
+     * @brief Set display rotation.
+     *
+     * @param r 0, 1, 2, or 3 (0° / 90° / 180° / 270°).
+     *
+     * @note Ignored on panels without MADCTL rotation (HAS_ROTATION = false).
+     */
+    void setRotation(uint8_t r) {
+        if constexpr (Panel::HAS_ROTATION) {
+            rotation = r & 3;
+            windowCache.invalidate();
+
+            sendCommand(Panel::CMD_MADCTL, &Panel::MADCTL[rotation], 1);
+
+            bool portrait = (rotation & 1) == 0;
+            width = portrait ? nativeWidth : nativeHeight;
+            height = portrait ? nativeHeight : nativeWidth;
+            clearClipRect();
+        }
+    }
+
+
+    /**
+     * @brief Get current rotation (0-3).
+     */
+    uint8_t getRotation() const { return rotation; }
+
+
+    /**
+     * @brief Set display memory offset.
+     *
+     * @param x X offset (positive = shift right, negative = shift left).
+     * @param y Y offset (positive = shift down, negative = shift up).
+     *
+     * @details
+     * Added to every window. Useful for panels that are smaller than the
+     * controller RAM or physically misaligned.
+     */
+    void setOffset(int16_t x, int16_t y) {
+        xOffset = x;
+        yOffset = y;
+        ESP_LOGI(Panel::NAME, "Display offset set to (%d, %d)", x, y);
+    }
+
+
+    /**
+     * @brief Get current X offset.
+     */
+    int16_t getOffsetX() const { return xOffset; }
+
+
+    /**
+     * @brief Get current Y offset.
+     */
+    int16_t getOffsetY() const { return yOffset; }
+
+
+    /**
+     * @brief Enable or disable queued (DMA) pixel writes.
+     *
+     * @param enable true = queue pixel buffers with spi_device_queue_trans(),
+     *               false = blocking polling transfers.
+     *
+     * @details
+     * In queued mode, drawing calls return while the last buffer is still
+     * on the wire. Enabled by default.
+     *
+     * @par Example:
+     * @code
+     *     display.fillScreen(COLOR_BLUE);  // Returns before the last chunk is sent
+     *     computeNextFrame();               // Overlaps with the transfer
+     *     display.flush();                  // Wait for the panel to catch up
+     * @endcode
+     */
+    void setQueuedMode(bool enable) {
+        flush();
+        queuedMode = enable;
+    }
+
+
+    /**
+     * @brief Check if queued (DMA) pixel writes are active.
+     */
+    bool isQueuedMode() const { return queuedMode; }
+
+
+    /**
+     * @brief Wait until all queued pixel transfers have finished.
+     *
+     * @details
+     * Acts as a fence: after flush() returns, every pixel drawn so far is
+     * in display RAM and both DMA buffers are free. Commands flush
+     * automatically, so you only need this before timing measurements or
+     * before touching the bus from outside the driver.
+     */
+    void flush() {
+        sendPending();
+        while (dmaInFlight > 0) {
+            reclaimOne();
+        }
+    }
+
+
+    /**
+     * @brief Get address-window cache counters.
+     *
+     * @details
+     * Shows how many column/row commands were skipped because the range
+     * was already programmed, and how many SPI bytes that saved.
+     */
+    const DisplayWindowStats& getWindowStats() const { return windowCache.getStats(); }
+
+
+    /**
+     * @brief Reset address-window cache counters.
+     */
+    void resetWindowStats() { windowCache.resetStats(); }
+
+
+    /**
+     * @brief Convert 24-bit RGB to RGB565.
+     *
+     * @param r Red (0-255).
+     * @param g Green (0-255).
+     * @param b Blue (0-255).
+     * @return RGB565 color value.
+     */
+    static uint16_t color565(uint8_t r, uint8_t g, uint8_t b) {
+        return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+    }
+
+
+    /**
+     * @brief Get current display width (changes with rotation).
+     */
+    uint16_t getWidth() const { return width; }
+
+
+    /**
+     * @brief Get current display height (changes with rotation).
+     */
+    uint16_t getHeight() const { return height; }
+
+
+    /**
+     * @brief Rows of controller RAM (hardware scrolling counts in RAM rows).
+     */
+    static constexpr uint16_t RAM_HEIGHT = Panel::HEIGHT;
+
+
+protected:
+
+    gpio_num_t dcPin;
+    gpio_num_t rstPin;
+    spi_host_device_t spiHost;
+    spi_device_handle_t spiDevice;
+    WindowCache windowCache;        // Last programmed column/row ranges
+    bool initialized;
+    bool ownsBus;                   // We initialized the SPI bus (free it on exit)
+
+    uint8_t rotation;
+    uint16_t nativeWidth;           // Width at rotation 0
+    uint16_t nativeHeight;          // Height at rotation 0
+    uint16_t width;                 // Current width (changes with rotation)
+    uint16_t height;                // Current height (changes with rotation)
+    int16_t xOffset;                // Display X offset (can be negative)
+    int16_t yOffset;                // Display Y offset (can be negative)
+    int16_t clipX0, clipY0;         // Drawable area (setClipRect()), inclusive
+    int16_t clipX1, clipY1;
+
+
+    /**
+     * @brief Construct the core (no hardware access).
+     *
+     * @param dcPin GPIO for Data/Command.
+     * @param rstPin GPIO for Reset.
+     * @param spiHost SPI host.
+     */
+    Rgb565Display(gpio_num_t dcPin, gpio_num_t rstPin, spi_host_device_t spiHost)
+        : dcPin(dcPin),
+          rstPin(rstPin),
+          spiHost(spiHost),
+          spiDevice(nullptr),
+          windowCache(Panel::WINDOW_16BIT ? 4 : 2),
+          initialized(false),
+          ownsBus(false),
+          rotation(0),
+          nativeWidth(Panel::WIDTH),
+          nativeHeight(Panel::HEIGHT),
+          width(Panel::WIDTH),
+          height(Panel::HEIGHT),
+          xOffset(0),
+          yOffset(0),
+          clipX0(0), clipY0(0),
+          clipX1(Panel::WIDTH - 1), clipY1(Panel::HEIGHT - 1),
+          queuedMode(true),
+          dmaBuf{nullptr, nullptr},
+          dmaBufColor{0, 0},
+          dmaBufPixels{0, 0},
+          dmaTrans{},
+          dmaNext(0),
+          dmaInFlight(0),
+          pendingBytes(0),
+          rowInsets(nullptr),
+          streamMasked(false),
+          streamX0(0), streamX1(0),
+          streamY1(0),
+          streamX(0), streamY(0),
+          streamVis0(0), streamVis1(-1),
+          streamGroupEnd(-1),
+          captureBuf(nullptr),
+          captureX(0), captureY(0), captureW(0), captureH(0),
+          captureInsets(nullptr),
+          captureX0(0), captureX1(-1), captureY1(-1),
+          capturePosX(0), capturePosY(0),
+          captureHalf(false), captureHigh(0)
+    {
+    }
+
+
+    /**
+     * @brief Release the SPI device, bus and DMA buffers.
+     */
+    ~Rgb565Display() {
+        if (spiDevice) {
+            flush();
+            spi_bus_remove_device(spiDevice);
+            if (ownsBus) spi_bus_free(spiHost);
+        }
+        heap_caps_free(dmaBuf[0]);
+        heap_caps_free(dmaBuf[1]);
+    }
+
+
+    /**
+     * @brief Override the native panel size (for controllers driving
+     *        several glass sizes, like ST7789).
+     */
+    void setNativeSize(uint16_t w, uint16_t h) {
+        nativeWidth = w;
+        nativeHeight = h;
+        width = w;
+        height = h;
+        clearClipRect();
+    }
+
+
+    /**
+     * @brief Configure DC/RST, the SPI bus, the device and the DMA buffers.
+     *
+     * @param mosiPin GPIO for MOSI.
+     * @param misoPin GPIO for MISO (GPIO_NUM_NC if not used).
+     * @param sckPin GPIO for SCK.
+     * @param csPin GPIO for Chip Select.
+     *
+     * @return true if successful, false on error.
+     *
+     * @note An already initialized bus (shared with another device) is OK.
+     */
+    bool beginSpi(gpio_num_t mosiPin, gpio_num_t misoPin, gpio_num_t sckPin, gpio_num_t csPin) {
+        // DC and RST pins
+        gpio_config_t io_conf = {};
+        io_conf.mode = GPIO_MODE_OUTPUT;
+        io_conf.pull_up_en = GPIO_PULLUP_DISABLE;
+        io_conf.pull_down_en = GPIO_PULLDOWN_DISABLE;
+        io_conf.intr_type = GPIO_INTR_DISABLE;
+        io_conf.pin_bit_mask = (1ULL << dcPin) | (1ULL << rstPin);
+        gpio_config(&io_conf);
+
+        // SPI bus (largest single transfer is one DMA buffer)
+        spi_bus_config_t busConfig = {};
+        busConfig.mosi_io_num = mosiPin;
+        busConfig.miso_io_num = misoPin;
+        busConfig.sclk_io_num = sckPin;
+        busConfig.quadwp_io_num = -1;
+        busConfig.quadhd_io_num = -1;
+        busConfig.max_transfer_sz = BUF_BYTES;
+
+        esp_err_t err = spi_bus_initialize(spiHost, &busConfig, SPI_DMA_CH_AUTO);
+        if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+            ESP_LOGE(Panel::NAME, "SPI bus init failed: %s", esp_err_to_name(err));
+            return false;
+        }
+        // ESP_ERR_INVALID_STATE means bus already initialized - OK for shared bus
+        ownsBus = (err == ESP_OK);
+
+        // SPI device
+        spi_device_interface_config_t devConfig = {};
+        devConfig.clock_speed_hz = Panel::SPI_CLOCK_HZ;
+        devConfig.mode = 0;
+        devConfig.spics_io_num = csPin;
+        devConfig.queue_size = 7;
+
+        err = spi_bus_add_device(spiHost, &devConfig, &spiDevice);
+        if (err != ESP_OK) {
+            ESP_LOGE(Panel::NAME, "SPI device add failed: %s", esp_err_to_name(err));
+            spiDevice = nullptr;
+            if (ownsBus) spi_bus_free(spiHost);
+            return false;
+        }
+
+        // Ping-pong DMA buffers
+        for (int i = 0; i < 2; i++) {
+            if (!dmaBuf[i]) {
+                dmaBuf[i] = (uint8_t*)heap_caps_malloc(BUF_BYTES, MALLOC_CAP_DMA);
+            }
+            if (!dmaBuf[i]) {
+                ESP_LOGE(Panel::NAME, "DMA buffer allocation failed (%u bytes)", (unsigned)BUF_BYTES);
+                return false;
+            }
+            dmaBufPixels[i] = 0;
+        }
+
+        return true;
+    }
+
+
+    /**
+     * @brief Pulse the reset line and wait for the controller to wake up.
+     */
+    void hardwareReset() {
+        gpio_set_level(rstPin, 1);
+        vTaskDelay(pdMS_TO_TICKS(Panel::RESET_PULSE_MS));
+        gpio_set_level(rstPin, 0);
+        vTaskDelay(pdMS_TO_TICKS(Panel::RESET_PULSE_MS));
+        gpio_set_level(rstPin, 1);
+        vTaskDelay(pdMS_TO_TICKS(Panel::RESET_SETTLE_MS));
+
+        windowCache.invalidate();   // Controller registers are back to defaults
+    }
+
+
+    /**
+     * @brief Send a command/argument/delay table (see file header).
+     *
+     * @param table Table terminated by DISPLAY_INIT_END.
+     */
+    void runInitTable(const uint8_t* table) {
+        while (table[1] != DISPLAY_INIT_END) {
+            uint8_t cmd = *table++;
+            uint8_t argc = *table++;
+            bool hasDelay = argc & DISPLAY_INIT_DELAY;
+            argc &= ~DISPLAY_INIT_DELAY;
+
+            sendCommand(cmd, table, argc);
+            table += argc;
+
+            if (hasDelay) {
+                vTaskDelay(pdMS_TO_TICKS(*table++));
+            }
+        }
+    }
+
+
+    /**
+     * @brief Send a command byte.
+     */
+    void sendCommand(uint8_t cmd) {
+        transmit(&cmd, 1, 0);
+    }
+
+
+    /**
+     * @brief Send a command byte followed by its parameters in one burst.
+     */
+    void sendCommand(uint8_t cmd, const uint8_t* params, size_t len) {
+        transmit(&cmd, 1, 0);
+        if (len > 0) transmit(params, len, 1);
+    }
+
+
+    /**
+     * @brief Send a data byte.
+     */
+    void sendData(uint8_t data) {
+        transmit(&data, 1, 1);
+    }
+
+
+    /**
+     * @brief Send multiple data bytes.
+     */
+    void sendData(const uint8_t* data, size_t len) {
+        if (len > 0) transmit(data, len, 1);
+    }
+
+
+    /**
+     * @brief Send 16-bit data (for colors).
+     */
+    void sendData16(uint16_t data) {
+        uint8_t buf[2] = {(uint8_t)(data >> 8), (uint8_t)(data & 0xFF)};
+        transmit(buf, 2, 1);
+    }
+
+
+    /**
+     * @brief Set the drawing window (offsets applied, unchanged ranges skipped).
+     *
+     * @param x0 Start X.
+     * @param y0 Start Y.
+     * @param x1 End X.
+     * @param y1 End Y.
+     */
+    void setWindow(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+        if (captureBuf) {
+            captureWindow(x0, y0, x1, y1);
+            return;
+        }
+
+        x0 += xOffset;
+        x1 += xOffset;
+        y0 += yOffset;
+        y1 += yOffset;
+
+        if (windowCache.needColumns(x0, x1)) {
+            sendRange(Panel::CMD_COLUMN, x0, x1);
+        }
+        if (windowCache.needRows(y0, y1)) {
+            sendRange(Panel::CMD_ROW, y0, y1);
+        }
+
+        sendCommand(Panel::CMD_WRITE);  // Always sent: resets the RAM write pointer
+    }
+
+
+    /**
+     * @brief Clip a rectangle to the drawable area (screen or clip rectangle).
+     *
+     * @return false if nothing is left to draw.
+     */
+    bool clip(int16_t& x, int16_t& y, int16_t& w, int16_t& h) const {
+        if (x > clipX1 || y > clipY1) return false;
+        if (x < clipX0) { w -= clipX0 - x; x = clipX0; }
+        if (y < clipY0) { h -= clipY0 - y; y = clipY0; }
+        if (x + w > clipX1 + 1) w = clipX1 + 1 - x;
+        if (y + h > clipY1 + 1) h = clipY1 + 1 - y;
+        return w > 0 && h > 0;
+    }
+
+
+    /**
+     * @brief Stream one color into the current window.
+     *
+     * @param color RGB565 color value.
+     * @param count Number of pixels.
+     */
+    void writeColor(uint16_t color, uint32_t count) {
+        // Big-endian RGB565 pair repeated twice per 32-bit word
+        uint8_t hi = color >> 8;
+        uint8_t lo = color & 0xFF;
+        uint32_t pattern = ((uint32_t)lo << 24) | ((uint32_t)hi << 16) |
+                           ((uint32_t)lo << 8) | hi;
+
+        // Short runs (line and circle pieces): one blocking transfer beats
+        // queueing a DMA buffer and waiting for it at the next command
+        if (count <= SMALL_FILL_PIXELS) {
+            uint8_t buf[SMALL_FILL_PIXELS * 2];
+            for (uint32_t i = 0; i < count; i++) {
+                buf[2 * i] = hi;
+                buf[2 * i + 1] = lo;
+            }
+            transmit(buf, count * 2, 1);
+            return;
+        }
+
+        while (count > 0) {
+            uint32_t chunk = count > BUF_PIXELS ? BUF_PIXELS : count;
+
+            if (dmaInFlight == 2) reclaimOne();
+            uint8_t idx = dmaNext;
+
+            if (dmaBufColor[idx] != color || dmaBufPixels[idx] < chunk) {
+                uint32_t* words = (uint32_t*)dmaBuf[idx];
+                size_t nWords = (chunk + 1) / 2;
+                for (size_t i = 0; i < nWords; i++) {
+                    words[i] = pattern;
+                }
+                dmaBufColor[idx] = color;
+                dmaBufPixels[idx] = nWords * 2;
+            }
+
+            submit(idx, chunk * 2);
+            count -= chunk;
+        }
+    }
+
+
+    /**
+     * @brief Hide part of every row from fills and pixel streams.
+     *
+     * @param insets One entry per screen row: pixels hidden at each end of
+     *               the row. nullptr = whole rectangle visible.
+     *
+     * @details
+     * For panels whose glass does not cover the whole RAM (round panels).
+     * fillRect() and beginWrite()/pushPixels() then only send the visible
+     * part of each row; rows with the same visible span share one window.
+     * Text and single pixels are not masked: hidden pixels are harmless,
+     * skipping them just saves SPI time.
+     *
+     * The table must outlive the display and match the current rotation.
+     */
+    void setRowInsets(const uint8_t* insets) {
+        rowInsets = insets;
+    }
+
+
+    /**
+     * @brief Get a free DMA buffer (BUF_BYTES long) to render pixels into.
+     *
+     * @details
+     * Fill it with big-endian RGB565 and hand it back with
+     * sendPixelBuffer(). Waits if both buffers are on the wire.
+     */
+    uint8_t* pixelBuffer() {
+        if (dmaInFlight == 2) reclaimOne();
+        dmaBufPixels[dmaNext] = 0;  // Contents no longer a solid color
+        return dmaBuf[dmaNext];
+    }
+
+
+    /**
+     * @brief Send the buffer returned by pixelBuffer().
+     *
+     * @param bytes Number of bytes filled.
+     */
+    void sendPixelBuffer(size_t bytes) {
+        if (bytes > 0) submit(dmaNext, bytes);
+    }
+
+
+    /**
+     * @brief Draw a run of characters (no newlines) through one window.
+     *
+     * @details
+     * The whole run is one window, rendered row by row straight into the
+     * DMA buffers. Background pixels are painted too (text is opaque).
+     */
+    void drawTextRun(int16_t x, int16_t y, const char* str, size_t len,
+                     uint16_t color, uint16_t bg, uint8_t size) {
+        if (len == 0 || size == 0) return;
+
+        int32_t runW = (int32_t)len * FONT_5X7_CELL_WIDTH * size;
+        int32_t runH = FONT_5X7_HEIGHT * size;
+
+        // Clip the run to the drawable area
+        int32_t x0 = x < clipX0 ? clipX0 : x;
+        int32_t y0 = y < clipY0 ? clipY0 : y;
+        int32_t x1 = x + runW - 1;
+        int32_t y1 = y + runH - 1;
+        if (x1 > clipX1) x1 = clipX1;
+        if (y1 > clipY1) y1 = clipY1;
+        if (x0 > x1 || y0 > y1) return;
+
+        setWindow(x0, y0, x1, y1);
+
+        uint8_t* buf = pixelBuffer();
+        size_t bufIdx = 0;
+        int16_t rowPixels = x1 - x0 + 1;
+
+        for (int32_t py = y0; py <= y1; py++) {
+            int16_t done = 0;
+
+            // Rows wider than the buffer are split across several bursts
+            while (done < rowPixels) {
+                if (bufIdx + 2 > BUF_BYTES) {
+                    sendPixelBuffer(bufIdx);
+                    buf = pixelBuffer();
+                    bufIdx = 0;
+                }
+
+                int16_t n = (BUF_BYTES - bufIdx) / 2;
+                if (n > rowPixels - done) n = rowPixels - done;
+
+                font5x7RenderRow(str, py - y, x0 - x + done, n, color, bg, size, &buf[bufIdx]);
+                bufIdx += n * 2;
+                done += n;
+            }
+        }
+
+        sendPixelBuffer(bufIdx);
+    }
+
+
+private:
+
+    bool queuedMode;                // Pixel buffers go through the DMA queue
+    uint8_t* dmaBuf[2];             // Ping-pong DMA buffers (internal RAM)
+    uint16_t dmaBufColor[2];        // Color each buffer is pre-filled with
+    size_t dmaBufPixels[2];         // How many pixels of that color are laid out
+    spi_transaction_t dmaTrans[2];  // One transaction per buffer
+    uint8_t dmaNext;                // Buffer to fill next
+    uint8_t dmaInFlight;            // Queued transactions not yet reclaimed
+    size_t pendingBytes;            // Pushed bytes waiting in dmaBuf[dmaNext]
+
+    const uint8_t* rowInsets;       // Hidden pixels per row end (nullptr = none)
+    bool streamMasked;              // Current beginWrite() stream is masked
+    int16_t streamX0, streamX1;     // Stream window columns
+    int16_t streamY1;               // Stream window last row
+    int16_t streamX, streamY;       // Next pixel position in the stream
+    int16_t streamVis0, streamVis1; // Visible columns of the current row group
+    int16_t streamGroupEnd;         // Last row of the current row group
+
+    uint8_t* captureBuf;            // beginCapture() target (nullptr = panel)
+    int16_t captureX, captureY;     // Screen rectangle of captureBuf
+    int16_t captureW, captureH;
+    const uint8_t* captureInsets;   // Row insets to restore at endCapture()
+    int16_t captureX0, captureX1;   // Window set while capturing
+    int16_t captureY1;
+    int16_t capturePosX;            // Next pixel in that window
+    int16_t capturePosY;
+    bool captureHalf;               // High byte of a pixel seen, low byte pending
+    uint8_t captureHigh;
+
+
+    /**
+     * @brief Blocking transfer with the given DC level.
+     */
+    void transmit(const uint8_t* data, size_t len, int dc) {
+        sendPending();
+        if (captureBuf) {
+            if (dc) captureBytes(data, len);    // Commands have no meaning in memory
+            return;
+        }
+        if (dmaInFlight) flush();   // Queued pixels must land before DC changes
+
+        gpio_set_level(dcPin, dc);
+
+        spi_transaction_t trans = {};
+        trans.length = len * 8;
+        trans.tx_buffer = data;
+        spi_device_polling_transmit(spiDevice, &trans);
+    }
+
+
+    /**
+     * @brief Send a column or row range command.
+     */
+    void sendRange(uint8_t cmd, int16_t a, int16_t b) {
+        if constexpr (Panel::WINDOW_16BIT) {
+            uint8_t params[4] = {(uint8_t)(a >> 8), (uint8_t)(a & 0xFF),
+                                 (uint8_t)(b >> 8), (uint8_t)(b & 0xFF)};
+            sendCommand(cmd, params, 4);
+        } else {
+            uint8_t params[2] = {(uint8_t)a, (uint8_t)b};
+            sendCommand(cmd, params, 2);
+        }
+    }
+
+
+    /**
+     * @brief Send DMA buffer idx (queued or blocking) and advance.
+     */
+    void submit(uint8_t idx, size_t bytes) {
+        if (captureBuf) {
+            captureBytes(dmaBuf[idx], bytes);
+            dmaNext ^= 1;
+            return;
+        }
+
+        if (!queuedMode) {
+            transmit(dmaBuf[idx], bytes, 1);
+            dmaNext ^= 1;
+            return;
+        }
+
+        if (dmaInFlight == 0) {
+            gpio_set_level(dcPin, 1);   // Stays high until the queue drains
+        }
+
+        spi_transaction_t* trans = &dmaTrans[idx];
+        memset(trans, 0, sizeof(*trans));
+        trans->length = bytes * 8;
+        trans->tx_buffer = dmaBuf[idx];
+
+        if (spi_device_queue_trans(spiDevice, trans, portMAX_DELAY) != ESP_OK) {
+            ESP_LOGE(Panel::NAME, "Queue transfer failed, falling back to blocking mode");
+            queuedMode = false;
+            transmit(dmaBuf[idx], bytes, 1);
+        } else {
+            dmaInFlight++;
+        }
+        dmaNext ^= 1;
+    }
+
+
+    /**
+     * @brief Append native-order pixels to the pending buffer.
+     */
+    void appendPixels(const uint16_t* colors, int32_t count) {
+        while (count > 0) {
+            uint8_t* buf = pixelBuffer() + pendingBytes;
+            int32_t n = (int32_t)((BUF_BYTES - pendingBytes) / 2);
+            if (n > count) n = count;
+
+            for (int32_t i = 0; i < n; i++) {
+                buf[2 * i] = colors[i] >> 8;
+                buf[2 * i + 1] = colors[i] & 0xFF;
+            }
+
+            pendingBytes += n * 2;
+            if (pendingBytes == BUF_BYTES) sendPending();
+            colors += n;
+            count -= n;
+        }
+    }
+
+
+    /**
+     * @brief Append wire-order bytes to the pending buffer.
+     */
+    void appendBytes(const uint8_t* data, size_t bytes) {
+        while (bytes > 0) {
+            uint8_t* buf = pixelBuffer() + pendingBytes;
+            size_t n = BUF_BYTES - pendingBytes;
+            if (n > bytes) n = bytes;
+
+            memcpy(buf, data, n);
+
+            pendingBytes += n;
+            if (pendingBytes == BUF_BYTES) sendPending();
+            data += n;
+            bytes -= n;
+        }
+    }
+
+
+    /**
+     * @brief Draw up to FONT_RUN_CHARS characters through one window.
+     *
+     * @return Width of the run in pixels (also when clipped).
+     */
+    int16_t drawFontRun(int16_t x, int16_t y, const PackedFont& font, const char* str,
+                        size_t len, uint16_t color, uint16_t bg, const uint8_t lut[][2],
+                        GlyphCache* cache) {
+        PackedFont::Glyph glyphs[FONT_RUN_CHARS];
+        int32_t runW = 0;
+        for (size_t i = 0; i < len; i++) {
+            glyphs[i] = font.glyph(str[i]);
+            runW += glyphs[i].advance;
+        }
+
+        // Clip the run to the drawable area
+        int32_t x0 = x < clipX0 ? clipX0 : x;
+        int32_t y0 = y < clipY0 ? clipY0 : y;
+        int32_t x1 = x + runW - 1;
+        int32_t y1 = y + font.lineHeight - 1;
+        if (x1 > clipX1) x1 = clipX1;
+        if (y1 > clipY1) y1 = clipY1;
+        if (x0 > x1 || y0 > y1) return runW;
+
+        // Visible glyphs: cached cell (or nullptr) and visible columns
+        const uint8_t* cells[FONT_RUN_CHARS];
+        int16_t firstCol[FONT_RUN_CHARS];
+        int16_t colCount[FONT_RUN_CHARS];
+        if (cache) cache->beginDraw();
+
+        int32_t pen = x;
+        for (size_t i = 0; i < len; i++) {
+            int32_t a = pen > x0 ? pen : x0;
+            int32_t b = pen + glyphs[i].advance - 1 < x1 ? pen + glyphs[i].advance - 1 : x1;
+            firstCol[i] = a - pen;
+            colCount[i] = a <= b ? b - a + 1 : 0;
+            cells[i] = cache && colCount[i] ? cache->get(font, glyphs[i], str[i], color, bg, lut) : nullptr;
+            pen += glyphs[i].advance;
+        }
+
+        setWindow(x0, y0, x1, y1);
+
+        uint8_t chunk[64];
+        for (int32_t py = y0; py <= y1; py++) {
+            uint8_t row = py - y;
+
+            for (size_t i = 0; i < len; i++) {
+                if (colCount[i] == 0) continue;
+
+                if (cells[i]) {
+                    const uint8_t* src = cells[i] + ((size_t)row * glyphs[i].advance + firstCol[i]) * 2;
+                    appendBytes(src, (size_t)colCount[i] * 2);
+                    continue;
+                }
+
+                for (int16_t done = 0; done < colCount[i]; done += sizeof(chunk) / 2) {
+                    int16_t n = colCount[i] - done;
+                    if (n > (int16_t)(sizeof(chunk) / 2)) n = sizeof(chunk) / 2;
+                    font.renderRow(glyphs[i], row, firstCol[i] + done, n, lut, chunk);
+                    appendBytes(chunk, (size_t)n * 2);
+                }
+            }
+        }
+
+        sendPending();
+        return runW;
+    }
+
+
+    /**
+     * @brief Span sink for the line/circle rasterizers: runs go to fillRect().
+     */
+    auto spanSink(uint16_t color) {
+        return SpanSink([this, color](int16_t x, int16_t y, int16_t w, int16_t h) {
+            fillRect(x, y, w, h, color);
+        });
+    }
+
+
+    /**
+     * @brief Fill every span of an arc, one row-wide fillRect per span.
+     */
+    void fillArcSpans(const ArcSpanTable& arc, int16_t cx, int16_t cy,
+                      const ArcSweep& sweep, uint16_t color) {
+        arc.forEachSpan(sweep, [&](int16_t dy, int16_t dx0, int16_t dx1) {
+            fillRect(cx + dx0, cy + dy, dx1 - dx0 + 1, 1, color);
+        });
+    }
+
+
+    /**
+     * @brief Visible part of columns [x0, x1] on row y (empty if a > b).
+     */
+    void visibleSpan(int16_t y, int16_t x0, int16_t x1, int16_t& a, int16_t& b) const {
+        if (y < 0 || y >= height) {
+            a = 1;
+            b = 0;
+            return;
+        }
+        int16_t left = rowInsets[y];
+        int16_t right = width - 1 - rowInsets[y];
+        a = x0 > left ? x0 : left;
+        b = x1 < right ? x1 : right;
+    }
+
+
+    /**
+     * @brief Last row from y on (up to yEnd) with the same visible span as y.
+     */
+    int16_t rowGroupEnd(int16_t y, int16_t yEnd, int16_t x0, int16_t x1) const {
+        int16_t a, b;
+        visibleSpan(y, x0, x1, a, b);
+
+        while (y < yEnd) {
+            int16_t na, nb;
+            visibleSpan(y + 1, x0, x1, na, nb);
+            if (na != a || nb != b) break;
+            y++;
+        }
+        return y;
+    }
+
+
+    /**
+     * @brief fillRect() for masked panels: one window per row group.
+     */
+    void fillMasked(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+        int16_t y = y0;
+        while (y <= y1) {
+            int16_t a, b;
+            visibleSpan(y, x0, x1, a, b);
+            int16_t last = rowGroupEnd(y, y1, x0, x1);
+
+            if (a <= b) {
+                setWindow(a, y, b, last);
+                writeColor(color, (uint32_t)(b - a + 1) * (last - y + 1));
+            }
+            y = last + 1;
+        }
+    }
+
+
+    /**
+     * @brief Start a new row group of a masked stream if streamY needs one.
+     */
+    void openStreamRow() {
+        if (streamY <= streamGroupEnd) return;
+
+        visibleSpan(streamY, streamX0, streamX1, streamVis0, streamVis1);
+        streamGroupEnd = rowGroupEnd(streamY, streamY1, streamX0, streamX1);
+
+        if (streamVis0 <= streamVis1) {
+            setWindow(streamVis0, streamY, streamVis1, streamGroupEnd);
+        }
+    }
+
+
+    /**
+     * @brief Walk count stream pixels, passing the visible pieces to emit.
+     *
+     * @param emit Called as emit(firstPixel, pixelCount), relative to the push.
+     */
+    template <typename Emit>
+    void pushMasked(int32_t count, Emit emit) {
+        int32_t done = 0;
+
+        while (done < count && streamY <= streamY1) {
+            int32_t n = streamX1 - streamX + 1;
+            if (n > count - done) n = count - done;
+
+            int32_t last = streamX + n - 1;
+            int32_t a = streamX > streamVis0 ? streamX : streamVis0;
+            int32_t b = last < streamVis1 ? last : streamVis1;
+            if (a <= b) emit(done + (a - streamX), b - a + 1);
+
+            done += n;
+            streamX += n;
+            if (streamX > streamX1) {
+                streamX = streamX0;
+                streamY++;
+                if (streamY <= streamY1) openStreamRow();
+            }
+        }
+    }
+
+
+    /**
+     * @brief Start a window in the capture buffer (like CASET/RASET/RAMWR).
+     */
+    void captureWindow(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+        captureX0 = x0;
+        captureX1 = x1;
+        captureY1 = y1;
+        capturePosX = x0;
+        capturePosY = y0;
+        captureHalf = false;
+    }
+
+
+    /**
+     * @brief Write pixel bytes into the capture window, row by row.
+     */
+    void captureBytes(const uint8_t* data, size_t len) {
+        if (captureHalf && len > 0) {
+            uint8_t pixel[2] = {captureHigh, *data};
+            captureHalf = false;
+            captureBytes(pixel, 2);
+            data++;
+            len--;
+        }
+
+        while (len >= 2 && capturePosY <= captureY1) {
+            int32_t n = captureX1 - capturePosX + 1;
+            if (n > (int32_t)(len / 2)) n = len / 2;
+            if (n <= 0) break;
+
+            // Part of this row piece inside the buffer's rectangle
+            int32_t a = capturePosX > captureX ? capturePosX : captureX;
+            int32_t b = capturePosX + n - 1;
+            if (b > captureX + captureW - 1) b = captureX + captureW - 1;
+            int32_t row = capturePosY - captureY;
+            if (row >= 0 && row < captureH && a <= b) {
+                memcpy(captureBuf + ((size_t)row * captureW + (a - captureX)) * 2,
+                       data + (a - capturePosX) * 2, (size_t)(b - a + 1) * 2);
+            }
+
+            data += n * 2;
+            len -= n * 2;
+            capturePosX += n;
+            if (capturePosX > captureX1) {
+                capturePosX = captureX0;
+                capturePosY++;
+            }
+        }
+
+        if (len == 1 && capturePosY <= captureY1) {
+            captureHigh = *data;
+            captureHalf = true;
+        }
+    }
+
+
+    /**
+     * @brief Send what pushPixels()/pushBytes() collected so far.
+     */
+    void sendPending() {
+        if (pendingBytes == 0) return;
+        size_t bytes = pendingBytes;
+        pendingBytes = 0;           // Cleared first: submit() may call transmit()
+        submit(dmaNext, bytes);
+    }
+
+
+    /**
+     * @brief Wait for the oldest queued transfer to finish.
+     */
+    void reclaimOne() {
+        spi_transaction_t* done = nullptr;
+        if (spi_device_get_trans_result(spiDevice, &done, portMAX_DELAY) != ESP_OK) {
+            dmaInFlight = 0;
+            return;
+        }
+        dmaInFlight--;
+    }
+};
@@ -0,0 +1,286 @@
+/**
+ * @file scroll_terminal.h
+ * @brief Text log widget on top of hardware vertical scrolling (ILI9341, ST7789).
+ *
+ * @details
+ * Keeps a ring of text lines in a band of the screen. A new line is drawn
+ * into the row band of the oldest one and the hardware scroll start
+ * (VSCRSADD) moves by one line, so adding a line costs one line of
+ * pixels instead of a repaint of the whole area.
+ *
+ * Works with any Rgb565Display driver that has setupScroll() / scroll() /
+ * stopScroll(): ILI9341 and ST7789.
+ *
+ * @note
+ * - Rotation 0 only: the controller scrolls RAM rows, which are screen
+ *   rows only in the native orientation
+ * - Anything else drawn inside the terminal band scrolls with it
+ *
+ * @par Usage
+ * @code
+ * ScrollTerminal<ILI9341> term(display);
+ * term.begin(20, 280);                      // Below a 20 px header
+ * term.println("Boot OK");
+ * term.printLine(COLOR_YELLOW, "Relay %d on", 2);
+ * @endcode
+ */
+
+/*
+ * =============================================================================
+ * BEGINNER'S GUIDE: A LOG WITHOUT REPAINTING
+ * =============================================================================
+ *
+ * Scrolling a log in software means moving every line up one row band:
+ *
+ *     30 lines × 240 px × 8 rows × 2 bytes  → ~115 KB of SPI per entry
+ *
+ * The controller can do the moving itself. Its RAM rows in the scroll area
+ * form a ring, and VSCRSADD picks which RAM row is shown first:
+ *
+ *     RAM (never moves)          Screen after scroll(2 lines)
+ *     ┌──────────────┐           ┌──────────────┐
+ *     │ slot 0: L4   │ ◄─┐       │ slot 2: L2   │  ← oldest
+ *     │ slot 1: L5   │   │       │ slot 3: L3   │
+ *     │ slot 2: L2   │ ──┼─ top  │ slot 0: L4   │
+ *     │ slot 3: L3   │   │       │ slot 1: L5   │  ← newest
+ *     └──────────────┘ ──┘       └──────────────┘
+ *
+ * Adding L6: draw it into slot 2 (the oldest line), then scroll by one
+ * more line. Cost: one row band of pixels plus a 3-byte command.
+ *
+ * The text of every slot is kept, so redraw() can repaint the band
+ * after something covered it.
+ *
+ * ST7789 glass smaller than its 320-row RAM (e.g. 240x280, row offset
+ * 20) is handled by converting the band to RAM rows with the display
+ * offset; rows outside the band stay fixed.
+ *
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <esp_log.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "font_5x7.h"
+
+
+/**
+ * @brief Text log scrolled by the display controller.
+ *
+ * @tparam Display ILI9341 or ST7789 (anything with the Rgb565Display API
+ *                 plus setupScroll/scroll/stopScroll).
+ * @tparam MAX_COLS Characters kept per line.
+ * @tparam MAX_LINES Lines kept (one per row band).
+ */
+template <typename Display, uint8_t MAX_COLS = 40, uint8_t MAX_LINES = 40>
+class ScrollTerminal {
+
+public:
+
+    explicit ScrollTerminal(Display& display)
+        : display(display), top(0), rows(0), cols(0), lineHeight(8), size(1),
+          fg(0xFFFF), bg(0x0000), head(0), count(0) {}
+
+
+    /**
+     * @brief Set up the terminal band and the hardware scroll area.
+     *
+     * @param y First screen row of the band.
+     * @param height Band height; rounded down to whole lines.
+     * @param color Default text color (RGB565).
+     * @param background Background color (RGB565).
+     * @param textSize Font scale (1 = 8 px lines).
+     *
+     * @return false if the display is rotated or the band holds no line.
+     */
+    bool begin(int16_t y, int16_t height, uint16_t color = 0xFFFF,
+               uint16_t background = 0x0000, uint8_t textSize = 1) {
+        if (display.getRotation() != 0) {
+            ESP_LOGE(TAG, "Hardware scrolling needs rotation 0");
+            return false;
+        }
+        if (textSize == 0) textSize = 1;
+
+        lineHeight = 8 * textSize;
+        int16_t lines = height / lineHeight;
+        if (lines > MAX_LINES) lines = MAX_LINES;
+
+        // Scroll area in RAM rows: the band, shifted by the glass offset
+        int16_t ramTop = y + display.getOffsetY();
+        int16_t ramBottom = Display::RAM_HEIGHT - ramTop - lines * lineHeight;
+        if (lines < 1 || y < 0 || ramTop < 0 || ramBottom < 0) {
+            ESP_LOGE(TAG, "Invalid terminal band: y=%d, height=%d", y, height);
+            return false;
+        }
+
+        top = y;
+        rows = lines;
+        size = textSize;
+        fg = color;
+        bg = background;
+
+        int16_t fit = display.getWidth() / (FONT_5X7_CELL_WIDTH * size);
+        cols = fit > MAX_COLS ? MAX_COLS : fit;
+
+        display.setupScroll(ramTop, ramBottom);
+        clear();
+        return true;
+    }
+
+
+    /**
+     * @brief Add text in the default color.
+     *
+     * @details '\n' starts a new line; lines longer than the band wrap.
+     */
+    void println(const char* text) { println(text, fg); }
+
+
+    /**
+     * @brief Add text in a given color.
+     */
+    void println(const char* text, uint16_t color) {
+        if (rows == 0) return;
+
+        while (true) {
+            const char* lineEnd = strchr(text, '\n');
+            size_t len = lineEnd ? (size_t)(lineEnd - text) : strlen(text);
+
+            do {
+                size_t n = len > cols ? cols : len;
+                addLine(text, n, color);
+                text += n;
+                len -= n;
+            } while (len > 0);
+
+            if (!lineEnd) break;
+            text = lineEnd + 1;
+        }
+    }
+
+
+    /**
+     * @brief Add formatted text (printf syntax).
+     */
+    void printLine(uint16_t color, const char* format, ...) __attribute__((format(printf, 3, 4))) {
+        char line[2 * MAX_COLS + 1];
+        va_list args;
+        va_start(args, format);
+        vsnprintf(line, sizeof(line), format, args);
+        va_end(args);
+        println(line, color);
+    }
+
+
+    /**
+     * @brief Erase all lines and reset the scroll position.
+     */
+    void clear() {
+        if (rows == 0) return;
+        head = 0;
+        count = 0;
+        display.fillRect(0, top, display.getWidth(), rows * lineHeight, bg);
+        display.scroll(0);
+    }
+
+
+    /**
+     * @brief Repaint every kept line (after something covered the band).
+     */
+    void redraw() {
+        for (uint8_t slot = 0; slot < rows; slot++) drawSlot(slot);
+        display.scroll(head * lineHeight);
+    }
+
+
+    /**
+     * @brief Give the band back to normal drawing (scroll start = row 0).
+     */
+    void end() {
+        display.stopScroll();
+        rows = 0;
+    }
+
+
+    /**
+     * @brief Lines the band shows.
+     */
+    uint8_t getRows() const { return rows; }
+
+
+    /**
+     * @brief Characters per line.
+     */
+    uint8_t getCols() const { return cols; }
+
+
+    /**
+     * @brief Lines currently kept (up to getRows()).
+     */
+    uint8_t getLineCount() const { return count; }
+
+
+private:
+
+    static constexpr const char* TAG = "ScrollTerminal";
+
+    Display& display;
+    int16_t top;                            // First screen row of the band
+    uint8_t rows;                           // Row bands (slots)
+    uint8_t cols;                           // Characters per line
+    uint8_t lineHeight;                     // Pixels per slot
+    uint8_t size;                           // Font scale
+    uint16_t fg;
+    uint16_t bg;
+
+    uint8_t head;                           // Slot of the oldest line (shown first)
+    uint8_t count;                          // Slots in use
+    char text[MAX_LINES][MAX_COLS + 1];     // Text per slot
+    uint16_t colors[MAX_LINES];             // Color per slot
+
+
+    /**
+     * @brief Put one line (already cut to cols) into the next slot.
+     */
+    void addLine(const char* str, size_t len, uint16_t color) {
+        uint8_t slot;
+
+        if (count < rows) {
+            // Band not full yet: fill slots top to bottom, no scrolling
+            slot = count++;
+        } else {
+            // Recycle the oldest slot: scroll it to the bottom, then draw
+            slot = head;
+            head = (head + 1) % rows;
+            display.scroll(head * lineHeight);
+        }
+
+        memcpy(text[slot], str, len);
+        text[slot][len] = '\0';
+        colors[slot] = color;
+        drawSlot(slot);
+    }
+
+
+    /**
+     * @brief Draw a slot's text and clear the rest of its row band.
+     */
+    void drawSlot(uint8_t slot) {
+        int16_t y = top + slot * lineHeight;
+        int16_t w = display.getWidth();
+        int16_t textW = 0;
+        int16_t textH = FONT_5X7_HEIGHT * size;
+
+        if (slot < count && text[slot][0]) {
+            display.drawString(0, y, text[slot], colors[slot], bg, size);
+            textW = strlen(text[slot]) * FONT_5X7_CELL_WIDTH * size;
+        }
+
+        if (textW > 0) display.fillRect(0, y + textH, textW, lineHeight - textH, bg);
+        display.fillRect(textW, y, w - textW, lineHeight, bg);
+    }
+};
@@ -0,0 +1,266 @@
+/**
+ * @file span_raster.h
+ * @brief Line, circle and polygon rasterizers that emit runs instead of pixels.
+ *
+ * @details
+ * The rasterizers walk the same Bresenham / midpoint steps as before, but
+ * hand out horizontal or vertical runs of pixels to a sink:
+ *
+ * - rasterLine()       : Bresenham, consecutive pixels on one row/column merged
+ * - rasterCircle()     : midpoint outline, merged per octant
+ * - rasterFillCircle() : midpoint fill, one horizontal span per row
+ * - rasterPolygon()    : closed outline, one rasterLine() per edge
+ *
+ * A sink is anything with add(x, y, w, h). SpanSink is the usual one: it
+ * joins runs that continue each other into one rectangle and forwards the
+ * result to a fill callback (Rgb565Display::fillRect()).
+ *
+ * @par Usage
+ * @code
+ * SpanSink sink([&](int16_t x, int16_t y, int16_t w, int16_t h) {
+ *     fillRect(x, y, w, h, color);
+ * });
+ * rasterLine(0, 0, 200, 40, sink);
+ * sink.flush();
+ * @endcode
+ */
+
+/*
+ * =============================================================================
+ * BEGINNER'S GUIDE: WHY RUNS?
+ * =============================================================================
+ *
+ * Every pixel sent on its own costs a full window setup on the SPI bus:
+ *
+ *     CASET x,x   RASET y,y   RAMWR   color     → ~13 bytes, 3 commands
+ *
+ * A shallow line from (0,0) to (200,40) moves one row down every five
+ * pixels. Bresenham visits its pixels in order, so neighbours on the same
+ * row can be sent as one horizontal run:
+ *
+ *     pixel by pixel:  ▪▪▪▪▪                  201 windows
+ *                           ▪▪▪▪▪
+ *                                ▪▪▪▪▪
+ *
+ *     as runs:         ━━━━━                   41 windows
+ *                           ━━━━━
+ *                                ━━━━━
+ *
+ * Steep lines give vertical runs the same way. A circle outline is a set
+ * of runs too: near the top it is almost horizontal, near the sides almost
+ * vertical. Only a perfect 45° diagonal stays one pixel per run.
+ *
+ * The pixels themselves do not change: runs are built from exactly the
+ * points the pixel-by-pixel loop used to draw.
+ *
+ * FILLED CIRCLES: the old fill drew four vertical lines per midpoint step,
+ * overlapping each other. One horizontal span per row covers the same
+ * pixels with 2r+1 windows, and rows of equal width (around the equator)
+ * join into a single rectangle in SpanSink.
+ *
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+
+/**
+ * @brief Joins adjacent runs into rectangles before filling them.
+ *
+ * @tparam Fill Callable fill(int16_t x, int16_t y, int16_t w, int16_t h).
+ *
+ * @details
+ * A run that continues the pending rectangle (same columns on the next
+ * row, or same rows in the next column) grows it; anything else sends the
+ * pending rectangle first. Call flush() once drawing is done.
+ */
+template <typename Fill>
+class SpanSink {
+
+public:
+
+    explicit SpanSink(Fill fill) : fill(fill), pending(false), px(0), py(0), pw(0), ph(0) {}
+
+
+    /**
+     * @brief Add one run (w x h rectangle, one of w/h is usually 1).
+     */
+    void add(int16_t x, int16_t y, int16_t w, int16_t h) {
+        if (pending) {
+            if (x == px && w == pw && y == py + ph) { ph += h; return; }
+            if (y == py && h == ph && x == px + pw) { pw += w; return; }
+            fill(px, py, pw, ph);
+        }
+        px = x; py = y; pw = w; ph = h;
+        pending = true;
+    }
+
+
+    /**
+     * @brief Fill the pending rectangle, if any.
+     */
+    void flush() {
+        if (pending) fill(px, py, pw, ph);
+        pending = false;
+    }
+
+
+private:
+
+    Fill fill;
+    bool pending;
+    int16_t px, py, pw, ph;
+};
+
+
+/**
+ * @brief Collects consecutive pixels of one path into a straight run.
+ *
+ * @details
+ * Pixels must arrive in drawing order. A pixel next to the end of the run,
+ * on the same row (or column) and in the same direction, extends it;
+ * anything else closes the run and starts a new one.
+ */
+struct SpanRun {
+    int16_t x0 = 0, y0 = 0;     ///< First pixel
+    int16_t x1 = 0, y1 = 0;     ///< Last pixel
+    bool open = false;
+
+    template <typename Sink>
+    void add(int16_t x, int16_t y, Sink& sink) {
+        if (open) {
+            if (y == y1 && y0 == y1 &&
+                ((x == x1 + 1 && x1 >= x0) || (x == x1 - 1 && x1 <= x0))) {
+                x1 = x;
+                return;
+            }
+            if (x == x1 && x0 == x1 &&
+                ((y == y1 + 1 && y1 >= y0) || (y == y1 - 1 && y1 <= y0))) {
+                y1 = y;
+                return;
+            }
+            close(sink);
+        }
+        x0 = x1 = x;
+        y0 = y1 = y;
+        open = true;
+    }
+
+    template <typename Sink>
+    void close(Sink& sink) {
+        if (!open) return;
+        int16_t x = x0 < x1 ? x0 : x1;
+        int16_t y = y0 < y1 ? y0 : y1;
+        sink.add(x, y, (x0 < x1 ? x1 - x0 : x0 - x1) + 1,
+                       (y0 < y1 ? y1 - y0 : y0 - y1) + 1);
+        open = false;
+    }
+};
+
+
+/**
+ * @brief Rasterize a line (Bresenham) into runs.
+ */
+template <typename Sink>
+void rasterLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Sink& sink) {
+    int16_t dx = x1 > x0 ? x1 - x0 : x0 - x1;
+    int16_t dy = y1 > y0 ? y1 - y0 : y0 - y1;
+    int16_t sx = (x0 < x1) ? 1 : -1;
+    int16_t sy = (y0 < y1) ? 1 : -1;
+    int16_t err = dx - dy;
+    SpanRun run;
+
+    while (true) {
+        run.add(x0, y0, sink);
+
+        if (x0 == x1 && y0 == y1) break;
+
+        int16_t e2 = 2 * err;
+        if (e2 > -dy) { err -= dy; x0 += sx; }
+        if (e2 < dx) { err += dx; y0 += sy; }
+    }
+    run.close(sink);
+}
+
+
+/**
+ * @brief Rasterize a circle outline (midpoint) into runs, one per octant.
+ */
+template <typename Sink>
+void rasterCircle(int16_t cx, int16_t cy, int16_t radius, Sink& sink) {
+    int16_t x = radius;
+    int16_t y = 0;
+    int16_t err = 0;
+    SpanRun run[8];
+
+    while (x >= y) {
+        run[0].add(cx + x, cy + y, sink);
+        run[1].add(cx + y, cy + x, sink);
+        run[2].add(cx - y, cy + x, sink);
+        run[3].add(cx - x, cy + y, sink);
+        run[4].add(cx - x, cy - y, sink);
+        run[5].add(cx - y, cy - x, sink);
+        run[6].add(cx + y, cy - x, sink);
+        run[7].add(cx + x, cy - y, sink);
+
+        y++;
+        if (err <= 0) err += 2 * y + 1;
+        if (err > 0) { x--; err -= 2 * x + 1; }
+    }
+    for (int i = 0; i < 8; i++) run[i].close(sink);
+}
+
+
+/**
+ * @brief Rasterize a filled circle (midpoint) into one span per row.
+ *
+ * @details
+ * Covers the same pixels as vertical lines at ±x (height 2y+1) and ±y
+ * (height 2x+1) for every step. Rows ±y get width 2x+1 on every step;
+ * rows ±x get width 2y+1 only on the last step before x changes (the
+ * widest one), and only above the rows already done.
+ */
+template <typename Sink>
+void rasterFillCircle(int16_t cx, int16_t cy, int16_t radius, Sink& sink) {
+    if (radius < 0) return;
+
+    int16_t x = radius;
+    int16_t y = 0;
+    int16_t err = 0;
+
+    while (x >= y) {
+        sink.add(cx - x, cy + y, 2 * x + 1, 1);
+        if (y > 0) sink.add(cx - x, cy - y, 2 * x + 1, 1);
+
+        int16_t lastX = x;
+        int16_t lastY = y;
+
+        y++;
+        if (err <= 0) err += 2 * y + 1;
+        if (err > 0) { x--; err -= 2 * x + 1; }
+
+        if ((x != lastX || x < y) && lastX > lastY) {
+            sink.add(cx - lastY, cy + lastX, 2 * lastY + 1, 1);
+            sink.add(cx - lastY, cy - lastX, 2 * lastY + 1, 1);
+        }
+    }
+}
+
+
+/**
+ * @brief Rasterize a closed polygon outline into runs.
+ *
+ * @param xy Vertices as x0, y0, x1, y1, ...
+ * @param count Number of vertices.
+ */
+template <typename Sink>
+void rasterPolygon(const int16_t* xy, int count, Sink& sink) {
+    if (count <= 0) return;
+
+    for (int i = 0; i < count; i++) {
+        int j = (i + 1 == count) ? 0 : i + 1;
+        rasterLine(xy[2 * i], xy[2 * i + 1], xy[2 * j], xy[2 * j + 1], sink);
+    }
+}
@@ -0,0 +1,634 @@
+/**
+ * @file ui_screen.h
+ * @brief Retained-mode widget screen with damage tracking for the RGB565 displays.
+ *
+ * @details
+ * Instead of every screen remembering its previous values and working
+ * out what to repaint, widgets keep their own state (text, value,
+ * color, position) and report the area a change affects. Once per frame
+ * UiScreen::render() repaints only those areas:
+ *
+ * - Overlapping damage is merged, at most MAX_DAMAGE rectangles a frame
+ * - Each rectangle is cleared and redrawn through the display's clip
+ *   rectangle, widgets bottom to top (z-order = order of add())
+ * - Widgets under an opaque widget that covers the whole rectangle are
+ *   skipped, and so is the clear
+ * - Optionally each rectangle is composed in a small buffer first and
+ *   sent once (setComposeBuffer())
+ * - Frame timing and counters come out of getStats()
+ *
+ * Works with any Rgb565Display driver (GC9A01, ILI9341, ST7789, SSD1357).
+ * The widgets themselves are in ui_widgets.h.
+ *
+ * @par Usage
+ * @code
+ * UiScreen<ILI9341> screen(display, COLOR_BLACK);
+ * UiLabel<ILI9341> title(120, 10, UiAlign::CENTER, COLOR_WHITE);
+ * UiBar<ILI9341> level(20, 40, 200, 12, COLOR_GREEN, COLOR_BLACK);
+ * screen.add(title);
+ * screen.add(level);
+ *
+ * title.setText("Living room");
+ * level.setValue(40);
+ * screen.render();                // First frame: both widgets
+ *
+ * level.setValue(45);
+ * screen.render();                // Only the 10 columns that changed
+ * @endcode
+ */
+
+/*
+ * =============================================================================
+ * BEGINNER'S GUIDE: RETAINED MODE AND DAMAGE
+ * =============================================================================
+ *
+ * IMMEDIATE MODE: the app draws pixels and forgets them. To change a
+ * value it must know what is on screen now and what to erase, so every
+ * screen carries "previous value" fields and special cases.
+ *
+ * RETAINED MODE: the screen keeps a list of widgets. Changing a widget
+ * marks the rectangle it occupied (and will occupy) as DAMAGED:
+ *
+ *     label.setText("75%")   →  damage: the label's box
+ *     gauge.setValue(80)     →  damage: bounding box of the 75→80 slice
+ *
+ * render() then repaints each damaged rectangle from scratch, with
+ * drawing clipped to it:
+ *
+ *     ┌───────────────────────────┐      for each damage rect:
+ *     │  ┌─────────┐              │        clip to rect
+ *     │  │ damage ░│░░┐           │        clear to background
+ *     │  │  ┌──────┼──┐│          │        draw widgets that touch it,
+ *     │  └──┼──────┘  ││ merged   │        bottom to top
+ *     │     │ damage  ││          │
+ *     │     └─────────┘┘          │
+ *     └───────────────────────────┘
+ *
+ * Two overlapping rectangles become one (their bounding box), so no
+ * pixel is sent twice for the same frame.
+ *
+ * OPAQUE WIDGETS paint every pixel of their bounds (labels, bars, icons
+ * without transparency). If one covers a whole damage rectangle, nothing
+ * under it can show through: the clear and the widgets below are
+ * skipped.
+ *
+ * REFRESH: a change that keeps a widget's shape (only its colors change)
+ * does not need the clear either. refresh() repaints the widget (or part
+ * of it) over itself, then the widgets above it that overlap that area:
+ *
+ *     hue change         →  refresh: the arc, in its new color
+ *     gauge with a track →  refresh: the 75→80 slice (arc + track pixels
+ *                           cover every ring pixel, nothing to clear)
+ *
+ * A widget can paint a refresh its own way (drawRefresh()): the gauge
+ * paints just the slice between the old and new end, like fillArcDelta().
+ *
+ * COMPOSING: drawn straight to the panel, a damage rectangle costs the
+ * clear plus every widget on top of it, so overlapping pixels cross the
+ * SPI bus several times, each piece through its own window. With a
+ * compose buffer, the rectangle is drawn into memory band by band
+ * (Rgb565Display::beginCapture()) and each band goes out once:
+ *
+ *     damage 200 x 40, buffer 240 x 16 rows:
+ *
+ *     ┌──────────────┐  band 1: clear + widgets in RAM → 1 window, 12.8 KB
+ *     ├──────────────┤  band 2: ...
+ *     ├──────────────┤  band 3: 8 rows left
+ *     └──────────────┘
+ *
+ * Every damaged pixel is sent exactly once, whatever the overdraw.
+ * Refreshes stay direct: they already send only the pixels they change.
+ *
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <stdint.h>
+
+
+/**
+ * @brief Rectangle in screen pixels (empty when w or h <= 0).
+ */
+struct UiRect {
+    int16_t x, y, w, h;
+
+    bool isEmpty() const { return w <= 0 || h <= 0; }
+    int16_t right() const { return x + w - 1; }
+    int16_t bottom() const { return y + h - 1; }
+    int32_t area() const { return isEmpty() ? 0 : (int32_t)w * h; }
+
+    bool intersects(const UiRect& o) const {
+        return !isEmpty() && !o.isEmpty() &&
+               x <= o.right() && o.x <= right() && y <= o.bottom() && o.y <= bottom();
+    }
+
+    bool contains(const UiRect& o) const {
+        return !isEmpty() && x <= o.x && y <= o.y && right() >= o.right() && bottom() >= o.bottom();
+    }
+
+    /**
+     * @brief Bounding box of both (an empty one is ignored).
+     */
+    UiRect united(const UiRect& o) const {
+        if (isEmpty()) return o;
+        if (o.isEmpty()) return *this;
+        int16_t x0 = x < o.x ? x : o.x;
+        int16_t y0 = y < o.y ? y : o.y;
+        int16_t x1 = right() > o.right() ? right() : o.right();
+        int16_t y1 = bottom() > o.bottom() ? bottom() : o.bottom();
+        return UiRect{x0, y0, (int16_t)(x1 - x0 + 1), (int16_t)(y1 - y0 + 1)};
+    }
+
+    UiRect intersected(const UiRect& o) const {
+        int16_t x0 = x > o.x ? x : o.x;
+        int16_t y0 = y > o.y ? y : o.y;
+        int16_t x1 = right() < o.right() ? right() : o.right();
+        int16_t y1 = bottom() < o.bottom() ? bottom() : o.bottom();
+        return UiRect{x0, y0, (int16_t)(x1 - x0 + 1), (int16_t)(y1 - y0 + 1)};
+    }
+};
+
+
+/**
+ * @brief Timing and counters of the last frame and since resetStats().
+ */
+struct UiFrameStats {
+    uint32_t frames;        ///< render() calls that drew something
+    uint32_t lastUs;        ///< CPU time of the last frame (pixels queued, not sent)
+    uint32_t maxUs;         ///< Slowest frame
+    uint64_t totalUs;       ///< All frames (average = totalUs / frames)
+    uint16_t lastRects;     ///< Damage rectangles in the last frame
+    uint16_t lastBands;     ///< Composed bands sent in the last frame (0 = drawn direct)
+    uint16_t lastWidgets;   ///< Widget draws in the last frame
+    uint32_t lastPixels;    ///< Damaged pixels in the last frame (before clipping to shapes)
+};
+
+
+template <typename Display> class UiScreen;
+
+
+/**
+ * @class UiWidget
+ * @brief Base of every widget: bounds, visibility, damage reporting.
+ *
+ * @tparam Display Any Rgb565Display driver.
+ *
+ * @details
+ * A widget belongs to at most one UiScreen. Subclasses implement draw()
+ * and call invalidate() / damage() / refresh() from their setters when a
+ * property really changes.
+ */
+template <typename Display>
+class UiWidget {
+
+    friend class UiScreen<Display>;
+
+public:
+
+    virtual ~UiWidget() {
+        if (screen) screen->remove(*this);
+    }
+
+    UiWidget(const UiWidget&) = delete;
+    UiWidget& operator=(const UiWidget&) = delete;
+
+
+    /**
+     * @brief Paint the widget.
+     *
+     * @param display Display to draw on; its clip rectangle is set to area
+     *                (or to a band of it, when the screen composes).
+     * @param area Part of the bounds that needs painting (never empty).
+     *
+     * @details
+     * Drawing the whole widget is always correct (the clip drops the
+     * rest); area lets expensive widgets skip what is not needed.
+     * Opaque widgets must paint every pixel of area.
+     */
+    virtual void draw(Display& display, const UiRect& area) = 0;
+
+
+    /**
+     * @brief Paint a pending refresh() (default: draw()).
+     *
+     * @details
+     * Called once per frame for every visible widget with a pending
+     * refresh, even if a damage rectangle already covered it. A widget
+     * that remembers what it last put on screen can override this to
+     * paint only the pixels that changed since.
+     */
+    virtual void drawRefresh(Display& display, const UiRect& area) { draw(display, area); }
+
+
+    /**
+     * @brief Area the widget paints (screen pixels).
+     */
+    const UiRect& getBounds() const { return bounds; }
+
+
+    /**
+     * @brief True if draw() paints every pixel of the bounds.
+     */
+    bool isOpaque() const { return opaque; }
+
+
+    bool isVisible() const { return visible; }
+
+
+    /**
+     * @brief Show or hide the widget (the area it covers is repainted).
+     */
+    void setVisible(bool show) {
+        if (show == visible) return;
+        if (visible) invalidate();
+        visible = show;
+        if (visible) invalidate();
+    }
+
+
+    /**
+     * @brief Repaint the whole widget on the next frame.
+     */
+    void invalidate() { damage(bounds); }
+
+
+protected:
+
+    UiWidget(int16_t x, int16_t y, int16_t w, int16_t h, bool opaque)
+        : bounds{x, y, w, h}, opaque(opaque) {}
+
+
+    /**
+     * @brief Report a changed area (cleared and redrawn on the next frame).
+     */
+    void damage(const UiRect& area) {
+        if (visible && screen) screen->addDamage(area);
+    }
+
+
+    /**
+     * @brief Repaint the widget over itself on the next frame, without
+     *        clearing first.
+     *
+     * @param area Part of the bounds to repaint (default: all of it).
+     *
+     * @details
+     * Only correct if draw() paints every pixel in area that can have
+     * changed (e.g. same shape, new colors).
+     */
+    void refresh(const UiRect& area) {
+        if (visible && screen) refreshArea = refreshArea.united(area.intersected(bounds));
+    }
+
+    void refresh() { refresh(bounds); }
+
+
+    /**
+     * @brief Move/resize, repainting both the old and the new area.
+     */
+    void setBounds(const UiRect& r) {
+        if (r.x == bounds.x && r.y == bounds.y && r.w == bounds.w && r.h == bounds.h) return;
+        invalidate();
+        bounds = r;
+        invalidate();
+    }
+
+
+    void setOpaque(bool value) { opaque = value; }
+
+
+    UiRect bounds;
+    bool opaque;
+
+
+private:
+
+    UiScreen<Display>* screen = nullptr;    // Set by UiScreen::add()
+    UiWidget* next = nullptr;               // Next widget up the z-order
+    bool visible = true;
+    UiRect refreshArea = {0, 0, 0, 0};      // Pending refresh() (empty = none)
+};
+
+
+/**
+ * @class UiScreen
+ * @brief Z-ordered widget list plus the damage of the current frame.
+ *
+ * @tparam Display Any Rgb565Display driver.
+ */
+template <typename Display>
+class UiScreen {
+
+public:
+
+    /**
+     * @brief Damage rectangles kept per frame; more are merged into the
+     *        one that grows least.
+     */
+    static constexpr uint8_t MAX_DAMAGE = 8;
+
+
+    explicit UiScreen(Display& display, uint16_t background = 0x0000)
+        : display(display), background(background), head(nullptr), tail(nullptr),
+          damageCount(0), composeBuf(nullptr), composeBytes(0), stats{} {}
+
+    ~UiScreen() {
+        while (head) remove(*head);
+        heap_caps_free(composeBuf);
+    }
+
+    UiScreen(const UiScreen&) = delete;
+    UiScreen& operator=(const UiScreen&) = delete;
+
+
+    /**
+     * @brief Add a widget on top of the others.
+     */
+    void add(UiWidget<Display>& widget) {
+        if (widget.screen) return;
+
+        widget.screen = this;
+        widget.next = nullptr;
+        if (tail) tail->next = &widget;
+        else head = &widget;
+        tail = &widget;
+        widget.invalidate();
+    }
+
+
+    /**
+     * @brief Take a widget off the screen (its area is repainted).
+     */
+    void remove(UiWidget<Display>& widget) {
+        if (widget.screen != this) return;
+        widget.invalidate();
+
+        UiWidget<Display>* prev = nullptr;
+        for (UiWidget<Display>* w = head; w; prev = w, w = w->next) {
+            if (w != &widget) continue;
+            if (prev) prev->next = w->next;
+            else head = w->next;
+            if (tail == w) tail = prev;
+            break;
+        }
+
+        widget.screen = nullptr;
+        widget.next = nullptr;
+        widget.refreshArea = UiRect{0, 0, 0, 0};
+    }
+
+
+    /**
+     * @brief Mark an area for repainting on the next frame.
+     */
+    void addDamage(const UiRect& area) {
+        UiRect r = area.intersected(screenRect());
+        if (r.isEmpty()) return;
+
+        // Absorb every overlapping rectangle; when the list is full, merge
+        // with the one whose bounding box grows least
+        while (true) {
+            int hit = -1;
+            for (uint8_t i = 0; i < damageCount && hit < 0; i++) {
+                if (damage[i].intersects(r)) hit = i;
+            }
+            if (hit < 0 && damageCount < MAX_DAMAGE) break;
+            if (hit < 0) hit = cheapestMerge(r);
+
+            r = r.united(damage[hit]);
+            damage[hit] = damage[--damageCount];
+        }
+        damage[damageCount++] = r;
+    }
+
+
+    /**
+     * @brief Repaint the whole screen on the next frame.
+     */
+    void invalidate() {
+        damageCount = 0;
+        addDamage(screenRect());
+    }
+
+
+    /**
+     * @brief Change the color shown where no widget paints.
+     */
+    void setBackground(uint16_t color) {
+        if (color == background) return;
+        background = color;
+        invalidate();
+    }
+
+
+    /**
+     * @brief Compose damage in memory before sending it (see file header).
+     *
+     * @param bytes Buffer size; bands get bytes / (2 * width) rows.
+     *              0 = draw straight to the panel (default).
+     * @return false if the buffer could not be allocated or is smaller
+     *         than one screen row (composing stays off).
+     *
+     * @details
+     * 240 x 16 rows (7.5 KB) is a good size for a 240-wide panel: a few
+     * windows per rectangle, no full framebuffer. Internal RAM or PSRAM
+     * both work (bands are copied into the DMA buffers to be sent).
+     */
+    bool setComposeBuffer(size_t bytes) {
+        heap_caps_free(composeBuf);
+        composeBuf = nullptr;
+        composeBytes = 0;
+
+        if (bytes == 0) return true;
+        if (bytes < (size_t)display.getWidth() * 2) return false;
+
+        composeBuf = (uint8_t*)heap_caps_malloc(bytes, MALLOC_CAP_8BIT);
+        if (!composeBuf) return false;
+        composeBytes = bytes;
+        return true;
+    }
+
+
+    /**
+     * @brief True if damage is composed before it is sent.
+     */
+    bool isComposing() const { return composeBuf != nullptr; }
+
+
+    /**
+     * @brief True if the next render() has anything to draw.
+     */
+    bool needsRender() const {
+        if (damageCount > 0) return true;
+        for (UiWidget<Display>* w = head; w; w = w->next) {
+            if (!w->refreshArea.isEmpty()) return true;
+        }
+        return false;
+    }
+
+
+    /**
+     * @brief Draw the frame: repaint damaged areas and refreshed widgets.
+     *
+     * @return false if nothing had changed.
+     */
+    bool render() {
+        if (!needsRender()) return false;
+        int64_t start = esp_timer_get_time();
+
+        uint16_t drawn = 0;
+        uint16_t bands = 0;
+        uint32_t pixels = 0;
+        const uint8_t rects = damageCount;
+
+        for (uint8_t i = 0; i < damageCount; i++) {
+            const UiRect& r = damage[i];
+            pixels += r.area();
+
+            int16_t rows = composeBuf ? (int16_t)(composeBytes / ((size_t)r.w * 2)) : 0;
+            if (rows <= 0) {
+                drawn += repaint(r, r);
+                continue;
+            }
+
+            // Band by band: draw into the buffer, then one window each
+            for (int16_t y = r.y; y <= r.bottom(); y += rows) {
+                UiRect band{r.x, y, r.w, (int16_t)(r.bottom() - y + 1 < rows ? r.bottom() - y + 1 : rows)};
+
+                display.beginCapture(composeBuf, band.x, band.y, band.w, band.h);
+                drawn += repaint(r, band);
+                display.endCapture();
+
+                display.beginWrite(band.x, band.y, band.right(), band.bottom());
+                display.pushBytes(composeBuf, (size_t)band.area() * 2);
+                display.endWrite();
+                bands++;
+            }
+        }
+
+        // Refreshed widgets, then whatever lies above them
+        for (UiWidget<Display>* w = head; w; w = w->next) {
+            UiRect r = w->refreshArea.intersected(screenRect());
+            w->refreshArea = UiRect{0, 0, 0, 0};
+            if (!w->visible || r.isEmpty()) continue;
+
+            display.setClipRect(r.x, r.y, r.w, r.h);
+            pixels += r.area();
+            w->drawRefresh(display, r);
+            drawn += 1 + drawFrom(w->next, r, r);
+        }
+
+        display.clearClipRect();
+        damageCount = 0;
+
+        uint32_t us = (uint32_t)(esp_timer_get_time() - start);
+        stats.frames++;
+        stats.lastUs = us;
+        if (us > stats.maxUs) stats.maxUs = us;
+        stats.totalUs += us;
+        stats.lastRects = rects;
+        stats.lastBands = bands;
+        stats.lastWidgets = drawn;
+        stats.lastPixels = pixels;
+        return true;
+    }
+
+
+    /**
+     * @brief Frame timing and counters.
+     */
+    const UiFrameStats& getStats() const { return stats; }
+
+
+    /**
+     * @brief Reset the frame timing and counters.
+     */
+    void resetStats() { stats = {}; }
+
+
+    Display& getDisplay() { return display; }
+
+
+private:
+
+    Display& display;
+    uint16_t background;
+    UiWidget<Display>* head;        // Bottom of the z-order
+    UiWidget<Display>* tail;        // Top
+    UiRect damage[MAX_DAMAGE];
+    uint8_t damageCount;
+    uint8_t* composeBuf;            // setComposeBuffer() (nullptr = draw direct)
+    size_t composeBytes;
+    UiFrameStats stats;
+
+
+    /**
+     * @brief Clear damage rectangle r and draw the widgets that touch it,
+     *        clipped to part (r itself or one of its bands).
+     *
+     * @return Number of widgets drawn.
+     */
+    uint16_t repaint(const UiRect& r, const UiRect& part) {
+        display.setClipRect(part.x, part.y, part.w, part.h);
+
+        // The topmost opaque widget covering the rectangle hides the
+        // background and everything under it
+        UiWidget<Display>* from = nullptr;
+        for (UiWidget<Display>* w = head; w; w = w->next) {
+            if (w->visible && w->opaque && w->bounds.contains(r)) from = w;
+        }
+        if (!from) {
+            display.fillRect(part.x, part.y, part.w, part.h, background);
+            from = head;
+        }
+
+        return drawFrom(from, r, part);
+    }
+
+
+    /**
+     * @brief Draw the visible widgets from `from` up that touch part of r.
+     *
+     * @details
+     * Widgets get their share of the whole rectangle r as the area to
+     * paint (the clip keeps them inside part): a band of a composed
+     * rectangle still counts as painting all of r, which r is by the end
+     * of the frame.
+     *
+     * @return Number of widgets drawn.
+     */
+    uint16_t drawFrom(UiWidget<Display>* from, const UiRect& r, const UiRect& part) {
+        uint16_t drawn = 0;
+        for (UiWidget<Display>* w = from; w; w = w->next) {
+            if (!w->visible || !w->bounds.intersects(part)) continue;
+            w->draw(display, w->bounds.intersected(r));
+            drawn++;
+        }
+        return drawn;
+    }
+
+
+    UiRect screenRect() const {
+        return UiRect{0, 0, (int16_t)display.getWidth(), (int16_t)display.getHeight()};
+    }
+
+
+    /**
+     * @brief Damage rectangle that grows least when merged with r.
+     */
+    int cheapestMerge(const UiRect& r) const {
+        int best = 0;
+        int32_t bestGrowth = INT32_MAX;
+        for (uint8_t i = 0; i < damageCount; i++) {
+            int32_t growth = damage[i].united(r).area() - damage[i].area();
+            if (growth < bestGrowth) {
+                bestGrowth = growth;
+                best = i;
+            }
+        }
+        return best;
+    }
+};
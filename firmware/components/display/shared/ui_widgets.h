@@ -0,0 +1,771 @@
+/**
+ * @file ui_widgets.h
+ * @brief Label, arc gauge, icon, bar and list widgets for UiScreen.
+ *
+ * @details
+ * Each widget keeps its own state and, when a setter really changes
+ * something, reports the smallest area that has to be repainted (see
+ * ui_screen.h). Setters are cheap to call every frame with the same
+ * value: nothing is marked, nothing is drawn.
+ *
+ *     Widget       Draws with                     A change repaints
+ *     ──────────   ────────────────────────────   ───────────────────────────
+ *     UiLabel      drawString() / drawText()      its box (old + new if the
+ *                                                 text width moves it)
+ *     UiArcGauge   fillArc()                      bounding box of the slice
+ *                                                 between old and new value
+ *     UiIcon       drawSprite() / drawBitmap()    the image
+ *     UiBar        fillRect()                     the part between old and
+ *                                                 new value
+ *     UiList       drawString()                   the rows that changed
+ *
+ * @par Usage
+ * @code
+ * UiScreen<GC9A01> screen(display);
+ * UiArcGauge<GC9A01> dial(ring, 120, 120, COLOR_ORANGE);
+ * UiLabel<GC9A01> value(120, 110, UiAlign::CENTER, COLOR_WHITE);
+ * value.setFont(bigFont, &glyphCache);
+ * value.setBoxWidth(bigFont.textWidth("100%"));    // Fixed box: no clear
+ * screen.add(dial);
+ * screen.add(value);
+ *
+ * dial.setValue(level);
+ * value.setTextf("%d%%", level);
+ * screen.render();
+ * @endcode
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "arc_spans.h"
+#include "font_5x7.h"
+#include "glyph_cache.h"
+#include "packed_font.h"
+#include "rgb565_asset.h"
+#include "ui_screen.h"
+
+
+/**
+ * @brief Horizontal alignment of a label around its anchor X.
+ */
+enum class UiAlign : uint8_t {
+    LEFT,       ///< x is the left edge
+    CENTER,     ///< x is the center
+    RIGHT,      ///< x is the right edge
+};
+
+
+/**
+ * @brief Fill the part of box that is not inside inner.
+ *
+ * @details
+ * Used by opaque widgets that draw opaque text in a bigger box: the
+ * margins are filled, the text area is not painted twice.
+ */
+template <typename Display>
+void uiFillAround(Display& display, const UiRect& box, const UiRect& inner, uint16_t color) {
+    UiRect in = inner.intersected(box);
+    if (in.isEmpty()) {
+        display.fillRect(box.x, box.y, box.w, box.h, color);
+        return;
+    }
+    display.fillRect(box.x, box.y, box.w, in.y - box.y, color);
+    display.fillRect(box.x, in.y, in.x - box.x, in.h, color);
+    display.fillRect(in.right() + 1, in.y, box.right() - in.right(), in.h, color);
+    display.fillRect(box.x, in.bottom() + 1, box.w, box.bottom() - in.bottom(), color);
+}
+
+
+/* =============================================================================
+ * UiLabel
+ * ========================================================================== */
+
+/**
+ * @class UiLabel
+ * @brief One line of opaque text, in the 5x7 font or a PackedFont.
+ *
+ * @tparam Display Any Rgb565Display driver.
+ * @tparam MAX_CHARS Longest text kept (longer text is cut).
+ *
+ * @details
+ * The box is the text itself, or a fixed width set with setBoxWidth()
+ * with the text aligned in it. A fixed box never moves, so changing the
+ * text repaints just the box, with no clear underneath.
+ */
+template <typename Display, uint8_t MAX_CHARS = 31>
+class UiLabel : public UiWidget<Display> {
+
+public:
+
+    /**
+     * @param x Anchor X (left edge, center or right edge, see align).
+     * @param y Top of the text.
+     * @param align How the box sits around x.
+     * @param color Text color (RGB565).
+     * @param bg Background color of the box (RGB565).
+     */
+    UiLabel(int16_t x, int16_t y, UiAlign align = UiAlign::LEFT,
+            uint16_t color = 0xFFFF, uint16_t bg = 0x0000)
+        : UiWidget<Display>(x, y, 0, FONT_5X7_HEIGHT, true),
+          anchorX(x), align(align), color(color), bg(bg), size(1),
+          font(nullptr), cache(nullptr), boxWidth(0) {
+        text[0] = '\0';
+    }
+
+
+    /**
+     * @brief Use the built-in 5x7 font at a scale (the default, size 1).
+     */
+    void setFont(uint8_t scale) {
+        if (scale == 0) scale = 1;
+        if (!font && scale == size) return;
+        font = nullptr;
+        cache = nullptr;
+        size = scale;
+        relayout();
+    }
+
+
+    /**
+     * @brief Use a converted font (see packed_font.h).
+     *
+     * @param f Font opened with PackedFont::open() (must outlive the label).
+     * @param glyphCache Optional cache for repeated glyphs.
+     */
+    void setFont(const PackedFont& f, GlyphCache* glyphCache = nullptr) {
+        cache = glyphCache;
+        if (font == &f) return;
+        font = &f;
+        relayout();
+    }
+
+
+    /**
+     * @brief Change the text (single line).
+     */
+    void setText(const char* str) {
+        if (strncmp(str, text, MAX_CHARS) == 0) return;     // Same text once cut
+        strncpy(text, str, MAX_CHARS);
+        text[MAX_CHARS] = '\0';
+        relayout();
+    }
+
+
+    /**
+     * @brief Change the text, printf style.
+     */
+    void setTextf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+        char buf[MAX_CHARS + 1];
+        va_list args;
+        va_start(args, format);
+        vsnprintf(buf, sizeof(buf), format, args);
+        va_end(args);
+        setText(buf);
+    }
+
+
+    /**
+     * @brief Change the text and box colors (RGB565).
+     */
+    void setColor(uint16_t textColor, uint16_t background) {
+        if (textColor == color && background == bg) return;
+        color = textColor;
+        bg = background;
+        this->invalidate();
+    }
+
+    void setColor(uint16_t textColor) { setColor(textColor, bg); }
+
+
+    /**
+     * @brief Fix the box width (0 = as wide as the text).
+     */
+    void setBoxWidth(int16_t width) {
+        if (width < 0) width = 0;
+        if (width == boxWidth) return;
+        boxWidth = width;
+        relayout();
+    }
+
+
+    /**
+     * @brief Move the anchor.
+     */
+    void setPosition(int16_t x, int16_t y) {
+        if (x == anchorX && y == this->bounds.y) return;
+        anchorX = x;
+        this->setBounds(layout(y));
+    }
+
+
+    const char* getText() const { return text; }
+
+
+    void draw(Display& display, const UiRect&) override {
+        const UiRect& box = this->bounds;
+        int16_t w = textWidth();
+        int16_t x = box.x;
+        if (align == UiAlign::CENTER) x += (box.w - w) / 2;
+        else if (align == UiAlign::RIGHT) x += box.w - w;
+
+        uiFillAround(display, box, UiRect{x, box.y, w, box.h}, bg);
+        if (!text[0]) return;
+
+        if (font) {
+            display.drawText(x, box.y, *font, text, color, bg, cache);
+        } else {
+            display.drawString(x, box.y, text, color, bg, size);
+        }
+    }
+
+
+private:
+
+    int16_t anchorX;
+    UiAlign align;
+    uint16_t color;
+    uint16_t bg;
+    uint8_t size;                   // 5x7 scale (font == nullptr)
+    const PackedFont* font;
+    GlyphCache* cache;
+    int16_t boxWidth;               // 0 = fit the text
+    char text[MAX_CHARS + 1];
+
+
+    int16_t textWidth() const {
+        if (font) return font->isValid() ? font->textWidth(text, strlen(text)) : 0;
+        return (int16_t)strlen(text) * FONT_5X7_CELL_WIDTH * size;
+    }
+
+
+    UiRect layout(int16_t y) const {
+        int16_t w = boxWidth ? boxWidth : textWidth();
+        int16_t h = font ? font->lineHeight : FONT_5X7_HEIGHT * size;
+        int16_t x = anchorX;
+        if (align == UiAlign::CENTER) x -= w / 2;
+        else if (align == UiAlign::RIGHT) x -= w - 1;
+        return UiRect{x, y, w, h};
+    }
+
+
+    /**
+     * @brief Recompute the box after a text or font change; repaint it
+     *        (and the old box, if it moved).
+     */
+    void relayout() {
+        UiRect r = layout(this->bounds.y);
+        const UiRect& b = this->bounds;
+        if (r.x == b.x && r.w == b.w && r.h == b.h) {
+            this->invalidate();
+        } else {
+            this->setBounds(r);
+        }
+    }
+};
+
+
+/* =============================================================================
+ * UiArcGauge
+ * ========================================================================== */
+
+/**
+ * @class UiArcGauge
+ * @brief Ring dial showing a 0-100 value as an arc (see arc_spans.h).
+ *
+ * @tparam Display Any Rgb565Display driver.
+ *
+ * @details
+ * A value change repaints only the bounding box of the slice between
+ * the old and the new end, so a one-step change costs a few hundred
+ * pixels, not the whole ring.
+ *
+ * Without a track color the rest of the ring shows whatever is under the
+ * gauge, so the slice box is cleared and redrawn. With a track color
+ * (even one equal to the background) the gauge owns every ring pixel:
+ * a value change paints just the slice between the old and the new end
+ * (fillArcDelta()), and a color change just the arc.
+ */
+template <typename Display>
+class UiArcGauge : public UiWidget<Display> {
+
+public:
+
+    /**
+     * @param ring Row extents of the ring (init() done, must outlive the gauge).
+     * @param cx Center X.
+     * @param cy Center Y.
+     * @param color Arc color (RGB565).
+     * @param startDeg Angle of value 0 (0 = top, clockwise).
+     * @param sweepDeg Angle covered by value 100.
+     */
+    UiArcGauge(const ArcSpanTable& ring, int16_t cx, int16_t cy, uint16_t color,
+               int16_t startDeg = 0, int16_t sweepDeg = 360)
+        : UiWidget<Display>(cx - ring.getOuterRadius(), cy - ring.getOuterRadius(),
+                            2 * ring.getOuterRadius() + 1, 2 * ring.getOuterRadius() + 1, false),
+          ring(ring), cx(cx), cy(cy), startDeg(startDeg), sweepDeg(sweepDeg),
+          color(color), track(0), hasTrack(false), value(0),
+          shownValid(false), shownEnd(startDeg), shownColor(color), shownTrack(0) {}
+
+
+    /**
+     * @brief Set the level (clamped to 100).
+     */
+    void setValue(uint8_t percent) {
+        if (percent > 100) percent = 100;
+        if (percent == value) return;
+
+        int a = endAngle(value);
+        int b = endAngle(percent);
+        value = percent;
+        if (a == b) return;
+
+        UiRect slice = sliceBounds(a < b ? a : b, a < b ? b : a);
+        if (hasTrack) this->refresh(slice);
+        else this->damage(slice);
+    }
+
+
+    /**
+     * @brief Change the arc color (repainted in place, no clear).
+     */
+    void setColor(uint16_t arcColor) {
+        if (arcColor == color) return;
+        color = arcColor;
+        int end = endAngle(value);
+        if (end > startDeg) this->refresh(sliceBounds(startDeg, end));
+    }
+
+
+    /**
+     * @brief Paint the unfilled part of the ring in a color (see class notes).
+     */
+    void setTrackColor(uint16_t trackColor) {
+        if (hasTrack && trackColor == track) return;
+        track = trackColor;
+        hasTrack = true;
+        if (value < 100) this->refresh();
+    }
+
+
+    uint8_t getValue() const { return value; }
+
+
+    void draw(Display& display, const UiRect& area) override {
+        int end = endAngle(value);
+        if (hasTrack && end < startDeg + sweepDeg) {
+            display.fillArc(ring, cx, cy, end, startDeg + sweepDeg, track);
+        }
+        if (end > startDeg) {
+            display.fillArc(ring, cx, cy, startDeg, end, color);
+        }
+
+        // Everything on screen is current only after a full paint
+        UiRect all = this->bounds.intersected(
+            UiRect{0, 0, (int16_t)display.getWidth(), (int16_t)display.getHeight()});
+        if (area.contains(all)) markShown();
+    }
+
+
+    /**
+     * @brief Paint only what changed since the last refresh or full paint.
+     */
+    void drawRefresh(Display& display, const UiRect& area) override {
+        if (!hasTrack || !shownValid || shownTrack != track) {
+            draw(display, area);
+            markShown();
+            return;
+        }
+
+        int end = endAngle(value);
+        if (shownColor != color) {
+            if (end > startDeg) display.fillArc(ring, cx, cy, startDeg, end, color);
+            if (end < shownEnd) {
+                display.fillArcDelta(ring, cx, cy, startDeg, shownEnd, end, color, track);
+            }
+        } else {
+            display.fillArcDelta(ring, cx, cy, startDeg, shownEnd, end, color, track);
+        }
+        markShown();
+    }
+
+
+private:
+
+    const ArcSpanTable& ring;
+    int16_t cx, cy;
+    int16_t startDeg;
+    int16_t sweepDeg;
+    uint16_t color;
+    uint16_t track;
+    bool hasTrack;
+    uint8_t value;
+
+    // What the last refresh or full paint left on screen
+    bool shownValid;
+    int16_t shownEnd;
+    uint16_t shownColor;
+    uint16_t shownTrack;
+
+
+    void markShown() {
+        shownValid = true;
+        shownEnd = endAngle(value);
+        shownColor = color;
+        shownTrack = track;
+    }
+
+
+    int endAngle(uint8_t v) const { return startDeg + (int)v * sweepDeg / 100; }
+
+
+    /**
+     * @brief Bounding box of the ring between two angles.
+     *
+     * @details
+     * The four corner points of the slice, plus the outer edge at every
+     * multiple of 90° inside it (where the ring is widest); one pixel of
+     * margin covers rounding.
+     */
+    UiRect sliceBounds(int a, int b) const {
+        const float inner = ring.getInnerRadius();
+        const float outer = ring.getOuterRadius();
+        float x0 = 1e9f, y0 = 1e9f, x1 = -1e9f, y1 = -1e9f;
+
+        auto addPoint = [&](int deg, float radius) {
+            float rad = deg * (float)M_PI / 180.0f;
+            float x = radius * sinf(rad);
+            float y = -radius * cosf(rad);
+            if (x < x0) x0 = x;
+            if (x > x1) x1 = x;
+            if (y < y0) y0 = y;
+            if (y > y1) y1 = y;
+        };
+
+        addPoint(a, inner);
+        addPoint(a, outer);
+        addPoint(b, inner);
+        addPoint(b, outer);
+        for (int q = (int)floorf(a / 90.0f) * 90 + 90; q < b; q += 90) addPoint(q, outer);
+
+        int16_t left = cx + (int16_t)floorf(x0) - 1;
+        int16_t top = cy + (int16_t)floorf(y0) - 1;
+        int16_t right = cx + (int16_t)ceilf(x1) + 1;
+        int16_t bottom = cy + (int16_t)ceilf(y1) + 1;
+        return UiRect{left, top, (int16_t)(right - left + 1), (int16_t)(bottom - top + 1)}
+            .intersected(this->bounds);
+    }
+};
+
+
+/* =============================================================================
+ * UiIcon
+ * ========================================================================== */
+
+/**
+ * @class UiIcon
+ * @brief Image from flash (see rgb565_asset.h).
+ *
+ * @tparam Display Any Rgb565Display driver.
+ *
+ * @details
+ * Images with a transparent key are drawn with drawSprite() and let the
+ * widgets below show through; images without one are opaque.
+ */
+template <typename Display>
+class UiIcon : public UiWidget<Display> {
+
+public:
+
+    /**
+     * @param x Left edge.
+     * @param y Top edge.
+     * @param image Image opened with Rgb565Asset::open() (must outlive the icon).
+     */
+    UiIcon(int16_t x, int16_t y, const Rgb565Asset& image)
+        : UiWidget<Display>(x, y, image.width, image.height, !image.hasKey), asset(&image) {}
+
+
+    /**
+     * @brief Show another image (same top-left corner).
+     */
+    void setImage(const Rgb565Asset& image) {
+        if (&image == asset) return;
+        this->invalidate();
+        asset = &image;
+        this->bounds.w = image.width;
+        this->bounds.h = image.height;
+        this->setOpaque(!image.hasKey);
+        this->invalidate();
+    }
+
+
+    void setPosition(int16_t x, int16_t y) {
+        this->setBounds(UiRect{x, y, this->bounds.w, this->bounds.h});
+    }
+
+
+    void draw(Display& display, const UiRect&) override {
+        display.drawSprite(this->bounds.x, this->bounds.y, *asset);
+    }
+
+
+private:
+
+    const Rgb565Asset* asset;
+};
+
+
+/* =============================================================================
+ * UiBar
+ * ========================================================================== */
+
+/**
+ * @class UiBar
+ * @brief Level bar: left to right when wider than tall, else bottom to top.
+ *
+ * @tparam Display Any Rgb565Display driver.
+ */
+template <typename Display>
+class UiBar : public UiWidget<Display> {
+
+public:
+
+    /**
+     * @param x Left edge.
+     * @param y Top edge.
+     * @param w Width.
+     * @param h Height.
+     * @param color Filled part (RGB565).
+     * @param bg Empty part (RGB565).
+     */
+    UiBar(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color, uint16_t bg = 0x0000)
+        : UiWidget<Display>(x, y, w, h, true), color(color), bg(bg), value(0) {}
+
+
+    /**
+     * @brief Set the level (clamped to 100); repaints only the change.
+     */
+    void setValue(uint8_t percent) {
+        if (percent > 100) percent = 100;
+        if (percent == value) return;
+
+        int16_t a = fillLength(value);
+        int16_t b = fillLength(percent);
+        value = percent;
+        if (a == b) return;
+
+        if (a > b) {
+            int16_t t = a;
+            a = b;
+            b = t;
+        }
+        const UiRect& r = this->bounds;
+        if (horizontal()) this->damage(UiRect{(int16_t)(r.x + a), r.y, (int16_t)(b - a), r.h});
+        else this->damage(UiRect{r.x, (int16_t)(r.bottom() + 1 - b), r.w, (int16_t)(b - a)});
+    }
+
+
+    /**
+     * @brief Change the colors (RGB565).
+     */
+    void setColor(uint16_t fill, uint16_t background) {
+        if (fill == color && background == bg) return;
+        color = fill;
+        bg = background;
+        this->invalidate();
+    }
+
+
+    uint8_t getValue() const { return value; }
+
+
+    void draw(Display& display, const UiRect&) override {
+        const UiRect& r = this->bounds;
+        int16_t n = fillLength(value);
+        if (horizontal()) {
+            display.fillRect(r.x, r.y, n, r.h, color);
+            display.fillRect(r.x + n, r.y, r.w - n, r.h, bg);
+        } else {
+            display.fillRect(r.x, r.y, r.w, r.h - n, bg);
+            display.fillRect(r.x, r.bottom() + 1 - n, r.w, n, color);
+        }
+    }
+
+
+private:
+
+    uint16_t color;
+    uint16_t bg;
+    uint8_t value;
+
+
+    bool horizontal() const { return this->bounds.w >= this->bounds.h; }
+
+    int16_t fillLength(uint8_t v) const {
+        int16_t length = horizontal() ? this->bounds.w : this->bounds.h;
+        return (int32_t)length * v / 100;
+    }
+};
+
+
+/* =============================================================================
+ * UiList
+ * ========================================================================== */
+
+/**
+ * @class UiList
+ * @brief Vertical list of text rows with one highlighted selection.
+ *
+ * @tparam Display Any Rgb565Display driver.
+ * @tparam MAX_ITEMS Items kept (pointers only: the strings must outlive
+ *                   the list, e.g. literals).
+ *
+ * @details
+ * Moving the selection repaints the two rows involved; scrolling (when
+ * the selection leaves the visible rows) repaints the whole list.
+ */
+template <typename Display, uint8_t MAX_ITEMS = 16>
+class UiList : public UiWidget<Display> {
+
+public:
+
+    /**
+     * @brief Pixels above and below the text of each row.
+     */
+    static constexpr uint8_t ROW_PADDING = 3;
+
+
+    /**
+     * @param x Left edge.
+     * @param y Top edge.
+     * @param w Width.
+     * @param rows Rows shown at once.
+     * @param color Text color (RGB565).
+     * @param bg Row background (RGB565).
+     * @param size 5x7 font scale.
+     */
+    UiList(int16_t x, int16_t y, int16_t w, uint8_t rows,
+           uint16_t color = 0xFFFF, uint16_t bg = 0x0000, uint8_t size = 1)
+        : UiWidget<Display>(x, y, w, rows * (FONT_5X7_HEIGHT * size + 2 * ROW_PADDING), true),
+          rows(rows), size(size), rowHeight(FONT_5X7_HEIGHT * size + 2 * ROW_PADDING),
+          color(color), bg(bg), selColor(bg), selBg(color),
+          count(0), top(0), selected(-1) {}
+
+
+    /**
+     * @brief Replace all items (repaints the list).
+     */
+    void setItems(const char* const* list, uint8_t n) {
+        count = n > MAX_ITEMS ? MAX_ITEMS : n;
+        for (uint8_t i = 0; i < count; i++) items[i] = list[i];
+        top = 0;
+        if (selected >= count) selected = count - 1;
+        scrollTo(selected);
+        this->invalidate();
+    }
+
+
+    /**
+     * @brief Replace one item's text (repaints its row).
+     */
+    void setItem(uint8_t index, const char* text) {
+        if (index >= count || items[index] == text) return;
+        items[index] = text;
+        damageItem(index);
+    }
+
+
+    /**
+     * @brief Highlight an item (-1 = none), scrolling it into view.
+     */
+    void setSelected(int16_t index) {
+        if (index < -1 || index >= count) index = -1;
+        if (index == selected) return;
+
+        int16_t old = selected;
+        selected = index;
+        if (scrollTo(index)) {
+            this->invalidate();
+        } else {
+            damageItem(old);
+            damageItem(index);
+        }
+    }
+
+
+    /**
+     * @brief Colors of the selected row (default: inverted).
+     */
+    void setHighlight(uint16_t textColor, uint16_t background) {
+        selColor = textColor;
+        selBg = background;
+        damageItem(selected);
+    }
+
+
+    int16_t getSelected() const { return selected; }
+    uint8_t getCount() const { return count; }
+
+
+    void draw(Display& display, const UiRect& area) override {
+        const UiRect& r = this->bounds;
+        for (uint8_t row = 0; row < rows; row++) {
+            UiRect rowRect{r.x, (int16_t)(r.y + row * rowHeight), r.w, (int16_t)rowHeight};
+            if (!rowRect.intersects(area)) continue;
+
+            uint8_t item = top + row;
+            bool isSel = item == selected;
+            uint16_t fg = isSel ? selColor : color;
+            uint16_t back = isSel ? selBg : bg;
+            const char* text = item < count ? items[item] : "";
+
+            int16_t textW = (int16_t)strlen(text) * FONT_5X7_CELL_WIDTH * size;
+            UiRect textRect{(int16_t)(r.x + ROW_PADDING), (int16_t)(rowRect.y + ROW_PADDING),
+                            textW, (int16_t)(FONT_5X7_HEIGHT * size)};
+
+            uiFillAround(display, rowRect, textRect, back);
+            if (textW > 0) display.drawString(textRect.x, textRect.y, text, fg, back, size);
+        }
+    }
+
+
+private:
+
+    uint8_t rows;
+    uint8_t size;
+    uint8_t rowHeight;
+    uint16_t color, bg;
+    uint16_t selColor, selBg;
+    const char* items[MAX_ITEMS];
+    uint8_t count;
+    uint8_t top;                    // First item shown
+    int16_t selected;
+
+
+    /**
+     * @brief Scroll so that index is visible.
+     *
+     * @return true if the list scrolled.
+     */
+    bool scrollTo(int16_t index) {
+        if (index < 0) return false;
+        uint8_t newTop = top;
+        if (index < newTop) newTop = index;
+        if (index >= newTop + rows) newTop = index - rows + 1;
+        if (newTop == top) return false;
+        top = newTop;
+        return true;
+    }
+
+
+    void damageItem(int16_t index) {
+        if (index < top || index >= top + rows) return;
+        const UiRect& r = this->bounds;
+        this->damage(UiRect{r.x, (int16_t)(r.y + (index - top) * rowHeight), r.w, (int16_t)rowHeight});
+    }
+};
@@ -0,0 +1,160 @@
+/**
+ * @file window_cache.h
+ * @brief Address-window cache shared by the SPI RGB565 display drivers.
+ *
+ * @details
+ * Every drawing primitive opens a window (column range, row range, then
+ * "write RAM") before sending pixels. The controller keeps the last column
+ * and row ranges in its registers, so re-sending an unchanged range is
+ * pure overhead. This cache remembers what was last programmed and tells
+ * the driver which of the two range commands it can skip.
+ *
+ * Used by ILI9341, ST7789, GC9A01 and SSD1357.
+ *
+ * @par Usage
+ * @code
+ * #include "../shared/window_cache.h"
+ *
+ * WindowCache windowCache(4);   // 4 parameter bytes per range command
+ *
+ * void setWindow(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+ *     if (windowCache.needColumns(x0, x1)) sendColumnRange(x0, x1);
+ *     if (windowCache.needRows(y0, y1))    sendRowRange(y0, y1);
+ *     sendCommand(RAMWR);   // Always needed: resets the write pointer
+ * }
+ * @endcode
+ */
+
+/*
+ * =============================================================================
+ * WHY CACHE THE WINDOW?
+ * =============================================================================
+ *
+ * A window setup used to be seven tiny SPI transactions:
+ *
+ *     CASET  x0  x1  PASET  y0  y1  RAMWR
+ *       │     │   │    │     │   │    │
+ *      cmd  data data cmd  data data cmd      ← each one a DC toggle + SPI
+ *
+ * Two things make most of that unnecessary:
+ *
+ *     1. Coalescing: the four parameter bytes of a range command can go
+ *        out in ONE data transaction (7 → 5 transactions).
+ *
+ *     2. Caching: drawing text or spans line by line usually keeps the
+ *        same columns and only moves the row (or vice versa). The skipped
+ *        range costs nothing at all (5 → 3 transactions).
+ *
+ *     drawHLine on consecutive rows, same x range:
+ *
+ *         Before:  CASET x0 x1 PASET y y RAMWR  (7 transactions)
+ *         After:   PASET [y y] RAMWR           (3 transactions)
+ *
+ * WHEN TO INVALIDATE:
+ *     - After a hardware/software reset (registers are back to defaults)
+ *     - After a rotation change (safer to reprogram both ranges)
+ *
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+
+/**
+ * @brief Counters for window commands the cache saved.
+ */
+struct DisplayWindowStats {
+    uint32_t windowsSet;        ///< setWindow() calls
+    uint32_t commandsElided;    ///< Column/row commands skipped (range unchanged)
+    uint32_t bytesSaved;        ///< Command + parameter bytes not sent
+};
+
+
+/**
+ * @class WindowCache
+ * @brief Remembers the last programmed column/row ranges of a display.
+ */
+class WindowCache {
+
+public:
+
+    /**
+     * @brief Create a cache.
+     *
+     * @param paramBytes Parameter bytes per range command
+     *                   (4 for 16-bit ranges, 2 for 8-bit ranges).
+     */
+    explicit WindowCache(uint8_t paramBytes)
+        : paramBytes(paramBytes), colValid(false), rowValid(false),
+          col0(0), col1(0), row0(0), row1(0), stats{} {}
+
+
+    /**
+     * @brief Forget the programmed ranges (next window sends both).
+     */
+    void invalidate() {
+        colValid = false;
+        rowValid = false;
+    }
+
+
+    /**
+     * @brief Check whether a column range must be sent, and remember it.
+     *
+     * @param x0 First column (after offsets).
+     * @param x1 Last column (after offsets).
+     * @return true if the driver must send the column command.
+     */
+    bool needColumns(int16_t x0, int16_t x1) {
+        stats.windowsSet++;
+        return need(colValid, col0, col1, x0, x1);
+    }
+
+
+    /**
+     * @brief Check whether a row range must be sent, and remember it.
+     *
+     * @param y0 First row (after offsets).
+     * @param y1 Last row (after offsets).
+     * @return true if the driver must send the row command.
+     */
+    bool needRows(int16_t y0, int16_t y1) {
+        return need(rowValid, row0, row1, y0, y1);
+    }
+
+
+    /**
+     * @brief Get the counters.
+     */
+    const DisplayWindowStats& getStats() const { return stats; }
+
+
+    /**
+     * @brief Reset the counters to zero.
+     */
+    void resetStats() { stats = {}; }
+
+
+private:
+
+    uint8_t paramBytes;
+    bool colValid;
+    bool rowValid;
+    int16_t col0, col1;
+    int16_t row0, row1;
+    DisplayWindowStats stats;
+
+    bool need(bool& valid, int16_t& lo, int16_t& hi, int16_t a, int16_t b) {
+        if (valid && lo == a && hi == b) {
+            stats.commandsElided++;
+            stats.bytesSaved += 1 + paramBytes;
+            return false;
+        }
+        valid = true;
+        lo = a;
+        hi = b;
+        return true;
+    }
+};
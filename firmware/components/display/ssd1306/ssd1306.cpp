@@ -129,17 +129,43 @@ static const uint8_t font5x7[] = {
 };
 
 
-SSD1306::SSD1306(i2c_master_bus_handle_t busHandle, uint8_t address)
+SSD1306::SSD1306(i2c_master_bus_handle_t busHandle, uint8_t address, uint32_t sclSpeedHz)
     : address(address),
+      sclSpeedHz(sclSpeedHz),
       initialized(false),
       busHandle(busHandle),
-      devHandle(nullptr)
+      devHandle(nullptr),
+      shadowValid(false),
+      windowCount(0),
+      lastUpdateBytes(0),
+      flushing(false),
+      stopping(false),
+      flushTaskHandle(nullptr),
+      flushEvents(nullptr),
+      flushCallback(nullptr),
+      flushCallbackArg(nullptr)
 {
     memset(buffer, 0, SSD1306_BUFFER_SIZE);
+    txBuffer[0] = 0x40;  // Data mode
+    for (uint8_t page = 0; page < SSD1306_PAGES; page++) {
+        dirtyX0[page] = SSD1306_WIDTH;
+        dirtyX1[page] = -1;
+    }
+    invalidate();
 }
 
 
 SSD1306::~SSD1306() {
+    if (flushTaskHandle) {
+        // The task may still be in the flush callback after EVENT_IDLE:
+        // let it finish and park itself before it is deleted.
+        waitFlush();
+        stopping = true;
+        xTaskNotifyGive(flushTaskHandle);
+        xEventGroupWaitBits(flushEvents, SSD1306_EVENT_STOPPED, pdFALSE, pdTRUE, portMAX_DELAY);
+        vTaskDelete(flushTaskHandle);
+    }
+    if (flushEvents) vEventGroupDelete(flushEvents);
     if (initialized && devHandle) {
         i2c_master_bus_rm_device(devHandle);
     }
@@ -158,7 +184,7 @@ bool SSD1306::init() {
     i2c_device_config_t devConfig = {};
     devConfig.dev_addr_length = I2C_ADDR_BIT_LEN_7;
     devConfig.device_address = address;
-    devConfig.scl_speed_hz = 400000;
+    devConfig.scl_speed_hz = sclSpeedHz;
 
     esp_err_t err = i2c_master_bus_add_device(busHandle, &devConfig, &devHandle);
     if (err != ESP_OK) {
@@ -193,6 +219,10 @@ bool SSD1306::init() {
     sendCommand(SSD1306_CMD_NORMAL_DISPLAY);
     sendCommand(SSD1306_CMD_DISPLAY_ON);
 
+    // Async flush bookkeeping (the task itself starts on first use)
+    if (!flushEvents) flushEvents = xEventGroupCreate();
+    if (flushEvents) xEventGroupSetBits(flushEvents, SSD1306_EVENT_IDLE);
+
     initialized = true;
     ESP_LOGI(TAG, "SSD1306 initialized");
     return true;
@@ -205,45 +235,229 @@ void SSD1306::sendCommand(uint8_t cmd) {
 }
 
 
-void SSD1306::sendData(const uint8_t* data, size_t len) {
-    // Allocate buffer: control byte + data
-    uint8_t* buf = new uint8_t[len + 1];
-    buf[0] = 0x40;  // Data mode
-    memcpy(buf + 1, data, len);
+void SSD1306::sendCommands(const uint8_t* cmds, size_t len) {
+    uint8_t buf[8] = {0x00};  // 0x00 = command mode
+    memcpy(buf + 1, cmds, len);
     i2c_master_transmit(devHandle, buf, len + 1, 100);
-    delete[] buf;
+    lastUpdateBytes += len + 1;
+}
+
+
+void SSD1306::sendWindow(int16_t x0, int16_t x1, uint8_t page0, uint8_t page1) {
+    const uint8_t cmds[] = {
+        SSD1306_CMD_SET_COLUMN_ADDR, (uint8_t)x0, (uint8_t)x1,
+        SSD1306_CMD_SET_PAGE_ADDR, page0, page1
+    };
+    sendCommands(cmds, sizeof(cmds));
+
+    // Horizontal addressing: the window is filled page by page, each page
+    // from x0 to x1. Pack the segments behind the control byte.
+    size_t width = x1 - x0 + 1;
+    size_t len = 0;
+    for (uint8_t page = page0; page <= page1; page++) {
+        memcpy(&txBuffer[1 + len], &shadow[page * SSD1306_WIDTH + x0], width);
+        len += width;
+    }
+
+    i2c_master_transmit(devHandle, txBuffer, len + 1, 100);
+    lastUpdateBytes += len + 1;
+}
+
+
+void SSD1306::markDirty(int16_t x0, int16_t x1, uint8_t page0, uint8_t page1) {
+    for (uint8_t page = page0; page <= page1; page++) {
+        if (x0 < dirtyX0[page]) dirtyX0[page] = x0;
+        if (x1 > dirtyX1[page]) dirtyX1[page] = x1;
+    }
+}
+
+
+void SSD1306::invalidate() {
+    shadowValid = false;
+    markDirty(0, SSD1306_WIDTH - 1, 0, SSD1306_PAGES - 1);
+}
+
+
+bool SSD1306::isDirty() const {
+    if (!shadowValid) return true;
+
+    for (uint8_t page = 0; page < SSD1306_PAGES; page++) {
+        const uint8_t* row = &buffer[page * SSD1306_WIDTH];
+        const uint8_t* old = &shadow[page * SSD1306_WIDTH];
+        for (int16_t x = dirtyX0[page]; x <= dirtyX1[page]; x++) {
+            if (row[x] != old[x]) return true;
+        }
+    }
+    return false;
 }
 
 
 void SSD1306::update() {
-    sendCommand(SSD1306_CMD_SET_COLUMN_ADDR);
-    sendCommand(0);
-    sendCommand(SSD1306_WIDTH - 1);
-    sendCommand(SSD1306_CMD_SET_PAGE_ADDR);
-    sendCommand(0);
-    sendCommand(SSD1306_PAGES - 1);
-    sendData(buffer, SSD1306_BUFFER_SIZE);
+    if (!initialized) return;
+    waitFlush();
+
+    planWindows();
+    sendWindows();
+}
+
+
+/*
+ * Async flush: planWindows() runs in the caller and copies the changed
+ * bytes into the front buffer; only the I2C transfer moves to the task.
+ *
+ *     UI task     draw N ─ updateAsync ─ draw N+1 ─ waitFlush ─ updateAsync ─ ...
+ *                                 │                     ▲
+ *     flush task                  └── windows of N ─────┘ EVENT_IDLE, callback
+ *
+ * The back buffer is never read by the task, so drawing needs no lock.
+ * The front buffer only changes in planWindows(), which waits for (or
+ * refuses) a running flush.
+ */
+bool SSD1306::updateAsync() {
+    if (!initialized || !flushEvents || flushing) return false;
+
+    if (!flushTaskHandle) {
+        BaseType_t ret = xTaskCreate(
+            flushTask, "ssd1306_flush", SSD1306_FLUSH_TASK_STACK,
+            this, SSD1306_FLUSH_TASK_PRIORITY, &flushTaskHandle
+        );
+        if (ret != pdPASS) {
+            ESP_LOGE(TAG, "Failed to create flush task");
+            flushTaskHandle = nullptr;
+            return false;
+        }
+    }
+
+    planWindows();
+
+    xEventGroupClearBits(flushEvents, SSD1306_EVENT_IDLE);
+    flushing = true;
+    xTaskNotifyGive(flushTaskHandle);
+    return true;
+}
+
+
+bool SSD1306::waitFlush(TickType_t timeout) {
+    if (!flushing) return true;
+
+    xEventGroupWaitBits(flushEvents, SSD1306_EVENT_IDLE, pdFALSE, pdTRUE, timeout);
+    return !flushing;
+}
+
+
+void SSD1306::setFlushCallback(SSD1306FlushCallback callback, void* arg) {
+    flushCallbackArg = arg;
+    flushCallback = callback;
+}
+
+
+void SSD1306::flushTask(void* arg) {
+    SSD1306* oled = static_cast<SSD1306*>(arg);
+
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        if (oled->stopping) {
+            // Acknowledge and wait to be deleted; oled is not touched again
+            xEventGroupSetBits(oled->flushEvents, SSD1306_EVENT_STOPPED);
+            vTaskSuspend(nullptr);
+            continue;
+        }
+
+        oled->sendWindows();
+        oled->flushing = false;
+        xEventGroupSetBits(oled->flushEvents, SSD1306_EVENT_IDLE);
+
+        if (oled->flushCallback) oled->flushCallback(oled->flushCallbackArg);
+    }
+}
+
+
+void SSD1306::planWindows() {
+    // Trim each dirty range to the columns that really differ from what
+    // the panel shows (clear() + redraw of the same content sends nothing),
+    // and copy those columns into the front buffer.
+    int16_t x0[SSD1306_PAGES];
+    int16_t x1[SSD1306_PAGES];
+
+    for (uint8_t page = 0; page < SSD1306_PAGES; page++) {
+        const uint8_t* row = &buffer[page * SSD1306_WIDTH];
+        uint8_t* old = &shadow[page * SSD1306_WIDTH];
+        int16_t a = dirtyX0[page];
+        int16_t b = dirtyX1[page];
+
+        if (shadowValid) {
+            while (a <= b && row[a] == old[a]) a++;
+            while (b >= a && row[b] == old[b]) b--;
+        }
+        if (a <= b) memcpy(&old[a], &row[a], b - a + 1);
+        x0[page] = a;
+        x1[page] = b;
+
+        dirtyX0[page] = SSD1306_WIDTH;
+        dirtyX1[page] = -1;
+    }
+    shadowValid = true;
+
+    // Merge neighbouring pages into one window while that costs fewer
+    // bytes than an extra window.
+    windowCount = 0;
+    uint8_t page = 0;
+    while (page < SSD1306_PAGES) {
+        if (x0[page] > x1[page]) { page++; continue; }
+
+        uint8_t first = page;
+        int16_t c0 = x0[page];
+        int16_t c1 = x1[page];
+
+        for (page++; page < SSD1306_PAGES && x0[page] <= x1[page]; page++) {
+            int16_t m0 = x0[page] < c0 ? x0[page] : c0;
+            int16_t m1 = x1[page] > c1 ? x1[page] : c1;
+            int32_t merged = (page - first + 1) * (m1 - m0 + 1);
+            int32_t apart = (page - first) * (c1 - c0 + 1) +
+                            (x1[page] - x0[page] + 1) + SSD1306_WINDOW_OVERHEAD;
+            if (merged > apart) break;
+            c0 = m0;
+            c1 = m1;
+        }
+
+        windows[windowCount++] = { (uint8_t)c0, (uint8_t)c1, first, (uint8_t)(page - 1) };
+    }
+}
+
+
+void SSD1306::sendWindows() {
+    lastUpdateBytes = 0;
+    for (uint8_t i = 0; i < windowCount; i++) {
+        sendWindow(windows[i].x0, windows[i].x1, windows[i].page0, windows[i].page1);
+    }
 }
 
 
 void SSD1306::clear() {
     memset(buffer, 0x00, SSD1306_BUFFER_SIZE);
+    markDirty(0, SSD1306_WIDTH - 1, 0, SSD1306_PAGES - 1);
 }
 
 
 void SSD1306::fill() {
     memset(buffer, 0xFF, SSD1306_BUFFER_SIZE);
+    markDirty(0, SSD1306_WIDTH - 1, 0, SSD1306_PAGES - 1);
 }
 
 
 void SSD1306::drawPixel(int16_t x, int16_t y, bool on) {
     if (x < 0 || x >= SSD1306_WIDTH || y < 0 || y >= SSD1306_HEIGHT) return;
     
-    uint16_t idx = (y / 8) * SSD1306_WIDTH + x;
+    uint8_t page = y / 8;
+    uint16_t idx = page * SSD1306_WIDTH + x;
     uint8_t bit = 1 << (y % 8);
     
     if (on) buffer[idx] |= bit;
     else buffer[idx] &= ~bit;
+
+    if (x < dirtyX0[page]) dirtyX0[page] = x;
+    if (x > dirtyX1[page]) dirtyX1[page] = x;
 }
 
 
@@ -1,12 +1,34 @@
 /**
  * @file ssd1306.h
  * @brief SSD1306 OLED display driver (ESP-IDF, new I2C API only).
+ *
+ * @details
+ * Drawing only touches the RAM buffer. Each primitive widens a dirty
+ * column range for the pages it writes; update() compares those ranges
+ * against a copy of what the panel already shows and sends just the
+ * changed segments:
+ *
+ *     page 0  ........####....    → column/page window 32..47, page 0
+ *     page 1  ................    → nothing sent
+ *     ...
+ *
+ * Neighbouring pages with overlapping ranges go out as one window.
+ * Data is staged in a preallocated buffer with the 0x40 control byte
+ * already in front, so update() never allocates.
+ *
+ * updateAsync() hands the transfer to a flush task instead: the changed
+ * bytes are copied into the front buffer (the panel copy) and the caller
+ * goes back to drawing the next frame into the back buffer while the
+ * previous one is on the wire.
  */
 
 #pragma once
 
 #include <driver/i2c_master.h>
 #include <driver/gpio.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/event_groups.h>
 #include <cstring>
 
 // Display dimensions
@@ -19,19 +41,111 @@
 #define SSD1306_ADDR_DEFAULT    0x3C
 #define SSD1306_ADDR_ALT        0x3D
 
+// Default SCL clock; most modules also run at 1 MHz (Fast-mode Plus)
+#define SSD1306_SCL_SPEED_DEFAULT   400000
+
+// A window costs ~10 extra bytes on the bus (address bytes, 7 command
+// bytes, control byte). Pages are merged into one window while that
+// wastes fewer bytes than a separate window would add.
+#define SSD1306_WINDOW_OVERHEAD 10
+
+// Async flush
+#define SSD1306_EVENT_IDLE          BIT0    // Set while no flush is running
+#define SSD1306_EVENT_STOPPED       BIT1    // Set by the flush task when it stops
+#define SSD1306_FLUSH_TASK_STACK    3072
+#define SSD1306_FLUSH_TASK_PRIORITY 5
+
+/**
+ * @brief Called when an async flush has been sent.
+ *
+ * @details Runs in the flush task. Keep it short: it delays the next
+ *          flush of this display.
+ */
+typedef void (*SSD1306FlushCallback)(void* arg);
+
 class SSD1306 {
 public:
     /**
      * @brief Construct using an existing I2C bus (from PCA9548A or direct).
      * @param busHandle I2C master bus handle
      * @param address I2C address (default 0x3C)
+     * @param sclSpeedHz SCL clock for this display (default 400 kHz)
      */
-    SSD1306(i2c_master_bus_handle_t busHandle, uint8_t address = SSD1306_ADDR_DEFAULT);
+    SSD1306(i2c_master_bus_handle_t busHandle, uint8_t address = SSD1306_ADDR_DEFAULT,
+            uint32_t sclSpeedHz = SSD1306_SCL_SPEED_DEFAULT);
     
     ~SSD1306();
 
     bool init();
+
+    /**
+     * @brief Send the changed parts of the buffer to the display.
+     */
     void update();
+
+    /**
+     * @brief Start sending the changed parts of the buffer in the background.
+     *
+     * @details
+     * The changes are taken over before this returns, so drawing the next
+     * frame right away is safe. The first call starts the flush task.
+     *
+     * @return false if a flush is still running or the task failed to start.
+     *
+     * @par Example:
+     * @code
+     *     while (true) {
+     *         drawFrame(display);          // Previous frame still on the wire
+     *         display.waitFlush();
+     *         display.updateAsync();
+     *     }
+     * @endcode
+     */
+    bool updateAsync();
+
+    /**
+     * @brief Check if an async flush is still running.
+     */
+    bool isBusy() const { return flushing; }
+
+    /**
+     * @brief Block until the running flush (if any) is sent.
+     * @return true if no flush is running anymore.
+     */
+    bool waitFlush(TickType_t timeout = portMAX_DELAY);
+
+    /**
+     * @brief Set a function called after each async flush (nullptr = none).
+     */
+    void setFlushCallback(SSD1306FlushCallback callback, void* arg = nullptr);
+
+    /**
+     * @brief Event group with SSD1306_EVENT_IDLE (set while idle) and
+     *        SSD1306_EVENT_STOPPED (used by the destructor).
+     */
+    EventGroupHandle_t getEventGroup() const { return flushEvents; }
+
+    /**
+     * @brief Resend the whole buffer on the next update().
+     * @details Use after the panel lost its RAM (power cycle, reset).
+     */
+    void invalidate();
+
+    /**
+     * @brief Check if update() would send anything.
+     * @details Compares the dirty ranges with the panel copy; no bus traffic.
+     */
+    bool isDirty() const;
+
+    /**
+     * @brief Bytes written to the bus by the last update().
+     * @details Counts the payload of each I2C transaction: the leading
+     *          control byte (0x00 commands / 0x40 data), the window
+     *          commands and the pixel data. The address byte the master
+     *          sends before each transaction is not included (add one
+     *          per transaction: two per window sent).
+     */
+    size_t getLastUpdateBytes() const { return lastUpdateBytes; }
     
     // Buffer operations
     void clear();
@@ -58,13 +172,41 @@ public:
     
 private:
     void sendCommand(uint8_t cmd);
-    void sendData(const uint8_t* data, size_t len);
+    void sendCommands(const uint8_t* cmds, size_t len);
+    void sendWindow(int16_t x0, int16_t x1, uint8_t page0, uint8_t page1);
+    void markDirty(int16_t x0, int16_t x1, uint8_t page0, uint8_t page1);
+    void planWindows();
+    void sendWindows();
+
+    static void flushTask(void* arg);
     
     uint8_t address;
+    uint32_t sclSpeedHz;
     bool initialized;
     
     i2c_master_bus_handle_t busHandle;
     i2c_master_dev_handle_t devHandle;
     
-    uint8_t buffer[SSD1306_BUFFER_SIZE];
+    uint8_t buffer[SSD1306_BUFFER_SIZE];        // Back buffer (drawing)
+    uint8_t shadow[SSD1306_BUFFER_SIZE];        // Front buffer (panel copy)
+    uint8_t txBuffer[1 + SSD1306_BUFFER_SIZE];  // 0x40 + window data
+    bool shadowValid;                           // false = resend everything
+
+    // Dirty columns per page (x0 > x1 = clean)
+    int16_t dirtyX0[SSD1306_PAGES];
+    int16_t dirtyX1[SSD1306_PAGES];
+
+    // Windows of the frame in the front buffer, sent by sendWindows()
+    struct Window { uint8_t x0, x1, page0, page1; };
+    Window windows[SSD1306_PAGES];
+    uint8_t windowCount;
+
+    size_t lastUpdateBytes;
+
+    volatile bool flushing;             // Flush task sending windows
+    volatile bool stopping;             // Destructor asks the flush task to stop
+    TaskHandle_t flushTaskHandle;
+    EventGroupHandle_t flushEvents;     // SSD1306_EVENT_IDLE, SSD1306_EVENT_STOPPED
+    SSD1306FlushCallback flushCallback;
+    void* flushCallbackArg;
 };
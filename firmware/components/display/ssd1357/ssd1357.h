@@ -99,6 +99,7 @@
 #include <driver/gpio.h>
 #include <stdint.h>
 #include <string.h>
+#include "../shared/rgb565_display.h"
 
 
 /**
@@ -123,6 +124,27 @@
 #define COLOR_GRAY      0x8410
 
 
+/**
+ * @brief SSD1357 panel traits for the shared RGB565 core.
+ */
+struct SSD1357Panel {
+    static constexpr const char* NAME = "SSD1357";
+    static constexpr uint16_t WIDTH = SSD1357_WIDTH;
+    static constexpr uint16_t HEIGHT = SSD1357_HEIGHT;
+    static constexpr int SPI_CLOCK_HZ = 10 * 1000 * 1000;  // 10 MHz
+    static constexpr uint8_t CMD_COLUMN = 0x15;             // Set column address
+    static constexpr uint8_t CMD_ROW = 0x75;                // Set row address
+    static constexpr uint8_t CMD_WRITE = 0x5C;              // Write RAM
+    static constexpr bool WINDOW_16BIT = false;             // 8-bit start/end
+    static constexpr bool HAS_ROTATION = false;
+    static constexpr uint8_t CMD_MADCTL = 0x00;
+    static constexpr uint8_t MADCTL[4] = {0, 0, 0, 0};
+    static constexpr uint16_t RESET_PULSE_MS = 100;
+    static constexpr uint16_t RESET_SETTLE_MS = 700;        // OLED supply needs a long settle
+    static const uint8_t INIT_TABLE[];                      // Defined in ssd1357.cpp
+};
+
+
 /**
  * @class SSD1357
  * @brief SSD1357 RGB OLED display driver over SPI.
@@ -134,8 +156,12 @@
  * - Drawing primitives (pixel, line, rectangle, circle)
  * - Text rendering with built-in font
  * - Color utilities
+ *
+ * Drawing, text and the DMA pixel queue come from Rgb565Display
+ * (shared/rgb565_display.h). Modules whose glass is shifted inside the
+ * controller RAM (many 64x64 SSD1357Z boards) need setOffset(30, 0).
  */
-class SSD1357 {
+class SSD1357 : public Rgb565Display<SSD1357Panel> {
 
 public:
 
@@ -154,12 +180,6 @@ public:
             spi_host_device_t spiHost = SPI2_HOST);
 
 
-    /**
-     * @brief Destroy the SSD1357 instance.
-     */
-    ~SSD1357();
-
-
     /**
      * @brief Initialize SPI and display.
      *
@@ -168,94 +188,6 @@ public:
     bool init();
 
 
-    /**
-     * @brief Fill entire screen with a color.
-     *
-     * @param color RGB565 color value.
-     */
-    void fillScreen(uint16_t color);
-
-
-    /**
-     * @brief Draw a single pixel.
-     *
-     * @param x X coordinate.
-     * @param y Y coordinate.
-     * @param color RGB565 color value.
-     */
-    void drawPixel(int16_t x, int16_t y, uint16_t color);
-
-
-    /**
-     * @brief Draw a horizontal line.
-     */
-    void drawHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
-
-
-    /**
-     * @brief Draw a vertical line.
-     */
-    void drawVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
-
-
-    /**
-     * @brief Draw a line between two points.
-     */
-    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
-
-
-    /**
-     * @brief Draw a rectangle outline.
-     */
-    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
-
-
-    /**
-     * @brief Draw a filled rectangle.
-     */
-    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
-
-
-    /**
-     * @brief Draw a circle outline.
-     */
-    void drawCircle(int16_t cx, int16_t cy, int16_t radius, uint16_t color);
-
-
-    /**
-     * @brief Draw a filled circle.
-     */
-    void fillCircle(int16_t cx, int16_t cy, int16_t radius, uint16_t color);
-
-
-    /**
-     * @brief Draw a single character.
-     *
-     * @param x Top-left X position.
-     * @param y Top-left Y position.
-     * @param c Character to draw.
-     * @param color Text color (RGB565).
-     * @param bg Background color (RGB565).
-     * @param size Font scale (1 = 5x7, 2 = 10x14, etc.)
-     *
-     * @return Width of character drawn.
-     */
-    uint8_t drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size = 1);
-
-
-    /**
-     * @brief Draw a string.
-     *
-     * @param x Starting X position.
-     * @param y Starting Y position.
-     * @param str Null-terminated string.
-     * @param color Text color (RGB565).
-     * @param bg Background color (RGB565).
-     * @param size Font scale.
-     */
-    void drawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg = COLOR_BLACK, uint8_t size = 1);
-
-
     /**
      * @brief Set display brightness.
      *
@@ -316,74 +248,11 @@ public:
     bool isPartialMode() const;
 
 
-    /**
-     * @brief Convert 24-bit RGB to RGB565.
-     *
-     * @param r Red (0-255).
-     * @param g Green (0-255).
-     * @param b Blue (0-255).
-     * @return RGB565 color value.
-     */
-    static uint16_t color565(uint8_t r, uint8_t g, uint8_t b);
-
-
-    /**
-     * @brief Get display width.
-     */
-    uint16_t getWidth() const { return SSD1357_WIDTH; }
-
-
-    /**
-     * @brief Get display height.
-     */
-    uint16_t getHeight() const { return SSD1357_HEIGHT; }
-
-
 private:
 
     gpio_num_t mosiPin;
     gpio_num_t sckPin;
     gpio_num_t csPin;
-    gpio_num_t dcPin;
-    gpio_num_t rstPin;
-    spi_host_device_t spiHost;
-    spi_device_handle_t spiDevice;
-    bool initialized;
-    bool partialMode;
 
-
-    /**
-     * @brief Send a command byte.
-     */
-    void sendCommand(uint8_t cmd);
-
-
-    /**
-     * @brief Send a data byte.
-     */
-    void sendData(uint8_t data);
-
-
-    /**
-     * @brief Send multiple data bytes.
-     */
-    void sendData(const uint8_t* data, size_t len);
-
-
-    /**
-     * @brief Send 16-bit data (for colors).
-     */
-    void sendData16(uint16_t data);
-
-
-    /**
-     * @brief Set the drawing window.
-     */
-    void setWindow(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
-
-
-    /**
-     * @brief Hardware reset the display.
-     */
-    void hardwareReset();
+    bool partialMode;
 };
@@ -109,6 +109,7 @@
 #include <driver/gpio.h>
 #include <stdint.h>
 #include <string.h>
+#include "../shared/rgb565_display.h"
 
 
 /**
@@ -126,6 +127,31 @@
 #define COLOR_GRAY      0x8410
 
 
+/**
+ * @brief ST7789 panel traits for the shared RGB565 core.
+ *
+ * @details
+ * WIDTH/HEIGHT are the controller RAM (240x320). The glass size is given
+ * to the ST7789 constructor at runtime.
+ */
+struct ST7789Panel {
+    static constexpr const char* NAME = "ST7789";
+    static constexpr uint16_t WIDTH = 240;
+    static constexpr uint16_t HEIGHT = 320;
+    static constexpr int SPI_CLOCK_HZ = 20 * 1000 * 1000;  // 20 MHz (safe for all boards)
+    static constexpr uint8_t CMD_COLUMN = 0x2A;             // CASET
+    static constexpr uint8_t CMD_ROW = 0x2B;                // RASET
+    static constexpr uint8_t CMD_WRITE = 0x2C;              // RAMWR
+    static constexpr bool WINDOW_16BIT = true;
+    static constexpr bool HAS_ROTATION = true;
+    static constexpr uint8_t CMD_MADCTL = 0x36;
+    static constexpr uint8_t MADCTL[4] = {0x00, 0x60, 0xC0, 0xA0};
+    static constexpr uint16_t RESET_PULSE_MS = 10;
+    static constexpr uint16_t RESET_SETTLE_MS = 120;
+    static const uint8_t INIT_TABLE[];                      // Defined in st7789.cpp
+};
+
+
 /**
  * @class ST7789
  * @brief ST7789 TFT display driver over SPI.
@@ -138,8 +164,11 @@
  * - Text rendering with built-in font
  * - Color utilities
  * - Configurable resolution and memory offset
+ *
+ * Drawing, text, rotation, offsets and the DMA pixel queue come from
+ * Rgb565Display (shared/rgb565_display.h).
  */
-class ST7789 {
+class ST7789 : public Rgb565Display<ST7789Panel> {
 
 public:
 
@@ -162,12 +191,6 @@ public:
            spi_host_device_t spiHost = SPI2_HOST);
 
 
-    /**
-     * @brief Destroy the ST7789 instance.
-     */
-    ~ST7789();
-
-
     /**
      * @brief Initialize SPI and display.
      *
@@ -177,156 +200,13 @@ public:
 
 
     /**
-     * @brief Set memory offset for displays that don't start at (0,0).
-     *
-     * @param xOffset X offset in pixels.
-     * @param yOffset Y offset in pixels.
-     */
-    void setOffset(int16_t xOffset, int16_t yOffset);
-
-
-    /**
-     * @brief Fill entire screen with a color.
-     *
-     * @param color RGB565 color value.
-     */
-    void fillScreen(uint16_t color);
-
-
-    /**
-     * @brief Draw a single pixel.
-     *
-     * @param x X coordinate.
-     * @param y Y coordinate.
-     * @param color RGB565 color value.
-     */
-    void drawPixel(int16_t x, int16_t y, uint16_t color);
-
-
-    /**
-     * @brief Draw a horizontal line.
-     *
-     * @param x Starting X position.
-     * @param y Y position.
-     * @param w Line width in pixels.
-     * @param color RGB565 color value.
-     */
-    void drawHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
-
-
-    /**
-     * @brief Draw a vertical line.
-     *
-     * @param x X position.
-     * @param y Starting Y position.
-     * @param h Line height in pixels.
-     * @param color RGB565 color value.
-     */
-    void drawVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
-
-
-    /**
-     * @brief Draw a line between two points.
-     *
-     * @param x0 Start X.
-     * @param y0 Start Y.
-     * @param x1 End X.
-     * @param y1 End Y.
-     * @param color RGB565 color value.
-     */
-    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
-
-
-    /**
-     * @brief Draw a rectangle outline.
-     *
-     * @param x Top-left X.
-     * @param y Top-left Y.
-     * @param w Rectangle width.
-     * @param h Rectangle height.
-     * @param color RGB565 color value.
-     */
-    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
-
-
-    /**
-     * @brief Draw a filled rectangle.
-     *
-     * @param x Top-left X.
-     * @param y Top-left Y.
-     * @param w Rectangle width.
-     * @param h Rectangle height.
-     * @param color RGB565 color value.
-     */
-    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
-
-
-    /**
-     * @brief Draw a circle outline.
-     *
-     * @param cx Center X.
-     * @param cy Center Y.
-     * @param radius Circle radius.
-     * @param color RGB565 color value.
-     */
-    void drawCircle(int16_t cx, int16_t cy, int16_t radius, uint16_t color);
-
-
-    /**
-     * @brief Draw a filled circle.
-     *
-     * @param cx Center X.
-     * @param cy Center Y.
-     * @param radius Circle radius.
-     * @param color RGB565 color value.
-     */
-    void fillCircle(int16_t cx, int16_t cy, int16_t radius, uint16_t color);
-
-
-    /**
-     * @brief Draw a single character.
-     *
-     * @param x Top-left X position.
-     * @param y Top-left Y position.
-     * @param c Character to draw.
-     * @param color Text color (RGB565).
-     * @param bg Background color (RGB565).
-     * @param size Font scale (1 = 5x7, 2 = 10x14, etc.)
-     *
-     * @return Width of character drawn.
-     */
-    uint8_t drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size = 1);
-
-
-    /**
-     * @brief Draw a string.
-     *
-     * @param x Starting X position.
-     * @param y Starting Y position.
-     * @param str Null-terminated string.
-     * @param color Text color (RGB565).
-     * @param bg Background color (RGB565), use same as color for transparent.
-     * @param size Font scale (1 = 5x7, 2 = 10x14, etc.)
-     */
-    void drawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg = COLOR_BLACK, uint8_t size = 1);
-
-
-    /**
-     * @brief Set backlight brightness.
+     * @brief Set backlight on/off.
      *
      * @param on true = backlight on, false = off.
      */
     void setBacklight(bool on);
 
 
-    /**
-     * @brief Set display rotation.
-     *
-     * @param rotation 0, 1, 2, or 3 (0° / 90° / 180° / 270°).
-     */
-    void setRotation(uint8_t rotation);
-
-
     /**
      * @brief Invert display colors.
      *
@@ -422,94 +302,16 @@ public:
     uint16_t getScrollHeight() const;
 
 
-    /**
-     * @brief Convert 24-bit RGB to RGB565.
-     *
-     * @param r Red (0-255).
-     * @param g Green (0-255).
-     * @param b Blue (0-255).
-     * @return RGB565 color value.
-     */
-    static uint16_t color565(uint8_t r, uint8_t g, uint8_t b);
-
-
-    /**
-     * @brief Get display width.
-     */
-    uint16_t getWidth() const { return dispWidth; }
-
-
-    /**
-     * @brief Get display height.
-     */
-    uint16_t getHeight() const { return dispHeight; }
-
-
 private:
 
-    uint16_t dispWidth;
-    uint16_t dispHeight;
-    int16_t xOffset;
-    int16_t yOffset;
-
     gpio_num_t mosiPin;
     gpio_num_t sckPin;
     gpio_num_t csPin;
-    gpio_num_t dcPin;
-    gpio_num_t rstPin;
     gpio_num_t blkPin;
-    spi_host_device_t spiHost;
-    spi_device_handle_t spiDevice;
-    bool initialized;
-
-    uint8_t rotation;
-    uint16_t width;     // Current width (may change with rotation)
-    uint16_t height;    // Current height (may change with rotation)
 
     bool partialMode;               // Track if partial mode is active
     bool scrollEnabled;             // Track if scrolling is set up
     uint16_t scrollTopFixed;        // Top fixed area height
     uint16_t scrollBottomFixed;     // Bottom fixed area height
     uint16_t scrollHeight;          // Scrollable area height
-
-
-    /**
-     * @brief Send a command byte.
-     */
-    void sendCommand(uint8_t cmd);
-
-
-    /**
-     * @brief Send a data byte.
-     */
-    void sendData(uint8_t data);
-
-
-    /**
-     * @brief Send multiple data bytes.
-     */
-    void sendData(const uint8_t* data, size_t len);
-
-
-    /**
-     * @brief Send 16-bit data (for colors).
-     */
-    void sendData16(uint16_t data);
-
-
-    /**
-     * @brief Set the drawing window.
-     *
-     * @param x0 Start X.
-     * @param y0 Start Y.
-     * @param x1 End X.
-     * @param y1 End Y.
-     */
-    void setWindow(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
-
-
-    /**
-     * @brief Hardware reset the display.
-     */
-    void hardwareReset();
 };
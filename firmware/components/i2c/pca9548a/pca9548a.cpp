@@ -150,6 +150,10 @@ bool PCA9548A::selectChannel(uint8_t channel) {
 bool PCA9548A::enableChannels(uint8_t channelMask) {
     if (!initialized) return false;
 
+    // Already routed there: skip the bus write. Every selection goes
+    // through this object, so currentChannels matches the register.
+    if (channelMask == currentChannels) return true;
+
     if (writeRegister(channelMask)) {
         currentChannels = channelMask;
         ESP_LOGD(TAG, "Enabled channels: 0x%02X", channelMask);
@@ -115,6 +115,9 @@
  *     display1.init();
  *     display1.drawString(0, 0, "Display 1");
  *     display1.update();
+ *     
+ *     For several displays, OledMux (display/oled_mux) does the channel
+ *     switching and only flushes panels that changed.
  * 
  * =============================================================================
  */
@@ -199,6 +202,9 @@ public:
      *
      * @note Multiple channels can be enabled simultaneously.
      *       Example: enableChannels(0b00000101) enables CH0 and CH2.
+     *
+     * @note Nothing is written if the mask is already selected, so
+     *       selecting before every transfer costs no bus time.
      */
     bool enableChannels(uint8_t channelMask);
 
@@ -228,6 +234,12 @@ public:
     bool isChannelEnabled(uint8_t channel);
 
 
+    /**
+     * @brief Get the channels selected by this driver (no bus access).
+     */
+    uint8_t getSelectedChannels() const { return currentChannels; }
+
+
     /**
      * @brief Hardware reset the multiplexer.
      *
@@ -0,0 +1,101 @@
+// Generated by font_convert.py, do not edit
+// font_convert.py Lato-Regular.ttf --size 24 --chars 0123456789% --tight --header percent_font.h --name percent_font
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+static const uint8_t percent_font[] = {
+    0x50, 0x46, 0x4E, 0x54, 0x01, 0x04, 0x25, 0x39, 0x11, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x12, 0x11, 0x13, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x99, 0x00, 0x00, 0x00, 0x0E, 0x11,
+    0x0E, 0x00, 0x00, 0x00, 0x10, 0x01, 0x00, 0x00, 0x0B, 0x11, 0x0E, 0x02, 0x00, 0x00, 0x76, 0x01,
+    0x00, 0x00, 0x0C, 0x11, 0x0E, 0x01, 0x00, 0x00, 0xDC, 0x01, 0x00, 0x00, 0x0C, 0x11, 0x0E, 0x01,
+    0x00, 0x00, 0x42, 0x02, 0x00, 0x00, 0x0E, 0x11, 0x0E, 0x00, 0x00, 0x00, 0xB9, 0x02, 0x00, 0x00,
+    0x0C, 0x11, 0x0E, 0x01, 0x00, 0x00, 0x1F, 0x03, 0x00, 0x00, 0x0C, 0x11, 0x0E, 0x01, 0x00, 0x00,
+    0x85, 0x03, 0x00, 0x00, 0x0D, 0x11, 0x0E, 0x01, 0x00, 0x00, 0xFC, 0x03, 0x00, 0x00, 0x0C, 0x11,
+    0x0E, 0x01, 0x00, 0x00, 0x62, 0x04, 0x00, 0x00, 0x0C, 0x11, 0x0E, 0x01, 0x00, 0x00, 0x00, 0x4C,
+    0xFD, 0x70, 0x00, 0x00, 0x00, 0x8F, 0x70, 0x04, 0xFF, 0xFF, 0xF9, 0x00, 0x00, 0x05, 0xFA, 0x00,
+    0x0C, 0xF6, 0x13, 0xDF, 0x20, 0x00, 0x2E, 0xD1, 0x00, 0x1F, 0xB0, 0x00, 0x6F, 0x60, 0x00, 0xCF,
+    0x30, 0x00, 0x2F, 0x90, 0x00, 0x3F, 0x70, 0x09, 0xF6, 0x00, 0x00, 0x1F, 0xB0, 0x00, 0x5F, 0x60,
+    0x5F, 0xA0, 0x00, 0x00, 0x0C, 0xF5, 0x13, 0xDF, 0x22, 0xED, 0x10, 0x00, 0x00, 0x04, 0xFF, 0xFF,
+    0xF8, 0x0C, 0xF3, 0x00, 0x00, 0x00, 0x00, 0x4C, 0xFD, 0x60, 0x9F, 0x60, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x05, 0xFA, 0x01, 0x9E, 0xFB, 0x30, 0x00, 0x00, 0x00, 0x2E, 0xD1, 0x0C, 0xFF, 0xFF,
+    0xF3, 0x00, 0x00, 0x01, 0xCF, 0x30, 0x6F, 0xA2, 0x16, 0xFB, 0x00, 0x00, 0x09, 0xF6, 0x00, 0x9F,
+    0x20, 0x00, 0xCE, 0x00, 0x00, 0x6F, 0xA0, 0x00, 0x9F, 0x20, 0x00, 0xBE, 0x00, 0x03, 0xED, 0x10,
+    0x00, 0x6F, 0xA1, 0x16, 0xFB, 0x00, 0x1D, 0xE3, 0x00, 0x00, 0x0C, 0xFF, 0xFF, 0xF3, 0x00, 0xAF,
+    0x50, 0x00, 0x00, 0x01, 0x9E, 0xFB, 0x30, 0x00, 0x00, 0x7C, 0xEE, 0xC6, 0x00, 0x00, 0x00, 0x1C,
+    0xFF, 0xFF, 0xFF, 0xB1, 0x00, 0x00, 0xBF, 0xD5, 0x11, 0x6E, 0xFA, 0x00, 0x05, 0xFF, 0x20, 0x00,
+    0x04, 0xFF, 0x30, 0x0B, 0xF9, 0x00, 0x00, 0x00, 0xAF, 0x90, 0x0E, 0xF4, 0x00, 0x00, 0x00, 0x5F,
+    0xD0, 0x2F, 0xF1, 0x00, 0x00, 0x00, 0x2F, 0xF1, 0x3F, 0xF0, 0x00, 0x00, 0x00, 0x1F, 0xF2, 0x4F,
+    0xE0, 0x00, 0x00, 0x00, 0x0F, 0xF3, 0x3F, 0xF0, 0x00, 0x00, 0x00, 0x1F, 0xF2, 0x2F, 0xF1, 0x00,
+    0x00, 0x00, 0x2F, 0xF1, 0x0E, 0xF4, 0x00, 0x00, 0x00, 0x5F, 0xD0, 0x0B, 0xF9, 0x00, 0x00, 0x00,
+    0xAF, 0x90, 0x05, 0xFF, 0x20, 0x00, 0x04, 0xFF, 0x40, 0x00, 0xBF, 0xD5, 0x11, 0x6E, 0xFA, 0x00,
+    0x00, 0x1C, 0xFF, 0xFF, 0xFF, 0xB1, 0x00, 0x00, 0x00, 0x7C, 0xEE, 0xC6, 0x00, 0x00, 0x00, 0x00,
+    0x3D, 0xF4, 0x00, 0x00, 0x00, 0x05, 0xEF, 0xF4, 0x00, 0x00, 0x00, 0x7F, 0xFF, 0xF4, 0x00, 0x00,
+    0x09, 0xFE, 0x4D, 0xF4, 0x00, 0x00, 0x5F, 0xD2, 0x0D, 0xF4, 0x00, 0x00, 0x05, 0x10, 0x0D, 0xF4,
+    0x00, 0x00, 0x00, 0x00, 0x0D, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x0D, 0xF4, 0x00, 0x00, 0x00, 0x00,
+    0x0D, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x0D, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x0D, 0xF4, 0x00, 0x00,
+    0x00, 0x00, 0x0D, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x0D, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x0D, 0xF4,
+    0x00, 0x00, 0x00, 0x00, 0x0D, 0xF4, 0x00, 0x00, 0x08, 0xFF, 0xFF, 0xFF, 0xFF, 0xA0, 0x08, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xA0, 0x00, 0x06, 0xBE, 0xFD, 0x81, 0x00, 0x01, 0xBF, 0xFF, 0xFF, 0xFE, 0x30,
+    0x09, 0xFE, 0x61, 0x15, 0xDF, 0xC0, 0x1F, 0xF3, 0x00, 0x00, 0x3F, 0xF3, 0x4F, 0xB0, 0x00, 0x00,
+    0x0D, 0xF5, 0x00, 0x00, 0x00, 0x00, 0x0E, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x2F, 0xE1, 0x00, 0x00,
+    0x00, 0x00, 0xAF, 0x80, 0x00, 0x00, 0x00, 0x06, 0xFC, 0x10, 0x00, 0x00, 0x00, 0x5F, 0xE2, 0x00,
+    0x00, 0x00, 0x05, 0xFE, 0x20, 0x00, 0x00, 0x00, 0x5F, 0xE3, 0x00, 0x00, 0x00, 0x06, 0xFE, 0x30,
+    0x00, 0x00, 0x00, 0x6F, 0xE3, 0x00, 0x00, 0x00, 0x06, 0xFE, 0x30, 0x00, 0x00, 0x00, 0x6F, 0xFD,
+    0xEF, 0xFF, 0xFF, 0xF9, 0xBF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFB, 0x00, 0x05, 0xBE, 0xFE, 0xA3, 0x00,
+    0x00, 0xAF, 0xFF, 0xFF, 0xFF, 0x60, 0x07, 0xFE, 0x72, 0x13, 0xAF, 0xF2, 0x0E, 0xF5, 0x00, 0x00,
+    0x0D, 0xF6, 0x19, 0x80, 0x00, 0x00, 0x0A, 0xF6, 0x00, 0x00, 0x00, 0x00, 0x0D, 0xF2, 0x00, 0x00,
+    0x00, 0x15, 0xCF, 0x80, 0x00, 0x00, 0x0B, 0xFF, 0xD5, 0x00, 0x00, 0x00, 0x0B, 0xFF, 0xFD, 0x30,
+    0x00, 0x00, 0x00, 0x14, 0xAF, 0xE2, 0x00, 0x00, 0x00, 0x00, 0x0A, 0xF9, 0x00, 0x00, 0x00, 0x00,
+    0x06, 0xFC, 0x6D, 0x60, 0x00, 0x00, 0x06, 0xFC, 0x5F, 0xE2, 0x00, 0x00, 0x0C, 0xF8, 0x0C, 0xFD,
+    0x51, 0x04, 0xCF, 0xE2, 0x02, 0xEF, 0xFF, 0xFF, 0xFE, 0x40, 0x00, 0x18, 0xCE, 0xFD, 0x92, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x8F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x04, 0xFF, 0xD0, 0x00, 0x00, 0x00,
+    0x00, 0x1E, 0xEF, 0xD0, 0x00, 0x00, 0x00, 0x00, 0xBF, 0x6F, 0xD0, 0x00, 0x00, 0x00, 0x07, 0xF9,
+    0x1F, 0xD0, 0x00, 0x00, 0x00, 0x3F, 0xD1, 0x1F, 0xD0, 0x00, 0x00, 0x01, 0xDF, 0x30, 0x1F, 0xD0,
+    0x00, 0x00, 0x0A, 0xF6, 0x00, 0x1F, 0xD0, 0x00, 0x00, 0x6F, 0xA0, 0x00, 0x1F, 0xD0, 0x00, 0x02,
+    0xED, 0x10, 0x00, 0x1F, 0xD0, 0x00, 0x1C, 0xF3, 0x00, 0x00, 0x1F, 0xD0, 0x00, 0x6F, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xF7, 0x4F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF6, 0x00, 0x00, 0x00, 0x00, 0x1F,
+    0xD0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xD0, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x1F, 0xD0, 0x00, 0x00, 0x7F, 0xFF, 0xFF, 0xFF, 0xB0, 0x00, 0xAF, 0xFF,
+    0xFF, 0xFF, 0x70, 0x00, 0xDF, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x03,
+    0xF9, 0x00, 0x00, 0x00, 0x00, 0x05, 0xF7, 0x00, 0x00, 0x00, 0x00, 0x08, 0xFC, 0xDF, 0xEC, 0x60,
+    0x00, 0x0A, 0xFF, 0xFF, 0xFF, 0xFC, 0x10, 0x03, 0x64, 0x11, 0x38, 0xFF, 0x90, 0x00, 0x00, 0x00,
+    0x00, 0x6F, 0xF1, 0x00, 0x00, 0x00, 0x00, 0x0F, 0xF3, 0x00, 0x00, 0x00, 0x00, 0x0E, 0xF3, 0x00,
+    0x00, 0x00, 0x00, 0x1F, 0xF1, 0x01, 0x00, 0x00, 0x00, 0xAF, 0xC0, 0x5F, 0xB4, 0x10, 0x3A, 0xFF,
+    0x30, 0x3D, 0xFF, 0xFF, 0xFF, 0xE5, 0x00, 0x01, 0x7C, 0xEF, 0xD9, 0x20, 0x00, 0x00, 0x00, 0x00,
+    0x4D, 0xF6, 0x00, 0x00, 0x00, 0x01, 0xEF, 0x80, 0x00, 0x00, 0x00, 0x0B, 0xFA, 0x00, 0x00, 0x00,
+    0x00, 0x8F, 0xC1, 0x00, 0x00, 0x00, 0x04, 0xFE, 0x20, 0x00, 0x00, 0x00, 0x2E, 0xF3, 0x00, 0x00,
+    0x00, 0x00, 0xCF, 0xAC, 0xFE, 0xB4, 0x00, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0x70, 0x1E, 0xFD, 0x51,
+    0x14, 0xCF, 0xF3, 0x6F, 0xE2, 0x00, 0x00, 0x1D, 0xF9, 0x9F, 0x80, 0x00, 0x00, 0x06, 0xFC, 0xAF,
+    0x60, 0x00, 0x00, 0x04, 0xFD, 0x9F, 0x80, 0x00, 0x00, 0x06, 0xFB, 0x5F, 0xE1, 0x00, 0x00, 0x1D,
+    0xF6, 0x0D, 0xFC, 0x41, 0x15, 0xDF, 0xD1, 0x02, 0xDF, 0xFF, 0xFF, 0xFD, 0x20, 0x00, 0x18, 0xCE,
+    0xEC, 0x71, 0x00, 0xAF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x9F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x2F, 0xE1, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x9F, 0x80, 0x00, 0x00, 0x00, 0x00, 0x02, 0xFE, 0x10, 0x00, 0x00, 0x00, 0x00,
+    0x0A, 0xF7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xE1, 0x00, 0x00, 0x00, 0x00, 0x00, 0xAF, 0x70,
+    0x00, 0x00, 0x00, 0x00, 0x03, 0xFE, 0x10, 0x00, 0x00, 0x00, 0x00, 0x0B, 0xF7, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x4F, 0xE1, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBF, 0x70, 0x00, 0x00, 0x00, 0x00, 0x04,
+    0xFE, 0x10, 0x00, 0x00, 0x00, 0x00, 0x0C, 0xF7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5F, 0xE1, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xCE, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xDF, 0xEC, 0x71, 0x00,
+    0x02, 0xEF, 0xFF, 0xFF, 0xFD, 0x20, 0x0C, 0xFC, 0x41, 0x15, 0xDF, 0xA0, 0x2F, 0xF2, 0x00, 0x00,
+    0x3F, 0xF1, 0x3F, 0xD0, 0x00, 0x00, 0x0F, 0xF1, 0x1F, 0xF2, 0x00, 0x00, 0x3F, 0xE0, 0x08, 0xFC,
+    0x41, 0x15, 0xDF, 0x60, 0x00, 0x6E, 0xFF, 0xFF, 0xD5, 0x00, 0x01, 0xAF, 0xFF, 0xFF, 0xE9, 0x10,
+    0x1D, 0xFB, 0x41, 0x14, 0xCF, 0xC0, 0x8F, 0xC0, 0x00, 0x00, 0x1D, 0xF6, 0xBF, 0x60, 0x00, 0x00,
+    0x08, 0xFA, 0xCF, 0x70, 0x00, 0x00, 0x08, 0xFB, 0xAF, 0xC0, 0x00, 0x00, 0x1D, 0xF8, 0x4F, 0xFB,
+    0x31, 0x14, 0xCF, 0xF2, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0x50, 0x00, 0x39, 0xDF, 0xFD, 0x92, 0x00,
+    0x00, 0x04, 0xAE, 0xFD, 0xA3, 0x00, 0x00, 0x8F, 0xFF, 0xFF, 0xFF, 0x60, 0x06, 0xFF, 0x82, 0x13,
+    0x9F, 0xF3, 0x0D, 0xF6, 0x00, 0x00, 0x09, 0xF9, 0x2F, 0xF0, 0x00, 0x00, 0x03, 0xFD, 0x3F, 0xF0,
+    0x00, 0x00, 0x03, 0xFE, 0x1F, 0xF5, 0x00, 0x00, 0x09, 0xFC, 0x0A, 0xFE, 0x62, 0x13, 0xAF, 0xF9,
+    0x02, 0xDF, 0xFF, 0xFF, 0xFF, 0xF3, 0x00, 0x19, 0xDF, 0xD9, 0xCF, 0xA0, 0x00, 0x00, 0x00, 0x07,
+    0xFE, 0x10, 0x00, 0x00, 0x00, 0x3F, 0xF4, 0x00, 0x00, 0x00, 0x01, 0xDF, 0x90, 0x00, 0x00, 0x00,
+    0x0B, 0xFD, 0x10, 0x00, 0x00, 0x00, 0x7F, 0xF3, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x70, 0x00, 0x00,
+    0x00, 0x1D, 0xFA, 0x00, 0x00, 0x00,
+};
+static const size_t percent_font_size = sizeof(percent_font);
@@ -37,6 +37,7 @@ static void hueToRgb(uint16_t hue, uint8_t& r, uint8_t& g, uint8_t& b) {
 
 SmartLightDevice::SmartLightDevice(gpio_num_t pin, uint16_t numLeds)
     : _strip(pin, numLeds, LedType::SK6812_RGBW),
+      _effects(_strip),
       _isOn(false),
       _brightness(50),
       _hue(0),
@@ -45,19 +46,26 @@ SmartLightDevice::SmartLightDevice(gpio_num_t pin, uint16_t numLeds)
 {
 }
 
-SmartLightDevice::~SmartLightDevice() {}
+SmartLightDevice::~SmartLightDevice() {
+    _effects.stop();
+}
 
 
 /* ─── Init ────────────────────────────────────────────────────────────────── */
 
 bool SmartLightDevice::init() {
     _strip.setBrightness(255);
+    _strip.setDithering(true);      // 16-bit pixels for low brightness levels
 
     if (!_strip.init()) {
         ESP_LOGE(TAG, "Failed to init LED strip");
         return false;
     }
 
+    // A static color is shown once per update(): dithering only runs
+    // while the effect engine sends frames (see setEffect())
+    _strip.setDithering(false);
+
     ESP_LOGI(TAG, "Initialized: %d SK6812 RGBW LEDs on GPIO %d",
              _strip.getNumLeds(), (int)_strip.getNumLeds());
 
@@ -94,21 +102,53 @@ void SmartLightDevice::recomputeRgb() {
 /* ─── Update — push state to strip ────────────────────────────────────────── */
 
 void SmartLightDevice::update() {
+    if (_effects.isRunning()) {
+        // The effect task owns the strip; only pass on the level
+        _effects.setLevel(_isOn ? (_brightness * 255) / 100 : 0);
+        return;
+    }
+
     if (!_isOn) {
         _strip.clear();
         _strip.show();
         return;
     }
 
-    // Scale RGB by brightness percentage
-    uint8_t scale = (_brightness * 255) / 100;
-    uint8_t sr = (_r * scale) / 255;
-    uint8_t sg = (_g * scale) / 255;
-    uint8_t sb = (_b * scale) / 255;
+    // Scale RGB by brightness percentage, in 8.8 fixed point so the low
+    // percentages are not rounded to a few 8-bit levels before gamma
+    uint16_t sr = ((uint32_t)_r * _brightness * 256) / 100;
+    uint16_t sg = ((uint32_t)_g * _brightness * 256) / 100;
+    uint16_t sb = ((uint32_t)_b * _brightness * 256) / 100;
 
     // White channel is independent
-    uint8_t w = (_whiteBright * 255) / 100;
+    uint16_t w = ((uint32_t)_whiteBright * 255 * 256) / 100;
 
-    _strip.fill(sr, sg, sb, w);
+    _strip.fill16(sr, sg, sb, w);
     _strip.show();
+}
+
+
+/* ─── Effects ─────────────────────────────────────────────────────────────── */
+
+void SmartLightDevice::setEffect(LedEffect* effect, uint16_t fadeMs) {
+    if (!effect) {
+        _effects.stop();
+        _strip.setDithering(false);
+        update();
+        return;
+    }
+
+    // A freshly started engine fades in from black. Its frames keep
+    // coming, so the strip can dither while it runs.
+    if (!_effects.isRunning()) {
+        _strip.setDithering(true);
+        if (!_effects.start()) {
+            ESP_LOGE(TAG, "Failed to start effect engine");
+            _strip.setDithering(false);
+            return;
+        }
+    }
+
+    _effects.setEffect(effect, fadeMs);
+    update();
 }
\ No newline at end of file
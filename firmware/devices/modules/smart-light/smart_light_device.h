@@ -17,6 +17,14 @@
  *   The white channel is controlled independently via setWhite().
  *   RGB and white can be mixed — e.g. warm amber tint + white fill.
  *
+ * Low brightness (known limitation):
+ *   The static color is sent once per update(), so the strip's temporal
+ *   dithering is paused for it and each channel is rounded to the nearest
+ *   8-bit level after gamma. At full saturation, 1-5% rounds to off and
+ *   6-9% give the same level; above ~20% the steps are no longer visible.
+ *   Only effects (setEffect()), which send frames continuously, get the
+ *   dithered in-between levels.
+ *
  * =============================================================================
  * USAGE
  * =============================================================================
@@ -30,6 +38,10 @@
  *     light.setWhite(50);         // 50% white channel
  *     light.update();             // push to strip
  *
+ *     static FireEffect fire;
+ *     light.setEffect(&fire);     // animate (brightness still applies)
+ *     light.setEffect(nullptr);   // back to the static color
+ *
  * =============================================================================
  */
 
@@ -38,6 +50,7 @@
 #include <stdint.h>
 #include <driver/gpio.h>
 #include "addressable_led.h"
+#include "led_effect_engine.h"
 
 
 class SmartLightDevice {
@@ -68,15 +81,31 @@ public:
      */
     void update();
 
+    /**
+     * @brief Run an animated effect instead of the static color.
+     *
+     * @param effect Effect to show, or nullptr to return to hue/white.
+     * @param fadeMs Crossfade when switching between effects.
+     *
+     * While an effect runs, brightness and on/off still apply through
+     * update(); hue and white are ignored (effects drive RGB only).
+     * The strip dithers only while an effect runs; the static color is
+     * rounded to the nearest level, so it does not change between updates
+     * (see "Low brightness" above).
+     */
+    void setEffect(LedEffect* effect, uint16_t fadeMs = 500);
+
     /* ─── Query ─────────────────────────────────────────────────────── */
 
     bool     isOn()        const { return _isOn; }
     uint8_t  brightness()  const { return _brightness; }
     uint16_t hue()         const { return _hue; }
     uint8_t  whiteBright() const { return _whiteBright; }
+    bool     effectActive() const { return _effects.isRunning(); }
 
 private:
     AddressableLED _strip;
+    LedEffectEngine _effects;
 
     bool     _isOn;
     uint8_t  _brightness;     // 0-100
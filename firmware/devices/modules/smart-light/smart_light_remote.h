@@ -15,21 +15,25 @@
  * Owns:
  *   - LED-style state (on/off, brightness, hue, white channel, control mode)
  *   - A reference to the GC9A01 it draws on
- *   - Incremental redraw bookkeeping (prev* fields)
+ *   - A widget screen (ui_screen.h): level gauge + labels. render() copies
+ *     the state into the widgets and they repaint only what changed,
+ *     composed in a 7.5 KB band buffer (each damaged pixel sent once).
  *
  * Does NOT own:
  *   - Input devices (touch / encoder). Caller drives state via setters.
  *   - Physical LEDs. (See smart_light_device — separate component.)
  *   - Networking. Sync to the device over LoRa/ESP-NOW happens elsewhere.
  *
- * The arc-drawing helpers and the angle LUT live in smart_light_remote.cpp.
- * Call SmartLightRemote::buildAngleLUT() ONCE at boot before any render().
+ * The level arc is drawn with the display's span-based fillArc(); its row
+ * table and the percentage font live in smart_light_remote.cpp, shared by
+ * all panels. The first SmartLightRemote sets them up (initSharedAssets()); calling that at
+ * boot instead keeps the work out of the first panel's construction.
  *
  * =============================================================================
  * USAGE
  * =============================================================================
  *
- *     SmartLightRemote::buildAngleLUT();   // once, before any render
+ *     SmartLightRemote::initSharedAssets(); // optional: arc table + font up front
  *
  *     GC9A01 tft(...);
  *     tft.init();
@@ -48,6 +52,7 @@
 
 #include <stdint.h>
 #include "gc9a01.h"
+#include "ui_widgets.h"
 
 
 /* ─── Control Mode ───────────────────────────────────────────────────────── */
@@ -85,13 +90,16 @@ public:
     void adjustWhite(int32_t delta);
 
     /** Force a full redraw on next render() (e.g. after blanking the screen). */
-    void invalidate() { _forceRedraw = true; }
+    void invalidate() { _screen.invalidate(); }
 
     /* ─── Render (call after any state change) ─────────────────────── */
 
-    /** Paint to the display. Uses incremental updates when possible. */
+    /** Paint to the display. Only the areas whose widgets changed are redrawn. */
     void render();
 
+    /** Timing of the rendered frames (see UiFrameStats). */
+    const UiFrameStats& frameStats() const { return _screen.getStats(); }
+
     /* ─── Query ────────────────────────────────────────────────────── */
 
     bool             isOn()        const { return _isOn; }
@@ -108,9 +116,11 @@ public:
 
     /* ─── One-time setup ───────────────────────────────────────────── */
 
-    /** Build the angle lookup table used by the arc renderer.
-     *  Must be called ONCE at program start, before any render(). */
-    static void buildAngleLUT();
+    /** Set up what all panels share: the ring span table used by the arc
+     *  renderer and the percentage font (plus its glyph cache).
+     *  The constructor calls it; later calls only retry what failed. Not
+     *  thread safe: create the first panel (or call this) from one task. */
+    static void initSharedAssets();
 
 private:
 
@@ -125,13 +135,13 @@ private:
     SmartLightMode _mode;
     uint8_t        _r, _g, _b;      // Cached RGB derived from hue
 
-    /* Previous state — for incremental redraw decisions */
-    bool           _prevOn;
-    uint8_t        _prevBrightness;
-    uint16_t       _prevHue;
-    uint8_t        _prevWhiteBright;
-    SmartLightMode _prevMode;
-    bool           _forceRedraw;
+    /* Widgets, bottom to top (declared after the screen: removed first) */
+    UiScreen<GC9A01>   _screen;
+    UiArcGauge<GC9A01> _gauge;      // Level ring
+    UiLabel<GC9A01>    _name;       // "LED N"
+    UiLabel<GC9A01>    _percent;    // Level readout
+    UiLabel<GC9A01>    _modeLabel;  // "RGB" / "COLOR" / "WHITE"
+    UiLabel<GC9A01>    _offLabel;   // "OFF"
 
     /* Helpers */
     void recomputeRgbFromHue();
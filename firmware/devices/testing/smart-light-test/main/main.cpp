@@ -131,14 +131,16 @@ static void syncToDevice(SmartLightRemote& panel, SmartLightDevice& device) {
 extern "C" void app_main(void) {
     ESP_LOGI(TAG, "Smart-light bench test starting (wired)...");
 
-    /* 1. Angle LUT for panel renderer. */
-    SmartLightRemote::buildAngleLUT();
+    /* 1. Arc table and font shared by the panels. */
+    SmartLightRemote::initSharedAssets();
 
     /* 2. Displays. */
     GC9A01 tft0(SPI_MOSI, SPI_SCK, GC1_CS, GC1_DC, GC1_RST, GC_BLK,      SPI2_HOST);
     GC9A01 tft1(SPI_MOSI, SPI_SCK, GC2_CS, GC2_DC, GC2_RST, GPIO_NUM_NC, SPI2_HOST);
     if (!tft0.init()) ESP_LOGE(TAG, "TFT 0 init failed");
     if (!tft1.init()) ESP_LOGE(TAG, "TFT 1 init failed");
+    tft0.setRoundMode(true);    // Round glass: don't send the invisible corners
+    tft1.setRoundMode(true);
 
     /* 3. Inputs. */
     TouchSensor   touch0(TOUCH1_PIN, true);
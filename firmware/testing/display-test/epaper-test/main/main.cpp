@@ -17,6 +17,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "epaper.h"
 
 
@@ -182,6 +183,62 @@ extern "C" void app_main(void) {
     ESP_LOGI(TAG, "Test 4 complete. Waiting 5 seconds...");
     vTaskDelay(pdMS_TO_TICKS(5000));
     
+    /*
+     * =========================================================================
+     * TEST 4b: Automatic refresh - counter redrawn, refresh() picks the mode
+     * =========================================================================
+     */
+    ESP_LOGI(TAG, "Test 4b: Automatic refresh");
+    
+    static const char* refreshNames[] = {"none", "partial", "full"};
+    
+    display.clear(EPAPER_WHITE);
+    display.drawString(10, 10, "Auto refresh", EPAPER_BLACK, 2);
+    
+    for (int count = 0; count <= 12; count++) {
+        char text[16];
+        snprintf(text, sizeof(text), "Count %2d", count);
+        display.fillRect(10, 100, 100, 16, EPAPER_WHITE);
+        display.drawString(10, 100, text, EPAPER_BLACK, 2);
+        
+        EPaperRefresh result = display.refresh();
+        ESP_LOGI(TAG, "%s -> %s (partials since full: %d)",
+                 text, refreshNames[result], display.getPartialCount());
+        vTaskDelay(pdMS_TO_TICKS(1000));
+    }
+    
+    // Nothing drawn: no SPI traffic, no flash
+    ESP_LOGI(TAG, "Unchanged -> %s", refreshNames[display.refresh()]);
+    vTaskDelay(pdMS_TO_TICKS(3000));
+    
+    /*
+     * =========================================================================
+     * TEST 4c: Asynchronous refresh - task keeps running during the waveform
+     * =========================================================================
+     */
+    ESP_LOGI(TAG, "Test 4c: Async refresh");
+    
+    display.clear(EPAPER_WHITE);
+    display.drawString(10, 10, "Async", EPAPER_BLACK, 2);
+    display.drawString(10, 40, "Task not blocked", EPAPER_BLACK, 1);
+    
+    if (display.updateAsync()) {
+        int64_t start = esp_timer_get_time();
+        int loops = 0;
+        
+        // Stand-in for encoder/radio work
+        while (display.isBusy()) {
+            loops++;
+            vTaskDelay(pdMS_TO_TICKS(10));
+        }
+        
+        ESP_LOGI(TAG, "Full refresh took %lld ms, task ran %d loops meanwhile",
+                 (esp_timer_get_time() - start) / 1000, loops);
+    } else {
+        ESP_LOGW(TAG, "Async refresh not available");
+    }
+    vTaskDelay(pdMS_TO_TICKS(3000));
+    
     /*
      * =========================================================================
      * TEST 5: Final screen with pattern
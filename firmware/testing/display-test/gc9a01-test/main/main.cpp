@@ -5,18 +5,22 @@
  * @details
  * Demonstrates the GC9A01 component:
  * - Display initialization
- * - Color fills
- * - Drawing primitives (lines, rectangles, circles)
+ * - Color fills (square vs round mode)
+ * - Drawing primitives (lines, rectangles, circles, arcs)
  * - Text rendering
  * - Animation demo
+ * - Widget screen (damage drawn direct vs composed in a band buffer)
  */
 
 #include <stdio.h>
 #include <math.h>
+#include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "gc9a01.h"
+#include "ui_widgets.h"
 
 
 static const char* TAG = "GC9A01_TEST";
@@ -67,6 +71,7 @@ extern "C" void app_main(void) {
     }
     
     ESP_LOGI(TAG, "Display initialized. Running tests...");
+
         
     while (1) {
 
@@ -86,6 +91,26 @@ extern "C" void app_main(void) {
         vTaskDelay(pdMS_TO_TICKS(500));
     }
     
+    /*
+     * -------------------------------------------------------------------------
+     * TEST 1b: Round mode - full-screen fills with and without corners
+     * -------------------------------------------------------------------------
+     */
+    ESP_LOGI(TAG, "Test 1b: Round mode");
+
+    for (int mode = 0; mode < 2; mode++) {
+        display.setRoundMode(mode == 1);
+
+        int64_t start = esp_timer_get_time();
+        for (int i = 0; i < 10; i++) {
+            display.fillScreen(colors[i % 6]);
+        }
+        display.flush();
+        int64_t elapsed = esp_timer_get_time() - start;
+
+        ESP_LOGI(TAG, "%s: %lld us/fillScreen", mode ? "Round " : "Square", elapsed / 10);
+    }
+
     /*
      * -------------------------------------------------------------------------
      * TEST 2: Text Display
@@ -114,6 +139,7 @@ extern "C" void app_main(void) {
     
     // Draw lines from center outward
     int cx = 120, cy = 130;
+    int64_t rasterStart = esp_timer_get_time();
     for (int angle = 0; angle < 360; angle += 15) {
         float rad = angle * 3.14159f / 180.0f;
         int x = cx + (int)(80 * cosf(rad));
@@ -121,6 +147,15 @@ extern "C" void app_main(void) {
         uint16_t color = GC9A01::color565(angle * 255 / 360, 100, 255 - angle * 255 / 360);
         display.drawLine(cx, cy, x, y, color);
     }
+    display.flush();
+    ESP_LOGI(TAG, "24 lines: %lld us", esp_timer_get_time() - rasterStart);
+
+    // Hexagon outline (one drawLine per edge)
+    static const int16_t hexagon[] = {120, 45, 194, 88, 194, 172, 120, 215, 46, 172, 46, 88};
+    rasterStart = esp_timer_get_time();
+    display.drawPolygon(hexagon, 6, COLOR_WHITE);
+    display.flush();
+    ESP_LOGI(TAG, "Hexagon: %lld us", esp_timer_get_time() - rasterStart);
     
     vTaskDelay(pdMS_TO_TICKS(2000));
     
@@ -158,10 +193,13 @@ extern "C" void app_main(void) {
     display.drawString(60, 10, "Circles", COLOR_WHITE, COLOR_BLACK, 2);
     
     // Concentric circles
+    rasterStart = esp_timer_get_time();
     for (int r = 20; r <= 100; r += 10) {
         uint16_t color = GC9A01::color565(r * 2, 50, 255 - r * 2);
         display.drawCircle(120, 130, r, color);
     }
+    display.flush();
+    ESP_LOGI(TAG, "9 circles: %lld us", esp_timer_get_time() - rasterStart);
     
     vTaskDelay(pdMS_TO_TICKS(2000));
     
@@ -169,12 +207,15 @@ extern "C" void app_main(void) {
     display.fillScreen(COLOR_BLACK);
     display.drawString(30, 10, "Filled Circles", COLOR_WHITE, COLOR_BLACK, 2);
     
+    rasterStart = esp_timer_get_time();
     display.fillCircle(70, 100, 40, COLOR_RED);
     display.fillCircle(170, 100, 40, COLOR_BLUE);
     display.fillCircle(120, 170, 40, COLOR_GREEN);
     
     // Overlapping creates nice effect
     display.fillCircle(120, 120, 30, COLOR_YELLOW);
+    display.flush();
+    ESP_LOGI(TAG, "4 filled circles: %lld us", esp_timer_get_time() - rasterStart);
     
     vTaskDelay(pdMS_TO_TICKS(2000));
     
@@ -262,6 +303,90 @@ extern "C" void app_main(void) {
         vTaskDelay(pdMS_TO_TICKS(20));
     }
     
+    /*
+     * -------------------------------------------------------------------------
+     * TEST 7b: Arc spans - level dial, full redraw vs delta slices
+     * -------------------------------------------------------------------------
+     */
+    ESP_LOGI(TAG, "Test 7b: Arc spans");
+
+    ArcSpanTable ring;
+    if (ring.init(40, 100)) {
+        display.fillScreen(COLOR_BLACK);
+
+        int64_t start = esp_timer_get_time();
+        for (int level = 0; level <= 100; level += 2) {
+            display.fillArc(ring, 120, 120, 0, level * 36 / 10, COLOR_ORANGE);
+        }
+        display.flush();
+        int64_t fullUs = esp_timer_get_time() - start;
+
+        display.fillScreen(COLOR_BLACK);
+        start = esp_timer_get_time();
+        int prevAngle = 0;
+        for (int level = 0; level <= 100; level += 2) {
+            int angle = level * 36 / 10;
+            display.fillArcDelta(ring, 120, 120, 0, prevAngle, angle, COLOR_CYAN, COLOR_BLACK);
+            prevAngle = angle;
+        }
+        display.flush();
+        int64_t deltaUs = esp_timer_get_time() - start;
+
+        ESP_LOGI(TAG, "51 dial steps: full arcs %lld us, delta slices %lld us", fullUs, deltaUs);
+        vTaskDelay(pdMS_TO_TICKS(1000));
+    }
+
+    /*
+     * -------------------------------------------------------------------------
+     * TEST 8: Widget screen - smart light dial, damage direct vs composed
+     * -------------------------------------------------------------------------
+     */
+    ESP_LOGI(TAG, "Test 8: Widget screen");
+
+    for (int composed = 0; composed < 2 && ring.isReady(); composed++) {
+        UiScreen<GC9A01> screen(display, COLOR_BLACK);
+        if (composed && !screen.setComposeBuffer(GC9A01_WIDTH * 16 * 2)) {
+            ESP_LOGE(TAG, "No memory for the compose buffer");
+            break;
+        }
+
+        UiArcGauge<GC9A01> dial(ring, 120, 120, COLOR_ORANGE);
+        UiLabel<GC9A01> value(120, 110, UiAlign::CENTER, COLOR_WHITE);
+        UiLabel<GC9A01> name(120, 60, UiAlign::CENTER, COLOR_CYAN);
+        value.setFont(3);
+        name.setText("Living");
+        screen.add(dial);
+        screen.add(value);
+        screen.add(name);
+        screen.invalidate();        // Screen was drawn directly above
+
+        uint32_t bands = 0;
+        for (int frame = 0; frame < 120; frame++) {
+            // Script: ramp up, hue sweep, ramp down; off for a while twice
+            int level = frame < 40 ? frame * 100 / 39 : frame < 80 ? 100 : (119 - frame) * 100 / 39;
+            int hue = frame < 40 ? 30 : frame < 80 ? 30 + (frame - 40) * 8 : 350;
+            bool on = frame % 60 < 50;
+
+            dial.setVisible(on);
+            dial.setValue(level);
+            dial.setColor(GC9A01::color565(255, (hue % 360) * 255 / 360, 0));
+            value.setTextf("%d%%", level);
+
+            screen.render();
+            display.flush();
+            bands += screen.getStats().lastBands;
+            vTaskDelay(pdMS_TO_TICKS(20));
+        }
+
+        const UiFrameStats& st = screen.getStats();
+        ESP_LOGI(TAG, "%s: %lu frames, %llu us/frame avg, %lu us max, %lu bands",
+                 composed ? "Composed" : "Direct  ", (unsigned long)st.frames,
+                 (unsigned long long)(st.totalUs / (st.frames ? st.frames : 1)),
+                 (unsigned long)st.maxUs, (unsigned long)bands);
+        display.fillScreen(COLOR_BLACK);
+    }
+    vTaskDelay(pdMS_TO_TICKS(1000));
+
     /*
      * -------------------------------------------------------------------------
      * FINAL: Complete message
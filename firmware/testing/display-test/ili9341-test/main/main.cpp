@@ -116,7 +116,41 @@ extern "C" void app_main(void) {
         display.drawString(80, 150, names[i], COLOR_WHITE, colors[i], 2);
         vTaskDelay(pdMS_TO_TICKS(400));
     }
-    
+
+    /*
+     * =========================================================================
+     * STEP 3b: Fill throughput - blocking vs queued (DMA) mode
+     * =========================================================================
+     */
+    ESP_LOGI(TAG, "Test 1b: Fill throughput");
+
+    for (int mode = 0; mode < 2; mode++) {
+        display.setQueuedMode(mode == 1);
+
+        int64_t start = esp_timer_get_time();
+        for (int i = 0; i < 10; i++) {
+            display.fillScreen(colors[i % 6]);
+        }
+        int64_t issued = esp_timer_get_time();
+        display.flush();
+        int64_t done = esp_timer_get_time();
+
+        ESP_LOGI(TAG, "%s: %lld us/frame (CPU returned after %lld us/frame)",
+                 mode ? "Queued  " : "Blocking",
+                 (done - start) / 10, (issued - start) / 10);
+    }
+    display.setQueuedMode(true);
+
+    // Window cache: stacked lines share columns, so most CASETs are skipped
+    display.resetWindowStats();
+    for (int row = 0; row < 40; row++) {
+        display.drawHLine(20, 100 + row, 200, COLOR_WHITE);
+    }
+    const DisplayWindowStats& ws = display.getWindowStats();
+    ESP_LOGI(TAG, "Window cache: %lu windows, %lu commands elided, %lu bytes saved",
+             (unsigned long)ws.windowsSet, (unsigned long)ws.commandsElided,
+             (unsigned long)ws.bytesSaved);
+
     /*
      * =========================================================================
      * STEP 4: Touch coordinate test screen
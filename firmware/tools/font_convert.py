@@ -0,0 +1,238 @@
+#!/usr/bin/env python3
+"""
+Convert a TTF/OTF or BDF font to the packed font format (packed_font.h).
+
+TTF/OTF fonts are rasterized at --size pixels with anti-aliasing and
+quantized to --bpp bits per pixel. BDF fonts are bitmaps already and
+are stored as 1 bpp unless --bpp asks for more (then edges stay hard).
+
+Only the characters you need have to be included: --chars "0123456789%"
+stores the range "%" to "9"; the characters in between that were not
+asked for become empty (10 bytes each).
+
+Usage:
+    font_convert.py Lato-Regular.ttf --size 28 --chars "0123456789%" --tight \\
+                    --header digits_28.h --name digits_28
+    font_convert.py ter-u16n.bdf -o terminus16.pfnt
+
+Requires Pillow (pip install pillow) for TTF/OTF input.
+"""
+
+import argparse
+import re
+import struct
+import sys
+from pathlib import Path
+
+from rgb565_asset import write_header
+
+MAGIC = b"PFNT"
+VERSION = 1
+
+
+class Glyph:
+    def __init__(self, advance, x, y, rows):
+        self.advance = advance      # Pen advance in pixels
+        self.x = x                  # Bitmap left edge relative to the pen
+        self.y = y                  # Bitmap top edge relative to the line top
+        self.rows = rows            # Coverage 0.0-1.0, list of rows
+
+
+def load_ttf(path, size, codes):
+    from PIL import Image, ImageDraw, ImageFont
+
+    font = ImageFont.truetype(str(path), size)
+    ascent, descent = font.getmetrics()
+    glyphs = {}
+
+    for code in codes:
+        ch = chr(code)
+        advance = round(font.getlength(ch))
+        left, top, right, bottom = font.getbbox(ch, anchor="ls")
+        rows = []
+        if right > left and bottom > top:
+            img = Image.new("L", (right - left, bottom - top), 0)
+            ImageDraw.Draw(img).text((-left, -top), ch, font=font, fill=255, anchor="ls")
+            pixels = img.tobytes()
+            w = right - left
+            rows = [[pixels[r * w + c] / 255 for c in range(w)] for r in range(bottom - top)]
+        glyphs[code] = Glyph(advance, left, ascent + top, rows)
+
+    return glyphs, ascent + descent, ascent
+
+
+def load_bdf(path, codes):
+    glyphs = {}
+    ascent = descent = None
+    lines = Path(path).read_text(errors="replace").splitlines()
+    i = 0
+
+    while i < len(lines):
+        words = lines[i].split()
+        key = words[0] if words else ""
+        if key == "FONT_ASCENT":
+            ascent = int(words[1])
+        elif key == "FONT_DESCENT":
+            descent = int(words[1])
+        elif key == "STARTCHAR":
+            code = advance = None
+            bbx = (0, 0, 0, 0)
+            rows = []
+            while True:
+                i += 1
+                words = lines[i].split()
+                if words[0] == "ENCODING":
+                    code = int(words[1])
+                elif words[0] == "DWIDTH":
+                    advance = int(words[1])
+                elif words[0] == "BBX":
+                    bbx = tuple(int(v) for v in words[1:5])
+                elif words[0] == "BITMAP":
+                    w, h = bbx[0], bbx[1]
+                    for r in range(h):
+                        bits = int(lines[i + 1 + r], 16)
+                        nbits = len(lines[i + 1 + r].strip()) * 4
+                        rows.append([float((bits >> (nbits - 1 - c)) & 1) for c in range(w)])
+                    i += h
+                elif words[0] == "ENDCHAR":
+                    break
+            if code in codes:
+                w, h, bx, by = bbx
+                glyphs[code] = (advance, bx, by, h, rows)
+        i += 1
+
+    if ascent is None or descent is None:
+        sys.exit(f"{path}: FONT_ASCENT/FONT_DESCENT missing")
+
+    result = {code: Glyph(adv, bx, ascent - (by + h), rows)
+              for code, (adv, bx, by, h, rows) in glyphs.items()}
+    return result, ascent + descent, ascent
+
+
+def fit_to_cell(g, line_height):
+    """Crop the bitmap to its cell: no negative offsets, nothing past the advance."""
+    rows = [list(r) for r in g.rows]
+    x, y = g.x, g.y
+
+    # Trim empty rows and columns
+    while rows and not any(rows[0]):
+        rows.pop(0)
+        y += 1
+    while rows and not any(rows[-1]):
+        rows.pop()
+    while rows and rows[0] and not any(r[0] for r in rows):
+        rows = [r[1:] for r in rows]
+        x += 1
+    while rows and rows[0] and not any(r[-1] for r in rows):
+        rows = [r[:-1] for r in rows]
+
+    if x < 0:
+        rows = [r[-x:] for r in rows]
+        x = 0
+    if y < 0:
+        rows = rows[-y:]
+        y = 0
+    advance = max(g.advance, 0)
+    rows = [r[:max(advance - x, 0)] for r in rows[:max(line_height - y, 0)]]
+    if not rows or not rows[0]:
+        rows, x, y = [], 0, 0
+
+    return Glyph(advance, x, y, rows)
+
+
+def pack_rows(rows, bpp):
+    top = (1 << bpp) - 1
+    out = bytearray()
+    for row in rows:
+        bits, nbits = 0, 0
+        for cover in row:
+            bits = (bits << bpp) | min(top, int(cover * top + 0.5))
+            nbits += bpp
+            if nbits == 8:
+                out.append(bits)
+                bits, nbits = 0, 0
+        if nbits:
+            out.append(bits << (8 - nbits))
+    return bytes(out)
+
+
+def build(glyphs, line_height, ascent, bpp, first, last):
+    if line_height > 255 or ascent > 255:
+        sys.exit(f"line height {line_height} too large (max 255)")
+
+    table = bytearray()
+    bitmaps = bytearray()
+
+    for code in range(first, last + 1):
+        g = glyphs.get(code)
+        if g is None:
+            table += struct.pack("<IBBBBBB", 0, 0, 0, 0, 0, 0, 0)
+            continue
+        g = fit_to_cell(g, line_height)
+        if g.advance > 255:
+            sys.exit(f"glyph {code} too wide")
+        width, height = (len(g.rows[0]), len(g.rows)) if g.rows else (0, 0)
+        table += struct.pack("<IBBBBBB", len(bitmaps), width, height, g.advance, g.x, g.y, 0)
+        bitmaps += pack_rows(g.rows, bpp)
+
+    header = MAGIC + struct.pack("<BBBBBBH", VERSION, bpp, first, last, line_height, ascent, 0)
+    return header + table + bitmaps
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a font to the packed font format")
+    parser.add_argument("font", help="Input font (.ttf, .otf or .bdf)")
+    parser.add_argument("--size", type=int, help="Pixel size for TTF/OTF")
+    parser.add_argument("--bpp", type=int, choices=[1, 2, 4], default=None,
+                        help="Bits per pixel (default: 4 for TTF/OTF, 1 for BDF)")
+    parser.add_argument("--chars", help="Characters to include (default: printable ASCII)")
+    parser.add_argument("--tight", action="store_true",
+                        help="Shrink the line height to the included glyphs (e.g. digits)")
+    parser.add_argument("-o", "--output", help="Binary output (.pfnt)")
+    parser.add_argument("--header", help="C header output")
+    parser.add_argument("--name", help="Array name in the header (default: from file name)")
+    args = parser.parse_args()
+
+    if not args.output and not args.header:
+        parser.error("give --output and/or --header")
+
+    codes = sorted({ord(c) for c in args.chars}) if args.chars else list(range(32, 127))
+    if codes[-1] > 255:
+        sys.exit("only characters 0-255 are supported")
+
+    if args.font.lower().endswith(".bdf"):
+        glyphs, line_height, ascent = load_bdf(args.font, set(codes))
+        bpp = args.bpp or 1
+    else:
+        if not args.size:
+            parser.error("--size is required for TTF/OTF fonts")
+        glyphs, line_height, ascent = load_ttf(args.font, args.size, codes)
+        bpp = args.bpp or 4
+
+    # Digits-only fonts: no room for accents and descenders that are not there
+    if args.tight:
+        tops = [g.y for g in glyphs.values() if g.rows]
+        bottoms = [g.y + len(g.rows) for g in glyphs.values() if g.rows]
+        if tops:
+            shift = min(tops)
+            for g in glyphs.values():
+                g.y -= shift
+            ascent -= shift
+            line_height = max(bottoms) - shift
+
+    if not glyphs:
+        sys.exit(f"{args.font}: none of the requested characters found")
+    blob = build(glyphs, line_height, ascent, bpp, min(glyphs), max(glyphs))
+
+    if args.output:
+        Path(args.output).write_bytes(blob)
+    if args.header:
+        name = args.name or re.sub(r"\W", "_", Path(args.font).stem)
+        write_header(args.header, name, blob, tool="font_convert.py")
+
+    print(f"{args.font}: {len(glyphs)} glyphs, line height {line_height}, "
+          f"{bpp} bpp, {len(blob)} bytes")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,30 @@
+# Render one effect sequence and compare it with its golden image.
+#
+#   cmake -DRENDER=<led_effects_render> -DARGS="fire;--leds;30" \
+#         -DOUT=<file.ppm> -DGOLDEN=<golden/file.ppm> [-DUPDATE=ON] -P golden_compare.cmake
+#
+# UPDATE=ON copies the new render over the golden image instead (after an
+# intended change to an effect; look at the images before committing).
+
+execute_process(
+    COMMAND ${RENDER} ${ARGS} -o ${OUT}
+    RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "led_effects_render failed (${result})")
+endif()
+
+if(UPDATE)
+    execute_process(COMMAND ${CMAKE_COMMAND} -E copy ${OUT} ${GOLDEN})
+    message(STATUS "Updated ${GOLDEN}")
+    return()
+endif()
+
+execute_process(
+    COMMAND ${CMAKE_COMMAND} -E compare_files ${OUT} ${GOLDEN}
+    RESULT_VARIABLE differ
+)
+if(differ)
+    message(FATAL_ERROR "${OUT} differs from ${GOLDEN}\n"
+                        "If the change is intended: cmake -DUPDATE_GOLDEN=ON, run ctest -R golden, review the images")
+endif()
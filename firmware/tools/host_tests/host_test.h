@@ -0,0 +1,77 @@
+/**
+ * @file host_test.h
+ * @brief Minimal test runner for the host tests (no external framework).
+ *
+ * @details
+ * @code
+ *     TEST_CASE(fills_match) {
+ *         CHECK(a == b);
+ *         CHECK_EQ(count, 3);
+ *         METRIC("bytes_per_frame", bytes, "B");
+ *     }
+ * @endcode
+ *
+ * Every test file links host_test_main.cpp, which runs all cases and
+ * returns non-zero if any check failed (ctest reports the failure).
+ * METRIC lines are printed so benchmark numbers show up in the ctest
+ * output (ctest --output-on-failure -V).
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <chrono>
+
+
+namespace host_test {
+
+typedef void (*TestFn)();
+
+/**
+ * @brief Registers a case at static-init time (used by TEST_CASE).
+ */
+struct Register {
+    Register(const char* name, TestFn fn);
+};
+
+/**
+ * @brief Record a failed check (used by the CHECK macros).
+ */
+void fail(const char* file, int line, const char* expr);
+
+/**
+ * @brief Wall-clock microseconds on the host (for benchmarks).
+ */
+inline double hostUs()
+{
+    using namespace std::chrono;
+    return duration<double, std::micro>(steady_clock::now().time_since_epoch()).count();
+}
+
+}   // namespace host_test
+
+
+#define TEST_CASE(name)                                                  \
+    static void name();                                                  \
+    static host_test::Register register_##name(#name, name);             \
+    static void name()
+
+#define CHECK(cond)                                                      \
+    do {                                                                 \
+        if (!(cond)) host_test::fail(__FILE__, __LINE__, #cond);         \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                   \
+    do {                                                                 \
+        long long va_ = (long long)(a), vb_ = (long long)(b);            \
+        if (va_ != vb_) {                                                \
+            char msg_[256];                                              \
+            snprintf(msg_, sizeof(msg_), "%s == %s (%lld != %lld)",      \
+                     #a, #b, va_, vb_);                                  \
+            host_test::fail(__FILE__, __LINE__, msg_);                   \
+        }                                                                \
+    } while (0)
+
+#define METRIC(name, value, unit)                                        \
+    printf("  METRIC %-40s %12.2f %s\n", name, (double)(value), unit)
@@ -0,0 +1,64 @@
+/**
+ * @file host_test_main.cpp
+ * @brief Runs every TEST_CASE of the binary (see host_test.h).
+ */
+
+#include "host_test.h"
+#include "mock/idf_mock.h"
+
+#include <vector>
+
+
+namespace {
+
+struct Case {
+    const char* name;
+    host_test::TestFn fn;
+};
+
+std::vector<Case>& cases()
+{
+    static std::vector<Case> list;
+    return list;
+}
+
+int failures = 0;
+
+}   // namespace
+
+
+host_test::Register::Register(const char* name, TestFn fn)
+{
+    cases().push_back({name, fn});
+}
+
+
+void host_test::fail(const char* file, int line, const char* expr)
+{
+    printf("  FAIL %s:%d: %s\n", file, line, expr);
+    failures++;
+}
+
+
+int main()
+{
+    int failedCases = 0;
+
+    for (const Case& c : cases()) {
+        printf("[ RUN  ] %s\n", c.name);
+        mock::reset();
+
+        int before = failures;
+        c.fn();
+        if (mock::deadlocks() > 0) {
+            host_test::fail(__FILE__, __LINE__, "blocking wait that would never return");
+        }
+
+        bool ok = failures == before;
+        if (!ok) failedCases++;
+        printf("[ %s ] %s\n", ok ? " OK " : "FAIL", c.name);
+    }
+
+    printf("%d of %zu cases failed\n", failedCases, cases().size());
+    return failedCases == 0 ? 0 : 1;
+}
@@ -0,0 +1,58 @@
+/*
+ * Host stand-in for <driver/i2c_master.h> (the new I2C master API).
+ *
+ * Every transmit/receive is logged with the device address and bytes.
+ * A transfer blocks for its wire time at the device's scl_speed_hz: the
+ * mock clock moves by 9 clocks per byte (address byte included) plus
+ * start and stop. See mock::i2c in ../../mock/idf_mock.h.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../freertos/FreeRTOS.h"
+#include "gpio.h"
+
+typedef enum { I2C_NUM_0 = 0, I2C_NUM_1 = 1, I2C_NUM_MAX } i2c_port_t;
+
+typedef enum { I2C_CLK_SRC_DEFAULT = 0 } i2c_clock_source_t;
+
+typedef enum { I2C_ADDR_BIT_LEN_7 = 0, I2C_ADDR_BIT_LEN_10 = 1 } i2c_addr_bit_len_t;
+
+typedef struct i2c_master_bus_t* i2c_master_bus_handle_t;
+typedef struct i2c_master_dev_t* i2c_master_dev_handle_t;
+
+typedef struct {
+    i2c_port_t i2c_port;
+    gpio_num_t sda_io_num;
+    gpio_num_t scl_io_num;
+    i2c_clock_source_t clk_source;
+    uint8_t glitch_ignore_cnt;
+    int intr_priority;
+    size_t trans_queue_depth;
+    struct {
+        uint32_t enable_internal_pullup : 1;
+    } flags;
+} i2c_master_bus_config_t;
+
+typedef struct {
+    i2c_addr_bit_len_t dev_addr_length;
+    uint16_t device_address;
+    uint32_t scl_speed_hz;
+    uint32_t scl_wait_us;
+    struct {
+        uint32_t disable_ack_check : 1;
+    } flags;
+} i2c_device_config_t;
+
+esp_err_t i2c_new_master_bus(const i2c_master_bus_config_t* config, i2c_master_bus_handle_t* bus);
+esp_err_t i2c_del_master_bus(i2c_master_bus_handle_t bus);
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t bus, const i2c_device_config_t* config,
+                                    i2c_master_dev_handle_t* device);
+esp_err_t i2c_master_bus_rm_device(i2c_master_dev_handle_t device);
+
+esp_err_t i2c_master_transmit(i2c_master_dev_handle_t device, const uint8_t* data, size_t size,
+                              int timeoutMs);
+esp_err_t i2c_master_receive(i2c_master_dev_handle_t device, uint8_t* data, size_t size, int timeoutMs);
+esp_err_t i2c_master_transmit_receive(i2c_master_dev_handle_t device, const uint8_t* write, size_t writeSize,
+                                      uint8_t* read, size_t readSize, int timeoutMs);
@@ -0,0 +1,62 @@
+/*
+ * Host stand-in for <driver/rmt_encoder.h>.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../esp_err.h"
+
+#ifndef __containerof
+#define __containerof(ptr, type, member) ((type*)((char*)(ptr) - offsetof(type, member)))
+#endif
+
+typedef struct rmt_channel_t* rmt_channel_handle_t;
+
+typedef enum {
+    RMT_ENCODING_RESET = 0,
+    RMT_ENCODING_COMPLETE = (1 << 0),
+    RMT_ENCODING_MEM_FULL = (1 << 1),
+} rmt_encode_state_t;
+
+inline rmt_encode_state_t& operator|=(rmt_encode_state_t& a, int b)
+{
+    a = (rmt_encode_state_t)(a | b);
+    return a;
+}
+
+typedef union {
+    struct {
+        uint16_t duration0 : 15;
+        uint16_t level0 : 1;
+        uint16_t duration1 : 15;
+        uint16_t level1 : 1;
+    };
+    uint32_t val;
+} rmt_symbol_word_t;
+
+typedef struct rmt_encoder_t rmt_encoder_t;
+typedef rmt_encoder_t* rmt_encoder_handle_t;
+
+struct rmt_encoder_t {
+    size_t (*encode)(rmt_encoder_t* encoder, rmt_channel_handle_t channel, const void* data,
+                     size_t size, rmt_encode_state_t* state);
+    esp_err_t (*reset)(rmt_encoder_t* encoder);
+    esp_err_t (*del)(rmt_encoder_t* encoder);
+};
+
+typedef struct {
+    rmt_symbol_word_t bit0;
+    rmt_symbol_word_t bit1;
+    struct {
+        uint32_t msb_first : 1;
+    } flags;
+} rmt_bytes_encoder_config_t;
+
+typedef struct {
+} rmt_copy_encoder_config_t;
+
+esp_err_t rmt_new_bytes_encoder(const rmt_bytes_encoder_config_t* config, rmt_encoder_handle_t* encoder);
+esp_err_t rmt_new_copy_encoder(const rmt_copy_encoder_config_t* config, rmt_encoder_handle_t* encoder);
+esp_err_t rmt_del_encoder(rmt_encoder_handle_t encoder);
+esp_err_t rmt_encoder_reset(rmt_encoder_handle_t encoder);
@@ -0,0 +1,55 @@
+/*
+ * Host stand-in for <driver/rmt_tx.h>.
+ *
+ * rmt_transmit() records the raw bytes handed to the encoder and calls
+ * on_trans_done at once (see mock::rmt in ../../mock/idf_mock.h).
+ */
+#pragma once
+
+#include "gpio.h"
+#include "rmt_encoder.h"
+
+typedef enum { RMT_CLK_SRC_DEFAULT = 0 } rmt_clock_source_t;
+
+typedef struct {
+    gpio_num_t gpio_num;
+    rmt_clock_source_t clk_src;
+    uint32_t resolution_hz;
+    size_t mem_block_symbols;
+    size_t trans_queue_depth;
+    int intr_priority;
+    struct {
+        uint32_t invert_out : 1;
+        uint32_t with_dma : 1;
+        uint32_t io_loop_back : 1;
+        uint32_t io_od_mode : 1;
+    } flags;
+} rmt_tx_channel_config_t;
+
+typedef struct {
+    int loop_count;
+    struct {
+        uint32_t eot_level : 1;
+    } flags;
+} rmt_transmit_config_t;
+
+typedef struct {
+    size_t num_symbols;
+} rmt_tx_done_event_data_t;
+
+typedef bool (*rmt_tx_done_callback_t)(rmt_channel_handle_t channel,
+                                       const rmt_tx_done_event_data_t* event, void* arg);
+
+typedef struct {
+    rmt_tx_done_callback_t on_trans_done;
+} rmt_tx_event_callbacks_t;
+
+esp_err_t rmt_new_tx_channel(const rmt_tx_channel_config_t* config, rmt_channel_handle_t* channel);
+esp_err_t rmt_del_channel(rmt_channel_handle_t channel);
+esp_err_t rmt_enable(rmt_channel_handle_t channel);
+esp_err_t rmt_disable(rmt_channel_handle_t channel);
+esp_err_t rmt_tx_register_event_callbacks(rmt_channel_handle_t channel,
+                                          const rmt_tx_event_callbacks_t* callbacks, void* arg);
+esp_err_t rmt_transmit(rmt_channel_handle_t channel, rmt_encoder_handle_t encoder, const void* data,
+                       size_t size, const rmt_transmit_config_t* config);
+esp_err_t rmt_tx_wait_all_done(rmt_channel_handle_t channel, int timeout_ms);
@@ -0,0 +1,93 @@
+/*
+ * Host stand-in for <driver/spi_master.h>.
+ *
+ * Every transfer is recorded with the GPIO output levels at that moment
+ * (so DC can be read back) and completes at once: post_cb runs inside
+ * spi_device_queue_trans(), the result waits for
+ * spi_device_get_trans_result(). See mock::spi in ../../mock/idf_mock.h.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../freertos/FreeRTOS.h"
+#include "gpio.h"
+
+typedef enum { SPI1_HOST = 0, SPI2_HOST = 1, SPI3_HOST = 2, SPI_HOST_MAX } spi_host_device_t;
+
+#define SPI_DMA_DISABLED        0
+#define SPI_DMA_CH_AUTO         3
+
+#define SPI_TRANS_MODE_DIO      (1 << 0)
+#define SPI_TRANS_MODE_QIO      (1 << 1)
+#define SPI_TRANS_USE_RXDATA    (1 << 2)
+#define SPI_TRANS_USE_TXDATA    (1 << 3)
+
+#define SPI_DEVICE_TXBIT_LSBFIRST   (1 << 0)
+#define SPI_DEVICE_3WIRE            (1 << 2)
+#define SPI_DEVICE_HALFDUPLEX       (1 << 4)
+#define SPI_DEVICE_NO_DUMMY         (1 << 6)
+
+typedef struct spi_transaction_t spi_transaction_t;
+typedef void (*transaction_cb_t)(spi_transaction_t* trans);
+
+struct spi_transaction_t {
+    uint32_t flags;
+    uint16_t cmd;
+    uint64_t addr;
+    size_t length;          ///< Bits to send
+    size_t rxlength;        ///< Bits to receive (0 = length)
+    void* user;
+    union {
+        const void* tx_buffer;
+        uint8_t tx_data[4];
+    };
+    union {
+        void* rx_buffer;
+        uint8_t rx_data[4];
+    };
+};
+
+typedef struct {
+    int mosi_io_num;
+    int miso_io_num;
+    int sclk_io_num;
+    int quadwp_io_num;
+    int quadhd_io_num;
+    int max_transfer_sz;
+    uint32_t flags;
+    int intr_flags;
+} spi_bus_config_t;
+
+typedef struct {
+    uint8_t command_bits;
+    uint8_t address_bits;
+    uint8_t dummy_bits;
+    uint8_t mode;
+    uint16_t duty_cycle_pos;
+    uint16_t cs_ena_pretrans;
+    uint8_t cs_ena_posttrans;
+    int clock_speed_hz;
+    int input_delay_ns;
+    int spics_io_num;
+    uint32_t flags;
+    int queue_size;
+    transaction_cb_t pre_cb;
+    transaction_cb_t post_cb;
+} spi_device_interface_config_t;
+
+typedef struct spi_device_t* spi_device_handle_t;
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t* config, int dma);
+esp_err_t spi_bus_free(spi_host_device_t host);
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t* config,
+                             spi_device_handle_t* handle);
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle);
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t* trans);
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t* trans);
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t* trans, TickType_t timeout);
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t** trans,
+                                      TickType_t timeout);
+esp_err_t spi_device_acquire_bus(spi_device_handle_t handle, TickType_t timeout);
+void spi_device_release_bus(spi_device_handle_t handle);
@@ -0,0 +1,8 @@
+/*
+ * Host stand-in for <esp_attr.h>.
+ */
+#pragma once
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define RTC_DATA_ATTR
@@ -0,0 +1,14 @@
+/*
+ * Host stand-in for <esp_bit_defs.h>.
+ */
+#pragma once
+
+#define BIT(n)  (1UL << (n))
+#define BIT0    0x00000001
+#define BIT1    0x00000002
+#define BIT2    0x00000004
+#define BIT3    0x00000008
+#define BIT4    0x00000010
+#define BIT5    0x00000020
+#define BIT6    0x00000040
+#define BIT7    0x00000080
@@ -0,0 +1,24 @@
+/*
+ * Host stand-in for <esp_heap_caps.h>: every capability is plain malloc()
+ * (a test can make allocations fail, see mock::heap).
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_EXEC         (1 << 0)
+#define MALLOC_CAP_32BIT        (1 << 1)
+#define MALLOC_CAP_8BIT         (1 << 2)
+#define MALLOC_CAP_DMA          (1 << 3)
+#define MALLOC_CAP_SPIRAM       (1 << 10)
+#define MALLOC_CAP_INTERNAL     (1 << 11)
+#define MALLOC_CAP_DEFAULT      (1 << 12)
+
+void* heap_caps_malloc(size_t size, uint32_t caps);
+void* heap_caps_calloc(size_t n, size_t size, uint32_t caps);
+void* heap_caps_realloc(void* p, size_t size, uint32_t caps);
+inline void heap_caps_free(void* p) { free(p); }
+inline size_t heap_caps_get_free_size(uint32_t) { return 256 * 1024; }
+inline size_t heap_caps_get_largest_free_block(uint32_t) { return 128 * 1024; }
@@ -0,0 +1,32 @@
+/*
+ * Host stand-in for <esp_log.h>: log calls are type-checked and dropped
+ * (set HOST_TEST_LOG=1 in the environment to print them).
+ */
+#pragma once
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "esp_err.h"
+
+inline void host_log(char level, const char* tag, const char* fmt, ...)
+    __attribute__((format(printf, 3, 4)));
+
+inline void host_log(char level, const char* tag, const char* fmt, ...)
+{
+    static const bool enabled = getenv("HOST_TEST_LOG") != nullptr;
+    if (!enabled) return;
+
+    va_list args;
+    va_start(args, fmt);
+    fprintf(stderr, "%c (%s) ", level, tag);
+    vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    va_end(args);
+}
+
+#define ESP_LOGE(tag, fmt, ...) host_log('E', tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) host_log('W', tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) host_log('I', tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...) host_log('D', tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGV(tag, fmt, ...) host_log('V', tag, fmt, ##__VA_ARGS__)
@@ -0,0 +1,10 @@
+/*
+ * Host stand-in for <esp_timer.h>: time is the mock clock
+ * (mock::nowUs(), advanced by vTaskDelay() and blocking waits).
+ */
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+
+int64_t esp_timer_get_time();
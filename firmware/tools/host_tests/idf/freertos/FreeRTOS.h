@@ -0,0 +1,45 @@
+/*
+ * Host stand-in for <freertos/FreeRTOS.h>.
+ *
+ * One thread, 1 ms ticks. Nothing runs concurrently: blocking calls
+ * advance the mock clock instead (see ../../mock/idf_mock.h).
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../esp_attr.h"
+#include "../esp_bit_defs.h"
+#include "../esp_err.h"
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t EventBits_t;
+
+typedef struct HostTask* TaskHandle_t;
+typedef struct HostQueue* QueueHandle_t;
+typedef struct HostQueue* SemaphoreHandle_t;
+typedef struct HostEventGroup* EventGroupHandle_t;
+
+#define configTICK_RATE_HZ      1000
+#define portTICK_PERIOD_MS      ((TickType_t)1000 / configTICK_RATE_HZ)
+#define portMAX_DELAY           ((TickType_t)0xffffffffUL)
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000))
+#define pdTICKS_TO_MS(t)        ((uint32_t)(((uint64_t)(t) * 1000) / configTICK_RATE_HZ))
+
+#define pdFALSE                 0
+#define pdTRUE                  1
+#define pdFAIL                  0
+#define pdPASS                  1
+#define errQUEUE_FULL           0
+
+#define tskNO_AFFINITY          0x7FFFFFFF
+
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED    0
+#define portENTER_CRITICAL(mux)         ((void)(mux))
+#define portEXIT_CRITICAL(mux)          ((void)(mux))
+#define portENTER_CRITICAL_ISR(mux)     ((void)(mux))
+#define portEXIT_CRITICAL_ISR(mux)      ((void)(mux))
+#define portYIELD_FROM_ISR(woken)       ((void)(woken))
@@ -0,0 +1,19 @@
+/*
+ * Host stand-in for <freertos/event_groups.h>.
+ *
+ * xEventGroupWaitBits() advances the mock clock through scheduled GPIO
+ * events (which may run ISRs that set the bits) until the bits are set
+ * or the timeout passes.
+ */
+#pragma once
+
+#include "FreeRTOS.h"
+
+EventGroupHandle_t xEventGroupCreate();
+void vEventGroupDelete(EventGroupHandle_t group);
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits);
+BaseType_t xEventGroupSetBitsFromISR(EventGroupHandle_t group, EventBits_t bits, BaseType_t* woken);
+EventBits_t xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits);
+EventBits_t xEventGroupGetBits(EventGroupHandle_t group);
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, EventBits_t bits, BaseType_t clearOnExit,
+                                BaseType_t waitForAll, TickType_t timeout);
@@ -0,0 +1,17 @@
+/*
+ * Host stand-in for <freertos/queue.h> (copying FIFO; receive advances
+ * the mock clock like xEventGroupWaitBits()).
+ */
+#pragma once
+
+#include "FreeRTOS.h"
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+void vQueueDelete(QueueHandle_t queue);
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t timeout);
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* woken);
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t timeout);
+BaseType_t xQueueReset(QueueHandle_t queue);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+
+#define xQueueSendToBack xQueueSend
@@ -0,0 +1,27 @@
+/*
+ * Host stand-in for <freertos/task.h>.
+ *
+ * Tasks are not run on the host: xTaskCreate() fails, so code under test
+ * takes its "no task" path. vTaskDelay() advances the mock clock.
+ */
+#pragma once
+
+#include "FreeRTOS.h"
+
+typedef void (*TaskFunction_t)(void*);
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stack, void* arg,
+                       UBaseType_t priority, TaskHandle_t* handle);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack, void* arg,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core);
+void vTaskDelete(TaskHandle_t task);
+void vTaskSuspend(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t* previousWake, TickType_t period);
+BaseType_t xTaskDelayUntil(TickType_t* previousWake, TickType_t period);
+TickType_t xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* woken);
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t timeout);
@@ -0,0 +1,894 @@
+/**
+ * @file idf_mock.cpp
+ * @brief Host implementations of the ESP-IDF calls used by the components.
+ *
+ * See idf_mock.h for the model (one thread, mock clock, recorded buses).
+ */
+
+#include "idf_mock.h"
+
+#include <string.h>
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <driver/rmt_tx.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+
+/*
+ * =============================================================================
+ * STATE
+ * =============================================================================
+ */
+
+namespace {
+
+struct Pin {
+    int level = 0;
+    gpio_int_type_t intrType = GPIO_INTR_DISABLE;
+    bool intrEnabled = false;
+    gpio_isr_t isr = nullptr;
+    void* isrArg = nullptr;
+};
+
+struct ScheduledInput {
+    int64_t atUs;
+    uint64_t order;                 // Keeps events at the same time in call order
+    gpio_num_t pin;
+    int level;
+};
+
+int64_t clockUs = 0;
+uint32_t deadlockCount = 0;
+uint64_t scheduleOrder = 0;
+Pin pins[GPIO_NUM_MAX];
+std::vector<ScheduledInput> schedule;
+std::function<void(gpio_num_t, int)> outputHook;
+bool isrServiceInstalled = false;
+uint32_t taskNotifications = 0;
+bool allocationsFail = false;
+
+std::vector<mock::spi::Transfer> spiLog;
+std::deque<uint8_t> spiReadData;
+spi_device_handle_t spiLastDevice = nullptr;
+bool spiBusUsed[SPI_HOST_MAX] = {};
+
+std::vector<mock::i2c::Transfer> i2cLog;
+std::deque<uint8_t> i2cReadData;
+bool i2cPortUsed[I2C_NUM_MAX] = {};
+
+std::vector<std::vector<uint8_t>> rmtLog;
+
+
+bool validPin(gpio_num_t pin)
+{
+    return pin >= 0 && pin < GPIO_NUM_MAX;
+}
+
+
+uint64_t outputLevels()
+{
+    uint64_t levels = 0;
+    for (int i = 0; i < GPIO_NUM_MAX; i++) {
+        if (pins[i].level) levels |= 1ULL << i;
+    }
+    return levels;
+}
+
+
+void runIsrIfTriggered(gpio_num_t pin, int oldLevel, int newLevel)
+{
+    Pin& p = pins[pin];
+    if (!p.isr || !p.intrEnabled) return;
+
+    bool fire = false;
+    switch (p.intrType) {
+        case GPIO_INTR_POSEDGE:    fire = !oldLevel && newLevel; break;
+        case GPIO_INTR_NEGEDGE:    fire = oldLevel && !newLevel; break;
+        case GPIO_INTR_ANYEDGE:    fire = oldLevel != newLevel; break;
+        case GPIO_INTR_LOW_LEVEL:  fire = !newLevel; break;
+        case GPIO_INTR_HIGH_LEVEL: fire = newLevel; break;
+        default: break;
+    }
+    if (fire) p.isr(p.isrArg);
+}
+
+
+void applyInput(gpio_num_t pin, int level)
+{
+    int old = pins[pin].level;
+    pins[pin].level = level ? 1 : 0;
+    runIsrIfTriggered(pin, old, pins[pin].level);
+}
+
+
+/**
+ * @brief Fire the earliest scheduled input if it is due by limitUs.
+ */
+bool fireNext(int64_t limitUs)
+{
+    if (schedule.empty()) return false;
+
+    auto next = std::min_element(schedule.begin(), schedule.end(),
+        [](const ScheduledInput& a, const ScheduledInput& b) {
+            return a.atUs != b.atUs ? a.atUs < b.atUs : a.order < b.order;
+        });
+    if (next->atUs > limitUs) return false;
+
+    ScheduledInput ev = *next;
+    schedule.erase(next);
+    if (ev.atUs > clockUs) clockUs = ev.atUs;
+    applyInput(ev.pin, ev.level);
+    return true;
+}
+
+
+/**
+ * @brief Block until done() or the timeout, moving the clock through
+ *        scheduled inputs (whose ISRs may make done() true).
+ */
+template <typename Done>
+bool blockUntil(Done done, TickType_t timeout)
+{
+    if (done()) return true;
+    if (timeout == 0) return false;
+
+    bool forever = timeout == portMAX_DELAY;
+    int64_t deadline = forever ? INT64_MAX : clockUs + (int64_t)timeout * portTICK_PERIOD_MS * 1000;
+
+    while (fireNext(deadline)) {
+        if (done()) return true;
+    }
+
+    if (forever) {
+        deadlockCount++;            // Would hang on hardware
+        return false;
+    }
+    clockUs = deadline;
+    return done();
+}
+
+}   // namespace
+
+
+/*
+ * =============================================================================
+ * TEST CONTROLS
+ * =============================================================================
+ */
+
+namespace mock {
+
+void reset()
+{
+    clockUs = 0;
+    deadlockCount = 0;
+    for (Pin& p : pins) p = Pin();
+    schedule.clear();
+    outputHook = nullptr;
+    isrServiceInstalled = false;
+    taskNotifications = 0;
+    allocationsFail = false;
+    spiLog.clear();
+    spiReadData.clear();
+    for (bool& used : spiBusUsed) used = false;
+    i2cLog.clear();
+    i2cReadData.clear();
+    for (bool& used : i2cPortUsed) used = false;
+    rmtLog.clear();
+}
+
+int64_t nowUs() { return clockUs; }
+
+void advanceUs(int64_t us)
+{
+    int64_t target = clockUs + us;
+    while (fireNext(target)) {}
+    clockUs = target;
+}
+
+uint32_t deadlocks() { return deadlockCount; }
+
+
+namespace gpio {
+
+int level(gpio_num_t pin) { return validPin(pin) ? pins[pin].level : 0; }
+
+void setInput(gpio_num_t pin, int level)
+{
+    if (validPin(pin)) applyInput(pin, level);
+}
+
+void scheduleInput(gpio_num_t pin, int level, int64_t delayUs)
+{
+    if (validPin(pin)) schedule.push_back({clockUs + delayUs, scheduleOrder++, pin, level});
+}
+
+void onOutput(std::function<void(gpio_num_t, int)> hook) { outputHook = hook; }
+
+bool interruptEnabled(gpio_num_t pin)
+{
+    return validPin(pin) && pins[pin].isr && pins[pin].intrEnabled;
+}
+
+}   // namespace gpio
+
+
+namespace spi {
+
+const std::vector<Transfer>& log() { return spiLog; }
+
+void clearLog() { spiLog.clear(); }
+
+spi_device_handle_t lastDevice() { return spiLastDevice; }
+
+void setReadData(const std::vector<uint8_t>& bytes)
+{
+    spiReadData.insert(spiReadData.end(), bytes.begin(), bytes.end());
+}
+
+}   // namespace spi
+
+
+namespace i2c {
+
+const std::vector<Transfer>& log() { return i2cLog; }
+
+void clearLog() { i2cLog.clear(); }
+
+void setReadData(const std::vector<uint8_t>& bytes)
+{
+    i2cReadData.insert(i2cReadData.end(), bytes.begin(), bytes.end());
+}
+
+}   // namespace i2c
+
+
+namespace heap {
+
+void failAllocations(bool fail) { allocationsFail = fail; }
+
+}   // namespace heap
+
+
+namespace rmt {
+
+const std::vector<std::vector<uint8_t>>& log() { return rmtLog; }
+
+void clearLog() { rmtLog.clear(); }
+
+}   // namespace rmt
+
+}   // namespace mock
+
+
+/*
+ * =============================================================================
+ * esp_timer
+ * =============================================================================
+ */
+
+int64_t esp_timer_get_time() { return clockUs; }
+
+
+/*
+ * =============================================================================
+ * Heap
+ * =============================================================================
+ */
+
+void* heap_caps_malloc(size_t size, uint32_t) { return allocationsFail ? nullptr : malloc(size); }
+
+void* heap_caps_calloc(size_t n, size_t size, uint32_t) { return allocationsFail ? nullptr : calloc(n, size); }
+
+void* heap_caps_realloc(void* p, size_t size, uint32_t) { return allocationsFail ? nullptr : realloc(p, size); }
+
+
+/*
+ * =============================================================================
+ * GPIO
+ * =============================================================================
+ */
+
+esp_err_t gpio_config(const gpio_config_t* config)
+{
+    for (int i = 0; i < GPIO_NUM_MAX; i++) {
+        if (!(config->pin_bit_mask & (1ULL << i))) continue;
+        pins[i].intrType = config->intr_type;
+        pins[i].intrEnabled = config->intr_type != GPIO_INTR_DISABLE;
+        if (config->pull_up_en == GPIO_PULLUP_ENABLE && config->mode == GPIO_MODE_INPUT) {
+            pins[i].level = 1;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t gpio_reset_pin(gpio_num_t pin)
+{
+    if (!validPin(pin)) return ESP_ERR_INVALID_ARG;
+    pins[pin] = Pin();
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_direction(gpio_num_t pin, gpio_mode_t)
+{
+    return validPin(pin) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t gpio_set_pull_mode(gpio_num_t pin, int)
+{
+    return validPin(pin) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t gpio_set_level(gpio_num_t pin, uint32_t level)
+{
+    if (!validPin(pin)) return ESP_ERR_INVALID_ARG;
+    pins[pin].level = level ? 1 : 0;
+    if (outputHook) outputHook(pin, pins[pin].level);
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t pin)
+{
+    return validPin(pin) ? pins[pin].level : 0;
+}
+
+esp_err_t gpio_install_isr_service(int)
+{
+    if (isrServiceInstalled) return ESP_ERR_INVALID_STATE;
+    isrServiceInstalled = true;
+    return ESP_OK;
+}
+
+void gpio_uninstall_isr_service() { isrServiceInstalled = false; }
+
+esp_err_t gpio_isr_handler_add(gpio_num_t pin, gpio_isr_t handler, void* arg)
+{
+    if (!validPin(pin) || !isrServiceInstalled) return ESP_ERR_INVALID_STATE;
+    pins[pin].isr = handler;
+    pins[pin].isrArg = arg;
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t pin)
+{
+    if (!validPin(pin)) return ESP_ERR_INVALID_ARG;
+    pins[pin].isr = nullptr;
+    pins[pin].isrArg = nullptr;
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_intr_type(gpio_num_t pin, gpio_int_type_t type)
+{
+    if (!validPin(pin)) return ESP_ERR_INVALID_ARG;
+    pins[pin].intrType = type;
+    return ESP_OK;
+}
+
+esp_err_t gpio_intr_enable(gpio_num_t pin)
+{
+    if (!validPin(pin)) return ESP_ERR_INVALID_ARG;
+    pins[pin].intrEnabled = true;
+
+    // A level interrupt whose level is already present fires at once
+    Pin& p = pins[pin];
+    if (p.isr && ((p.intrType == GPIO_INTR_LOW_LEVEL && !p.level) ||
+                  (p.intrType == GPIO_INTR_HIGH_LEVEL && p.level))) {
+        p.isr(p.isrArg);
+    }
+    return ESP_OK;
+}
+
+esp_err_t gpio_intr_disable(gpio_num_t pin)
+{
+    if (!validPin(pin)) return ESP_ERR_INVALID_ARG;
+    pins[pin].intrEnabled = false;
+    return ESP_OK;
+}
+
+
+/*
+ * =============================================================================
+ * FreeRTOS: tasks, notifications, time
+ * =============================================================================
+ */
+
+BaseType_t xTaskCreate(TaskFunction_t, const char*, uint32_t, void*, UBaseType_t, TaskHandle_t* handle)
+{
+    if (handle) *handle = nullptr;
+    return pdFAIL;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack, void* arg,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t)
+{
+    return xTaskCreate(fn, name, stack, arg, priority, handle);
+}
+
+void vTaskDelete(TaskHandle_t) {}
+
+void vTaskSuspend(TaskHandle_t) {}
+
+void vTaskDelay(TickType_t ticks) { mock::advanceUs((int64_t)ticks * portTICK_PERIOD_MS * 1000); }
+
+void vTaskDelayUntil(TickType_t* previousWake, TickType_t period)
+{
+    xTaskDelayUntil(previousWake, period);
+}
+
+BaseType_t xTaskDelayUntil(TickType_t* previousWake, TickType_t period)
+{
+    TickType_t wake = *previousWake + period;
+    TickType_t now = xTaskGetTickCount();
+    if (wake > now) vTaskDelay(wake - now);
+    *previousWake = wake;
+    return wake > now ? pdTRUE : pdFALSE;
+}
+
+TickType_t xTaskGetTickCount() { return (TickType_t)(clockUs / 1000 / portTICK_PERIOD_MS); }
+
+TaskHandle_t xTaskGetCurrentTaskHandle() { return nullptr; }
+
+BaseType_t xTaskNotifyGive(TaskHandle_t)
+{
+    taskNotifications++;
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t, BaseType_t* woken)
+{
+    taskNotifications++;
+    if (woken) *woken = pdTRUE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t timeout)
+{
+    if (!blockUntil([] { return taskNotifications > 0; }, timeout)) return 0;
+    uint32_t value = taskNotifications;
+    taskNotifications = clearOnExit ? 0 : value - 1;
+    return value;
+}
+
+
+/*
+ * =============================================================================
+ * FreeRTOS: event groups
+ * =============================================================================
+ */
+
+struct HostEventGroup {
+    EventBits_t bits = 0;
+};
+
+EventGroupHandle_t xEventGroupCreate() { return new HostEventGroup(); }
+
+void vEventGroupDelete(EventGroupHandle_t group) { delete group; }
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits)
+{
+    group->bits |= bits;
+    return group->bits;
+}
+
+BaseType_t xEventGroupSetBitsFromISR(EventGroupHandle_t group, EventBits_t bits, BaseType_t* woken)
+{
+    group->bits |= bits;
+    if (woken) *woken = pdTRUE;
+    return pdPASS;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits)
+{
+    EventBits_t old = group->bits;
+    group->bits &= ~bits;
+    return old;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t group) { return group->bits; }
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, EventBits_t bits, BaseType_t clearOnExit,
+                                BaseType_t waitForAll, TickType_t timeout)
+{
+    auto done = [&] {
+        EventBits_t set = group->bits & bits;
+        return waitForAll ? set == bits : set != 0;
+    };
+
+    bool ok = blockUntil(done, timeout);
+    EventBits_t value = group->bits;
+    if (ok && clearOnExit) group->bits &= ~bits;
+    return value;
+}
+
+
+/*
+ * =============================================================================
+ * FreeRTOS: queues and semaphores
+ * =============================================================================
+ */
+
+struct HostQueue {
+    UBaseType_t length;
+    UBaseType_t itemSize;
+    UBaseType_t count;                      // Items (or semaphore count)
+    std::deque<std::vector<uint8_t>> items;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize)
+{
+    return new HostQueue{length, itemSize, 0, {}};
+}
+
+void vQueueDelete(QueueHandle_t queue) { delete queue; }
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t)
+{
+    if (queue->count >= queue->length) return errQUEUE_FULL;
+    const uint8_t* p = (const uint8_t*)item;
+    queue->items.emplace_back(p, p + queue->itemSize);
+    queue->count++;
+    return pdPASS;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* woken)
+{
+    if (woken) *woken = pdTRUE;
+    return xQueueSend(queue, item, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t timeout)
+{
+    if (!blockUntil([&] { return queue->count > 0; }, timeout)) return pdFAIL;
+    if (queue->itemSize) {
+        memcpy(item, queue->items.front().data(), queue->itemSize);
+        queue->items.pop_front();
+    }
+    queue->count--;
+    return pdPASS;
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue)
+{
+    queue->items.clear();
+    queue->count = 0;
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) { return queue->count; }
+
+SemaphoreHandle_t xSemaphoreCreateBinary() { return new HostQueue{1, 0, 0, {}}; }
+
+SemaphoreHandle_t xSemaphoreCreateMutex() { return new HostQueue{1, 0, 1, {}}; }
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max, UBaseType_t initial)
+{
+    return new HostQueue{max, 0, initial, {}};
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem) { delete sem; }
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t timeout)
+{
+    return xQueueReceive(sem, nullptr, timeout);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    if (sem->count >= sem->length) return pdFAIL;
+    sem->count++;
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t* woken)
+{
+    if (woken) *woken = pdTRUE;
+    return xSemaphoreGive(sem);
+}
+
+
+/*
+ * =============================================================================
+ * SPI master
+ * =============================================================================
+ */
+
+struct spi_device_t {
+    spi_host_device_t host;
+    spi_device_interface_config_t config;
+    std::deque<spi_transaction_t*> done;    // Queued, waiting for get_trans_result
+};
+
+namespace mock {
+namespace spi {
+
+const spi_device_interface_config_t* deviceConfig(spi_device_handle_t device)
+{
+    return device ? &device->config : nullptr;
+}
+
+}   // namespace spi
+}   // namespace mock
+
+namespace {
+
+void runTransfer(spi_device_handle_t dev, spi_transaction_t* trans, bool queued)
+{
+    if (dev->config.pre_cb) dev->config.pre_cb(trans);
+
+    mock::spi::Transfer t;
+    t.device = dev;
+    t.queued = queued;
+    t.gpioLevels = outputLevels();
+
+    size_t txBytes = (trans->length + 7) / 8;
+    const uint8_t* tx = (trans->flags & SPI_TRANS_USE_TXDATA) ? trans->tx_data
+                                                               : (const uint8_t*)trans->tx_buffer;
+    if (tx) t.data.assign(tx, tx + txBytes);
+    spiLog.push_back(std::move(t));
+
+    size_t rxBits = trans->rxlength ? trans->rxlength : trans->length;
+    uint8_t* rx = (trans->flags & SPI_TRANS_USE_RXDATA) ? trans->rx_data : (uint8_t*)trans->rx_buffer;
+    if (rx) {
+        for (size_t i = 0; i < (rxBits + 7) / 8; i++) {
+            rx[i] = spiReadData.empty() ? 0 : spiReadData.front();
+            if (!spiReadData.empty()) spiReadData.pop_front();
+        }
+    }
+
+    if (dev->config.post_cb) dev->config.post_cb(trans);
+}
+
+}   // namespace
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t*, int)
+{
+    if (spiBusUsed[host]) return ESP_ERR_INVALID_STATE;
+    spiBusUsed[host] = true;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_free(spi_host_device_t host)
+{
+    spiBusUsed[host] = false;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t* config,
+                             spi_device_handle_t* handle)
+{
+    *handle = new spi_device_t{host, *config, {}};
+    spiLastDevice = *handle;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle)
+{
+    if (spiLastDevice == handle) spiLastDevice = nullptr;
+    delete handle;
+    return ESP_OK;
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t* trans)
+{
+    runTransfer(handle, trans, false);
+    return ESP_OK;
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t* trans)
+{
+    runTransfer(handle, trans, false);
+    return ESP_OK;
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t* trans, TickType_t)
+{
+    if (handle->done.size() >= (size_t)handle->config.queue_size) return ESP_ERR_TIMEOUT;
+    runTransfer(handle, trans, true);
+    handle->done.push_back(trans);
+    return ESP_OK;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t** trans,
+                                      TickType_t timeout)
+{
+    if (!blockUntil([&] { return !handle->done.empty(); }, timeout)) return ESP_ERR_TIMEOUT;
+    *trans = handle->done.front();
+    handle->done.pop_front();
+    return ESP_OK;
+}
+
+esp_err_t spi_device_acquire_bus(spi_device_handle_t, TickType_t) { return ESP_OK; }
+
+void spi_device_release_bus(spi_device_handle_t) {}
+
+
+/*
+ * =============================================================================
+ * I2C master
+ * =============================================================================
+ */
+
+struct i2c_master_bus_t {
+    i2c_port_t port;
+};
+
+struct i2c_master_dev_t {
+    i2c_master_bus_handle_t bus;
+    i2c_device_config_t config;
+};
+
+namespace {
+
+esp_err_t runI2c(i2c_master_dev_handle_t dev, bool read, const uint8_t* data, size_t size)
+{
+    if (!dev || size == 0) return ESP_ERR_INVALID_ARG;
+
+    mock::i2c::Transfer t;
+    t.bus = dev->bus;
+    t.address = dev->config.device_address;
+    t.read = read;
+    t.sclHz = dev->config.scl_speed_hz ? dev->config.scl_speed_hz : 100000;
+    t.startUs = clockUs;
+    t.data.assign(data, data + size);
+
+    // Blocks for the wire time (rounded up to whole microseconds)
+    mock::advanceUs(((int64_t)t.clocks() * 1000000 + t.sclHz - 1) / t.sclHz);
+    i2cLog.push_back(std::move(t));
+    return ESP_OK;
+}
+
+}   // namespace
+
+esp_err_t i2c_new_master_bus(const i2c_master_bus_config_t* config, i2c_master_bus_handle_t* bus)
+{
+    if (config->i2c_port < 0 || config->i2c_port >= I2C_NUM_MAX) return ESP_ERR_INVALID_ARG;
+    if (i2cPortUsed[config->i2c_port]) return ESP_ERR_INVALID_STATE;
+    i2cPortUsed[config->i2c_port] = true;
+    *bus = new i2c_master_bus_t{config->i2c_port};
+    return ESP_OK;
+}
+
+esp_err_t i2c_del_master_bus(i2c_master_bus_handle_t bus)
+{
+    i2cPortUsed[bus->port] = false;
+    delete bus;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t bus, const i2c_device_config_t* config,
+                                    i2c_master_dev_handle_t* device)
+{
+    if (!bus) return ESP_ERR_INVALID_ARG;
+    *device = new i2c_master_dev_t{bus, *config};
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_rm_device(i2c_master_dev_handle_t device)
+{
+    delete device;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_transmit(i2c_master_dev_handle_t device, const uint8_t* data, size_t size, int)
+{
+    return runI2c(device, false, data, size);
+}
+
+esp_err_t i2c_master_receive(i2c_master_dev_handle_t device, uint8_t* data, size_t size, int)
+{
+    for (size_t i = 0; i < size; i++) {
+        data[i] = i2cReadData.empty() ? 0xFF : i2cReadData.front();
+        if (!i2cReadData.empty()) i2cReadData.pop_front();
+    }
+    return runI2c(device, true, data, size);
+}
+
+esp_err_t i2c_master_transmit_receive(i2c_master_dev_handle_t device, const uint8_t* write, size_t writeSize,
+                                      uint8_t* read, size_t readSize, int timeoutMs)
+{
+    esp_err_t err = i2c_master_transmit(device, write, writeSize, timeoutMs);
+    return err == ESP_OK ? i2c_master_receive(device, read, readSize, timeoutMs) : err;
+}
+
+
+/*
+ * =============================================================================
+ * RMT
+ * =============================================================================
+ */
+
+struct rmt_channel_t {
+    rmt_tx_done_callback_t onDone = nullptr;
+    void* arg = nullptr;
+    bool enabled = false;
+};
+
+namespace {
+
+esp_err_t plainEncoderReset(rmt_encoder_t*) { return ESP_OK; }
+
+esp_err_t plainEncoderDelete(rmt_encoder_t* encoder)
+{
+    delete encoder;
+    return ESP_OK;
+}
+
+rmt_encoder_t* newPlainEncoder()
+{
+    rmt_encoder_t* e = new rmt_encoder_t();
+    e->reset = plainEncoderReset;
+    e->del = plainEncoderDelete;
+    return e;
+}
+
+}   // namespace
+
+esp_err_t rmt_new_tx_channel(const rmt_tx_channel_config_t*, rmt_channel_handle_t* channel)
+{
+    *channel = new rmt_channel_t();
+    return ESP_OK;
+}
+
+esp_err_t rmt_del_channel(rmt_channel_handle_t channel)
+{
+    delete channel;
+    return ESP_OK;
+}
+
+esp_err_t rmt_enable(rmt_channel_handle_t channel)
+{
+    channel->enabled = true;
+    return ESP_OK;
+}
+
+esp_err_t rmt_disable(rmt_channel_handle_t channel)
+{
+    channel->enabled = false;
+    return ESP_OK;
+}
+
+esp_err_t rmt_tx_register_event_callbacks(rmt_channel_handle_t channel,
+                                          const rmt_tx_event_callbacks_t* callbacks, void* arg)
+{
+    if (channel->enabled) return ESP_ERR_INVALID_STATE;
+    channel->onDone = callbacks->on_trans_done;
+    channel->arg = arg;
+    return ESP_OK;
+}
+
+esp_err_t rmt_transmit(rmt_channel_handle_t channel, rmt_encoder_handle_t, const void* data,
+                       size_t size, const rmt_transmit_config_t*)
+{
+    if (!channel->enabled) return ESP_ERR_INVALID_STATE;
+    const uint8_t* p = (const uint8_t*)data;
+    rmtLog.emplace_back(p, p + size);
+
+    if (channel->onDone) {
+        rmt_tx_done_event_data_t event = {size * 8};
+        channel->onDone(channel, &event, channel->arg);
+    }
+    return ESP_OK;
+}
+
+esp_err_t rmt_tx_wait_all_done(rmt_channel_handle_t, int) { return ESP_OK; }
+
+esp_err_t rmt_new_bytes_encoder(const rmt_bytes_encoder_config_t*, rmt_encoder_handle_t* encoder)
+{
+    *encoder = newPlainEncoder();
+    return ESP_OK;
+}
+
+esp_err_t rmt_new_copy_encoder(const rmt_copy_encoder_config_t*, rmt_encoder_handle_t* encoder)
+{
+    *encoder = newPlainEncoder();
+    return ESP_OK;
+}
+
+esp_err_t rmt_del_encoder(rmt_encoder_handle_t encoder) { return encoder->del(encoder); }
+
+esp_err_t rmt_encoder_reset(rmt_encoder_handle_t encoder) { return encoder->reset(encoder); }
@@ -0,0 +1,199 @@
+/**
+ * @file idf_mock.h
+ * @brief Test-side controls of the host ESP-IDF stand-ins (../idf).
+ *
+ * @details
+ * The host build runs the real component sources against small fakes of
+ * the IDF drivers. Everything is single-threaded and deterministic:
+ *
+ * - CLOCK: esp_timer_get_time() and xTaskGetTickCount() read a mock
+ *   clock. It only moves when the code under test blocks (vTaskDelay(),
+ *   xEventGroupWaitBits(), ...) or when the test calls advanceUs().
+ *
+ * - GPIO: outputs are recorded. Inputs are set by the test, at once or
+ *   at a time on the mock clock; an edge runs the pin's ISR handler if
+ *   its interrupt is enabled and the edge matches the interrupt type.
+ *
+ * - SPI: every transfer is logged with its bytes and the GPIO output
+ *   levels when it started (so a display's DC line can be read back).
+ *   Transfers finish at once; queued ones run post_cb immediately and
+ *   wait in a FIFO for spi_device_get_trans_result().
+ *
+ * - I2C: every transmit/receive is logged with the device address and
+ *   bytes, and moves the clock by its wire time at the device's SCL
+ *   rate. Reads return bytes the test queued.
+ *
+ * - RMT: rmt_transmit() logs the raw bytes and calls on_trans_done.
+ *
+ * - Heap: heap_caps_*() is malloc(); a test can make it fail.
+ *
+ * - Tasks are never started (xTaskCreate() fails).
+ *
+ * A blocking wait with portMAX_DELAY and nothing scheduled that could
+ * end it would hang on hardware; here it returns and counts a deadlock
+ * (mock::deadlocks()), so a test can assert there were none.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <vector>
+#include <driver/gpio.h>
+#include <driver/i2c_master.h>
+#include <driver/spi_master.h>
+
+
+namespace mock {
+
+/**
+ * @brief Reset clock, GPIO, logs and counters (between test cases).
+ */
+void reset();
+
+
+/* ─── Clock ─────────────────────────────────────────────────────────────── */
+
+int64_t nowUs();
+
+/**
+ * @brief Move the clock forward, firing scheduled GPIO events on the way.
+ */
+void advanceUs(int64_t us);
+
+/**
+ * @brief Blocking waits that could never end (see file header).
+ */
+uint32_t deadlocks();
+
+
+/* ─── GPIO ──────────────────────────────────────────────────────────────── */
+
+namespace gpio {
+
+/**
+ * @brief Current level of a pin (last output written or input set).
+ */
+int level(gpio_num_t pin);
+
+/**
+ * @brief Drive an input now (runs the ISR on a matching edge).
+ */
+void setInput(gpio_num_t pin, int level);
+
+/**
+ * @brief Drive an input after delayUs of mock time.
+ */
+void scheduleInput(gpio_num_t pin, int level, int64_t delayUs);
+
+/**
+ * @brief Called whenever the code under test writes an output.
+ */
+void onOutput(std::function<void(gpio_num_t pin, int level)> hook);
+
+/**
+ * @brief True if the pin has an ISR handler installed and enabled.
+ */
+bool interruptEnabled(gpio_num_t pin);
+
+}   // namespace gpio
+
+
+/* ─── SPI ───────────────────────────────────────────────────────────────── */
+
+namespace spi {
+
+struct Transfer {
+    spi_device_handle_t device;
+    bool queued;                    ///< spi_device_queue_trans() (else polling/blocking)
+    uint64_t gpioLevels;            ///< Output levels when it started, bit n = GPIO n
+    std::vector<uint8_t> data;      ///< Bytes sent
+
+    int level(gpio_num_t pin) const { return (gpioLevels >> pin) & 1; }
+};
+
+/**
+ * @brief Every transfer since the last reset()/clearLog().
+ */
+const std::vector<Transfer>& log();
+
+void clearLog();
+
+/**
+ * @brief Clock and config of a device (for wire-time estimates).
+ */
+const spi_device_interface_config_t* deviceConfig(spi_device_handle_t device);
+
+/**
+ * @brief Handle of the most recently added device.
+ */
+spi_device_handle_t lastDevice();
+
+/**
+ * @brief Bytes returned for a read (rx_buffer/rx_data) of the next transfers.
+ */
+void setReadData(const std::vector<uint8_t>& bytes);
+
+}   // namespace spi
+
+
+/* ─── I2C ───────────────────────────────────────────────────────────────── */
+
+namespace i2c {
+
+struct Transfer {
+    i2c_master_bus_handle_t bus;
+    uint16_t address;               ///< 7-bit device address
+    bool read;                      ///< i2c_master_receive() (else transmit)
+    uint32_t sclHz;                 ///< Device clock
+    int64_t startUs;                ///< Mock clock when it started
+    std::vector<uint8_t> data;      ///< Bytes written (or returned by a read)
+
+    /**
+     * @brief Clocks on the wire: 9 per byte with the address byte, plus
+     *        start and stop.
+     */
+    uint32_t clocks() const { return 9 * (1 + (uint32_t)data.size()) + 2; }
+};
+
+/**
+ * @brief Every transfer since the last reset()/clearLog().
+ */
+const std::vector<Transfer>& log();
+
+void clearLog();
+
+/**
+ * @brief Bytes returned by the next reads (0xFF when empty).
+ */
+void setReadData(const std::vector<uint8_t>& bytes);
+
+}   // namespace i2c
+
+
+/* ─── Heap ──────────────────────────────────────────────────────────────── */
+
+namespace heap {
+
+/**
+ * @brief Make heap_caps_malloc()/calloc()/realloc() return nullptr (or not).
+ */
+void failAllocations(bool fail);
+
+}   // namespace heap
+
+
+/* ─── RMT ───────────────────────────────────────────────────────────────── */
+
+namespace rmt {
+
+/**
+ * @brief Raw bytes of every rmt_transmit() since the last reset()/clearLog().
+ */
+const std::vector<std::vector<uint8_t>>& log();
+
+void clearLog();
+
+}   // namespace rmt
+
+}   // namespace mock
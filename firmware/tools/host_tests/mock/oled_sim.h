@@ -0,0 +1,159 @@
+/**
+ * @file oled_sim.h
+ * @brief Replays recorded I2C transfers into an SSD1306's display RAM.
+ *
+ * @details
+ * Each transfer starts with a control byte: 0x00 = commands follow,
+ * 0x40 = display data follows. Column (0x21) and page (0x22) address
+ * commands set the window; data fills it page by page in horizontal
+ * addressing mode, wrapping like the controller. Other commands and
+ * their parameters are counted and skipped (parameters may come in
+ * later transfers, as the driver's init sequence sends them).
+ *
+ * Panels behind a PCA9548A can be told apart with setMux(): a transfer
+ * only reaches this panel while the last byte written to the mux enables
+ * its channel.
+ *
+ * @code
+ *     OledSim oled;
+ *     display.init();
+ *     display.drawPixel(3, 5);
+ *     display.update();
+ *     oled.replay(mock::i2c::log());
+ *     bool on = oled.pixel(3, 5);
+ * @endcode
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include "idf_mock.h"
+
+
+class OledSim {
+
+public:
+
+    static constexpr int WIDTH = 128;
+    static constexpr int PAGES = 8;
+
+    struct Stats {
+        uint32_t transfers = 0;     ///< I2C transactions to this panel
+        uint32_t windows = 0;       ///< Column address commands
+        uint64_t bytes = 0;         ///< Payload bytes (control bytes included)
+        uint64_t dataBytes = 0;     ///< Display data bytes
+        uint64_t clocks = 0;        ///< SCL clocks, address bytes included
+        double busUs = 0;           ///< Wire time at each transfer's SCL rate
+    };
+
+    explicit OledSim(uint16_t address = 0x3C) : address(address), ram(WIDTH * PAGES, 0) {}
+
+    /**
+     * @brief Only take transfers while the mux at muxAddress routes channel.
+     */
+    void setMux(uint16_t muxAddress, uint8_t channel) {
+        this->muxAddress = muxAddress;
+        muxChannel = channel;
+    }
+
+    /**
+     * @brief Apply the transfers logged since the last call.
+     */
+    void replay(const std::vector<mock::i2c::Transfer>& log) {
+        for (; replayed < log.size(); replayed++) {
+            const mock::i2c::Transfer& t = log[replayed];
+            if (muxAddress && t.address == muxAddress && !t.read && !t.data.empty()) {
+                muxRegister = t.data.back();
+                continue;
+            }
+            if (t.address != address || t.read || t.data.empty()) continue;
+            if (muxAddress && !(muxRegister & (1 << muxChannel))) continue;
+            apply(t);
+        }
+    }
+
+    /**
+     * @brief Zero the counters (RAM and window are kept).
+     */
+    void resetStats() { counters = Stats(); }
+
+    bool pixel(int x, int y) const { return ram[(y / 8) * WIDTH + x] & (1 << (y % 8)); }
+
+    const std::vector<uint8_t>& memory() const { return ram; }
+
+    const Stats& stats() const { return counters; }
+
+private:
+
+    uint16_t address;
+    uint16_t muxAddress = 0;
+    uint8_t muxChannel = 0;
+    uint8_t muxRegister = 0;
+    std::vector<uint8_t> ram;
+    Stats counters;
+    size_t replayed = 0;
+
+    uint8_t command = 0;
+    int paramsLeft = 0;
+    std::vector<uint8_t> params;
+    int col0 = 0, col1 = WIDTH - 1, page0 = 0, page1 = PAGES - 1;
+    int col = 0, page = 0;
+
+    void apply(const mock::i2c::Transfer& t) {
+        counters.transfers++;
+        counters.bytes += t.data.size();
+        counters.clocks += t.clocks();
+        counters.busUs += t.clocks() * 1e6 / t.sclHz;
+
+        bool isData = t.data[0] == 0x40;
+        for (size_t i = 1; i < t.data.size(); i++) {
+            if (isData) writeData(t.data[i]);
+            else commandByte(t.data[i]);
+        }
+    }
+
+    void commandByte(uint8_t b) {
+        if (paramsLeft > 0) {
+            params.push_back(b);
+            if (--paramsLeft == 0) finishCommand();
+            return;
+        }
+
+        command = b;
+        params.clear();
+        switch (b) {
+            case 0x21: case 0x22:
+                paramsLeft = 2;
+                break;
+            case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+            case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+                paramsLeft = 1;
+                break;
+            default:
+                paramsLeft = 0;
+                break;
+        }
+    }
+
+    void finishCommand() {
+        if (command == 0x21) {
+            counters.windows++;
+            col0 = col = params[0] & 0x7F;
+            col1 = params[1] & 0x7F;
+        }
+        if (command == 0x22) {
+            page0 = page = params[0] & 0x07;
+            page1 = params[1] & 0x07;
+        }
+    }
+
+    void writeData(uint8_t b) {
+        counters.dataBytes++;
+        ram[page * WIDTH + col] = b;
+        if (++col > col1) {
+            col = col0;
+            if (++page > page1) page = page0;
+        }
+    }
+};
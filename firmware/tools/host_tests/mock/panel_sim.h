@@ -0,0 +1,162 @@
+/**
+ * @file panel_sim.h
+ * @brief Replays recorded SPI transfers into an RGB565 controller's RAM.
+ *
+ * @details
+ * Understands what Rgb565Display sends: a command byte with DC low,
+ * then parameters/pixels with DC high. Column/row range commands set the
+ * window, the write command streams big-endian RGB565 into it (wrapping
+ * at the window edge like the controller). Other commands are counted
+ * and ignored.
+ *
+ * Addresses are used as sent (offsets included, no MADCTL mapping), so
+ * two runs are comparable whenever they use the same rotation. RAM is a
+ * square of the longest side so every rotation fits.
+ *
+ * @code
+ *     PanelSim<ILI9341Panel> panel(GPIO_NUM_16);
+ *     display.init();
+ *     panel.replay(mock::spi::log());     // Window state from init
+ *     display.fillRect(...);
+ *     panel.resetStats();
+ *     panel.replay(mock::spi::log());     // Only the new transfers
+ *     uint16_t c = panel.pixel(10, 20);
+ * @endcode
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include "idf_mock.h"
+
+
+template <typename Panel>
+class PanelSim {
+
+public:
+
+    static constexpr uint16_t SIDE = Panel::WIDTH > Panel::HEIGHT ? Panel::WIDTH : Panel::HEIGHT;
+
+    struct Stats {
+        uint32_t transfers = 0;     ///< SPI transactions of any kind
+        uint32_t queued = 0;        ///< ... of which went through the DMA queue
+        uint32_t commands = 0;      ///< Command bytes (DC low)
+        uint32_t windows = 0;       ///< Column/row range commands
+        uint64_t bytes = 0;         ///< All bytes on the wire
+        uint64_t pixelBytes = 0;    ///< Bytes after a write command
+    };
+
+    explicit PanelSim(gpio_num_t dcPin, uint16_t fill = 0)
+        : dcPin(dcPin),
+          ram((size_t)SIDE * SIDE, fill)
+    {
+    }
+
+    /**
+     * @brief Apply the transfers logged since the last call (optionally
+     *        only those of one device).
+     *
+     * Keep calling it on the same, never cleared log: the window the
+     * driver programmed earlier (and now skips thanks to its cache)
+     * stays known.
+     */
+    void replay(const std::vector<mock::spi::Transfer>& log, spi_device_handle_t device = nullptr) {
+        for (; replayed < log.size(); replayed++) {
+            if (device && log[replayed].device != device) continue;
+            apply(log[replayed]);
+        }
+    }
+
+    /**
+     * @brief Zero the counters (RAM and window are kept).
+     */
+    void resetStats() { counters = Stats(); }
+
+    uint16_t pixel(int x, int y) const { return ram[(size_t)y * SIDE + x]; }
+
+    const std::vector<uint16_t>& pixels() const { return ram; }
+
+    const Stats& stats() const { return counters; }
+
+    /**
+     * @brief Pixels that differ from another simulation (0 = identical).
+     */
+    size_t diff(const PanelSim& other) const {
+        size_t n = 0;
+        for (size_t i = 0; i < ram.size(); i++) n += ram[i] != other.ram[i];
+        return n;
+    }
+
+    /**
+     * @brief Estimated wire time in microseconds at the panel's SPI clock.
+     */
+    double wireUs() const {
+        return counters.bytes * 8.0 * 1e6 / Panel::SPI_CLOCK_HZ;
+    }
+
+private:
+
+    gpio_num_t dcPin;
+    std::vector<uint16_t> ram;
+    Stats counters;
+    size_t replayed = 0;            // Log entries already applied
+
+    uint8_t command = 0;
+    std::vector<uint8_t> params;
+    int x0 = 0, x1 = SIDE - 1, y0 = 0, y1 = SIDE - 1;
+    int cx = 0, cy = 0;
+    bool haveHigh = false;          // First byte of a pixel seen
+    uint8_t high = 0;
+
+    void apply(const mock::spi::Transfer& t) {
+        counters.transfers++;
+        counters.queued += t.queued;
+        counters.bytes += t.data.size();
+
+        if (!t.level(dcPin)) {
+            for (uint8_t b : t.data) startCommand(b);
+            return;
+        }
+        for (uint8_t b : t.data) data(b);
+    }
+
+    void startCommand(uint8_t cmd) {
+        counters.commands++;
+        command = cmd;
+        params.clear();
+        if (cmd == Panel::CMD_COLUMN || cmd == Panel::CMD_ROW) counters.windows++;
+        if (cmd == Panel::CMD_WRITE) {
+            cx = x0;
+            cy = y0;
+            haveHigh = false;
+        }
+    }
+
+    void data(uint8_t b) {
+        if (command == Panel::CMD_WRITE) {
+            counters.pixelBytes++;
+            if (!haveHigh) {
+                high = b;
+                haveHigh = true;
+                return;
+            }
+            haveHigh = false;
+            if (cy <= y1 && cx < SIDE && cy < SIDE) ram[(size_t)cy * SIDE + cx] = (uint16_t)(high << 8 | b);
+            if (++cx > x1) {
+                cx = x0;
+                cy++;
+            }
+            return;
+        }
+
+        params.push_back(b);
+        size_t need = Panel::WINDOW_16BIT ? 4 : 2;
+        if (params.size() != need) return;
+
+        int a = Panel::WINDOW_16BIT ? (params[0] << 8 | params[1]) : params[0];
+        int z = Panel::WINDOW_16BIT ? (params[2] << 8 | params[3]) : params[1];
+        if (command == Panel::CMD_COLUMN) { x0 = a; x1 = z; }
+        if (command == Panel::CMD_ROW) { y0 = a; y1 = z; }
+    }
+};
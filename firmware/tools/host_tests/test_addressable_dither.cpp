@@ -0,0 +1,155 @@
+/**
+ * @file test_addressable_dither.cpp
+ * @brief AddressableLED 16-bit pixels: dithering, pausing it, and its cost.
+ *
+ * Frames are read back from the bytes the RMT backend sends. With gamma
+ * off and full brightness the 16-bit level of a channel is exactly its
+ * 8.8 input, so the dithered average can be checked against it.
+ */
+
+#include "host_test.h"
+#include "mock/idf_mock.h"
+#include "../../components/addressable/addressable_led.h"
+#include "../../devices/modules/smart-light/smart_light_device.h"
+
+#include <stdlib.h>
+#include <vector>
+
+
+namespace {
+
+constexpr gpio_num_t PIN = GPIO_NUM_4;
+
+const std::vector<uint8_t>& lastFrame()
+{
+    return mock::rmt::log().back();
+}
+
+}   // namespace
+
+
+TEST_CASE(dithered_average_matches_16bit_level)
+{
+    const uint16_t levels[] = { 0x0040, 0x0140, 0x0180, 0x1234, 0x7F01, 0xFE80, 0xFF00 };
+
+    AddressableLED strip(PIN, 3, LedType::WS2812B, ColorOrder::RGB);
+    strip.setGammaCorrection(false);
+    strip.setDithering(true);
+    CHECK(strip.init());
+
+    for (uint16_t level : levels) {
+        strip.fill16(level, level / 2, 0);
+
+        // Sum over 256 frames = 256 × level, off by less than one carry
+        long sum[3] = {};
+        for (int f = 0; f < 256; f++) {
+            strip.show();
+            for (int c = 0; c < 3; c++) sum[c] += lastFrame()[c];
+            mock::rmt::clearLog();
+        }
+        CHECK(labs(sum[0] * 256 - 256L * level) < 256);
+        CHECK(labs(sum[1] * 256 - 256L * (level / 2)) < 256);
+        CHECK_EQ(sum[2], 0);
+    }
+}
+
+
+TEST_CASE(paused_dithering_repeats_the_frame)
+{
+    AddressableLED strip(PIN, 4, LedType::SK6812_RGBW);
+    strip.setGammaCorrection(false);
+    strip.setDithering(true);
+    CHECK(strip.init());
+    strip.setDithering(false);
+    CHECK(!strip.getDithering());
+
+    // 1.25, 2.5, 3.75, 0.5: rounded to the nearest level every frame
+    strip.fill16(0x0140, 0x0280, 0x03C0, 0x0080);
+    strip.show();
+    std::vector<uint8_t> first = lastFrame();
+    CHECK((first == std::vector<uint8_t>{3, 1, 4, 1, 3, 1, 4, 1, 3, 1, 4, 1, 3, 1, 4, 1}));
+    for (int f = 0; f < 10; f++) {
+        strip.show();
+        CHECK(lastFrame() == first);
+    }
+
+    // Resumed: the carry makes frames differ again
+    strip.setDithering(true);
+    int changed = 0;
+    for (int f = 0; f < 10; f++) {
+        strip.show();
+        if (lastFrame() != first) changed++;
+    }
+    CHECK(changed > 0);
+}
+
+
+TEST_CASE(fill16_without_dithering_rounds)
+{
+    AddressableLED strip(PIN, 2, LedType::WS2812B, ColorOrder::RGB);
+    strip.setGammaCorrection(false);
+    CHECK(strip.init());
+    CHECK(!strip.getDithering());
+
+    strip.setDithering(false);                  // Nothing to pause: ignored
+    strip.fill16(0x017F, 0x0180, 0xFFFF);
+    strip.show();
+    CHECK((lastFrame() == std::vector<uint8_t>{1, 2, 255, 1, 2, 255}));
+}
+
+
+TEST_CASE(smart_light_static_color_is_stable)
+{
+    SmartLightDevice light(PIN, 8);
+    CHECK(light.init());
+    light.setOn(true);
+    light.setHue(0);
+    light.setWhite(0);
+
+    // GRBW: red is byte 1 of each LED
+    int previous = -1;
+    for (uint8_t pct = 0; pct <= 100; pct++) {
+        light.setBrightness(pct);
+        light.update();
+        std::vector<uint8_t> first = lastFrame();
+        for (int i = 0; i < 5; i++) {
+            light.update();
+            CHECK(lastFrame() == first);
+        }
+        CHECK((int)first[1] >= previous);
+        previous = first[1];
+    }
+    CHECK_EQ(previous, 255);
+
+    light.setBrightness(0);
+    light.update();
+    CHECK_EQ(lastFrame()[1], 0);
+}
+
+
+TEST_CASE(dither_speed)
+{
+    const uint16_t numLeds = 300;
+    const int loops = 500;
+    double us[2];
+
+    for (int dither = 0; dither < 2; dither++) {
+        mock::reset();
+        AddressableLED strip(PIN, numLeds, LedType::SK6812_RGBW);
+        strip.setDithering(dither);
+        CHECK(strip.init());
+        strip.fill16(0x0140, 0x2A80, 0x0010, 0x00C0);
+
+        double start = host_test::hostUs();
+        for (int i = 0; i < loops; i++) {
+            strip.show();
+            mock::rmt::clearLog();
+        }
+        us[dither] = (host_test::hostUs() - start) / loops;
+        CHECK_EQ(strip.getStats().frames, (uint32_t)loops);
+    }
+
+    METRIC("300 RGBW LED show(), 8-bit (host)", numLeds / us[0], "Mpixel/s");
+    METRIC("300 RGBW LED show(), dithered (host)", numLeds / us[1], "Mpixel/s");
+    METRIC("dithering cost per frame (host)", us[1] - us[0], "us");
+}
@@ -0,0 +1,247 @@
+/**
+ * @file test_addressable_pixels.cpp
+ * @brief AddressableLED pixel writes vs the per-pixel reference, and their speed.
+ *
+ * The reference is the write path as it was before the fused table:
+ * gamma lookup, multiply and divide by 255 for every channel of every
+ * pixel, then a per-pixel switch on the color order. Frames are read back
+ * from the bytes the RMT backend sends.
+ */
+
+#include "host_test.h"
+#include "mock/idf_mock.h"
+#include "../../components/addressable/addressable_led.h"
+
+#include <string.h>
+#include <vector>
+
+
+namespace {
+
+constexpr gpio_num_t PIN = GPIO_NUM_4;
+
+uint32_t lcg = 1;
+
+uint8_t nextByte()
+{
+    lcg = lcg * 1103515245u + 12345u;
+    return (uint8_t)(lcg >> 23);
+}
+
+
+struct Layout {
+    LedType type;
+    ColorOrder order;
+    const char* channels;       // Byte order on the wire: R G B W, X = warm, Y = cool
+};
+
+const Layout LAYOUTS[] = {
+    { LedType::WS2812B,      ColorOrder::GRB,   "GRB"   },
+    { LedType::WS2812B,      ColorOrder::RGB,   "RGB"   },
+    { LedType::WS2812B,      ColorOrder::BGR,   "BGR"   },
+    { LedType::WS2812B,      ColorOrder::BRG,   "BRG"   },
+    { LedType::WS2812B,      ColorOrder::RBG,   "RBG"   },
+    { LedType::WS2812B,      ColorOrder::GBR,   "GBR"   },
+    { LedType::SK6812_RGBW,  ColorOrder::GRBW,  "GRBW"  },
+    { LedType::SK6812_RGBW,  ColorOrder::RGBW,  "RGBW"  },
+    { LedType::SK6812_RGBW,  ColorOrder::BGRW,  "BGRW"  },
+    { LedType::SK6812_RGBW,  ColorOrder::WGRB,  "WGRB"  },
+    { LedType::SK6812_RGBWW, ColorOrder::GRBWW, "GRBXY" },
+    { LedType::SK6812_RGBWW, ColorOrder::RGBWW, "RGBXY" },
+};
+
+
+/**
+ * @brief The strip's gamma curve, read back at full brightness.
+ */
+std::vector<uint8_t> gammaCurve()
+{
+    AddressableLED strip(PIN, 256, LedType::WS2812B, ColorOrder::RGB);
+    CHECK(strip.init());
+    for (int v = 0; v < 256; v++) strip.setPixel(v, v, 0, 0);
+    strip.show();
+
+    std::vector<uint8_t> curve(256);
+    for (int v = 0; v < 256; v++) curve[v] = mock::rmt::log().back()[v * 3];
+    mock::rmt::clearLog();
+    return curve;
+}
+
+
+/**
+ * @brief Back buffer written one pixel at a time, corrections per channel.
+ */
+struct Reference {
+    const Layout& layout;
+    const std::vector<uint8_t>& gamma;
+    uint16_t numLeds;
+    size_t bytesPerLed;
+    bool gammaEnabled = true;
+    uint8_t brightness = 255;
+    std::vector<uint8_t> buffer;
+
+    Reference(const Layout& l, const std::vector<uint8_t>& g, uint16_t n)
+        : layout(l), gamma(g), numLeds(n), bytesPerLed(strlen(l.channels)), buffer(n * bytesPerLed) {}
+
+    uint8_t applyCorrections(uint8_t value) const {
+        uint8_t corrected = gammaEnabled ? gamma[value] : value;
+        return (uint8_t)(((uint16_t)corrected * brightness) / 255);
+    }
+
+    void writeToBuffer(uint16_t index, uint8_t r, uint8_t g, uint8_t b, uint8_t w, uint8_t ww, uint8_t cw) {
+        if (index >= numLeds) return;
+        uint8_t* out = &buffer[index * bytesPerLed];
+        for (size_t i = 0; i < bytesPerLed; i++) {
+            switch (layout.channels[i]) {
+                case 'R': out[i] = applyCorrections(r); break;
+                case 'G': out[i] = applyCorrections(g); break;
+                case 'B': out[i] = applyCorrections(b); break;
+                case 'W': out[i] = applyCorrections(w); break;
+                case 'X': out[i] = applyCorrections(ww); break;
+                case 'Y': out[i] = applyCorrections(cw); break;
+            }
+        }
+    }
+};
+
+
+/**
+ * @brief Random setPixel()/setPixels()/fillRange() calls on both.
+ */
+void randomWrites(AddressableLED& strip, Reference& ref, int count)
+{
+    uint16_t n = ref.numLeds;
+    bool hasW = ref.layout.type == LedType::SK6812_RGBW;
+    bool hasWW = ref.layout.type == LedType::SK6812_RGBWW;
+
+    for (int i = 0; i < count; i++) {
+        uint8_t r = nextByte(), g = nextByte(), b = nextByte(), w = nextByte(), cw = nextByte();
+        uint16_t at = nextByte() % (n + 4);                 // Some off the end
+        uint16_t len = nextByte() % 40;
+
+        switch (nextByte() % 4) {
+            case 0:
+                if (hasWW) strip.setPixel(at, r, g, b, w, cw);
+                else if (hasW) strip.setPixel(at, r, g, b, w);
+                else strip.setPixel(at, r, g, b);
+                ref.writeToBuffer(at, r, g, b, hasW ? w : 0, hasWW ? w : 0, hasWW ? cw : 0);
+                break;
+
+            case 1:
+                if (hasWW) strip.fillRange(at, len, r, g, b, w, cw);
+                else if (hasW) strip.fillRange(at, len, r, g, b, w);
+                else strip.fillRange(at, len, r, g, b);
+                for (uint16_t k = 0; k < len; k++) {
+                    ref.writeToBuffer(at + k, r, g, b, hasW ? w : 0, hasWW ? w : 0, hasWW ? cw : 0);
+                }
+                break;
+
+            case 2: {
+                std::vector<RGB> pixels(len);
+                for (RGB& p : pixels) p = { nextByte(), nextByte(), nextByte() };
+                strip.setPixels(pixels.data(), len, at);
+                for (uint16_t k = 0; k < len; k++) {
+                    ref.writeToBuffer(at + k, pixels[k].r, pixels[k].g, pixels[k].b, 0, 0, 0);
+                }
+                break;
+            }
+
+            case 3: {
+                std::vector<RGBW> pixels(len);
+                for (RGBW& p : pixels) p = { nextByte(), nextByte(), nextByte(), nextByte() };
+                strip.setPixels(pixels.data(), len, at);
+                for (uint16_t k = 0; k < len; k++) {
+                    const RGBW& p = pixels[k];
+                    ref.writeToBuffer(at + k, p.r, p.g, p.b, hasW ? p.w : 0, 0, 0);
+                }
+                break;
+            }
+        }
+    }
+}
+
+}   // namespace
+
+
+TEST_CASE(bulk_writes_match_per_pixel_reference)
+{
+    std::vector<uint8_t> gamma = gammaCurve();
+    const uint8_t brightnesses[] = { 255, 200, 128, 17, 1, 0 };
+
+    for (const Layout& layout : LAYOUTS) {
+        mock::reset();
+        const uint16_t numLeds = 97;
+        AddressableLED strip(PIN, numLeds, layout.type, layout.order);
+        CHECK(strip.init());
+        Reference ref(layout, gamma, numLeds);
+
+        for (int pass = 0; pass < 12; pass++) {
+            ref.gammaEnabled = pass % 2 == 0;
+            ref.brightness = brightnesses[pass / 2];
+            strip.setGammaCorrection(ref.gammaEnabled);
+            strip.setBrightness(ref.brightness);
+
+            randomWrites(strip, ref, 60);
+            strip.show();
+
+            if (mock::rmt::log().back() != ref.buffer) {
+                printf("  order %s, gamma %d, brightness %u: frame differs\n",
+                       layout.channels, ref.gammaEnabled, ref.brightness);
+                CHECK(mock::rmt::log().back() == ref.buffer);
+            }
+        }
+    }
+}
+
+
+TEST_CASE(pixel_write_speed)
+{
+    std::vector<uint8_t> gamma = gammaCurve();
+    const uint16_t numLeds = 1000;
+    const int loops = 200;
+
+    AddressableLED strip(PIN, numLeds, LedType::WS2812B, ColorOrder::GRB);
+    CHECK(strip.init());
+    strip.setBrightness(180);
+    Reference ref(LAYOUTS[0], gamma, numLeds);
+    ref.brightness = 180;
+
+    std::vector<RGB> frame(numLeds);
+    for (RGB& p : frame) p = { nextByte(), nextByte(), nextByte() };
+
+    double start = host_test::hostUs();
+    for (int i = 0; i < loops; i++) {
+        frame[i].g++;
+        for (uint16_t k = 0; k < numLeds; k++) ref.writeToBuffer(k, frame[k].r, frame[k].g, frame[k].b, 0, 0, 0);
+    }
+    double referenceUs = (host_test::hostUs() - start) / loops;
+
+    start = host_test::hostUs();
+    for (int i = 0; i < loops; i++) {
+        frame[i].g++;
+        for (uint16_t k = 0; k < numLeds; k++) strip.setPixel(k, frame[k].r, frame[k].g, frame[k].b);
+    }
+    double setPixelUs = (host_test::hostUs() - start) / loops;
+
+    start = host_test::hostUs();
+    for (int i = 0; i < loops; i++) {
+        frame[i].g++;
+        strip.setPixels(frame.data(), numLeds);
+    }
+    double setPixelsUs = (host_test::hostUs() - start) / loops;
+
+    start = host_test::hostUs();
+    for (int i = 0; i < loops; i++) strip.fillRange(0, numLeds, i, 2 * i, 3 * i);
+    double fillUs = (host_test::hostUs() - start) / loops;
+
+    // Keep the writes observable
+    strip.show();
+    CHECK_EQ(mock::rmt::log().back().size(), (size_t)numLeds * 3);
+
+    METRIC("1000 LED per-pixel reference (host)", numLeds / referenceUs, "Mpixel/s");
+    METRIC("1000 LED setPixel() loop (host)", numLeds / setPixelUs, "Mpixel/s");
+    METRIC("1000 LED setPixels() (host)", numLeds / setPixelsUs, "Mpixel/s");
+    METRIC("1000 LED fillRange() (host)", numLeds / fillUs, "Mpixel/s");
+    CHECK(setPixelsUs < referenceUs);
+    CHECK(fillUs < referenceUs);
+}
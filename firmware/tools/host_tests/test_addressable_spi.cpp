@@ -0,0 +1,207 @@
+/**
+ * @file test_addressable_spi.cpp
+ * @brief AddressableLED SPI encoders vs bit-by-bit references.
+ *
+ * Random frames go in through writeNative() (no gamma, no brightness) and
+ * the DMA buffer show() queues is compared byte for byte with what a
+ * per-bit loop produces: 0xFC/0xE0 per LED bit for BITS_8 (the encoder as
+ * it was before the lookup tables), 110/100 packed MSB first for BITS_3.
+ * Both start with one LED of zero padding and end in zero reset bytes.
+ */
+
+#include "host_test.h"
+#include "mock/idf_mock.h"
+#include "../../components/addressable/addressable_led.h"
+
+#include <vector>
+
+
+namespace {
+
+constexpr gpio_num_t PIN = GPIO_NUM_4;
+
+uint32_t lcg = 1;
+
+uint8_t nextByte()
+{
+    lcg = lcg * 1103515245u + 12345u;
+    return (uint8_t)(lcg >> 23);
+}
+
+
+std::vector<uint8_t> randomFrame(size_t bytes)
+{
+    std::vector<uint8_t> frame(bytes);
+    for (uint8_t& b : frame) b = nextByte();
+    return frame;
+}
+
+
+/**
+ * @brief BITS_8 as it was encoded before the nibble table.
+ */
+void perBitEncode8(const std::vector<uint8_t>& frame, uint8_t bytesPerLed, std::vector<uint8_t>& out)
+{
+    size_t outIdx = bytesPerLed * 8;
+    for (uint8_t byte : frame) {
+        for (int bit = 7; bit >= 0; bit--) out[outIdx++] = (byte & (1 << bit)) ? 0xFC : 0xE0;
+    }
+}
+
+
+/**
+ * @brief BITS_3: three SPI bits per LED bit, packed MSB first.
+ */
+void perBitEncode3(const std::vector<uint8_t>& frame, uint8_t bytesPerLed, std::vector<uint8_t>& out)
+{
+    size_t outIdx = bytesPerLed * 3;
+    uint32_t acc = 0;
+    int bits = 0;
+    for (uint8_t byte : frame) {
+        for (int bit = 7; bit >= 0; bit--) {
+            acc = (acc << 3) | ((byte & (1 << bit)) ? 0x6 : 0x4);
+            bits += 3;
+            while (bits >= 8) {
+                out[outIdx++] = (uint8_t)(acc >> (bits - 8));
+                bits -= 8;
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief Bytes of the last transfer show() queued.
+ */
+const std::vector<uint8_t>& lastWire()
+{
+    return mock::spi::log().back().data;
+}
+
+
+struct Case {
+    LedType type;
+    SpiEncoding encoding;
+};
+
+const Case CASES[] = {
+    { LedType::WS2812B,      SpiEncoding::BITS_8 },
+    { LedType::SK6812_RGBW,  SpiEncoding::BITS_8 },
+    { LedType::SK6812_RGBWW, SpiEncoding::BITS_8 },
+    { LedType::WS2812B,      SpiEncoding::BITS_3 },
+};
+
+}   // namespace
+
+
+TEST_CASE(spi_output_matches_per_bit_encoders)
+{
+    const uint16_t lengths[] = { 1, 7, 60, 300 };
+
+    for (const Case& c : CASES) {
+        for (uint16_t numLeds : lengths) {
+            mock::reset();
+            AddressableLED strip(PIN, numLeds, c.type, ColorOrder::GRB, TransportBackend::SPI);
+            strip.setSpiEncoding(c.encoding);
+            CHECK(strip.init());
+
+            uint8_t bpl = strip.getBytesPerLed();
+            for (int f = 0; f < 5; f++) {
+                std::vector<uint8_t> frame = randomFrame((size_t)numLeds * bpl);
+                strip.writeNative(frame.data(), frame.size());
+                strip.show();
+
+                const std::vector<uint8_t>& wire = lastWire();
+                std::vector<uint8_t> expected(wire.size(), 0);
+                if (c.encoding == SpiEncoding::BITS_8) perBitEncode8(frame, bpl, expected);
+                else perBitEncode3(frame, bpl, expected);
+
+                if (wire != expected) {
+                    printf("  type %d, encoding %d, %u LEDs, frame %d: wire differs\n",
+                           (int)c.type, (int)c.encoding, numLeds, f);
+                    CHECK(wire == expected);
+                }
+            }
+        }
+    }
+}
+
+
+TEST_CASE(spi_every_byte_value)
+{
+    for (SpiEncoding encoding : { SpiEncoding::BITS_8, SpiEncoding::BITS_3 }) {
+        mock::reset();
+        AddressableLED strip(PIN, 256, LedType::WS2812B, ColorOrder::GRB, TransportBackend::SPI);
+        strip.setSpiEncoding(encoding);
+        CHECK(strip.init());
+
+        std::vector<uint8_t> frame(256 * 3);
+        for (size_t i = 0; i < frame.size(); i++) frame[i] = (uint8_t)(i / 3 + i % 3 * 85);
+        strip.writeNative(frame.data(), frame.size());
+        strip.show();
+
+        std::vector<uint8_t> expected(lastWire().size(), 0);
+        if (encoding == SpiEncoding::BITS_8) perBitEncode8(frame, 3, expected);
+        else perBitEncode3(frame, 3, expected);
+        CHECK(lastWire() == expected);
+    }
+}
+
+
+TEST_CASE(bits3_rejected_for_sk6812)
+{
+    for (LedType type : { LedType::SK6812_RGBW, LedType::SK6812_RGBWW }) {
+        AddressableLED strip(PIN, 10, type, ColorOrder::GRBW, TransportBackend::SPI);
+        strip.setSpiEncoding(SpiEncoding::BITS_3);
+        CHECK(!strip.init());
+        CHECK(mock::spi::log().empty());
+    }
+
+    // The RMT backend ignores the SPI encoding
+    AddressableLED rmt(PIN, 10, LedType::SK6812_RGBW, ColorOrder::GRBW, TransportBackend::RMT);
+    rmt.setSpiEncoding(SpiEncoding::BITS_3);
+    CHECK(rmt.init());
+}
+
+
+TEST_CASE(spi_encode_speed)
+{
+    const uint16_t numLeds = 300;
+    const int loops = 200;
+
+    for (SpiEncoding encoding : { SpiEncoding::BITS_8, SpiEncoding::BITS_3 }) {
+        mock::reset();
+        AddressableLED strip(PIN, numLeds, LedType::WS2812B, ColorOrder::GRB, TransportBackend::SPI);
+        strip.setSpiEncoding(encoding);
+        CHECK(strip.init());
+
+        std::vector<uint8_t> frame = randomFrame((size_t)numLeds * 3);
+        strip.writeNative(frame.data(), frame.size());
+        strip.show();
+        std::vector<uint8_t> out(lastWire().size(), 0);
+
+        double start = host_test::hostUs();
+        for (int i = 0; i < loops; i++) {
+            strip.show();
+            mock::spi::clearLog();
+        }
+        double showUs = (host_test::hostUs() - start) / loops;
+        CHECK_EQ(strip.getStats().frames, (uint32_t)loops + 1);
+
+        start = host_test::hostUs();
+        for (int i = 0; i < loops; i++) {
+            frame[i % frame.size()]++;
+            if (encoding == SpiEncoding::BITS_8) perBitEncode8(frame, 3, out);
+            else perBitEncode3(frame, 3, out);
+        }
+        double perBitUs = (host_test::hostUs() - start) / loops;
+
+        bool eight = encoding == SpiEncoding::BITS_8;
+        METRIC(eight ? "300 LED show(), BITS_8 (host)" : "300 LED show(), BITS_3 (host)", showUs, "us");
+        METRIC(eight ? "300 LED per-bit encode, BITS_8 (host)" : "300 LED per-bit encode, BITS_3 (host)",
+               perBitUs, "us");
+        METRIC(eight ? "BITS_8 encode throughput (host)" : "BITS_3 encode throughput (host)",
+               numLeds / showUs, "Mpixel/s");
+        CHECK(showUs < perBitUs);
+    }
+}
@@ -0,0 +1,222 @@
+/**
+ * @file test_arc_spans.cpp
+ * @brief fillArc()/fillArcDelta() vs the drawArcFast() they replaced.
+ *
+ * The reference is drawArcFast() as it was in smart_light_remote.cpp:
+ * two sqrtf() per row, an angle lookup per pixel and one window per run.
+ * It rounds angles to whole degrees, so the two only have to agree up to
+ * the pixels along the start and end rays. Delta drawing must leave the
+ * panel exactly as a fresh fillArc() of the new level would.
+ */
+
+#include "host_test.h"
+#include "mock/panel_sim.h"
+#include "../../components/display/gc9a01/gc9a01.h"
+#include "../../components/display/shared/arc_spans.h"
+
+#include <math.h>
+
+
+namespace {
+
+constexpr gpio_num_t DC = GPIO_NUM_16;
+constexpr int16_t CX = 120;
+constexpr int16_t CY = 120;
+constexpr int16_t INNER = 40;
+constexpr int16_t OUTER = 100;
+
+constexpr int ARC_MAX_RADIUS = OUTER + 1;
+uint8_t angleLUT[ARC_MAX_RADIUS][ARC_MAX_RADIUS];
+
+void buildAngleLUT()
+{
+    for (int dx = 0; dx < ARC_MAX_RADIUS; dx++) {
+        for (int dy = 0; dy < ARC_MAX_RADIUS; dy++) {
+            float rad = (dx == 0 && dy == 0) ? 0.0f : atan2f((float)dx, (float)dy);
+            angleLUT[dx][dy] = (uint8_t)(rad * 180.0f / (float)M_PI + 0.5f);
+        }
+    }
+}
+
+int getAngle(int dx, int dy)
+{
+    int adx = dx < 0 ? -dx : dx;
+    int ady = dy < 0 ? -dy : dy;
+    if (adx >= ARC_MAX_RADIUS) adx = ARC_MAX_RADIUS - 1;
+    if (ady >= ARC_MAX_RADIUS) ady = ARC_MAX_RADIUS - 1;
+
+    int q1angle = angleLUT[adx][ady];
+    if (dy <= 0) return dx >= 0 ? q1angle : (360 - q1angle) % 360;
+    return dx >= 0 ? 180 - q1angle : 180 + q1angle;
+}
+
+
+/**
+ * @brief drawArcFast() as it was: per-pixel angles, one window per run.
+ */
+void drawArcFast(GC9A01& disp, int16_t cx, int16_t cy, int16_t innerR, int16_t outerR,
+                 int startDeg, int endDeg, uint16_t color)
+{
+    if (outerR <= 0 || endDeg <= startDeg) return;
+    if (innerR < 0) innerR = 0;
+
+    int32_t innerSq = (int32_t)innerR * innerR;
+    int32_t outerSq = (int32_t)outerR * outerR;
+
+    for (int16_t y = cy - outerR; y <= cy + outerR; y++) {
+        if (y < 0 || y >= GC9A01_HEIGHT) continue;
+
+        int16_t dy = y - cy;
+        int32_t dySq = (int32_t)dy * dy;
+        int16_t dxOuter = (int16_t)sqrtf((float)(outerSq - dySq));
+        int16_t dxInner = (dySq < innerSq) ? (int16_t)sqrtf((float)(innerSq - dySq)) : 0;
+
+        int16_t rowXStart = cx - dxOuter < 0 ? 0 : cx - dxOuter;
+        int16_t rowXEnd = cx + dxOuter >= GC9A01_WIDTH ? GC9A01_WIDTH - 1 : cx + dxOuter;
+        int16_t rw = rowXEnd - rowXStart + 1;
+
+        uint16_t lineBuf[GC9A01_WIDTH];
+        int16_t runStart = -1;
+        for (int16_t i = 0; i <= rw; i++) {
+            bool inArc = false;
+            if (i < rw) {
+                int16_t dx = rowXStart + i - cx;
+                if ((dx < 0 ? -dx : dx) >= dxInner) {
+                    int angle = getAngle(dx, dy);
+                    inArc = endDeg <= 360 ? (angle >= startDeg && angle <= endDeg)
+                                          : (angle >= startDeg || angle <= endDeg - 360);
+                }
+            }
+
+            if (inArc) {
+                if (runStart < 0) runStart = i;
+                lineBuf[i] = color;
+            } else if (runStart >= 0) {
+                int16_t wx = rowXStart + runStart;
+                disp.beginWrite(wx, y, wx + (i - runStart) - 1, y);
+                disp.pushPixels(&lineBuf[runStart], i - runStart);
+                disp.endWrite();
+                runStart = -1;
+            }
+        }
+    }
+}
+
+
+struct Bench {
+    PanelSim<GC9A01Panel> panel{DC};
+    double cpuUs = 0;
+};
+
+/**
+ * @brief Draw on a fresh, black panel; stats cover draw() only.
+ */
+template <typename Draw>
+Bench measure(Draw draw)
+{
+    mock::reset();
+    GC9A01 tft(GPIO_NUM_23, GPIO_NUM_18, GPIO_NUM_5, DC, GPIO_NUM_17);
+    CHECK(tft.init());
+    tft.fillScreen(COLOR_BLACK);
+    tft.flush();
+
+    Bench b;
+    b.panel.replay(mock::spi::log());
+    b.panel.resetStats();
+
+    double start = host_test::hostUs();
+    draw(tft);
+    tft.flush();
+    b.cpuUs = host_test::hostUs() - start;
+
+    b.panel.replay(mock::spi::log());
+    return b;
+}
+
+
+uint32_t countColor(const PanelSim<GC9A01Panel>& panel, uint16_t color)
+{
+    uint32_t n = 0;
+    for (uint16_t px : panel.pixels()) n += px == color;
+    return n;
+}
+
+}   // namespace
+
+
+TEST_CASE(arc_matches_per_pixel_angles)
+{
+    buildAngleLUT();
+    ArcSpanTable ring;
+    CHECK(ring.init(INNER, OUTER));
+
+    const int sweeps[][2] = { {0, 30}, {0, 90}, {0, 180}, {45, 300}, {0, 359}, {270, 450} };
+    for (const auto& s : sweeps) {
+        Bench old = measure([&](GC9A01& t) { drawArcFast(t, CX, CY, INNER, OUTER, s[0], s[1], COLOR_RED); });
+        Bench now = measure([&](GC9A01& t) { t.fillArc(ring, CX, CY, s[0], s[1], COLOR_RED); });
+
+        // Both disagree only along the two rays (whole-degree rounding)
+        uint32_t area = countColor(old.panel, COLOR_RED);
+        size_t diff = now.panel.diff(old.panel);
+        if (diff * 20 > area) {
+            printf("  sweep %d..%d: %zu of %u pixels differ\n", s[0], s[1], diff, area);
+            CHECK(diff * 20 <= area);
+        }
+    }
+}
+
+
+TEST_CASE(delta_matches_full_arc)
+{
+    ArcSpanTable ring;
+    CHECK(ring.init(INNER, OUTER));
+
+    const int steps[][2] = { {0, 36}, {36, 40}, {40, 200}, {200, 197}, {197, 0}, {0, 360},
+                             {360, 355}, {355, 360}, {360, 0}, {90, 91}, {271, 180} };
+    for (const auto& s : steps) {
+        Bench delta = measure([&](GC9A01& t) {
+            t.fillArc(ring, CX, CY, 0, s[0], COLOR_RED);
+            t.fillArcDelta(ring, CX, CY, 0, s[0], s[1], COLOR_RED, COLOR_BLACK);
+        });
+        Bench full = measure([&](GC9A01& t) { t.fillArc(ring, CX, CY, 0, s[1], COLOR_RED); });
+
+        if (delta.panel.diff(full.panel) != 0) {
+            printf("  %d -> %d: %zu pixels differ\n", s[0], s[1], delta.panel.diff(full.panel));
+            CHECK_EQ(delta.panel.diff(full.panel), 0);
+        }
+    }
+}
+
+
+TEST_CASE(arc_speed)
+{
+    buildAngleLUT();
+    ArcSpanTable ring;
+    CHECK(ring.init(INNER, OUTER));
+
+    // Three quarters of the dial, then one 1% step (3.6 degrees)
+    Bench oldFull = measure([&](GC9A01& t) { drawArcFast(t, CX, CY, INNER, OUTER, 0, 270, COLOR_RED); });
+    Bench newFull = measure([&](GC9A01& t) { t.fillArc(ring, CX, CY, 0, 270, COLOR_RED); });
+    Bench oldStep = measure([&](GC9A01& t) { drawArcFast(t, CX, CY, INNER, OUTER, 270, 274, COLOR_RED); });
+    Bench newStep = measure([&](GC9A01& t) { t.fillArcDelta(ring, CX, CY, 0, 270, 274, COLOR_RED, COLOR_BLACK); });
+
+    METRIC("270 deg arc, drawArcFast: transactions", oldFull.panel.stats().transfers, "");
+    METRIC("270 deg arc, fillArc: transactions", newFull.panel.stats().transfers, "");
+    METRIC("270 deg arc, drawArcFast: bytes", oldFull.panel.stats().bytes, "B");
+    METRIC("270 deg arc, fillArc: bytes", newFull.panel.stats().bytes, "B");
+    METRIC("270 deg arc, drawArcFast: wire time @40MHz", oldFull.panel.wireUs(), "us");
+    METRIC("270 deg arc, fillArc: wire time @40MHz", newFull.panel.wireUs(), "us");
+    METRIC("270 deg arc, drawArcFast: host CPU", oldFull.cpuUs, "us");
+    METRIC("270 deg arc, fillArc: host CPU", newFull.cpuUs, "us");
+    METRIC("1% step, drawArcFast: transactions", oldStep.panel.stats().transfers, "");
+    METRIC("1% step, fillArcDelta: transactions", newStep.panel.stats().transfers, "");
+    METRIC("1% step, drawArcFast: host CPU", oldStep.cpuUs, "us");
+    METRIC("1% step, fillArcDelta: host CPU", newStep.cpuUs, "us");
+
+    // Same runs on the wire (both go through the window cache and the DMA
+    // queue); the saving is the per-pixel angle math
+    CHECK(newFull.panel.stats().bytes <= oldFull.panel.stats().bytes * 101 / 100);
+    CHECK(newStep.panel.stats().transfers <= oldStep.panel.stats().transfers);
+    CHECK(newFull.cpuUs < oldFull.cpuUs);
+    CHECK(newStep.cpuUs < oldStep.cpuUs);
+}
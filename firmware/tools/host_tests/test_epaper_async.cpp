@@ -0,0 +1,181 @@
+/**
+ * @file test_epaper_async.cpp
+ * @brief EPaper refreshes against a scripted BUSY line.
+ *
+ * The panel is modelled by scheduling BUSY high shortly after the
+ * refresh starts and low when the waveform would end. The falling edge
+ * runs the driver's ISR on the mock clock, so the tests see how long each
+ * call blocked and when the ready event and callback fired.
+ */
+
+#include "host_test.h"
+#include "mock/idf_mock.h"
+#include "../../components/display/epaper/epaper.h"
+
+
+namespace {
+
+constexpr gpio_num_t BUSY = GPIO_NUM_4;
+constexpr int64_t FULL_US = 2000000;        // Full waveform
+constexpr int64_t PARTIAL_US = 400000;      // Partial waveform
+
+int readyCalls = 0;
+
+void onReady(void* arg)
+{
+    readyCalls++;
+    *static_cast<int64_t*>(arg) = mock::nowUs();
+}
+
+
+/**
+ * @brief BUSY pulse of a refresh that starts now.
+ */
+void busyPulse(int64_t lengthUs)
+{
+    mock::gpio::scheduleInput(BUSY, 1, 1000);
+    mock::gpio::scheduleInput(BUSY, 0, 1000 + lengthUs);
+}
+
+
+struct Panel {
+    EPaper epd{GPIO_NUM_23, GPIO_NUM_18, GPIO_NUM_5, GPIO_NUM_17, GPIO_NUM_16, BUSY};
+    int64_t readyAt = 0;
+
+    Panel() {
+        readyCalls = 0;
+        CHECK(epd.init());
+        CHECK(mock::gpio::interruptEnabled(BUSY));
+        epd.setReadyCallback(onReady, &readyAt);
+    }
+};
+
+}   // namespace
+
+
+TEST_CASE(update_async_returns_before_the_waveform_ends)
+{
+    Panel p;
+
+    int64_t start = mock::nowUs();
+    busyPulse(FULL_US);
+    CHECK(p.epd.updateAsync());
+    CHECK(mock::nowUs() - start < 1000);            // Only the RAM writes
+    CHECK(p.epd.isBusy());
+    CHECK_EQ(xEventGroupGetBits(p.epd.getEventGroup()) & EPAPER_EVENT_READY, 0);
+
+    // Second start while the waveform runs is refused
+    CHECK(!p.epd.updateAsync());
+    CHECK(!p.epd.refreshAsync());
+
+    // Drawing into the buffers while busy is allowed
+    p.epd.fillRect(0, 0, 20, 20, EPAPER_BLACK);
+
+    CHECK(p.epd.waitReady());
+    CHECK(!p.epd.isBusy());
+    CHECK_EQ(readyCalls, 1);
+    CHECK_EQ(p.readyAt - start, 1000 + FULL_US);
+    CHECK(xEventGroupGetBits(p.epd.getEventGroup()) & EPAPER_EVENT_READY);
+}
+
+
+TEST_CASE(wait_ready_times_out_while_busy)
+{
+    Panel p;
+
+    busyPulse(FULL_US);
+    CHECK(p.epd.updateAsync());
+    CHECK(!p.epd.waitReady(pdMS_TO_TICKS(100)));
+    CHECK(p.epd.isBusy());
+    CHECK_EQ(readyCalls, 0);
+
+    CHECK(p.epd.waitReady(pdMS_TO_TICKS(5000)));
+    CHECK_EQ(readyCalls, 1);
+
+    // Idle: returns at once
+    int64_t before = mock::nowUs();
+    CHECK(p.epd.waitReady(0));
+    CHECK_EQ(mock::nowUs(), before);
+}
+
+
+TEST_CASE(blocking_update_ends_on_the_busy_edge)
+{
+    Panel p;
+
+    int64_t start = mock::nowUs();
+    busyPulse(FULL_US);
+    p.epd.update();
+
+    CHECK(!p.epd.isBusy());
+    CHECK_EQ(readyCalls, 1);
+    CHECK(mock::nowUs() - start >= FULL_US);
+    CHECK(mock::nowUs() - start < FULL_US + 20000);
+}
+
+
+TEST_CASE(refresh_async_partial_then_nothing)
+{
+    Panel p;
+
+    busyPulse(FULL_US);
+    p.epd.update();
+
+    p.epd.drawString(10, 10, "12:34", EPAPER_BLACK);
+    EPaperRefresh started = EPAPER_REFRESH_NONE;
+    busyPulse(PARTIAL_US);
+    int64_t start = mock::nowUs();
+    CHECK(p.epd.refreshAsync(&started));
+    CHECK_EQ(started, EPAPER_REFRESH_PARTIAL);
+    CHECK(p.epd.isBusy());
+    CHECK(p.epd.waitReady());
+    CHECK_EQ(p.readyAt - start, 1000 + PARTIAL_US);
+    CHECK_EQ(p.epd.getPartialCount(), 1);
+
+    // Nothing changed: no waveform to wait for
+    CHECK(p.epd.refreshAsync(&started));
+    CHECK_EQ(started, EPAPER_REFRESH_NONE);
+    CHECK(!p.epd.isBusy());
+    CHECK_EQ(readyCalls, 2);
+}
+
+
+TEST_CASE(next_blocking_call_waits_for_async_refresh)
+{
+    Panel p;
+
+    int64_t start = mock::nowUs();
+    busyPulse(FULL_US);
+    CHECK(p.epd.updateAsync());
+
+    // sleep() must not send its command in the middle of the waveform
+    size_t before = mock::spi::log().size();
+    p.epd.sleep();
+    CHECK(mock::nowUs() - start >= FULL_US);
+    CHECK_EQ(readyCalls, 1);
+    CHECK(mock::spi::log().size() > before);
+}
+
+
+TEST_CASE(lost_busy_edge_falls_back_to_polling)
+{
+    Panel p;
+
+    // Edge never reaches the ISR: the refresh still ends by timeout + BUSY level
+    gpio_intr_disable(BUSY);
+    int64_t start = mock::nowUs();
+    busyPulse(FULL_US);
+    p.epd.update();
+
+    CHECK(!p.epd.isBusy());
+    CHECK_EQ(readyCalls, 0);
+    CHECK(mock::nowUs() - start >= EPAPER_REFRESH_TIMEOUT_MS * 1000LL);
+    CHECK(xEventGroupGetBits(p.epd.getEventGroup()) & EPAPER_EVENT_READY);
+
+    // Async calls keep working afterwards
+    gpio_intr_enable(BUSY);
+    busyPulse(FULL_US);
+    CHECK(p.epd.updateAsync());
+    CHECK(p.epd.waitReady());
+    CHECK_EQ(readyCalls, 1);
+}
@@ -0,0 +1,176 @@
+/**
+ * @file test_epaper_fill.cpp
+ * @brief EPaper byte-wise fills vs the per-pixel path, in every rotation.
+ *
+ * The same random rectangles and lines are drawn twice: through
+ * fillRect()/drawHLine()/drawVLine()/drawRect(), and as drawPixel() loops
+ * (what those calls did before the byte-wise fill). Both frame buffers go
+ * out with update() and the B/W and red planes on the wire must match.
+ */
+
+#include "host_test.h"
+#include "mock/idf_mock.h"
+#include "../../components/display/epaper/epaper.h"
+
+#include <stdlib.h>
+
+
+namespace {
+
+constexpr gpio_num_t DC = GPIO_NUM_17;
+constexpr size_t PLANE_BYTES = ((EPAPER_WIDTH + 7) / 8) * EPAPER_HEIGHT;
+
+enum Shape { FILL, HLINE, VLINE, RECT, SHAPE_COUNT };
+
+struct Op {
+    Shape shape;
+    int16_t x, y, w, h;
+    uint8_t color;
+};
+
+
+/**
+ * @brief Random shapes, some of them partly or fully off screen.
+ */
+std::vector<Op> randomOps(unsigned seed, int count)
+{
+    srand(seed);
+    std::vector<Op> ops;
+    for (int i = 0; i < count; i++) {
+        Op op;
+        op.shape = (Shape)(rand() % SHAPE_COUNT);
+        op.x = (int16_t)(rand() % 290 - 20);
+        op.y = (int16_t)(rand() % 290 - 20);
+        op.w = (int16_t)(rand() % 140 - 5);
+        op.h = (int16_t)(rand() % 140 - 5);
+        op.color = (uint8_t)(rand() % 4);        // 3 is not a color: must draw nothing
+        ops.push_back(op);
+    }
+    return ops;
+}
+
+
+void pixelRect(EPaper& d, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color)
+{
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) d.drawPixel(x + i, y + j, color);
+    }
+}
+
+
+void draw(EPaper& d, const Op& op, bool perPixel)
+{
+    if (!perPixel) {
+        switch (op.shape) {
+            case FILL:  d.fillRect(op.x, op.y, op.w, op.h, op.color); break;
+            case HLINE: d.drawHLine(op.x, op.y, op.w, op.color); break;
+            case VLINE: d.drawVLine(op.x, op.y, op.h, op.color); break;
+            case RECT:  d.drawRect(op.x, op.y, op.w, op.h, op.color); break;
+            default: break;
+        }
+        return;
+    }
+
+    switch (op.shape) {
+        case FILL:  pixelRect(d, op.x, op.y, op.w, op.h, op.color); break;
+        case HLINE: pixelRect(d, op.x, op.y, op.w, 1, op.color); break;
+        case VLINE: pixelRect(d, op.x, op.y, 1, op.h, op.color); break;
+        case RECT:
+            pixelRect(d, op.x, op.y, op.w, 1, op.color);
+            pixelRect(d, op.x, op.y + op.h - 1, op.w, 1, op.color);
+            pixelRect(d, op.x, op.y, 1, op.h, op.color);
+            pixelRect(d, op.x + op.w - 1, op.y, 1, op.h, op.color);
+            break;
+        default: break;
+    }
+}
+
+
+/**
+ * @brief B/W then red plane as update() sent them.
+ */
+std::vector<uint8_t> sentPlanes(size_t from)
+{
+    std::vector<uint8_t> planes;
+    const std::vector<mock::spi::Transfer>& log = mock::spi::log();
+    for (size_t i = from; i < log.size(); i++) {
+        if (log[i].level(DC) && log[i].data.size() == PLANE_BYTES) {
+            planes.insert(planes.end(), log[i].data.begin(), log[i].data.end());
+        }
+    }
+    return planes;
+}
+
+
+std::vector<uint8_t> render(const std::vector<Op>& ops, uint8_t rotation, int16_t dx, int16_t dy, bool perPixel)
+{
+    mock::reset();
+    EPaper epd(GPIO_NUM_23, GPIO_NUM_18, GPIO_NUM_5, DC, GPIO_NUM_16, GPIO_NUM_4);
+    CHECK(epd.init());
+    epd.setRotation(rotation);
+    epd.setOffset(dx, dy);
+
+    for (const Op& op : ops) draw(epd, op, perPixel);
+
+    size_t from = mock::spi::log().size();
+    epd.update();
+    return sentPlanes(from);
+}
+
+}   // namespace
+
+
+TEST_CASE(fills_match_per_pixel_in_every_rotation)
+{
+    const int16_t offsets[][2] = { {0, 0}, {-5, 7}, {13, -9} };
+
+    for (uint8_t rotation = 0; rotation < 4; rotation++) {
+        for (const auto& offset : offsets) {
+            std::vector<Op> ops = randomOps(rotation * 31 + offset[0] + 100, 200);
+
+            std::vector<uint8_t> fast = render(ops, rotation, offset[0], offset[1], false);
+            std::vector<uint8_t> slow = render(ops, rotation, offset[0], offset[1], true);
+
+            CHECK_EQ(fast.size(), 2 * PLANE_BYTES);
+            if (fast != slow) {
+                printf("  rotation %u, offset (%d, %d): planes differ\n", rotation, offset[0], offset[1]);
+                CHECK(fast == slow);
+            }
+        }
+    }
+}
+
+
+TEST_CASE(fill_edges_within_one_byte)
+{
+    // Every start bit and width up to two bytes, in both orientations
+    for (uint8_t rotation = 0; rotation < 4; rotation++) {
+        std::vector<Op> ops;
+        for (int16_t x = 0; x < 16; x++) {
+            for (int16_t w = 1; w <= 17; w++) {
+                ops.push_back({FILL, (int16_t)(x + 3 * w), (int16_t)(x * 17 + w), w, 3, (uint8_t)((x + w) % 3)});
+            }
+        }
+        CHECK(render(ops, rotation, 0, 0, false) == render(ops, rotation, 0, 0, true));
+    }
+}
+
+
+TEST_CASE(fill_speed)
+{
+    EPaper epd(GPIO_NUM_23, GPIO_NUM_18, GPIO_NUM_5, DC, GPIO_NUM_16, GPIO_NUM_4);
+    CHECK(epd.init());
+
+    const int loops = 200;
+    double start = host_test::hostUs();
+    for (int i = 0; i < loops; i++) epd.fillRect(0, 0, EPAPER_WIDTH, EPAPER_HEIGHT, i % 3);
+    double fillUs = (host_test::hostUs() - start) / loops;
+
+    start = host_test::hostUs();
+    for (int i = 0; i < loops; i++) pixelRect(epd, 0, 0, EPAPER_WIDTH, EPAPER_HEIGHT, i % 3);
+    double pixelUs = (host_test::hostUs() - start) / loops;
+
+    METRIC("full-screen fillRect (host)", fillUs, "us");
+    METRIC("full-screen drawPixel loop (host)", pixelUs, "us");
+    CHECK(fillUs < pixelUs);
+}
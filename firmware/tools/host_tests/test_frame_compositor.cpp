@@ -0,0 +1,200 @@
+/**
+ * @file test_frame_compositor.cpp
+ * @brief Naive full redraws of a dial: straight to the panel vs through
+ *        FrameCompositor.
+ *
+ * Every frame draws the whole remote-style dial from scratch (clear,
+ * track, level arc, value, mode name). The direct run sends all of it;
+ * the composed run sends only the tiles that changed. After every frame
+ * both simulated GC9A01 panels must hold the same image.
+ */
+
+#include "host_test.h"
+#include "mock/panel_sim.h"
+#include "../../components/display/gc9a01/gc9a01.h"
+#include "../../components/display/shared/arc_spans.h"
+#include "../../components/display/shared/frame_compositor.h"
+
+#include <stdio.h>
+
+
+namespace {
+
+constexpr gpio_num_t DC = GPIO_NUM_16;
+constexpr int16_t CX = 120;
+constexpr int16_t CY = 120;
+
+struct Dial {
+    bool on = false;
+    int level = 50;
+    int hue = 30;
+    const char* mode = "BRIGHT";
+};
+
+
+/**
+ * @brief On/off, a brightness ramp, a hue sweep, idle frames and a ramp down.
+ */
+std::vector<Dial> session()
+{
+    std::vector<Dial> frames;
+    Dial d;
+    frames.push_back(d);                                    // First paint (off)
+    d.on = true;
+    frames.push_back(d);
+    for (int i = 0; i < 20; i++) { d.level += 2; frames.push_back(d); }
+    d.mode = "COLOR";
+    frames.push_back(d);
+    for (int i = 0; i < 20; i++) { d.hue += 9; frames.push_back(d); }
+    for (int i = 0; i < 5; i++) frames.push_back(d);        // Nothing changes
+    d.mode = "BRIGHT";
+    for (int i = 0; i < 20; i++) { d.level -= 4; frames.push_back(d); }
+    d.on = false;
+    frames.push_back(d);
+    return frames;
+}
+
+
+void drawDial(GC9A01& tft, const ArcSpanTable& ring, const Dial& d)
+{
+    tft.fillScreen(COLOR_BLACK);
+    if (!d.on) {
+        tft.drawString(CX - 27, CY - 10, "OFF", COLOR_GRAY, COLOR_BLACK, 3);
+        return;
+    }
+
+    uint16_t color = GC9A01::color565(255, (uint8_t)(d.hue % 360 * 255 / 360), 0);
+    int end = d.level * 360 / 100;
+    tft.fillArc(ring, CX, CY, 0, 360, COLOR_GRAY);          // Track
+    tft.fillArc(ring, CX, CY, 0, end, color);
+
+    char text[8];
+    snprintf(text, sizeof(text), "%d%%", d.level);
+    tft.drawString(CX - 27, CY - 10, text, COLOR_WHITE, COLOR_BLACK, 3);
+    tft.drawString(CX - 18, CY + 30, d.mode, COLOR_CYAN, COLOR_BLACK, 1);
+}
+
+
+struct Session {
+    std::vector<std::vector<uint16_t>> images;  // Panel RAM after each frame
+    std::vector<uint64_t> bytes;                // SPI bytes of each frame
+    uint64_t total = 0;
+    uint64_t peak = 0;
+    double cpuUs = 0;
+};
+
+Session run(bool compose)
+{
+    mock::reset();
+    ArcSpanTable ring;
+    CHECK(ring.init(95, 110));
+
+    GC9A01 tft(GPIO_NUM_23, GPIO_NUM_18, GPIO_NUM_5, DC, GPIO_NUM_17);
+    CHECK(tft.init());
+    PanelSim<GC9A01Panel> panel(DC);
+    panel.replay(mock::spi::log());
+
+    FrameCompositor<GC9A01> ui(tft);
+    CHECK(ui.begin());
+
+    Session s;
+    for (const Dial& d : session()) {
+        panel.resetStats();
+        double start = host_test::hostUs();
+        if (compose) ui.render([&](GC9A01& t) { drawDial(t, ring, d); });
+        else drawDial(tft, ring, d);
+        tft.flush();
+        s.cpuUs += host_test::hostUs() - start;
+        panel.replay(mock::spi::log());
+
+        s.images.push_back(panel.pixels());
+        s.bytes.push_back(panel.stats().bytes);
+        s.total += panel.stats().bytes;
+        if (panel.stats().bytes > s.peak) s.peak = panel.stats().bytes;
+        if (compose) CHECK(ui.getStats().lastBytes <= panel.stats().pixelBytes);
+    }
+    return s;
+}
+
+}   // namespace
+
+
+TEST_CASE(composed_frames_match_direct)
+{
+    Session direct = run(false);
+    Session composed = run(true);
+
+    CHECK_EQ(composed.images.size(), direct.images.size());
+    size_t firstDiff = composed.images.size();
+    for (size_t i = 0; i < composed.images.size() && i < direct.images.size(); i++) {
+        if (composed.images[i] != direct.images[i]) {
+            firstDiff = i;
+            break;
+        }
+    }
+    CHECK_EQ(firstDiff, composed.images.size());
+
+    // Level steps touch a few tiles of the ring, not the whole screen
+    CHECK(composed.total * 4 < direct.total);
+
+    const size_t frames = composed.bytes.size();
+    METRIC("frames", frames, "");
+    METRIC("naive direct bytes/frame (avg)", direct.total / frames, "B");
+    METRIC("naive composed bytes/frame (avg)", composed.total / frames, "B");
+    METRIC("naive direct bytes/frame (peak)", direct.peak, "B");
+    METRIC("naive composed bytes/frame (peak)", composed.peak, "B");
+    METRIC("naive direct host CPU/frame", direct.cpuUs / frames, "us");
+    METRIC("naive composed host CPU/frame", composed.cpuUs / frames, "us");
+}
+
+
+TEST_CASE(unchanged_frame_sends_nothing)
+{
+    ArcSpanTable ring;
+    CHECK(ring.init(95, 110));
+    GC9A01 tft(GPIO_NUM_23, GPIO_NUM_18, GPIO_NUM_5, DC, GPIO_NUM_17);
+    CHECK(tft.init());
+    FrameCompositor<GC9A01> ui(tft);
+    CHECK(ui.begin());
+
+    Dial d;
+    d.on = true;
+    auto draw = [&](GC9A01& t) { drawDial(t, ring, d); };
+
+    CHECK(ui.render(draw));
+    CHECK_EQ(ui.getStats().lastTiles, ui.getStats().tilesTotal);
+    CHECK_EQ(ui.getStats().lastBytes, (uint32_t)GC9A01_WIDTH * GC9A01_HEIGHT * 2);
+
+    tft.flush();
+    size_t before = mock::spi::log().size();
+    ui.render(draw);
+    tft.flush();
+    CHECK_EQ(ui.getStats().lastTiles, 0);
+    CHECK_EQ(ui.getStats().lastBytes, 0);
+    CHECK_EQ(mock::spi::log().size(), before);
+
+    // One character of the value: only its tiles
+    d.level = 51;
+    ui.render(draw);
+    CHECK(ui.getStats().lastTiles > 0);
+    CHECK(ui.getStats().lastTiles <= 6);
+
+    ui.invalidate();
+    ui.render(draw);
+    CHECK_EQ(ui.getStats().lastTiles, ui.getStats().tilesTotal);
+}
+
+
+TEST_CASE(begin_fails_without_memory)
+{
+    GC9A01 tft(GPIO_NUM_23, GPIO_NUM_18, GPIO_NUM_5, DC, GPIO_NUM_17);
+    CHECK(tft.init());
+    FrameCompositor<GC9A01> ui(tft);
+
+    mock::heap::failAllocations(true);
+    CHECK(!ui.begin());
+    mock::heap::failAllocations(false);
+    CHECK(!ui.isReady());
+    CHECK(!ui.render([](GC9A01&) {}));
+    CHECK(ui.begin());
+}
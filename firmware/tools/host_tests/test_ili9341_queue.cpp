@@ -0,0 +1,142 @@
+/**
+ * @file test_ili9341_queue.cpp
+ * @brief ILI9341 fills and lines: queued DMA pipeline vs blocking transfers.
+ *
+ * Draws the same frame both ways, checks the panel RAM ends up identical,
+ * and reports transactions, bytes and CPU time per frame.
+ */
+
+#include "host_test.h"
+#include "mock/panel_sim.h"
+#include "../../components/display/ili9341/ili9341.h"
+
+
+namespace {
+
+constexpr gpio_num_t DC = GPIO_NUM_16;
+
+ILI9341* newDisplay()
+{
+    ILI9341* d = new ILI9341(GPIO_NUM_23, GPIO_NUM_19, GPIO_NUM_18, GPIO_NUM_5, DC, GPIO_NUM_17);
+    CHECK(d->init());
+    return d;
+}
+
+
+/**
+ * @brief One frame of a typical UI: clear, panels, separators, a chart.
+ */
+void drawFrame(ILI9341& d, int frame)
+{
+    d.fillScreen(COLOR_BLACK);
+    d.fillRect(0, 0, 240, 24, COLOR_BLUE);
+    d.fillRect(10, 40, 220, 100, COLOR_GRAY);
+    d.fillRect(20, 150 + frame % 7, 7, 5, COLOR_RED);           // Small (blocking) fill
+    for (int y = 160; y < 320; y += 20) d.drawHLine(0, y, 240, COLOR_WHITE);
+    for (int x = 0; x < 240; x += 30) d.drawVLine(x, 160, 160, COLOR_CYAN);
+    for (int i = 0; i < 24; i++) {
+        d.drawLine(i * 10, 300 - (i * 37 + frame) % 120, i * 10 + 10, 300 - ((i + 1) * 37 + frame) % 120,
+                   COLOR_YELLOW);
+    }
+    d.flush();
+}
+
+
+struct Run {
+    PanelSim<ILI9341Panel> panel;
+    double cpuUs = 0;
+};
+
+/**
+ * @brief Draw frames on a fresh display; panel stats cover the frames only.
+ */
+Run drawFrames(bool queued, int frames)
+{
+    mock::reset();
+    ILI9341* d = newDisplay();
+    d->setQueuedMode(queued);
+
+    Run run{PanelSim<ILI9341Panel>(DC)};
+    run.panel.replay(mock::spi::log());
+    run.panel.resetStats();
+
+    double start = host_test::hostUs();
+    for (int f = 0; f < frames; f++) drawFrame(*d, f);
+    run.cpuUs = (host_test::hostUs() - start) / frames;
+
+    run.panel.replay(mock::spi::log());
+    delete d;
+    return run;
+}
+
+}   // namespace
+
+
+TEST_CASE(queued_frame_matches_blocking)
+{
+    const int frames = 20;
+
+    Run blocking = drawFrames(false, frames);
+    Run queued = drawFrames(true, frames);
+
+    CHECK_EQ(queued.panel.diff(blocking.panel), 0);
+    CHECK_EQ(queued.panel.stats().bytes, blocking.panel.stats().bytes);
+    CHECK_EQ(blocking.panel.stats().queued, 0);
+    CHECK(queued.panel.stats().queued > 0);
+
+    METRIC("blocking transactions/frame", blocking.panel.stats().transfers / frames, "");
+    METRIC("queued transactions/frame", queued.panel.stats().transfers / frames, "");
+    METRIC("blocking bytes/frame", blocking.panel.stats().bytes / frames, "B");
+    METRIC("queued bytes/frame", queued.panel.stats().bytes / frames, "B");
+    METRIC("wire time/frame @20MHz", queued.panel.wireUs() / frames, "us");
+    METRIC("blocking host CPU/frame", blocking.cpuUs, "us");
+    METRIC("queued host CPU/frame", queued.cpuUs, "us");
+}
+
+
+TEST_CASE(full_screen_clear_is_few_transactions)
+{
+    ILI9341* d = newDisplay();
+    PanelSim<ILI9341Panel> panel(DC);
+    panel.replay(mock::spi::log());
+    panel.resetStats();
+
+    d->fillScreen(COLOR_RED);
+    d->flush();
+    panel.replay(mock::spi::log());
+
+    // Window (2 commands + params) + RAMWR, then one transfer per buffer
+    const uint32_t pixelChunks = (240 * 320 * 2 + ILI9341::BUF_BYTES - 1) / ILI9341::BUF_BYTES;
+    CHECK_EQ(panel.stats().queued, pixelChunks);
+    CHECK(panel.stats().transfers <= pixelChunks + 5);
+    CHECK_EQ(panel.pixel(0, 0), COLOR_RED);
+    CHECK_EQ(panel.pixel(239, 319), COLOR_RED);
+    METRIC("fillScreen transactions", panel.stats().transfers, "");
+    delete d;
+}
+
+
+TEST_CASE(queued_pixels_land_before_next_command)
+{
+    ILI9341* d = newDisplay();
+    PanelSim<ILI9341Panel> panel(DC);
+    panel.replay(mock::spi::log());
+    size_t first = mock::spi::log().size();
+
+    d->fillRect(0, 0, 200, 100, COLOR_GREEN);   // Queued
+    d->drawPixel(5, 5, COLOR_RED);              // Commands: must flush first
+    d->flush();
+
+    // Queued buffers go out with DC high
+    const std::vector<mock::spi::Transfer>& log = mock::spi::log();
+    for (size_t i = first; i < log.size(); i++) {
+        if (log[i].queued) CHECK_EQ(log[i].level(DC), 1);
+    }
+
+    panel.replay(log);
+    CHECK_EQ(panel.pixel(5, 5), COLOR_RED);
+    CHECK_EQ(panel.pixel(6, 5), COLOR_GREEN);
+    CHECK_EQ(panel.pixel(199, 99), COLOR_GREEN);
+    CHECK_EQ(panel.pixel(200, 99), 0);
+    delete d;
+}
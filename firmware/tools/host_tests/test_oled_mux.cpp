@@ -0,0 +1,145 @@
+/**
+ * @file test_oled_mux.cpp
+ * @brief OledMux channel switching: select writes per flush on the I2C mock.
+ *
+ * Four SSD1306 panels at 0x3C sit behind a PCA9548A at 0x70. Every write
+ * to 0x70 is a select; each panel is simulated from the transfers made
+ * while its channel was routed (OledSim::setMux), so a panel that got
+ * another panel's frame shows up as wrong RAM.
+ */
+
+#include "host_test.h"
+#include "mock/oled_sim.h"
+#include "../../components/display/oled_mux/oled_mux.h"
+
+
+namespace {
+
+constexpr uint8_t PANELS = 4;
+constexpr uint16_t MUX_ADDR = PCA9548A_DEFAULT_ADDR;
+
+size_t logged = 0;
+
+/**
+ * @brief Select writes to the mux since the last call.
+ */
+int selectsSinceLast()
+{
+    const std::vector<mock::i2c::Transfer>& log = mock::i2c::log();
+    int selects = 0;
+    for (; logged < log.size(); logged++) {
+        if (log[logged].address == MUX_ADDR && !log[logged].read) selects++;
+    }
+    return selects;
+}
+
+
+/**
+ * @brief A 10x10 block at a place only this panel draws to.
+ */
+void mark(OledMux& oleds, uint8_t channel, int frame)
+{
+    oleds.panel(channel)->fillRect(channel * 20 + frame % 4, 8 * (frame % 6), 10, 10);
+}
+
+
+/**
+ * @brief Replace the top line of a panel with a counter.
+ */
+void tick(OledMux& oleds, uint8_t channel, int count)
+{
+    char text[16];
+    snprintf(text, sizeof(text), "%d", count);
+    oleds.panel(channel)->fillRect(0, 0, 128, 8, false);
+    oleds.panel(channel)->drawString(0, 0, text);
+}
+
+}   // namespace
+
+
+TEST_CASE(selects_per_flush)
+{
+    logged = 0;
+    PCA9548A mux(GPIO_NUM_21, GPIO_NUM_22);
+    CHECK(mux.init());
+
+    OledMux oleds(mux);
+    OledSim sims[PANELS];
+    for (uint8_t ch = 0; ch < PANELS; ch++) {
+        CHECK(oleds.addPanel(ch));
+        sims[ch].setMux(MUX_ADDR, ch);
+    }
+    selectsSinceLast();
+
+    // All dirty, CH3 selected by the last addPanel(): CH3, CH0, CH1, CH2
+    for (uint8_t ch = 0; ch < PANELS; ch++) mark(oleds, ch, 0);
+    CHECK_EQ(oleds.flush(), PANELS);
+    CHECK_EQ(selectsSinceLast(), PANELS - 1);
+
+    // Nothing changed: no traffic at all
+    size_t before = mock::i2c::log().size();
+    CHECK_EQ(oleds.flush(), 0);
+    CHECK_EQ(mock::i2c::log().size(), before);
+
+    // Only the panel left selected (CH2): no select
+    mark(oleds, 2, 1);
+    CHECK_EQ(oleds.flush(), 1);
+    CHECK_EQ(selectsSinceLast(), 0);
+
+    // CH0 and CH2, CH2 selected: CH2 free, one select for CH0
+    mark(oleds, 0, 2);
+    mark(oleds, 2, 2);
+    CHECK_EQ(oleds.flush(), 2);
+    CHECK_EQ(selectsSinceLast(), 1);
+
+    // Same panel again through flush(ch): still selected
+    mark(oleds, 0, 3);
+    CHECK(oleds.flush(0));
+    CHECK_EQ(selectsSinceLast(), 0);
+
+    // Every panel ended up with its own drawing only
+    for (uint8_t ch = 0; ch < PANELS; ch++) sims[ch].replay(mock::i2c::log());
+    for (uint8_t ch = 0; ch < PANELS; ch++) {
+        for (uint8_t other = 0; other < PANELS; other++) {
+            bool drawn = sims[ch].pixel(other * 20 + 5, 4);
+            if (drawn != (other == ch)) {
+                printf("  panel %d, block of panel %d: %s\n", ch, other, drawn ? "drawn" : "missing");
+                CHECK_EQ(drawn, other == ch);
+            }
+        }
+    }
+}
+
+
+TEST_CASE(selects_vs_select_every_panel)
+{
+    logged = 0;
+    PCA9548A mux(GPIO_NUM_21, GPIO_NUM_22);
+    CHECK(mux.init());
+
+    OledMux oleds(mux);
+    for (uint8_t ch = 0; ch < PANELS; ch++) CHECK(oleds.addPanel(ch));
+    for (uint8_t ch = 0; ch < PANELS; ch++) mark(oleds, ch, 0);
+    oleds.flush();
+    selectsSinceLast();
+
+    // A clock ticking on one panel, another panel changing every 10 frames
+    const int frames = 60;
+    int selects = 0;
+    int64_t start = mock::nowUs();
+    for (int f = 1; f <= frames; f++) {
+        tick(oleds, 1, f);
+        if (f % 10 == 0) tick(oleds, 3, f);
+        oleds.flush();
+        selects += selectsSinceLast();
+    }
+    double busUs = (double)(mock::nowUs() - start) / frames;
+
+    // Selecting and sending every panel each frame: 4 selects, 4 panels
+    METRIC("select every panel: selects/frame", PANELS, "");
+    METRIC("OledMux: selects/frame", (double)selects / frames, "");
+    METRIC("OledMux: bus time/frame @400kHz", busUs, "us");
+
+    // Only CH3's frames switch: away to CH3 and back to CH1
+    CHECK_EQ(selects, 2 * frames / 10);
+}
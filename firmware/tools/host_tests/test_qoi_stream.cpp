@@ -0,0 +1,325 @@
+/**
+ * @file test_qoi_stream.cpp
+ * @brief QoiStream decoding into a simulated ILI9341: pixels and MB/s.
+ *
+ * Test images are generated and QOI-encoded here (the reference encoder
+ * from qoiformat.org, all ops). Each one is fed in chunks from 1 byte to
+ * the whole file, some of them placed partly off screen; the panel RAM
+ * must hold the source pixels converted to RGB565. The throughput case
+ * times decode + push on the host CPU next to the panel's wire time.
+ */
+
+#include "host_test.h"
+#include "mock/panel_sim.h"
+#include "../../components/display/ili9341/ili9341.h"
+#include "../../components/display/shared/qoi_stream.h"
+
+#include <string.h>
+#include <vector>
+
+
+namespace {
+
+constexpr gpio_num_t DC = GPIO_NUM_16;
+
+struct Image {
+    const char* name;
+    uint32_t width, height;
+    uint8_t channels;
+    std::vector<uint8_t> rgba;      // 4 bytes per pixel
+    std::vector<uint8_t> qoi;
+};
+
+
+/*
+ * -----------------------------------------------------------------------------
+ * Encoder
+ * -----------------------------------------------------------------------------
+ */
+void put32(std::vector<uint8_t>& out, uint32_t v)
+{
+    for (int s = 24; s >= 0; s -= 8) out.push_back((v >> s) & 0xFF);
+}
+
+std::vector<uint8_t> encodeQoi(const Image& img)
+{
+    std::vector<uint8_t> out = { 'q', 'o', 'i', 'f' };
+    put32(out, img.width);
+    put32(out, img.height);
+    out.push_back(img.channels);
+    out.push_back(0);
+
+    uint8_t index[64][4] = {};
+    uint8_t prev[4] = { 0, 0, 0, 255 };
+    int run = 0;
+    const size_t count = (size_t)img.width * img.height;
+
+    for (size_t i = 0; i < count; i++) {
+        uint8_t px[4];
+        memcpy(px, &img.rgba[i * 4], 4);
+        if (img.channels == 3) px[3] = prev[3];
+
+        if (memcmp(px, prev, 4) == 0) {
+            if (++run == 62 || i == count - 1) {
+                out.push_back(0xC0 | (run - 1));
+                run = 0;
+            }
+            continue;
+        }
+        if (run > 0) {
+            out.push_back(0xC0 | (run - 1));
+            run = 0;
+        }
+
+        int hash = (px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) & 63;
+        if (memcmp(index[hash], px, 4) == 0) {
+            out.push_back((uint8_t)hash);
+        } else {
+            memcpy(index[hash], px, 4);
+            if (px[3] == prev[3]) {
+                int8_t dr = px[0] - prev[0], dg = px[1] - prev[1], db = px[2] - prev[2];
+                int8_t drg = dr - dg, dbg = db - dg;
+                if (dr > -3 && dr < 2 && dg > -3 && dg < 2 && db > -3 && db < 2) {
+                    out.push_back(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2));
+                } else if (drg > -9 && drg < 8 && dg > -33 && dg < 32 && dbg > -9 && dbg < 8) {
+                    out.push_back(0x80 | (dg + 32));
+                    out.push_back((drg + 8) << 4 | (dbg + 8));
+                } else {
+                    out.insert(out.end(), { 0xFE, px[0], px[1], px[2] });
+                }
+            } else {
+                out.insert(out.end(), { 0xFF, px[0], px[1], px[2], px[3] });
+            }
+        }
+        memcpy(prev, px, 4);
+    }
+
+    out.insert(out.end(), { 0, 0, 0, 0, 0, 0, 0, 1 });
+    return out;
+}
+
+
+/*
+ * -----------------------------------------------------------------------------
+ * Test images
+ * -----------------------------------------------------------------------------
+ */
+uint32_t lcg = 1;
+
+uint8_t noise(int amplitude)
+{
+    lcg = lcg * 1103515245u + 12345u;
+    return (uint8_t)((lcg >> 16) % (2 * amplitude + 1));
+}
+
+template<typename Pixel>
+Image makeImage(const char* name, uint32_t w, uint32_t h, uint8_t channels, Pixel pixel)
+{
+    Image img{ name, w, h, channels, {}, {} };
+    img.rgba.resize((size_t)w * h * 4);
+    for (uint32_t y = 0; y < h; y++) {
+        for (uint32_t x = 0; x < w; x++) pixel(x, y, &img.rgba[((size_t)y * w + x) * 4]);
+    }
+    img.qoi = encodeQoi(img);
+    return img;
+}
+
+std::vector<Image> images()
+{
+    lcg = 1;
+    std::vector<Image> list;
+
+    // Flat panels and blocky text, like a UI screenshot
+    list.push_back(makeImage("UI screenshot", 240, 320, 3, [](uint32_t x, uint32_t y, uint8_t* p) {
+        bool bar = y < 30 || y >= 290;
+        bool text = y % 40 >= 12 && y % 40 < 20 && x % 8 < 5 && (x / 8 + y / 40) % 5 != 0;
+        uint8_t v = bar ? 40 : text ? 230 : 16;
+        p[0] = v; p[1] = bar ? 90 : v; p[2] = bar ? 160 : v; p[3] = 255;
+    }));
+
+    list.push_back(makeImage("gradient", 240, 320, 3, [](uint32_t x, uint32_t y, uint8_t* p) {
+        p[0] = (uint8_t)x; p[1] = (uint8_t)(y * 4 / 5); p[2] = (uint8_t)((x + y) / 2); p[3] = 255;
+    }));
+
+    // Smooth shading plus sensor noise: DIFF, LUMA and RGB ops
+    list.push_back(makeImage("photo-like", 240, 320, 3, [](uint32_t x, uint32_t y, uint8_t* p) {
+        p[0] = (uint8_t)(60 + x / 3 + noise(3));
+        p[1] = (uint8_t)(80 + y / 4 + noise(2));
+        p[2] = (uint8_t)(120 + (x ^ y) / 16 + noise(6) * (x % 17 == 0 ? 8 : 1));
+        p[3] = 255;
+    }));
+
+    // Alpha changes: RGBA ops (alpha is ignored when drawing)
+    list.push_back(makeImage("RGBA shapes", 240, 320, 4, [](uint32_t x, uint32_t y, uint8_t* p) {
+        int dx = (int)x - 120, dy = (int)y - 160;
+        bool inside = dx * dx + dy * dy < 90 * 90;
+        p[0] = inside ? 250 : 20; p[1] = inside ? 180 : 20; p[2] = (uint8_t)(y / 2);
+        p[3] = inside ? 255 : (uint8_t)(x & 0x80);
+    }));
+
+    list.push_back(makeImage("640x480, clipped", 640, 480, 3, [](uint32_t x, uint32_t y, uint8_t* p) {
+        p[0] = (uint8_t)(x / 3); p[1] = (uint8_t)(((x / 32) + (y / 32)) % 2 ? 200 : 40); p[2] = (uint8_t)(y / 2);
+        p[3] = 255;
+    }));
+    return list;
+}
+
+
+/*
+ * -----------------------------------------------------------------------------
+ * Decoding
+ * -----------------------------------------------------------------------------
+ */
+struct Decoded {
+    PanelSim<ILI9341Panel> panel{DC};
+    bool done = false;
+    double cpuUs = 0;
+    int16_t screenW = 0, screenH = 0;
+};
+
+/**
+ * @brief Feed the file in chunks of chunk bytes (0 = random sizes).
+ */
+Decoded decode(const Image& img, int16_t x, int16_t y, size_t chunk, int repeat = 1)
+{
+    mock::reset();
+    ILI9341 d(GPIO_NUM_23, GPIO_NUM_19, GPIO_NUM_18, GPIO_NUM_5, DC, GPIO_NUM_17);
+    CHECK(d.init());
+    d.fillScreen(COLOR_BLACK);
+    d.flush();
+
+    Decoded out;
+    out.screenW = d.getWidth();
+    out.screenH = d.getHeight();
+    out.panel.replay(mock::spi::log());
+    out.panel.resetStats();
+
+    QoiStream<ILI9341> qoi(d);
+    lcg = 7;
+    double start = host_test::hostUs();
+    for (int k = 0; k < repeat; k++) {
+        qoi.begin(x, y);
+        for (size_t at = 0; at < img.qoi.size();) {
+            size_t n = chunk ? chunk : 1 + noise(700);
+            if (n > img.qoi.size() - at) n = img.qoi.size() - at;
+            if (!qoi.feed(&img.qoi[at], n)) break;
+            at += n;
+        }
+        out.done = qoi.finish();
+    }
+    d.flush();
+    out.cpuUs = (host_test::hostUs() - start) / repeat;
+
+    out.panel.replay(mock::spi::log());
+    return out;
+}
+
+/**
+ * @brief Visible pixels that differ from the source, and changed pixels outside.
+ */
+size_t wrongPixels(const Decoded& dec, const Image& img, int16_t x, int16_t y)
+{
+    size_t wrong = 0;
+    for (int sy = 0; sy < dec.screenH; sy++) {
+        for (int sx = 0; sx < dec.screenW; sx++) {
+            int ix = sx - x, iy = sy - y;
+            uint16_t expected = 0;
+            if (ix >= 0 && iy >= 0 && ix < (int)img.width && iy < (int)img.height) {
+                const uint8_t* p = &img.rgba[((size_t)iy * img.width + ix) * 4];
+                expected = ((p[0] & 0xF8) << 8) | ((p[1] & 0xFC) << 3) | (p[2] >> 3);
+            }
+            wrong += dec.panel.pixel(sx, sy) != expected;
+        }
+    }
+    return wrong;
+}
+
+size_t visiblePixels(const Decoded& dec, const Image& img, int16_t x, int16_t y)
+{
+    auto span = [](int at, int size, int screen) {
+        int a = at < 0 ? 0 : at, b = at + size < screen ? at + size : screen;
+        return b > a ? b - a : 0;
+    };
+    return (size_t)span(x, img.width, dec.screenW) * span(y, img.height, dec.screenH);
+}
+
+}   // namespace
+
+
+TEST_CASE(decode_matches_source)
+{
+    const std::vector<Image> list = images();
+    const size_t chunks[] = { 1, 7, 250, 1024, 0, SIZE_MAX };
+    int checks = 0;
+
+    for (const Image& img : list) {
+        bool big = img.width > 240;
+        const int16_t places[][2] = { { 0, 0 }, { -37, 50 }, { 90, -120 }, { -200, -100 } };
+
+        for (auto place : places) {
+            if (!big && place[0] == -200) continue;
+            if (big && place[0] != -200 && place[0] != 0) continue;
+            for (size_t chunk : chunks) {
+                Decoded dec = decode(img, place[0], place[1], chunk);
+                checks++;
+                CHECK(dec.done);
+                size_t wrong = wrongPixels(dec, img, place[0], place[1]);
+                if (wrong) {
+                    printf("  %s at %d,%d, chunk %zu: %zu pixels wrong\n", img.name, place[0], place[1],
+                           chunk, wrong);
+                    CHECK_EQ(wrong, 0);
+                }
+                CHECK_EQ(dec.panel.stats().pixelBytes, visiblePixels(dec, img, place[0], place[1]) * 2);
+            }
+        }
+    }
+    CHECK_EQ(checks, 4 * 3 * 6 + 2 * 6);
+}
+
+
+TEST_CASE(truncated_stream_closes_window)
+{
+    Image img = images()[2];
+    Image cut = img;
+    cut.qoi.resize(img.qoi.size() / 2);
+    Decoded dec = decode(cut, 0, 0, 1024);
+    CHECK(!dec.done);
+    CHECK(dec.panel.stats().pixelBytes > 0);
+    CHECK(dec.panel.stats().pixelBytes < (uint64_t)img.width * img.height * 2);
+}
+
+
+TEST_CASE(qoi_throughput)
+{
+    for (const Image& img : images()) {
+        int16_t x = img.width > 240 ? -200 : 0;
+        int16_t y = img.width > 240 ? -100 : 0;
+
+        for (size_t chunk : { (size_t)1024, SIZE_MAX }) {
+            const int repeat = 10;
+            Decoded dec = decode(img, x, y, chunk, repeat);
+            CHECK(dec.done);
+
+            double outBytes = (double)visiblePixels(dec, img, x, y) * 2;
+            double wireUs = dec.panel.wireUs() / repeat;
+            char label[96];
+            const char* feed = chunk == 1024 ? "1 KB chunks" : "one chunk";
+
+            if (chunk == SIZE_MAX) {
+                snprintf(label, sizeof(label), "%s: QOI size", img.name);
+                METRIC(label, img.qoi.size() / 1024.0, "KB");
+                snprintf(label, sizeof(label), "%s: wire time @20MHz", img.name);
+                METRIC(label, wireUs, "us");
+            }
+            snprintf(label, sizeof(label), "%s, %s: decode+push", img.name, feed);
+            METRIC(label, dec.cpuUs, "us");
+            snprintf(label, sizeof(label), "%s, %s: QOI in", img.name, feed);
+            METRIC(label, img.qoi.size() / dec.cpuUs, "MB/s");
+            snprintf(label, sizeof(label), "%s, %s: RGB565 out", img.name, feed);
+            METRIC(label, outBytes / dec.cpuUs, "MB/s");
+
+            // Each frame sends the visible pixels once
+            CHECK_EQ(dec.panel.stats().pixelBytes, (uint64_t)outBytes * repeat);
+        }
+    }
+}
@@ -0,0 +1,352 @@
+/**
+ * @file test_rgb565_asset.cpp
+ * @brief Rgb565Asset decoding and drawBitmap()/drawSprite() throughput.
+ *
+ * Test images are encoded here the way tools/rgb565_asset.py does (raw,
+ * RLE, palette + RLE) and drawn to a simulated ILI9341 and a round
+ * GC9A01 (masked stream path), clipped on every edge. The reference draws
+ * each source pixel with drawPixel(). The throughput case times decode
+ * alone and decode + push of a whole draw on the host CPU, next to the
+ * bytes and wire time the panel sees.
+ */
+
+#include "host_test.h"
+#include "mock/panel_sim.h"
+#include "../../components/display/ili9341/ili9341.h"
+#include "../../components/display/gc9a01/gc9a01.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+constexpr gpio_num_t DC = GPIO_NUM_16;
+constexpr uint16_t KEY = 0xF81F;
+
+struct Image {
+    const char* name;
+    uint16_t width, height;
+    bool keyed;
+    std::vector<uint16_t> pixels;
+};
+
+
+/*
+ * -----------------------------------------------------------------------------
+ * Encoder (same packets as rgb565_asset.py)
+ * -----------------------------------------------------------------------------
+ */
+void put16le(std::vector<uint8_t>& out, uint16_t v) { out.push_back(v & 0xFF); out.push_back(v >> 8); }
+void put16be(std::vector<uint8_t>& out, uint16_t v) { out.push_back(v >> 8); out.push_back(v & 0xFF); }
+
+template<typename Pack>
+void rleRow(const uint16_t* values, int n, std::vector<uint8_t>& out, Pack pack)
+{
+    std::vector<uint16_t> literal;
+    auto flushLiteral = [&]() {
+        for (size_t at = 0; at < literal.size(); at += 128) {
+            size_t chunk = literal.size() - at < 128 ? literal.size() - at : 128;
+            out.push_back((uint8_t)(chunk - 1));
+            for (size_t k = 0; k < chunk; k++) pack(literal[at + k]);
+        }
+        literal.clear();
+    };
+
+    for (int i = 0; i < n;) {
+        int run = 1;
+        while (i + run < n && values[i + run] == values[i] && run < 128) run++;
+        if (run >= 3 || (run == 2 && literal.empty())) {
+            flushLiteral();
+            out.push_back((uint8_t)(0x80 | (run - 1)));
+            pack(values[i]);
+            i += run;
+        } else {
+            literal.push_back(values[i++]);
+        }
+    }
+    flushLiteral();
+}
+
+std::vector<uint8_t> encode(const Image& img, uint8_t encoding)
+{
+    std::vector<uint16_t> palette;
+    std::map<uint16_t, uint8_t> lookup;
+    if (encoding == RGB565_ASSET_PALETTE) {
+        std::set<uint16_t> colors(img.pixels.begin(), img.pixels.end());
+        palette.assign(colors.begin(), colors.end());
+        for (size_t i = 0; i < palette.size(); i++) lookup[palette[i]] = (uint8_t)i;
+    }
+
+    std::vector<uint8_t> data, index;
+    for (uint16_t y = 0; y < img.height; y++) {
+        const uint16_t* row = &img.pixels[(size_t)y * img.width];
+        if (encoding == RGB565_ASSET_RAW) {
+            for (uint16_t x = 0; x < img.width; x++) put16be(data, row[x]);
+            continue;
+        }
+        uint32_t offset = data.size();
+        for (int b = 0; b < 4; b++) index.push_back((offset >> (8 * b)) & 0xFF);
+        if (encoding == RGB565_ASSET_PALETTE) rleRow(row, img.width, data, [&](uint16_t v) { data.push_back(lookup[v]); });
+        else rleRow(row, img.width, data, [&](uint16_t v) { put16be(data, v); });
+    }
+
+    std::vector<uint8_t> out = { 'R', '5', '6', '5', 1, encoding };
+    put16le(out, img.keyed ? RGB565_ASSET_HAS_KEY : 0);
+    put16le(out, img.width);
+    put16le(out, img.height);
+    put16le(out, img.keyed ? KEY : 0);
+    put16le(out, (uint16_t)palette.size());
+    for (uint16_t c : palette) put16be(out, c);
+    out.insert(out.end(), index.begin(), index.end());
+    out.insert(out.end(), data.begin(), data.end());
+    return out;
+}
+
+
+/*
+ * -----------------------------------------------------------------------------
+ * Test images
+ * -----------------------------------------------------------------------------
+ */
+uint16_t rgb(int r, int g, int b) { return (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)); }
+
+Image bulbIcon()
+{
+    // Flat bulb on a transparent background
+    Image img{ "48x48 icon", 48, 48, true, {} };
+    for (int y = 0; y < 48; y++) {
+        for (int x = 0; x < 48; x++) {
+            int dx = x - 24, dy = y - 18;
+            uint16_t c = KEY;
+            if (dx * dx + dy * dy <= 15 * 15) c = dx * dx + dy * dy <= 6 * 6 ? rgb(255, 250, 200) : rgb(255, 200, 40);
+            if (y >= 33 && y < 44 && dx >= -6 && dx < 6) c = y % 3 ? rgb(150, 150, 150) : rgb(90, 90, 90);
+            img.pixels.push_back(c);
+        }
+    }
+    return img;
+}
+
+Image banner()
+{
+    // Stripes with blocky "lettering"
+    Image img{ "240x40 banner", 240, 40, false, {} };
+    for (int y = 0; y < 40; y++) {
+        for (int x = 0; x < 240; x++) {
+            uint16_t c = y < 4 || y >= 36 ? rgb(0, 90, 160) : rgb(10, 20, 40);
+            if (y >= 12 && y < 28 && (x / 6) % 3 != 2 && ((x * 7 + y * 3) / 9) % 4 != 0) c = rgb(240, 240, 240);
+            img.pixels.push_back(c);
+        }
+    }
+    return img;
+}
+
+Image gradient()
+{
+    Image img{ "120x80 gradient", 120, 80, false, {} };
+    for (int y = 0; y < 80; y++) {
+        for (int x = 0; x < 120; x++) img.pixels.push_back(rgb(x * 2, y * 3, (x + y) & 0xFF));
+    }
+    return img;
+}
+
+std::vector<Image> images() { return { bulbIcon(), banner(), gradient() }; }
+
+const char* const ENCODING_NAMES[] = { "raw", "RLE", "palette" };
+
+
+/**
+ * @brief Encodings the converter could pick for this image.
+ */
+std::vector<uint8_t> encodings(const Image& img)
+{
+    std::set<uint16_t> colors(img.pixels.begin(), img.pixels.end());
+    if (colors.size() > 256) return { RGB565_ASSET_RAW, RGB565_ASSET_RLE };
+    return { RGB565_ASSET_RAW, RGB565_ASSET_RLE, RGB565_ASSET_PALETTE };
+}
+
+
+/*
+ * -----------------------------------------------------------------------------
+ * Drawing
+ * -----------------------------------------------------------------------------
+ */
+template<typename Display>
+void perPixel(Display& d, int16_t x, int16_t y, const Image& img, bool sprite)
+{
+    for (int j = 0; j < img.height; j++) {
+        for (int i = 0; i < img.width; i++) {
+            uint16_t c = img.pixels[(size_t)j * img.width + i];
+            if (sprite && img.keyed && c == KEY) continue;
+            d.drawPixel(x + i, y + j, c);
+        }
+    }
+}
+
+/**
+ * @brief Positions on screen and off every edge.
+ */
+std::vector<std::pair<int16_t, int16_t>> positions(int16_t w, int16_t h, const Image& img)
+{
+    return { { 20, 30 }, { (int16_t)(-img.width / 3), (int16_t)(-img.height / 2) },
+             { (int16_t)(w - img.width / 2), (int16_t)(h - img.height / 3) },
+             { (int16_t)(w / 2 - img.width / 2), (int16_t)(h / 2 - img.height / 2) } };
+}
+
+template<typename Display, typename Panel, typename Make>
+void checkDraws(Make make, int& checks)
+{
+    for (const Image& img : images()) {
+        for (uint8_t enc : encodings(img)) {
+            std::vector<uint8_t> blob = encode(img, enc);
+            Rgb565Asset asset;
+            CHECK(asset.open(blob.data(), blob.size()));
+
+            for (bool sprite : { false, true }) {
+                PanelSim<Panel> drawn(DC), reference(DC);
+                for (bool ref : { false, true }) {
+                    mock::reset();
+                    Display d = make();
+                    CHECK(d.init());
+                    d.fillScreen(COLOR_BLUE);
+                    for (auto [x, y] : positions(d.getWidth(), d.getHeight(), img)) {
+                        if (ref) perPixel(d, x, y, img, sprite);
+                        else if (sprite) d.drawSprite(x, y, asset);
+                        else d.drawBitmap(x, y, asset);
+                    }
+                    d.flush();
+                    (ref ? reference : drawn).replay(mock::spi::log());
+                }
+
+                checks++;
+                size_t diff = drawn.diff(reference);
+                if (diff != 0) {
+                    printf("  %s, %s, %s: %zu pixels differ\n", img.name, ENCODING_NAMES[enc],
+                           sprite ? "sprite" : "bitmap", diff);
+                    CHECK_EQ(diff, 0);
+                }
+            }
+        }
+    }
+}
+
+ILI9341 makeIli() { return ILI9341(GPIO_NUM_23, GPIO_NUM_19, GPIO_NUM_18, GPIO_NUM_5, DC, GPIO_NUM_17); }
+GC9A01 makeGc() { return GC9A01(GPIO_NUM_23, GPIO_NUM_18, GPIO_NUM_5, DC, GPIO_NUM_17); }
+
+}   // namespace
+
+
+TEST_CASE(decode_matches_source)
+{
+    for (const Image& img : images()) {
+        for (uint8_t enc : encodings(img)) {
+            std::vector<uint8_t> blob = encode(img, enc);
+            Rgb565Asset asset;
+            CHECK(asset.open(blob.data(), blob.size()));
+
+            // Whole rows and a span starting mid-packet
+            std::vector<uint8_t> row(img.width * 2);
+            size_t bad = 0;
+            for (uint16_t y = 0; y < img.height; y++) {
+                uint16_t x0 = y % 2 ? 0 : (uint16_t)(y % img.width);
+                asset.decodeRow(y, x0, img.width - x0, row.data());
+                for (uint16_t x = x0; x < img.width; x++) {
+                    uint16_t c = (row[2 * (x - x0)] << 8) | row[2 * (x - x0) + 1];
+                    bad += c != img.pixels[(size_t)y * img.width + x];
+                }
+            }
+            if (bad) {
+                printf("  %s, %s: %zu pixels wrong\n", img.name, ENCODING_NAMES[enc], bad);
+                CHECK_EQ(bad, 0);
+            }
+        }
+    }
+}
+
+
+TEST_CASE(draws_match_per_pixel)
+{
+    int checks = 0;
+    checkDraws<ILI9341, ILI9341Panel>(makeIli, checks);
+    checkDraws<GC9A01, GC9A01Panel>(makeGc, checks);
+    CHECK_EQ(checks, 2 * 2 * (3 + 3 + 2));
+}
+
+
+TEST_CASE(decode_push_throughput)
+{
+    for (const Image& img : images()) {
+        for (uint8_t enc : encodings(img)) {
+            std::vector<uint8_t> blob = encode(img, enc);
+            Rgb565Asset asset;
+            CHECK(asset.open(blob.data(), blob.size()));
+            const double pixels = (double)img.width * img.height;
+            char label[96];
+
+            // Decode alone
+            std::vector<uint8_t> row(img.width * 2);
+            const int decodes = 200;
+            double start = host_test::hostUs();
+            for (int k = 0; k < decodes; k++) {
+                for (uint16_t y = 0; y < img.height; y++) asset.decodeRow(y, 0, img.width, row.data());
+            }
+            double decodeUs = (host_test::hostUs() - start) / decodes;
+
+            // Decode + push through the driver
+            mock::reset();
+            ILI9341 d = makeIli();
+            CHECK(d.init());
+            PanelSim<ILI9341Panel> panel(DC);
+            panel.replay(mock::spi::log());
+            panel.resetStats();
+
+            const int draws = 50;
+            start = host_test::hostUs();
+            for (int k = 0; k < draws; k++) d.drawBitmap(0, 30, asset);
+            d.flush();
+            double drawUs = (host_test::hostUs() - start) / draws;
+            panel.replay(mock::spi::log());
+
+            const char* name = ENCODING_NAMES[enc];
+            snprintf(label, sizeof(label), "%s, %s: size", img.name, name);
+            METRIC(label, (double)blob.size(), "B");
+            snprintf(label, sizeof(label), "%s, %s: decode", img.name, name);
+            METRIC(label, decodeUs * 1000 / pixels, "ns/px");
+            snprintf(label, sizeof(label), "%s, %s: decode+push", img.name, name);
+            METRIC(label, pixels * 2 / drawUs, "MB/s");
+            snprintf(label, sizeof(label), "%s, %s: host CPU/draw", img.name, name);
+            METRIC(label, drawUs, "us");
+            snprintf(label, sizeof(label), "%s, %s: wire time/draw @20MHz", img.name, name);
+            METRIC(label, panel.wireUs() / draws, "us");
+
+            // One window per draw, nothing but pixels after it
+            CHECK(panel.stats().pixelBytes == (uint64_t)pixels * 2 * draws);
+            CHECK(panel.stats().bytes <= (uint64_t)(pixels * 2 + 16) * draws);
+        }
+    }
+
+    // Sprites send only opaque pixels
+    Image icon = bulbIcon();
+    std::vector<uint8_t> blob = encode(icon, RGB565_ASSET_PALETTE);
+    Rgb565Asset asset;
+    CHECK(asset.open(blob.data(), blob.size()));
+    uint64_t bytes[2];
+    for (bool sprite : { false, true }) {
+        mock::reset();
+        ILI9341 d = makeIli();
+        CHECK(d.init());
+        PanelSim<ILI9341Panel> panel(DC);
+        panel.replay(mock::spi::log());
+        panel.resetStats();
+        if (sprite) d.drawSprite(20, 30, asset);
+        else d.drawBitmap(20, 30, asset);
+        d.flush();
+        panel.replay(mock::spi::log());
+        bytes[sprite] = panel.stats().bytes;
+    }
+    METRIC("48x48 icon: drawBitmap bytes", bytes[0], "B");
+    METRIC("48x48 icon: drawSprite bytes", bytes[1], "B");
+    CHECK(bytes[1] < bytes[0]);
+}
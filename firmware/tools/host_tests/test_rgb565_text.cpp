@@ -0,0 +1,144 @@
+/**
+ * @file test_rgb565_text.cpp
+ * @brief 5x7 text runs vs the per-pixel drawChar() they replaced.
+ *
+ * The reference draws every font pixel on its own (drawPixel() at size 1,
+ * fillRect() per font pixel above), like drawChar() did before text went
+ * through one window per line, with the background painted too. Both end
+ * up in a simulated ILI9341; the RAM must match and the transaction
+ * counts show what the single window saves.
+ */
+
+#include "host_test.h"
+#include "mock/panel_sim.h"
+#include "../../components/display/ili9341/ili9341.h"
+
+#include <string.h>
+
+
+namespace {
+
+constexpr gpio_num_t DC = GPIO_NUM_16;
+
+const char* const LINES[] = {
+    "Hello!",
+    "Temp 23.5C  RH 41%",
+    "~{|}` \x7f\x01 edge",
+    "The quick brown fox jumps over the lazy dog",
+};
+
+
+void perPixelChar(ILI9341& d, int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size)
+{
+    if (c < FONT_5X7_FIRST_CHAR || c > FONT_5X7_LAST_CHAR) c = '?';
+    const uint8_t* glyph = &FONT_5X7[(c - FONT_5X7_FIRST_CHAR) * FONT_5X7_WIDTH];
+
+    for (uint8_t col = 0; col < FONT_5X7_CELL_WIDTH; col++) {
+        uint8_t bits = col < FONT_5X7_WIDTH ? glyph[col] : 0;
+        for (uint8_t row = 0; row < FONT_5X7_HEIGHT; row++) {
+            uint16_t px = (bits & (1 << row)) ? color : bg;
+            if (size == 1) d.drawPixel(x + col, y + row, px);
+            else d.fillRect(x + col * size, y + row * size, size, size, px);
+        }
+    }
+}
+
+
+void perPixelString(ILI9341& d, int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg,
+                    uint8_t size)
+{
+    for (int16_t cx = x; *str; str++, cx += FONT_5X7_CELL_WIDTH * size) {
+        perPixelChar(d, cx, y, *str, color, bg, size);
+    }
+}
+
+
+struct Run {
+    PanelSim<ILI9341Panel> panel{DC};
+    double cpuUs = 0;
+};
+
+
+/**
+ * @brief Every line at sizes 1-3, some of them clipped by the screen edge.
+ */
+Run drawText(bool perPixel)
+{
+    mock::reset();
+    ILI9341 d(GPIO_NUM_23, GPIO_NUM_19, GPIO_NUM_18, GPIO_NUM_5, DC, GPIO_NUM_17);
+    CHECK(d.init());
+
+    Run run;
+    run.panel.replay(mock::spi::log());
+    run.panel.resetStats();
+
+    double start = host_test::hostUs();
+    int16_t y = -3;
+    for (uint8_t size = 1; size <= 3; size++) {
+        for (const char* line : LINES) {
+            int16_t x = (int16_t)(strlen(line) % 3 == 0 ? -4 : 2);
+            if (perPixel) perPixelString(d, x, y, line, COLOR_WHITE, COLOR_BLUE, size);
+            else d.drawString(x, y, line, COLOR_WHITE, COLOR_BLUE, size);
+            y += 9 * size;
+        }
+    }
+    d.flush();
+    run.cpuUs = host_test::hostUs() - start;
+
+    run.panel.replay(mock::spi::log());
+    return run;
+}
+
+}   // namespace
+
+
+TEST_CASE(text_runs_match_per_pixel_chars)
+{
+    Run runs = drawText(false);
+    Run pixels = drawText(true);
+
+    CHECK_EQ(runs.panel.diff(pixels.panel), 0);
+    CHECK_EQ(runs.panel.stats().pixelBytes, pixels.panel.stats().pixelBytes);
+}
+
+
+TEST_CASE(string_transactions)
+{
+    const char* label = "Hello";
+
+    for (bool perPixel : { true, false }) {
+        mock::reset();
+        ILI9341 d(GPIO_NUM_23, GPIO_NUM_19, GPIO_NUM_18, GPIO_NUM_5, DC, GPIO_NUM_17);
+        CHECK(d.init());
+        PanelSim<ILI9341Panel> panel(DC);
+        panel.replay(mock::spi::log());
+        panel.resetStats();
+
+        if (perPixel) perPixelString(d, 10, 10, label, COLOR_WHITE, COLOR_BLACK, 1);
+        else d.drawString(10, 10, label, COLOR_WHITE, COLOR_BLACK, 1);
+        d.flush();
+        panel.replay(mock::spi::log());
+
+        if (perPixel) {
+            METRIC("5-char label, per pixel: transactions", panel.stats().transfers, "");
+            METRIC("5-char label, per pixel: windows", panel.stats().windows, "");
+            METRIC("5-char label, per pixel: bytes", panel.stats().bytes, "B");
+        } else {
+            METRIC("5-char label, one run: transactions", panel.stats().transfers, "");
+            METRIC("5-char label, one run: windows", panel.stats().windows, "");
+            METRIC("5-char label, one run: bytes", panel.stats().bytes, "B");
+            CHECK_EQ(panel.stats().windows, 2);                 // One column + one row range
+            CHECK_EQ(panel.stats().pixelBytes, 5 * 6 * 7 * 2);
+        }
+    }
+
+    Run runs = drawText(false);
+    Run pixels = drawText(true);
+    METRIC("text block, per pixel: transactions", pixels.panel.stats().transfers, "");
+    METRIC("text block, one run per line: transactions", runs.panel.stats().transfers, "");
+    METRIC("text block, per pixel: wire time @20MHz", pixels.panel.wireUs(), "us");
+    METRIC("text block, one run per line: wire time @20MHz", runs.panel.wireUs(), "us");
+    METRIC("text block, per pixel: host CPU", pixels.cpuUs, "us");
+    METRIC("text block, one run per line: host CPU", runs.cpuUs, "us");
+    CHECK(runs.panel.stats().transfers * 20 < pixels.panel.stats().transfers);
+}
@@ -0,0 +1,137 @@
+/**
+ * @file test_smart_light_remote.cpp
+ * @brief Scripted SmartLightRemote session: SPI bytes per frame, composed
+ *        damage vs damage drawn straight to the panel.
+ *
+ * The same session runs twice on a GC9A01: with the remote's compose
+ * buffer, and with the allocation made to fail (the remote then draws
+ * direct). After every frame both panels must hold the same image.
+ */
+
+#include "host_test.h"
+#include "mock/panel_sim.h"
+#include "../../devices/modules/smart-light/smart_light_remote.h"
+
+#include <functional>
+
+
+namespace {
+
+constexpr gpio_num_t DC = GPIO_NUM_16;
+
+typedef std::function<void(SmartLightRemote&)> Step;
+
+/**
+ * @brief Knob turns, mode changes and on/off, one render() each.
+ */
+std::vector<Step> session()
+{
+    std::vector<Step> steps;
+    steps.push_back([](SmartLightRemote&) {});                          // First paint (off)
+    steps.push_back([](SmartLightRemote& p) { p.setOn(true); });
+    for (int i = 0; i < 20; i++) steps.push_back([](SmartLightRemote& p) { p.adjustBrightness(+3); });
+    steps.push_back([](SmartLightRemote& p) { p.cycleMode(); });        // COLOR
+    for (int i = 0; i < 20; i++) steps.push_back([](SmartLightRemote& p) { p.adjustHue(+9); });
+    steps.push_back([](SmartLightRemote& p) { p.cycleMode(); });        // WHITE
+    for (int i = 0; i < 10; i++) steps.push_back([](SmartLightRemote& p) { p.adjustWhite(+7); });
+    steps.push_back([](SmartLightRemote& p) { p.toggle(); });           // Off
+    steps.push_back([](SmartLightRemote& p) { p.toggle(); });           // On again
+    steps.push_back([](SmartLightRemote& p) { p.cycleMode(); });        // BRIGHTNESS
+    for (int i = 0; i < 20; i++) steps.push_back([](SmartLightRemote& p) { p.adjustBrightness(-5); });
+    steps.push_back([](SmartLightRemote& p) { p.toggle(); });
+    return steps;
+}
+
+
+struct Session {
+    std::vector<std::vector<uint16_t>> images;  // Panel RAM after each frame
+    std::vector<uint64_t> bytes;                // SPI bytes of each frame
+    uint64_t total = 0;
+    uint64_t peak = 0;
+    uint32_t bands = 0;
+};
+
+Session run(bool compose)
+{
+    mock::reset();
+    SmartLightRemote::initSharedAssets();
+
+    GC9A01 tft(GPIO_NUM_23, GPIO_NUM_18, GPIO_NUM_5, DC, GPIO_NUM_17);
+    CHECK(tft.init());
+
+    PanelSim<GC9A01Panel> panel(DC);
+    panel.replay(mock::spi::log());
+
+    mock::heap::failAllocations(!compose);
+    SmartLightRemote remote(tft, 0);
+    mock::heap::failAllocations(false);
+
+    Session s;
+    for (const Step& step : session()) {
+        step(remote);
+        panel.resetStats();
+        remote.render();
+        tft.flush();
+        panel.replay(mock::spi::log());
+
+        s.images.push_back(panel.pixels());
+        s.bytes.push_back(panel.stats().bytes);
+        s.total += panel.stats().bytes;
+        if (panel.stats().bytes > s.peak) s.peak = panel.stats().bytes;
+        s.bands += remote.frameStats().lastBands;
+    }
+    return s;
+}
+
+}   // namespace
+
+
+TEST_CASE(composed_session_matches_direct)
+{
+    Session direct = run(false);
+    Session composed = run(true);
+
+    CHECK_EQ(direct.bands, 0);
+    CHECK(composed.bands > 0);
+    CHECK_EQ(composed.images.size(), direct.images.size());
+
+    size_t firstDiff = composed.images.size();
+    for (size_t i = 0; i < composed.images.size() && i < direct.images.size(); i++) {
+        if (composed.images[i] != direct.images[i]) {
+            firstDiff = i;
+            break;
+        }
+    }
+    CHECK_EQ(firstDiff, composed.images.size());
+
+    // Composing never sends more than drawing each widget over the clear
+    CHECK(composed.total <= direct.total);
+
+    const size_t frames = composed.bytes.size();
+    METRIC("frames", frames, "");
+    METRIC("direct bytes/frame (avg)", direct.total / frames, "B");
+    METRIC("composed bytes/frame (avg)", composed.total / frames, "B");
+    METRIC("direct bytes/frame (peak)", direct.peak, "B");
+    METRIC("composed bytes/frame (peak)", composed.peak, "B");
+    METRIC("full redraw bytes", GC9A01_WIDTH * GC9A01_HEIGHT * 2, "B");
+    for (size_t i = 0; i < frames; i++) {
+        printf("  frame %2zu: direct %6llu B, composed %6llu B\n", i,
+               (unsigned long long)direct.bytes[i], (unsigned long long)composed.bytes[i]);
+    }
+}
+
+
+TEST_CASE(idle_render_sends_nothing)
+{
+    SmartLightRemote::initSharedAssets();
+    GC9A01 tft(GPIO_NUM_23, GPIO_NUM_18, GPIO_NUM_5, DC, GPIO_NUM_17);
+    CHECK(tft.init());
+    SmartLightRemote remote(tft, 0);
+
+    remote.setOn(true);
+    remote.render();
+    size_t before = mock::spi::log().size();
+    remote.render();
+    remote.render();
+    CHECK_EQ(mock::spi::log().size(), before);
+}
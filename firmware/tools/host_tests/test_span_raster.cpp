@@ -0,0 +1,234 @@
+/**
+ * @file test_span_raster.cpp
+ * @brief Span rasterizers (lines, circles, polygons) vs the per-pixel code
+ *        they replaced.
+ *
+ * The references are drawLine(), drawCircle() and fillCircle() as they
+ * were before span_raster.h: Bresenham and midpoint steps with one
+ * drawPixel() per pixel, and four drawVLine() per step for the fill.
+ * Polygons are their edges drawn with the old drawLine(). Random shapes,
+ * some of them off the screen edge, go to two simulated ILI9341 panels;
+ * the RAM must match and the transaction counts show what runs save.
+ */
+
+#include "host_test.h"
+#include "mock/panel_sim.h"
+#include "../../components/display/ili9341/ili9341.h"
+
+#include <stdlib.h>
+
+
+namespace {
+
+constexpr gpio_num_t DC = GPIO_NUM_16;
+constexpr int SHAPES = 300;
+
+uint32_t lcg = 1;
+
+int16_t nextInt(int lo, int hi)
+{
+    lcg = lcg * 1103515245u + 12345u;
+    return (int16_t)(lo + (int)((lcg >> 8) % (uint32_t)(hi - lo + 1)));
+}
+
+
+void perPixelLine(ILI9341& d, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+    int16_t dx = abs(x1 - x0);
+    int16_t dy = abs(y1 - y0);
+    int16_t sx = (x0 < x1) ? 1 : -1;
+    int16_t sy = (y0 < y1) ? 1 : -1;
+    int16_t err = dx - dy;
+
+    while (true) {
+        d.drawPixel(x0, y0, color);
+        if (x0 == x1 && y0 == y1) break;
+        int16_t e2 = 2 * err;
+        if (e2 > -dy) { err -= dy; x0 += sx; }
+        if (e2 < dx) { err += dx; y0 += sy; }
+    }
+}
+
+
+void perPixelCircle(ILI9341& d, int16_t cx, int16_t cy, int16_t radius, uint16_t color)
+{
+    int16_t x = radius;
+    int16_t y = 0;
+    int16_t err = 0;
+
+    while (x >= y) {
+        d.drawPixel(cx + x, cy + y, color);
+        d.drawPixel(cx + y, cy + x, color);
+        d.drawPixel(cx - y, cy + x, color);
+        d.drawPixel(cx - x, cy + y, color);
+        d.drawPixel(cx - x, cy - y, color);
+        d.drawPixel(cx - y, cy - x, color);
+        d.drawPixel(cx + y, cy - x, color);
+        d.drawPixel(cx + x, cy - y, color);
+
+        y++;
+        if (err <= 0) err += 2 * y + 1;
+        if (err > 0) { x--; err -= 2 * x + 1; }
+    }
+}
+
+
+void columnFillCircle(ILI9341& d, int16_t cx, int16_t cy, int16_t radius, uint16_t color)
+{
+    d.drawVLine(cx, cy - radius, 2 * radius + 1, color);
+
+    int16_t x = radius;
+    int16_t y = 0;
+    int16_t err = 0;
+
+    while (x >= y) {
+        d.drawVLine(cx + x, cy - y, 2 * y + 1, color);
+        d.drawVLine(cx - x, cy - y, 2 * y + 1, color);
+        d.drawVLine(cx + y, cy - x, 2 * x + 1, color);
+        d.drawVLine(cx - y, cy - x, 2 * x + 1, color);
+
+        y++;
+        if (err <= 0) err += 2 * y + 1;
+        if (err > 0) { x--; err -= 2 * x + 1; }
+    }
+}
+
+
+enum class Shape { LINE, CIRCLE, FILL, POLYGON };
+
+const char* const NAMES[] = { "line", "circle", "fillCircle", "hexagon" };
+
+
+/**
+ * @brief SHAPES random shapes of one kind; the same ones for both runs.
+ */
+void drawShapes(ILI9341& d, Shape shape, bool perPixel)
+{
+    lcg = 1 + (uint32_t)shape;
+    for (int i = 0; i < SHAPES; i++) {
+        uint16_t color = (uint16_t)nextInt(1, 0xFFFF);
+        int16_t x = nextInt(-30, 270);
+        int16_t y = nextInt(-30, 350);
+
+        switch (shape) {
+            case Shape::LINE: {
+                int16_t x1 = nextInt(-30, 270), y1 = nextInt(-30, 350);
+                if (perPixel) perPixelLine(d, x, y, x1, y1, color);
+                else d.drawLine(x, y, x1, y1, color);
+                break;
+            }
+            case Shape::CIRCLE:
+            case Shape::FILL: {
+                int16_t r = nextInt(0, 60);
+                if (shape == Shape::CIRCLE) {
+                    if (perPixel) perPixelCircle(d, x, y, r, color);
+                    else d.drawCircle(x, y, r, color);
+                } else {
+                    if (perPixel) columnFillCircle(d, x, y, r, color);
+                    else d.fillCircle(x, y, r, color);
+                }
+                break;
+            }
+            case Shape::POLYGON: {
+                int16_t xy[12];
+                for (int k = 0; k < 12; k++) xy[k] = (int16_t)((k % 2 ? y : x) + nextInt(-40, 40));
+                if (perPixel) {
+                    for (int k = 0; k < 6; k++) {
+                        int n = (k + 1) % 6;
+                        perPixelLine(d, xy[2 * k], xy[2 * k + 1], xy[2 * n], xy[2 * n + 1], color);
+                    }
+                } else {
+                    d.drawPolygon(xy, 6, color);
+                }
+                break;
+            }
+        }
+    }
+    d.flush();
+}
+
+
+struct Run {
+    PanelSim<ILI9341Panel> panel{DC};
+    double cpuUs = 0;
+};
+
+Run run(Shape shape, bool perPixel)
+{
+    mock::reset();
+    ILI9341 d(GPIO_NUM_23, GPIO_NUM_19, GPIO_NUM_18, GPIO_NUM_5, DC, GPIO_NUM_17);
+    CHECK(d.init());
+
+    Run r;
+    r.panel.replay(mock::spi::log());
+    r.panel.resetStats();
+
+    double start = host_test::hostUs();
+    drawShapes(d, shape, perPixel);
+    r.cpuUs = host_test::hostUs() - start;
+
+    r.panel.replay(mock::spi::log());
+    return r;
+}
+
+}   // namespace
+
+
+TEST_CASE(spans_match_per_pixel_shapes)
+{
+    for (Shape shape : { Shape::LINE, Shape::CIRCLE, Shape::FILL, Shape::POLYGON }) {
+        Run spans = run(shape, false);
+        Run pixels = run(shape, true);
+
+        if (spans.panel.diff(pixels.panel) != 0) {
+            printf("  %s: %zu pixels differ\n", NAMES[(int)shape], spans.panel.diff(pixels.panel));
+            CHECK_EQ(spans.panel.diff(pixels.panel), 0);
+        }
+    }
+}
+
+
+TEST_CASE(span_transactions)
+{
+    for (Shape shape : { Shape::LINE, Shape::CIRCLE, Shape::FILL, Shape::POLYGON }) {
+        Run spans = run(shape, false);
+        Run pixels = run(shape, true);
+        const char* name = NAMES[(int)shape];
+        char label[64];
+
+        snprintf(label, sizeof(label), "%s, old: transactions/shape", name);
+        METRIC(label, (double)pixels.panel.stats().transfers / SHAPES, "");
+        snprintf(label, sizeof(label), "%s, spans: transactions/shape", name);
+        METRIC(label, (double)spans.panel.stats().transfers / SHAPES, "");
+        snprintf(label, sizeof(label), "%s, old: bytes/shape", name);
+        METRIC(label, (double)pixels.panel.stats().bytes / SHAPES, "B");
+        snprintf(label, sizeof(label), "%s, spans: bytes/shape", name);
+        METRIC(label, (double)spans.panel.stats().bytes / SHAPES, "B");
+        snprintf(label, sizeof(label), "%s, old: host CPU/shape", name);
+        METRIC(label, pixels.cpuUs / SHAPES, "us");
+        snprintf(label, sizeof(label), "%s, spans: host CPU/shape", name);
+        METRIC(label, spans.cpuUs / SHAPES, "us");
+
+        CHECK(spans.panel.stats().transfers < pixels.panel.stats().transfers);
+        CHECK(spans.panel.stats().bytes <= pixels.panel.stats().bytes);
+    }
+
+    // A shallow line: one run per row instead of one window per pixel
+    for (bool perPixel : { true, false }) {
+        mock::reset();
+        ILI9341 d(GPIO_NUM_23, GPIO_NUM_19, GPIO_NUM_18, GPIO_NUM_5, DC, GPIO_NUM_17);
+        CHECK(d.init());
+        PanelSim<ILI9341Panel> panel(DC);
+        panel.replay(mock::spi::log());
+        panel.resetStats();
+
+        if (perPixel) perPixelLine(d, 10, 100, 209, 139, COLOR_WHITE);
+        else d.drawLine(10, 100, 209, 139, COLOR_WHITE);
+        d.flush();
+        panel.replay(mock::spi::log());
+
+        METRIC(perPixel ? "200x40 line, old: transactions" : "200x40 line, spans: transactions",
+               panel.stats().transfers, "");
+        if (!perPixel) CHECK(panel.stats().windows <= 2 * 40);
+    }
+}
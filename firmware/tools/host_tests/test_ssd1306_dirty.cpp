@@ -0,0 +1,255 @@
+/**
+ * @file test_ssd1306_dirty.cpp
+ * @brief SSD1306 dirty-page updates: bytes on the bus and panel RAM.
+ *
+ * The panel is simulated from the I2C log (mock/oled_sim.h). After a
+ * partial update its RAM must equal what a full resend of the same
+ * drawing gives, and the bytes per update must be just the changed
+ * window: 7 command bytes (control byte + column/page window) plus the
+ * control byte and the data. The mock clock moves by each transfer's
+ * wire time, so frame rates at 400 kHz and 1 MHz SCL come from it.
+ */
+
+#include "host_test.h"
+#include "mock/oled_sim.h"
+#include "../../components/display/ssd1306/ssd1306.h"
+
+
+namespace {
+
+constexpr size_t WINDOW_BYTES = 7 + 1;      // 0x00 + 0x21 a b 0x22 c d, then 0x40
+
+i2c_master_bus_handle_t newBus()
+{
+    i2c_master_bus_config_t config = {};
+    config.i2c_port = I2C_NUM_0;
+    config.sda_io_num = GPIO_NUM_21;
+    config.scl_io_num = GPIO_NUM_22;
+    i2c_master_bus_handle_t bus = nullptr;
+    CHECK_EQ(i2c_new_master_bus(&config, &bus), ESP_OK);
+    return bus;
+}
+
+
+/**
+ * @brief Bytes and transactions of one update(), checked against the sim.
+ */
+struct Update {
+    size_t bytes;
+    uint32_t transfers;
+    double busUs;
+};
+
+Update update(SSD1306& oled, OledSim& sim)
+{
+    sim.replay(mock::i2c::log());
+    sim.resetStats();
+    oled.update();
+    sim.replay(mock::i2c::log());
+
+    CHECK_EQ(sim.stats().bytes, oled.getLastUpdateBytes());
+    return { oled.getLastUpdateBytes(), sim.stats().transfers, sim.stats().busUs };
+}
+
+
+void statusScreen(SSD1306& d)
+{
+    d.clear();
+    d.drawRect(0, 0, 128, 64);
+    d.drawString(4, 4, "Living room");
+    d.drawString(4, 20, "21.5C  41%");
+    d.drawLine(4, 40, 120, 58);
+    d.fillCircle(110, 20, 6);
+}
+
+}   // namespace
+
+
+TEST_CASE(bytes_per_update)
+{
+    i2c_master_bus_handle_t bus = newBus();
+    {
+        SSD1306 oled(bus);
+        CHECK(oled.init());
+        OledSim sim;
+
+        // First update: everything, one window
+        statusScreen(oled);
+        Update first = update(oled, sim);
+        CHECK_EQ(first.bytes, WINDOW_BYTES + 1024);
+        CHECK_EQ(first.transfers, 2);
+
+        // Nothing changed (same drawing again): nothing sent
+        statusScreen(oled);
+        Update none = update(oled, sim);
+        CHECK_EQ(none.bytes, 0);
+        CHECK_EQ(none.transfers, 0);
+
+        // From a blank screen: a single pixel, one column of one page
+        oled.clear();
+        update(oled, sim);
+        oled.drawPixel(64, 50);
+        Update pixel = update(oled, sim);
+        CHECK_EQ(pixel.bytes, WINDOW_BYTES + 1);
+        CHECK_EQ(pixel.transfers, 2);
+        CHECK(sim.pixel(64, 50));
+
+        // One full page (the one with the pixel)
+        oled.fillRect(0, 48, 128, 8);
+        Update page = update(oled, sim);
+        CHECK_EQ(page.bytes, WINDOW_BYTES + 128);
+        CHECK_EQ(page.transfers, 2);
+
+        // The whole screen
+        oled.clear();
+        update(oled, sim);
+        oled.fill();
+        Update full = update(oled, sim);
+        CHECK_EQ(full.bytes, WINDOW_BYTES + 1024);
+        CHECK_EQ(full.transfers, 2);
+
+        METRIC("single pixel: bytes/update", pixel.bytes, "B");
+        METRIC("one page: bytes/update", page.bytes, "B");
+        METRIC("full screen: bytes/update", full.bytes, "B");
+        METRIC("single pixel: bus time @400kHz", pixel.busUs, "us");
+        METRIC("one page: bus time @400kHz", page.busUs, "us");
+        METRIC("full screen: bus time @400kHz", full.busUs, "us");
+    }
+    i2c_del_master_bus(bus);
+}
+
+
+TEST_CASE(partial_updates_match_full_resend)
+{
+    // Same drawing on two panels: 0x3C sends its changes, 0x3D everything
+    i2c_master_bus_handle_t bus = newBus();
+    {
+        SSD1306 partial(bus, SSD1306_ADDR_DEFAULT);
+        SSD1306 full(bus, SSD1306_ADDR_ALT);
+        CHECK(partial.init());
+        CHECK(full.init());
+        OledSim partialSim(SSD1306_ADDR_DEFAULT);
+        OledSim fullSim(SSD1306_ADDR_ALT);
+
+        uint32_t lcg = 1;
+        auto next = [&](int n) { lcg = lcg * 1103515245u + 12345u; return (int16_t)((lcg >> 8) % n); };
+
+        size_t partialBytes = 0;
+        for (int frame = 0; frame < 200; frame++) {
+            for (SSD1306* d : { &partial, &full }) {
+                if (frame % 50 == 0) d->clear();
+            }
+            for (int k = 0; k < 3; k++) {
+                int16_t x = next(140) - 6, y = next(76) - 6, w = next(40), h = next(20);
+                bool on = next(4) != 0;
+                int shape = next(5);
+                for (SSD1306* d : { &partial, &full }) {
+                    switch (shape) {
+                        case 0: d->drawPixel(x, y, on); break;
+                        case 1: d->drawLine(x, y, x + w, y + h - 10, on); break;
+                        case 2: d->fillRect(x, y, w, h, on); break;
+                        case 3: d->drawCircle(x, y, h, on); break;
+                        case 4: d->drawString(x, y, "42.0", on); break;
+                    }
+                }
+            }
+
+            partial.update();
+            partialBytes += partial.getLastUpdateBytes();
+            full.invalidate();
+            full.update();
+
+            partialSim.replay(mock::i2c::log());
+            fullSim.replay(mock::i2c::log());
+            if (partialSim.memory() != fullSim.memory()) {
+                printf("  frame %d: panel RAM differs\n", frame);
+                CHECK(partialSim.memory() == fullSim.memory());
+                break;
+            }
+        }
+        METRIC("random primitives: bytes/update", partialBytes / 200.0, "B");
+    }
+    i2c_del_master_bus(bus);
+}
+
+
+TEST_CASE(status_screen_ticking)
+{
+    i2c_master_bus_handle_t bus = newBus();
+    {
+        SSD1306 oled(bus);
+        CHECK(oled.init());
+        OledSim sim;
+        statusScreen(oled);
+        update(oled, sim);
+
+        // Seconds ticking: clear() + full redraw every frame
+        size_t total = 0;
+        double busUs = 0;
+        const int frames = 60;
+        for (int s = 0; s < frames; s++) {
+            char clock[16];
+            snprintf(clock, sizeof(clock), "12:34:%02d", s);
+            statusScreen(oled);
+            oled.drawString(60, 40, clock);
+            Update u = update(oled, sim);
+            total += u.bytes;
+            busUs += u.busUs;
+        }
+
+        METRIC("ticking status screen: bytes/update", (double)total / frames, "B");
+        METRIC("ticking status screen: bus time @400kHz", busUs / frames, "us");
+        CHECK(total / frames * 10 < WINDOW_BYTES + 1024);
+    }
+    i2c_del_master_bus(bus);
+}
+
+
+TEST_CASE(frame_rate_by_scl_speed)
+{
+    double fullUs[2] = {}, tickUs[2] = {};
+    const uint32_t speeds[2] = { 400000, 1000000 };
+
+    for (int i = 0; i < 2; i++) {
+        mock::reset();
+        i2c_master_bus_handle_t bus = newBus();
+        {
+            SSD1306 oled(bus, SSD1306_ADDR_DEFAULT, speeds[i]);
+            CHECK(oled.init());
+
+            // Full screen: inverted every frame
+            const int frames = 20;
+            int64_t start = mock::nowUs();
+            for (int f = 0; f < frames; f++) {
+                if (f % 2) oled.clear();
+                else oled.fill();
+                oled.update();
+            }
+            fullUs[i] = (double)(mock::nowUs() - start) / frames;
+
+            // Status screen with the seconds ticking
+            statusScreen(oled);
+            oled.update();
+            start = mock::nowUs();
+            for (int s = 0; s < 60; s++) {
+                char clock[16];
+                snprintf(clock, sizeof(clock), "12:34:%02d", s);
+                statusScreen(oled);
+                oled.drawString(60, 40, clock);
+                oled.update();
+            }
+            tickUs[i] = (double)(mock::nowUs() - start) / 60;
+        }
+        i2c_del_master_bus(bus);
+    }
+
+    METRIC("full screen @400kHz", 1e6 / fullUs[0], "fps");
+    METRIC("full screen @1MHz", 1e6 / fullUs[1], "fps");
+    METRIC("ticking status screen @400kHz", 1e6 / tickUs[0], "fps");
+    METRIC("ticking status screen @1MHz", 1e6 / tickUs[1], "fps");
+
+    // 1032 bytes at 9 clocks each: ~23 ms at 400 kHz, ~9 ms at 1 MHz
+    CHECK(fullUs[0] > 20000 && fullUs[0] < 26000);
+    CHECK(fullUs[1] * 2.4 < fullUs[0]);
+    CHECK(tickUs[1] < tickUs[0]);
+}
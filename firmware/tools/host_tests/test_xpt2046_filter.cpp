@@ -0,0 +1,339 @@
+/**
+ * @file test_xpt2046_filter.cpp
+ * @brief XPT2046 raw ADC sequences through filter, calibration and tracker.
+ *
+ * Bursts are replayed the way the sampling task hands them over: seven
+ * X and Y conversions plus Z1/Z2 per burst, one burst per interval. The
+ * sequences mimic what a resistive panel produces (settling noise, wild
+ * readings while the pen lands or lifts, a bounce at lift-off), built
+ * from a fixed-seed generator so every run sees the same data.
+ */
+
+#include "host_test.h"
+#include "../../components/display/ili9341/xpt2046_filter.h"
+
+#include <math.h>
+#include <vector>
+
+
+namespace {
+
+constexpr uint8_t SAMPLES = 7;
+constexpr int64_t INTERVAL_US = 10000;
+
+struct Burst {
+    uint16_t xs[SAMPLES];
+    uint16_t ys[SAMPLES];
+    uint16_t z1, z2;
+};
+
+
+/**
+ * @brief Small LCG: the same sequence on every platform.
+ */
+struct Rng {
+    uint32_t state;
+    explicit Rng(uint32_t seed) : state(seed) {}
+    uint32_t next() { state = state * 1664525u + 1013904223u; return state >> 8; }
+    int range(int lo, int hi) { return lo + (int)(next() % (uint32_t)(hi - lo + 1)); }
+};
+
+
+uint16_t clampAdc(int v) { return (uint16_t)(v < 0 ? 0 : v > 4095 ? 4095 : v); }
+
+
+/**
+ * @brief Pen down at a raw position: settling noise and some wild readings.
+ */
+Burst pressed(Rng& rng, int rawX, int rawY, int noise, int outliers)
+{
+    Burst b;
+    for (uint8_t i = 0; i < SAMPLES; i++) {
+        b.xs[i] = clampAdc(rawX + rng.range(-noise, noise));
+        b.ys[i] = clampAdc(rawY + rng.range(-noise, noise));
+    }
+    for (int i = 0; i < outliers; i++) {
+        b.xs[rng.next() % SAMPLES] = (uint16_t)rng.range(0, 4095);
+        b.ys[rng.next() % SAMPLES] = (uint16_t)rng.range(0, 4095);
+    }
+    b.z1 = (uint16_t)rng.range(550, 650);
+    b.z2 = (uint16_t)rng.range(3150, 3250);
+    return b;
+}
+
+
+/**
+ * @brief Pen up: X floats high, Y low, no pressure.
+ */
+Burst released()
+{
+    Burst b;
+    for (uint8_t i = 0; i < SAMPLES; i++) {
+        b.xs[i] = 4095;
+        b.ys[i] = 0;
+    }
+    b.z1 = 0;
+    b.z2 = 4095;
+    return b;
+}
+
+
+struct Replay {
+    std::vector<XPT2046Event> events;
+    int down = 0, moves = 0, up = 0, noisy = 0;
+    int maxStep = 0;                    // Largest jump between two events (px)
+};
+
+
+Replay replay(const std::vector<Burst>& bursts, const XPT2046Calibration& cal,
+              const XPT2046FilterConfig& config = XPT2046FilterConfig())
+{
+    XPT2046Tracker tracker;
+    XPT2046EventQueue<16> queue;
+    Replay r;
+    int64_t t = 0;
+
+    for (const Burst& b : bursts) {
+        XPT2046Sample s = xpt2046FilterBurst(b.xs, b.ys, SAMPLES, b.z1, b.z2, config);
+        if (s.state == XPT2046SampleState::NOISY) r.noisy++;
+
+        XPT2046Event e;
+        if (tracker.update(s, cal, config, t, &e)) queue.post(e);
+
+        XPT2046Event out;
+        while (queue.poll(&out)) {
+            if (!r.events.empty()) {
+                int step = abs(out.x - r.events.back().x);
+                if (abs(out.y - r.events.back().y) > step) step = abs(out.y - r.events.back().y);
+                if (step > r.maxStep) r.maxStep = step;
+            }
+            r.events.push_back(out);
+            if (out.type == XPT2046EventType::DOWN) r.down++;
+            else if (out.type == XPT2046EventType::MOVE) r.moves++;
+            else r.up++;
+        }
+        t += INTERVAL_US;
+    }
+    return r;
+}
+
+
+XPT2046Calibration defaultCalibration()
+{
+    XPT2046Calibration cal;
+    cal.set(200, 3800, 200, 3800, 240, 320, 0);
+    return cal;
+}
+
+}   // namespace
+
+
+TEST_CASE(axis_median_drops_outliers)
+{
+    XPT2046FilterConfig config;
+    uint16_t out = 0;
+
+    // The header's example: one wild reading, average would be ~2046
+    const uint16_t landing[SAMPLES] = {1822, 1819, 1825, 3391, 1820, 1823, 1821};
+    CHECK(xpt2046FilterAxis(landing, SAMPLES, config, &out));
+    CHECK_EQ(out, 1822);
+
+    // Out-of-range readings are dropped before the median
+    const uint16_t edges[SAMPLES] = {4095, 1500, 1504, 20, 1498, 1502, 1500};
+    CHECK(xpt2046FilterAxis(edges, SAMPLES, config, &out));
+    CHECK_EQ(out, 1501);
+
+    // Fewer than half agree: no position
+    const uint16_t lifting[SAMPLES] = {1822, 50, 4095, 3391, 4000, 900, 1821};
+    CHECK(!xpt2046FilterAxis(lifting, SAMPLES, config, &out));
+
+    const uint16_t one[1] = {2000};
+    CHECK(xpt2046FilterAxis(one, 1, config, &out));
+    CHECK_EQ(out, 2000);
+    CHECK(!xpt2046FilterAxis(one, 0, config, &out));
+}
+
+
+TEST_CASE(burst_states_from_pressure_and_agreement)
+{
+    XPT2046FilterConfig config;
+    Rng rng(7);
+
+    Burst up = released();
+    CHECK(xpt2046FilterBurst(up.xs, up.ys, SAMPLES, up.z1, up.z2, config).state == XPT2046SampleState::RELEASED);
+
+    Burst light = pressed(rng, 2000, 2000, 5, 0);
+    light.z1 = 50;
+    light.z2 = 3900;                    // Pressure 245 < 400
+    CHECK(xpt2046FilterBurst(light.xs, light.ys, SAMPLES, light.z1, light.z2, config).state ==
+          XPT2046SampleState::RELEASED);
+
+    Burst good = pressed(rng, 2000, 1000, 5, 0);
+    XPT2046Sample s = xpt2046FilterBurst(good.xs, good.ys, SAMPLES, good.z1, good.z2, config);
+    CHECK(s.state == XPT2046SampleState::PRESSED);
+    CHECK(abs(s.rawX - 2000) <= 5);
+    CHECK(abs(s.rawY - 1000) <= 5);
+
+    Burst garbage = pressed(rng, 2000, 1000, 5, 0);
+    for (uint8_t i = 0; i < 4; i++) garbage.xs[i] = (uint16_t)(500 + i * 900);
+    CHECK(xpt2046FilterBurst(garbage.xs, garbage.ys, SAMPLES, garbage.z1, garbage.z2, config).state ==
+          XPT2046SampleState::NOISY);
+}
+
+
+TEST_CASE(calibration_matches_exact_mapping)
+{
+    // Normal, one inverted axis, both inverted, a very narrow range
+    const int16_t cals[][4] = { {200, 3800, 200, 3800}, {200, 3800, 3700, 300},
+                                {3900, 150, 3950, 120}, {1000, 1100, 500, 600} };
+    int worst = 0;
+
+    for (const auto& c : cals) {
+        for (uint8_t rotation = 0; rotation < 4; rotation++) {
+            XPT2046Calibration cal;
+            cal.set(c[0], c[1], c[2], c[3], 240, 320, rotation);
+
+            for (int rx = 0; rx < 4096; rx += 7) {
+                for (int ry = 0; ry < 4096; ry += 13) {
+                    int16_t x, y;
+                    cal.map(rx, ry, &x, &y);
+
+                    double fx = (double)(rx - c[0]) * 239 / (c[1] - c[0]);
+                    double fy = (double)(ry - c[2]) * 319 / (c[3] - c[2]);
+                    int sx = (int)lround(fmin(239, fmax(0, fx)));
+                    int sy = (int)lround(fmin(319, fmax(0, fy)));
+                    int ex, ey;
+                    switch (rotation) {
+                        case 0:  ex = sx;        ey = sy;        break;
+                        case 1:  ex = sy;        ey = 239 - sx;  break;
+                        case 2:  ex = 239 - sx;  ey = 319 - sy;  break;
+                        default: ex = 319 - sy;  ey = sx;        break;
+                    }
+                    if (abs(ex - x) > worst) worst = abs(ex - x);
+                    if (abs(ey - y) > worst) worst = abs(ey - y);
+                }
+            }
+        }
+    }
+    CHECK(worst <= 1);
+    METRIC("calibration max error vs exact", worst, "px");
+
+    // The calibration points land on the screen edges
+    XPT2046Calibration cal = defaultCalibration();
+    int16_t x, y;
+    cal.map(200, 200, &x, &y);
+    CHECK_EQ(x, 0);
+    CHECK_EQ(y, 0);
+    cal.map(3800, 3800, &x, &y);
+    CHECK_EQ(x, 239);
+    CHECK_EQ(y, 319);
+}
+
+
+TEST_CASE(tap_is_one_down_and_one_up)
+{
+    Rng rng(1);
+    std::vector<Burst> bursts;
+    for (int i = 0; i < 3; i++) bursts.push_back(released());
+    bursts.push_back(pressed(rng, 2000, 2000, 6, 2));       // Landing
+    for (int i = 0; i < 4; i++) bursts.push_back(pressed(rng, 2000, 2000, 6, 0));
+    for (int i = 0; i < 3; i++) bursts.push_back(released());
+
+    Replay r = replay(bursts, defaultCalibration());
+    CHECK_EQ(r.down, 1);
+    CHECK_EQ(r.moves, 0);
+    CHECK_EQ(r.up, 1);
+    CHECK(r.events.back().type == XPT2046EventType::UP);
+    CHECK_EQ(r.events.back().timeUs, 9 * INTERVAL_US);     // Second released burst
+}
+
+
+TEST_CASE(resting_pen_sends_almost_nothing)
+{
+    Rng rng(2);
+    std::vector<Burst> bursts;
+    for (int i = 0; i < 200; i++) bursts.push_back(pressed(rng, 1500, 2500, 10, i % 3 == 0));
+    bursts.push_back(released());
+    bursts.push_back(released());
+
+    Replay r = replay(bursts, defaultCalibration());
+    CHECK_EQ(r.down, 1);
+    CHECK_EQ(r.up, 1);
+    CHECK(r.moves <= 3);
+    METRIC("MOVEs from 200 resting bursts", r.moves, "");
+}
+
+
+TEST_CASE(drag_survives_noise_and_lift_bounce)
+{
+    Rng rng(3);
+    std::vector<Burst> bursts;
+    for (int i = 0; i < 100; i++) bursts.push_back(pressed(rng, 500 + i * 28, 800 + i * 20, 8, i % 4 == 0));
+    bursts.push_back(pressed(rng, 3300, 2800, 8, 5));        // Lifting: garbage
+    bursts.push_back(released());
+    bursts.push_back(pressed(rng, 3300, 2800, 8, 0));        // Bounce
+    bursts.push_back(released());
+    bursts.push_back(released());
+
+    Replay r = replay(bursts, defaultCalibration());
+    CHECK_EQ(r.down, 1);
+    CHECK_EQ(r.up, 1);
+    CHECK(r.moves >= 80);
+    CHECK(r.maxStep <= 4);              // No jump from an outlier
+    CHECK(r.events.front().type == XPT2046EventType::DOWN);
+    CHECK(r.events.back().type == XPT2046EventType::UP);
+    METRIC("drag MOVEs", r.moves, "");
+    METRIC("drag largest step", r.maxStep, "px");
+}
+
+
+TEST_CASE(full_queue_keeps_down_up_pairs)
+{
+    XPT2046EventQueue<4> q;
+    XPT2046Event e = {XPT2046EventType::DOWN, 0, 0, 0, 0};
+
+    CHECK(q.post(e));
+    e.type = XPT2046EventType::MOVE;
+    CHECK(q.post(e));
+    CHECK(q.post(e));
+    CHECK(!q.post(e));                  // Last slot is kept for UP
+    e.type = XPT2046EventType::UP;
+    CHECK(q.post(e));
+    e.type = XPT2046EventType::DOWN;
+    CHECK(!q.post(e));                  // Whole touch dropped...
+    e.type = XPT2046EventType::UP;
+    CHECK(!q.post(e));                  // ...including its UP
+
+    XPT2046Event out;
+    int n = 0;
+    XPT2046EventType last = XPT2046EventType::DOWN;
+    while (q.poll(&out)) {
+        n++;
+        last = out.type;
+    }
+    CHECK_EQ(n, 4);
+    CHECK(last == XPT2046EventType::UP);
+    CHECK_EQ(q.getDropped(), 3);
+}
+
+
+TEST_CASE(filter_speed)
+{
+    Rng rng(4);
+    std::vector<Burst> bursts;
+    for (int i = 0; i < 1000; i++) bursts.push_back(pressed(rng, rng.range(300, 3700), rng.range(300, 3700), 12, i & 1));
+
+    XPT2046FilterConfig config;
+    uint32_t valid = 0;
+    const int loops = 100;
+    double start = host_test::hostUs();
+    for (int l = 0; l < loops; l++) {
+        for (const Burst& b : bursts) {
+            valid += xpt2046FilterBurst(b.xs, b.ys, SAMPLES, b.z1, b.z2, config).state ==
+                       XPT2046SampleState::PRESSED;
+        }
+    }
+    double ns = (host_test::hostUs() - start) * 1000.0 / (loops * bursts.size());
+    CHECK(valid > 0);
+    METRIC("filter one 7-sample burst (host)", ns, "ns");
+}
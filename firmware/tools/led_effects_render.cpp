@@ -0,0 +1,145 @@
+/*
+ * Render LED effects (components/addressable/led_effects.h) on the PC.
+ *
+ * Every frame becomes one row of a PPM image, LED 0 on the left and time
+ * going down, so an effect can be looked at in any image viewer and
+ * compared byte for byte against a saved golden image. The same effect
+ * code runs on the ESP32, so a change in the output is a change on the
+ * strip.
+ *
+ * Build:
+ *     g++ -std=c++17 -O2 -I../components/addressable led_effects_render.cpp \
+ *         ../components/addressable/led_effects.cpp -o led_effects_render
+ *
+ * Usage:
+ *     led_effects_render fire -o fire.ppm                     # 144 LEDs, 250 frames at 50 fps
+ *     led_effects_render rainbow --leds 60 --frames 500 -o rainbow.ppm
+ *     led_effects_render chase --to twinkle --at 2000 --fade 1000 -o mix.ppm
+ *     led_effects_render breathe --raw breathe.rgb            # count × 3 bytes per frame
+ *
+ * Golden images:
+ *     host_tests builds this tool and compares short renders of every
+ *     effect (and two crossfades) with the host_tests/golden/ PPM files
+ *     (ctest -R golden). After an intended change, configure with
+ *     -DUPDATE_GOLDEN=ON, run ctest -R golden once and look at the new
+ *     images before committing.
+ *
+ * The FNV-1a hash of all frames is printed as well, for quick checks.
+ *
+ * Effects: rainbow, chase, twinkle, fire, breathe, gradient, gradient-scroll
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "led_effects.h"
+
+
+static RainbowEffect rainbow(5000, 1);
+static ChaseEffect chase({255, 255, 255}, {0, 0, 16}, 3000, 12);
+static TwinkleEffect twinkle({255, 200, 120}, 20, 800, 1);
+static FireEffect fire(55, 120, 16, 1);
+static BreatheEffect breathe({255, 120, 40}, 4000, 8);
+static GradientEffect gradient({255, 0, 80}, {0, 80, 255}, 0);
+static GradientEffect gradientScroll({255, 0, 80}, {0, 80, 255}, 6000);
+
+static LedEffect* findEffect(const char* name)
+{
+    if (!strcmp(name, "none")) return nullptr;
+    if (!strcmp(name, "gradient-scroll")) return &gradientScroll;
+
+    LedEffect* all[] = {&rainbow, &chase, &twinkle, &fire, &breathe, &gradient};
+    for (LedEffect* e : all) {
+        if (!strcmp(name, e->name())) return e;
+    }
+    fprintf(stderr, "unknown effect '%s'\n", name);
+    exit(2);
+}
+
+static void usage()
+{
+    fprintf(stderr,
+        "usage: led_effects_render <effect> [--leds N] [--fps N] [--frames N]\n"
+        "                          [--to <effect> --at MS --fade MS] [--level N]\n"
+        "                          [-o image.ppm] [--raw frames.rgb]\n");
+    exit(2);
+}
+
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) usage();
+
+    LedEffect* first = findEffect(argv[1]);
+    LedEffect* second = nullptr;
+    bool crossfade = false;
+    unsigned leds = 144, fps = 50, frames = 250, atMs = 0, fadeMs = 1000, level = 255;
+    const char* ppmPath = nullptr;
+    const char* rawPath = nullptr;
+
+    for (int i = 2; i < argc; i++) {
+        const char* opt = argv[i];
+        if (i + 1 >= argc) usage();
+        const char* val = argv[++i];
+
+        if      (!strcmp(opt, "--leds"))   leds = atoi(val);
+        else if (!strcmp(opt, "--fps"))    fps = atoi(val);
+        else if (!strcmp(opt, "--frames")) frames = atoi(val);
+        else if (!strcmp(opt, "--to"))     { second = findEffect(val); crossfade = true; }
+        else if (!strcmp(opt, "--at"))     atMs = atoi(val);
+        else if (!strcmp(opt, "--fade"))   fadeMs = atoi(val);
+        else if (!strcmp(opt, "--level"))  level = atoi(val);
+        else if (!strcmp(opt, "-o"))       ppmPath = val;
+        else if (!strcmp(opt, "--raw"))    rawPath = val;
+        else usage();
+    }
+    if (leds == 0 || leds > 65535 || fps == 0 || frames == 0 || level > 255 || fadeMs > 65535) usage();
+
+    LedEffectMixer mixer;
+    if (!mixer.begin(leds) || !mixer.setEffect(first, 0, 0)) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    mixer.setLevel(level);
+
+    FILE* ppm = ppmPath ? fopen(ppmPath, "wb") : nullptr;
+    FILE* raw = rawPath ? fopen(rawPath, "wb") : nullptr;
+    if ((ppmPath && !ppm) || (rawPath && !raw)) {
+        perror("open");
+        return 1;
+    }
+    if (ppm) fprintf(ppm, "P6\n%u %u\n255\n", leds, frames);
+
+    uint64_t hash = 1469598103934665603ull;
+    double renderUs = 0;
+    bool switched = false;
+
+    for (unsigned f = 0; f < frames; f++) {
+        uint32_t nowMs = (uint32_t)((uint64_t)f * 1000 / fps);      // Same clock as the engine task
+
+        if (crossfade && !switched && nowMs >= atMs) {
+            mixer.setEffect(second, nowMs, fadeMs);
+            switched = true;
+        }
+
+        auto t0 = std::chrono::steady_clock::now();
+        const RGB* frame = mixer.render(nowMs);
+        renderUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+
+        const uint8_t* bytes = (const uint8_t*)frame;
+        for (size_t i = 0; i < (size_t)leds * 3; i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        if (ppm) fwrite(frame, 3, leds, ppm);
+        if (raw) fwrite(frame, 3, leds, raw);
+    }
+
+    if (ppm) fclose(ppm);
+    if (raw) fclose(raw);
+
+    printf("%s%s%s: %u LEDs, %u frames, hash %016llx, %.2f us/frame on this PC\n",
+           argv[1], crossfade ? " -> " : "", crossfade ? (second ? second->name() : "none") : "",
+           leds, frames, (unsigned long long)hash, renderUs / frames);
+    return 0;
+}
@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+"""
+Convert images to the compressed RGB565 asset format (rgb565_asset.h).
+
+The smallest of raw, RLE and palette + RLE is picked unless --encoding is
+given. Transparent pixels (alpha < 128) become the transparent key, which
+drawSprite() skips.
+
+Usage:
+    rgb565_asset.py icon.png -o icon.r565              # Binary, for EMBED_FILES
+    rgb565_asset.py icon.png --header icon_asset.h     # C array
+    rgb565_asset.py logo.png -o logo.r565 --key 0xF81F --encoding rle
+
+Embedding the binary in an ESP-IDF component:
+    idf_component_register(... EMBED_FILES "icon.r565")
+    extern const uint8_t icon_start[] asm("_binary_icon_r565_start");
+
+Requires Pillow (pip install pillow).
+"""
+
+import argparse
+import re
+import shlex
+import struct
+import sys
+from pathlib import Path
+
+from PIL import Image
+
+MAGIC = b"R565"
+VERSION = 1
+ENC_RAW, ENC_RLE, ENC_PALETTE = 0, 1, 2
+ENCODINGS = {"raw": ENC_RAW, "rle": ENC_RLE, "palette": ENC_PALETTE}
+FLAG_HAS_KEY = 0x0001
+MAX_PACKET = 128
+
+
+def rgb565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def load_pixels(path, key):
+    """Return (width, height, rows of RGB565 values, key or None)."""
+    img = Image.open(path).convert("RGBA")
+    width, height = img.size
+    raw = img.tobytes()
+    data = [tuple(raw[i:i + 4]) for i in range(0, len(raw), 4)]
+
+    opaque = {rgb565(r, g, b) for r, g, b, a in data if a >= 128}
+    has_alpha = any(a < 128 for _, _, _, a in data)
+
+    if has_alpha and key is None:
+        # Any color the image does not use; magenta first
+        key = next((c for c in [0xF81F] + list(range(0x10000)) if c not in opaque), None)
+        if key is None:
+            sys.exit(f"{path}: every RGB565 value is used, no free transparent key")
+    if key is not None and key in opaque:
+        print(f"warning: {path}: opaque pixels have the key color 0x{key:04X} "
+              "and will be transparent", file=sys.stderr)
+
+    pixels = [key if a < 128 else rgb565(r, g, b) for r, g, b, a in data]
+    rows = [pixels[y * width:(y + 1) * width] for y in range(height)]
+    return width, height, rows, key
+
+
+def rle_row(values, pack):
+    """RLE-encode one row; pack(value) gives the stored bytes of a value."""
+    out = bytearray()
+    literal = []
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:MAX_PACKET]
+            del literal[:MAX_PACKET]
+            out.append(len(chunk) - 1)
+            for v in chunk:
+                out.extend(pack(v))
+
+    i = 0
+    while i < len(values):
+        run = 1
+        while i + run < len(values) and values[i + run] == values[i] and run < MAX_PACKET:
+            run += 1
+
+        # A 2-pixel run only pays off when no literal has to be split for it
+        if run >= 3 or (run == 2 and not literal):
+            flush_literal()
+            out.append(0x80 | (run - 1))
+            out += pack(values[i])
+            i += run
+        else:
+            literal.append(values[i])
+            i += 1
+
+    flush_literal()
+    return bytes(out)
+
+
+def encode(width, height, rows, key, encoding):
+    palette = []
+    if encoding == ENC_RAW:
+        data = b"".join(struct.pack(">%dH" % width, *row) for row in rows)
+        index = b""
+    else:
+        if encoding == ENC_PALETTE:
+            palette = sorted({v for row in rows for v in row})
+            lookup = {c: i for i, c in enumerate(palette)}
+            pack = lambda v: bytes([lookup[v]])
+        else:
+            pack = lambda v: struct.pack(">H", v)
+
+        encoded = [rle_row(row, pack) for row in rows]
+        offsets, pos = [], 0
+        for row in encoded:
+            offsets.append(pos)
+            pos += len(row)
+        data = b"".join(encoded)
+        index = struct.pack("<%dI" % height, *offsets)
+
+    flags = FLAG_HAS_KEY if key is not None else 0
+    header = MAGIC + struct.pack("<BBHHHHH", VERSION, encoding, flags, width, height,
+                                 key or 0, len(palette))
+    return header + struct.pack(">%dH" % len(palette), *palette) + index + data
+
+
+def write_header(path, name, blob, tool="rgb565_asset.py"):
+    args = " ".join(shlex.quote(Path(a).name if "/" in a else a) for a in sys.argv[1:])
+    lines = [f"// Generated by {tool}, do not edit", f"// {tool} {args}", "#pragma once", "",
+             "#include <stddef.h>", "#include <stdint.h>", "",
+             f"static const uint8_t {name}[] = {{"]
+    for i in range(0, len(blob), 16):
+        lines.append("    " + ", ".join(f"0x{b:02X}" for b in blob[i:i + 16]) + ",")
+    lines += ["};", f"static const size_t {name}_size = sizeof({name});", ""]
+    Path(path).write_text("\n".join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert an image to an RGB565 asset")
+    parser.add_argument("image", help="Input image (PNG, BMP, ...)")
+    parser.add_argument("-o", "--output", help="Binary output (.r565)")
+    parser.add_argument("--header", help="C header output")
+    parser.add_argument("--name", help="Array name in the header (default: from file name)")
+    parser.add_argument("--key", type=lambda s: int(s, 0),
+                        help="Transparent key as RGB565 (default: a free color if the image has alpha)")
+    parser.add_argument("--encoding", choices=["auto"] + list(ENCODINGS), default="auto")
+    args = parser.parse_args()
+
+    if not args.output and not args.header:
+        parser.error("give --output and/or --header")
+
+    width, height, rows, key = load_pixels(args.image, args.key)
+    if width > 0xFFFF or height > 0xFFFF:
+        sys.exit(f"{args.image}: too large")
+
+    colors = len({v for row in rows for v in row})
+    if args.encoding == "auto":
+        candidates = [ENC_RAW, ENC_RLE] + ([ENC_PALETTE] if colors <= 256 else [])
+        blobs = [encode(width, height, rows, key, e) for e in candidates]
+        blob = min(blobs, key=len)
+    else:
+        if args.encoding == "palette" and colors > 256:
+            sys.exit(f"{args.image}: {colors} colors, palette encoding holds 256")
+        blob = encode(width, height, rows, key, ENCODINGS[args.encoding])
+
+    if args.output:
+        Path(args.output).write_bytes(blob)
+    if args.header:
+        name = args.name or re.sub(r"\W", "_", Path(args.image).stem)
+        write_header(args.header, name, blob)
+
+    names = {v: k for k, v in ENCODINGS.items()}
+    print(f"{args.image}: {width}x{height}, {colors} colors, {names[blob[5]]}, "
+          f"{len(blob)} bytes (raw {width * height * 2})")
+
+
+if __name__ == "__main__":
+    main()
@@ -138,6 +138,97 @@ int WiFiHttpClient::get(const char* url, char* response_buf, size_t buf_len,
                           response_buf, buf_len, timeout_ms);
 }
 
+/* Streaming GET: open the connection and read the body ourselves instead
+ * of letting esp_http_client_perform() collect it through the event handler.
+ * esp_http_client_read() already removes chunked transfer encoding.
+ *
+ * perform() follows redirects by itself; open()/read() does not, so a 3xx
+ * with a Location header is followed here: point the client at the new
+ * URL and open again (at most STREAM_MAX_REDIRECTS times). */
+static bool isRedirect(int status_code) {
+    return status_code == 301 || status_code == 302 || status_code == 303 ||
+           status_code == 307 || status_code == 308;
+}
+
+int WiFiHttpClient::getStream(const char* url, StreamCallback on_data, void* ctx,
+                               int timeout_ms) {
+    if (!url || !on_data) return -1;
+
+    esp_http_client_config_t config = {};
+    config.url = url;
+    config.method = HTTP_METHOD_GET;
+    config.timeout_ms = timeout_ms;
+
+    esp_http_client_handle_t client = esp_http_client_init(&config);
+    if (!client) {
+        ESP_LOGE(TAG, "Failed to init HTTP client");
+        return -1;
+    }
+
+    int status_code = -1;
+
+    for (int redirects = 0; ; redirects++) {
+        esp_err_t err = esp_http_client_open(client, 0);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "HTTP request failed: %s", esp_err_to_name(err));
+            esp_http_client_cleanup(client);
+            return -1;
+        }
+
+        if (esp_http_client_fetch_headers(client) < 0) {
+            ESP_LOGE(TAG, "Failed to read response headers");
+            esp_http_client_close(client);
+            esp_http_client_cleanup(client);
+            return -1;
+        }
+        status_code = esp_http_client_get_status_code(client);
+
+        if (!isRedirect(status_code) || redirects == STREAM_MAX_REDIRECTS) break;
+
+        if (esp_http_client_set_redirection(client) != ESP_OK) {
+            ESP_LOGW(TAG, "Redirect %d without a usable Location", status_code);
+            break;
+        }
+        esp_http_client_close(client);
+    }
+
+    /* Error pages (and a redirect we did not follow) are not the body the
+     * caller asked for: report the status, never hand them to on_data. */
+    if (status_code < 200 || status_code >= 300) {
+        ESP_LOGW(TAG, "GET %s → %d, body not streamed", url, status_code);
+        esp_http_client_close(client);
+        esp_http_client_cleanup(client);
+        return status_code;
+    }
+
+    uint8_t chunk[STREAM_CHUNK_SIZE];
+    size_t total = 0;
+    bool stopped = false;
+
+    while (true) {
+        int len = esp_http_client_read(client, (char*)chunk, sizeof(chunk));
+        if (len < 0) {
+            ESP_LOGE(TAG, "Read failed after %d bytes", (int)total);
+            status_code = -1;
+            break;
+        }
+        if (len == 0) break;    // End of body
+
+        total += len;
+        if (!on_data(chunk, len, ctx)) {
+            stopped = true;
+            break;
+        }
+    }
+
+    ESP_LOGI(TAG, "GET %s → %d (%d bytes streamed%s)", url, status_code,
+             (int)total, stopped ? ", stopped by callback" : "");
+
+    esp_http_client_close(client);
+    esp_http_client_cleanup(client);
+    return status_code;
+}
+
 int WiFiHttpClient::post(const char* url, const char* body,
                           char* response_buf, size_t buf_len,
                           const char* content_type, int timeout_ms) {
@@ -48,6 +48,10 @@
  *     status = WiFiHttpClient::post("http://api.example.com/sensor",
  *                                    json, response, sizeof(response));
  * 
+ *     // Large download, processed chunk by chunk (no response buffer)
+ *     status = WiFiHttpClient::getStream("http://cam.local/snapshot.qoi",
+ *                                         onChunk, &decoder);
+ * 
  * =============================================================================
  */
 
@@ -60,6 +64,16 @@
 
 class WiFiHttpClient {
 public:
+    /**
+     * @brief Receives one chunk of a streamed response body.
+     * 
+     * @param data  Chunk data (valid only during the call)
+     * @param len   Chunk length
+     * @param ctx   Pointer passed to getStream()
+     * @return true to keep reading, false to stop the download
+     */
+    typedef bool (*StreamCallback)(const uint8_t* data, size_t len, void* ctx);
+
     /**
      * @brief Perform an HTTP GET request.
      * 
@@ -72,6 +86,34 @@ public:
     static int get(const char* url, char* response_buf, size_t buf_len,
                    int timeout_ms = 10000);
 
+    /**
+     * @brief Perform an HTTP GET request and hand the body over in chunks.
+     * 
+     * For responses too big for a buffer (images, firmware files): each
+     * network read goes straight to on_data, so memory use stays at one
+     * STREAM_CHUNK_SIZE buffer whatever the response size.
+     * 
+     * Redirects (301/302/303/307/308) are followed up to
+     * STREAM_MAX_REDIRECTS times. on_data only sees the body of a 2xx
+     * response; for any other status the body is skipped and the status
+     * is returned.
+     * 
+     * @param url           Full URL (http:// or https://)
+     * @param on_data       Called for every chunk of the body
+     * @param ctx           Passed through to on_data
+     * @param timeout_ms    Request timeout (default 10s)
+     * @return HTTP status code (200, 404, etc.) or -1 on error (connection,
+     *         headers, or a read failing mid-body)
+     */
+    static int getStream(const char* url, StreamCallback on_data, void* ctx,
+                         int timeout_ms = 10000);
+
+    /** @brief Bytes read from the network per getStream() chunk (stack buffer) */
+    static constexpr size_t STREAM_CHUNK_SIZE = 1024;
+
+    /** @brief Redirects getStream() follows before giving up */
+    static constexpr int STREAM_MAX_REDIRECTS = 3;
+
     /**
      * @brief Perform an HTTP POST request with a body.
      * 